@@ -30,12 +30,8 @@ class Crypto {
                                                 const std::string& message);
 
  private:
-  static std::vector<uint32_t> sha256Init();
   static std::vector<unsigned char> sha256(
       const std::vector<unsigned char>& src);
-  static void sha256Transform(const std::vector<unsigned char>& currentChunk,
-                              unsigned long startIndex,
-                              std::vector<uint32_t>& hashValue);
   static std::vector<unsigned char> toUnsignedCharVector(
       const std::string& src);
 };
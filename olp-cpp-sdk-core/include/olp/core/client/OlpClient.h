@@ -28,6 +28,7 @@
 #include <olp/core/CoreApi.h>
 #include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/OlpClientSettings.h>
+#include <olp/core/http/NetworkRequest.h>
 
 namespace olp {
 namespace client {
@@ -40,6 +41,8 @@ class CORE_API OlpClient {
   /// Alias for the parameters and headers type.
   using ParametersType = std::multimap<std::string, std::string>;
   using RequestBodyType = std::shared_ptr<std::vector<std::uint8_t>>;
+  /// Alias for the request body that is read while it is sent.
+  using RequestBodySourceType = http::NetworkRequest::RequestBodySourceType;
 
   OlpClient();
   virtual ~OlpClient();
@@ -131,6 +134,31 @@ class CORE_API OlpClient {
                        RequestBodyType post_body, std::string content_type,
                        CancellationContext context) const;
 
+  /**
+   * @brief Executes the HTTP request with a body that is read while it is
+   * sent in a blocking way.
+   *
+   * The body is not kept in memory. It is read again from the source if
+   * the request is retried.
+   *
+   * @param path The path that is appended to the base URL.
+   * @param method Select one of the following methods: `POST` or `PUT`.
+   * @param query_params The parameters that are appended to the URL path.
+   * @param header_params The headers used to customize the request.
+   * @param body_source The source of the request body.
+   * @param content_type The content type of the body.
+   * @param context The `CancellationContext` instance that is used to cancel
+   * the request.
+   *
+   * @return The `HttpResponse` instance.
+   */
+  HttpResponse CallApi(std::string path, std::string method,
+                       ParametersType query_params,
+                       ParametersType header_params,
+                       RequestBodySourceType body_source,
+                       std::string content_type,
+                       CancellationContext context) const;
+
  private:
   class OlpClientImpl;
   std::shared_ptr<OlpClientImpl> impl_;
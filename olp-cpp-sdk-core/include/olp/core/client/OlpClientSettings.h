@@ -289,6 +289,15 @@ struct CORE_API OlpClientSettings {
    * volatile or versioned, and which is stored in cache.
    */
   std::chrono::seconds default_cache_expiration = std::chrono::seconds::max();
+
+  /**
+   * @brief The maximum size (in bytes) of the quadtree indexes that the read
+   * clients keep decoded in memory.
+   *
+   * The quadtrees are shared by all the read clients of the process, the size
+   * set by the most recently created client applies. Set to 0 to disable.
+   */
+  size_t quad_tree_memory_cache_size = 16u * 1024u * 1024u;
 };
 
 }  // namespace client
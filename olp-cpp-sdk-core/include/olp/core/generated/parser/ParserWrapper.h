@@ -22,6 +22,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <boost/optional.hpp>
@@ -60,7 +61,7 @@ template <typename T>
 inline void from_json(const rapidjson::Value& value, boost::optional<T>& x) {
   T result = T();
   from_json(value, result);
-  x = result;
+  x = std::move(result);
 }
 
 template <typename T>
@@ -76,11 +77,12 @@ inline void from_json(const rapidjson::Value& value,
 
 template <typename T>
 inline void from_json(const rapidjson::Value& value, std::vector<T>& results) {
+  results.reserve(results.size() + value.Size());
   for (rapidjson::Value::ConstValueIterator itr = value.Begin();
        itr != value.End(); ++itr) {
     T result;
     from_json(*itr, result);
-    results.push_back(result);
+    results.push_back(std::move(result));
   }
 }
 
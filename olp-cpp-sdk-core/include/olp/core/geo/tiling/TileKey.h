@@ -20,6 +20,8 @@
 #pragma once
 
 #include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include <boost/optional.hpp>
@@ -64,6 +66,8 @@ class CORE_API TileKey {
  public:
   enum { LevelCount = 32 };
   enum { MaxLevel = LevelCount - 1 };
+  /// The maximum length of a heretile code, without the null character.
+  enum { HereTileMaxLength = 20 };
 
   /**
    * @brief Cardinal direction, used to find child node by such direction or for
@@ -158,6 +162,19 @@ class CORE_API TileKey {
    */
   std::string ToHereTile() const;
 
+  /**
+   * @brief Writes the heretile code of the tile key into the buffer.
+   *
+   * Does not allocate memory. A buffer of `HereTileMaxLength + 1` characters
+   * always fits the code and the terminating null character.
+   *
+   * @param buffer The buffer that receives the code.
+   * @param size The size of the buffer.
+   *
+   * @return The length of the code, or 0 if it does not fit into the buffer.
+   */
+  std::size_t ToHereTile(char* buffer, std::size_t size) const;
+
   /**
    * @brief Creates a tile key from a heretile codes string.
    *
@@ -458,6 +475,34 @@ struct CORE_API QuadKey64Helper {
   std::uint64_t key{0};
 };
 
+/**
+ * @brief A range of tiles on one level with consecutive 64-bit morton codes.
+ *
+ * Describes large areas of tiles with little memory, see
+ * TileKeyUtils::GeoRectangleToTileKeyRanges().
+ */
+struct CORE_API TileKeyRange {
+  /**
+   * @brief Checks whether the tile with the 64-bit morton code is in the
+   * range.
+   */
+  constexpr bool Contains(std::uint64_t quad_key) const {
+    return first <= quad_key && quad_key <= last;
+  }
+
+  /**
+   * @brief Equality operator.
+   */
+  constexpr bool operator==(const TileKeyRange& other) const {
+    return first == other.first && last == other.last;
+  }
+
+  /// The 64-bit morton code of the first tile, see TileKey::ToQuadKey64().
+  std::uint64_t first{0};
+  /// The 64-bit morton code of the last tile, included in the range.
+  std::uint64_t last{0};
+};
+
 using TileKeyLevels = std::bitset<TileKey::LevelCount>;
 
 /**
@@ -492,6 +537,30 @@ CORE_API boost::optional<std::uint32_t> GetMaxTileKeyLevel(
 CORE_API boost::optional<std::uint32_t> GetNearestAvailableTileKeyLevel(
     const TileKeyLevels& levels, const std::uint32_t reference_level);
 
+/**
+ * @brief Converts the tile keys to 64-bit morton codes.
+ *
+ * Gives the same results as TileKey::ToQuadKey64() called for each tile key.
+ *
+ * @param tile_keys The tile keys to convert.
+ * @param count The number of tile keys.
+ * @param quad_keys The array that receives `count` morton codes.
+ */
+CORE_API void ToQuadKey64(const TileKey* tile_keys, std::size_t count,
+                          std::uint64_t* quad_keys);
+
+/**
+ * @brief Creates tile keys from 64-bit morton codes.
+ *
+ * Gives the same results as TileKey::FromQuadKey64() called for each code.
+ *
+ * @param quad_keys The morton codes to convert.
+ * @param count The number of morton codes.
+ * @param tile_keys The array that receives `count` tile keys.
+ */
+CORE_API void FromQuadKey64(const std::uint64_t* quad_keys, std::size_t count,
+                            TileKey* tile_keys);
+
 /**
  * @brief The stream operator to print or serialize the given TileKey.
  */
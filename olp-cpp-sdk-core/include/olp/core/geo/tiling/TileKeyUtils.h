@@ -58,6 +58,91 @@ class CORE_API TileKeyUtils {
       const ITilingScheme& tiling_scheme, const GeoRectangle& geo_rectangle,
       const std::uint32_t level);
 
+  /**
+   * @brief Gets the tile keys overlapping with the specified geo rectangle as
+   * ranges of 64-bit morton codes.
+   *
+   * Covers the same tiles as GeoRectangleToTileKeys(), but the number of
+   * ranges depends on the outline of the rectangle rather than on its area.
+   *
+   * @param[in] tiling_scheme Tiling scheme.
+   * @param[in] geo_rectangle rectangle to find overlapping tile keys for.
+   * @param[in] level Level of the tile keys.
+   *
+   * @return The ranges sorted by their first tile, without overlaps. When the
+   * tiles can not be calculated empty container is returned.
+   */
+  static std::vector<TileKeyRange> GeoRectangleToTileKeyRanges(
+      const ITilingScheme& tiling_scheme, const GeoRectangle& geo_rectangle,
+      const std::uint32_t level);
+
+  /**
+   * @brief Gets the tile keys overlapping with the specified geo polygon as
+   * ranges of 64-bit morton codes.
+   *
+   * The tiles that are fully inside of the polygon are added without visiting
+   * their children, so the work depends on the outline of the polygon. The
+   * edges are straight lines in the world space of the tiling scheme, and
+   * must not cross the international date line.
+   *
+   * @param[in] tiling_scheme Tiling scheme.
+   * @param[in] geo_polygon The vertices of the polygon, it is closed
+   * implicitly.
+   * @param[in] level Level of the tile keys.
+   *
+   * @return The ranges sorted by their first tile, without overlaps. When the
+   * polygon has less than three vertices empty container is returned.
+   */
+  static std::vector<TileKeyRange> GeoPolygonToTileKeyRanges(
+      const ITilingScheme& tiling_scheme,
+      const std::vector<GeoCoordinates>& geo_polygon,
+      const std::uint32_t level);
+
+  /**
+   * @brief Gets the tile keys that are closer than the buffer to the
+   * specified geo polyline as ranges of 64-bit morton codes.
+   *
+   * The buffer is converted to the world space at every vertex, and the
+   * largest value of a segment is used for the whole segment, so the corridor
+   * may cover slightly more tiles than needed, but never less.
+   *
+   * @param[in] tiling_scheme Tiling scheme.
+   * @param[in] geo_polyline The vertices of the polyline, for example, of a
+   * route. A single vertex makes a circle.
+   * @param[in] buffer The distance in meters to each side of the polyline.
+   * @param[in] level Level of the tile keys.
+   *
+   * @return The ranges sorted by their first tile, without overlaps. When the
+   * polyline is empty or the buffer is negative empty container is returned.
+   */
+  static std::vector<TileKeyRange> GeoCorridorToTileKeyRanges(
+      const ITilingScheme& tiling_scheme,
+      const std::vector<GeoCoordinates>& geo_polyline, const double buffer,
+      const std::uint32_t level);
+
+  /**
+   * @brief Sorts the ranges by their first tile and merges the overlapping
+   * and adjacent ones.
+   *
+   * @param ranges The ranges to merge.
+   *
+   * @return The merged ranges.
+   */
+  static std::vector<TileKeyRange> MergeTileKeyRanges(
+      std::vector<TileKeyRange> ranges);
+
+  /**
+   * @brief Gets the fewest tile keys whose subtrees, on the level of the
+   * range, hold exactly the tiles of the range.
+   *
+   * @param range The range of tiles. Its first and last tiles must be on the
+   * same level.
+   *
+   * @return The tile keys in the order of the range, or an empty container if
+   * the range is invalid.
+   */
+  static std::vector<TileKey> GetCoveringTileKeys(const TileKeyRange& range);
+
   /**
    * @brief Returns the tile key relative to a given parent.
    *
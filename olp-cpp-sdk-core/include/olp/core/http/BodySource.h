@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace http {
+
+/**
+ * @brief The content of a request body that is read on demand.
+ *
+ * The network reads the content in chunks while the request is sent, so
+ * the content does not need to be kept in memory. The content is read by
+ * offset, which allows the network to resend the request. The source can be
+ * read from several threads at the same time.
+ */
+class CORE_API BodySource {
+ public:
+  /**
+   * @brief Reads `size` bytes starting at `offset` into `buffer`.
+   *
+   * @return True if all the bytes are read; false otherwise.
+   */
+  using ReadFunction = std::function<bool(std::uint64_t offset, size_t size,
+                                          std::uint8_t* buffer)>;
+
+  /**
+   * @brief Creates the `BodySource` instance that reads the content with
+   * a callback.
+   *
+   * @param size The size of the content in bytes.
+   * @param read The function that reads the content. It must be thread-safe.
+   */
+  BodySource(std::uint64_t size, ReadFunction read);
+
+  /**
+   * @brief Creates the `BodySource` instance that reads the content from
+   * memory.
+   *
+   * @param data The content.
+   *
+   * @return The `BodySource` instance.
+   */
+  static BodySource FromData(
+      std::shared_ptr<const std::vector<std::uint8_t>> data);
+
+  /**
+   * @brief Creates the `BodySource` instance that reads the content from
+   * a file.
+   *
+   * The file must not change until the request is completed.
+   *
+   * @param path The path to the file.
+   *
+   * @return The `BodySource` instance or `boost::none` if the file cannot be
+   * opened.
+   */
+  static boost::optional<BodySource> FromFile(const std::string& path);
+
+  /**
+   * @brief Creates the `BodySource` instance that reads a range of a file.
+   *
+   * @param path The path to the file.
+   * @param offset The position of the first byte of the range.
+   * @param length The length of the range.
+   *
+   * @return The `BodySource` instance or `boost::none` if the file cannot be
+   * opened or the range exceeds the file.
+   */
+  static boost::optional<BodySource> FromFile(const std::string& path,
+                                              std::uint64_t offset,
+                                              std::uint64_t length);
+
+  /**
+   * @brief Gets the size of the content.
+   *
+   * @return The size of the content in bytes.
+   */
+  std::uint64_t GetSize() const { return size_; }
+
+  /**
+   * @brief Reads a part of the content.
+   *
+   * @param offset The position of the first byte to read.
+   * @param size The number of bytes to read.
+   * @param buffer The buffer that receives at least `size` bytes.
+   *
+   * @return True if all the bytes are read; false otherwise.
+   */
+  bool Read(std::uint64_t offset, size_t size, std::uint8_t* buffer) const;
+
+  /**
+   * @brief Creates the `BodySource` instance that reads a range of this
+   * content.
+   *
+   * @param offset The position of the first byte of the range.
+   * @param length The length of the range. It is clamped to the end of
+   * the content.
+   *
+   * @return The `BodySource` instance.
+   */
+  BodySource Slice(std::uint64_t offset, std::uint64_t length) const;
+
+  /**
+   * @brief Reads the whole content into memory.
+   *
+   * Used by the network implementations that cannot stream the request
+   * body.
+   *
+   * @return The content or `nullptr` if it cannot be read.
+   */
+  std::shared_ptr<const std::vector<std::uint8_t>> ReadAll() const;
+
+ private:
+  std::uint64_t size_;
+  ReadFunction read_;
+};
+
+}  // namespace http
+}  // namespace olp
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include <olp/core/CoreApi.h>
+#include <olp/core/http/BodySource.h>
 #include <olp/core/http/NetworkSettings.h>
 
 namespace olp {
@@ -37,6 +38,8 @@ class CORE_API NetworkRequest final {
  public:
   /// The short type alias for the HTTP request body.
   using RequestBodyType = std::shared_ptr<const std::vector<std::uint8_t>>;
+  /// The short type alias for the HTTP request body that is read on demand.
+  using RequestBodySourceType = std::shared_ptr<const BodySource>;
 
   /// The HTTP method, as specified at https://tools.ietf.org/html/rfc2616.
   enum class HttpVerb {
@@ -129,6 +132,27 @@ class CORE_API NetworkRequest final {
    */
   NetworkRequest& WithBody(RequestBodyType body);
 
+  /**
+   * @brief Gets the request body source.
+   *
+   * @return The shared pointer to the source of the request body.
+   */
+  RequestBodySourceType GetBodySource() const;
+
+  /**
+   * @brief Sets the request body source.
+   *
+   * The network reads the body from the source while the request is sent
+   * instead of keeping it in memory. The source is ignored if the body is
+   * set.
+   *
+   * @param[in] body_source The shared pointer to the source of the request
+   * body.
+   *
+   * @return A reference to *this.
+   */
+  NetworkRequest& WithBodySource(RequestBodySourceType body_source);
+
   /**
    * @brief Gets the network settings for this request.
    *
@@ -154,6 +178,8 @@ class CORE_API NetworkRequest final {
   Headers headers_;
   /// The body of the HTTP request.
   RequestBodyType body_;
+  /// The source of the HTTP request body.
+  RequestBodySourceType body_source_;
   /// The network settings for this request.
   NetworkSettings settings_{};
 };
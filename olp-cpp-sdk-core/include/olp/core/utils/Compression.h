@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <olp/core/CoreApi.h>
+#include <olp/core/http/BodySource.h>
+
+namespace olp {
+namespace utils {
+
+/**
+ * @brief The content encodings of the layer data.
+ */
+enum class ContentEncoding {
+  kGzip /*!< The gzip format (RFC 1952). */
+};
+
+/**
+ * @brief The result of a compression or decompression.
+ */
+struct CORE_API CompressionStatistics {
+  /// The size of the uncompressed data in bytes.
+  std::uint64_t uncompressed_size = 0u;
+  /// The size of the compressed data in bytes.
+  std::uint64_t compressed_size = 0u;
+  /// The time spent.
+  std::chrono::microseconds duration{0};
+
+  /**
+   * @brief Gets the compression ratio.
+   *
+   * @return The size of the uncompressed data divided by the size of the
+   * compressed data.
+   */
+  double GetRatio() const;
+};
+
+/**
+ * @brief Compresses and decompresses data with streaming codecs.
+ *
+ * The data is processed in chunks of bounded size, so only the input and the
+ * output are kept in memory. Codecs are available only if the SDK is built
+ * with their libraries.
+ */
+class CORE_API Compression {
+ public:
+  /**
+   * @brief Parses the name of the content encoding.
+   *
+   * @param name The name used by the layer configuration, for example "gzip".
+   *
+   * @return The content encoding or `boost::none` if it is unknown.
+   */
+  static boost::optional<ContentEncoding> ParseContentEncoding(
+      const std::string& name);
+
+  /**
+   * @brief Checks whether the content encoding is available in this build.
+   *
+   * @param encoding The content encoding.
+   *
+   * @return True if the data can be compressed and decompressed; false
+   * otherwise.
+   */
+  static bool IsSupported(ContentEncoding encoding);
+
+  /**
+   * @brief Checks whether the data starts with the header of the content
+   * encoding.
+   *
+   * @param encoding The content encoding.
+   * @param data The data.
+   *
+   * @return True if the data looks compressed; false otherwise.
+   */
+  static bool IsCompressed(ContentEncoding encoding,
+                           const std::vector<std::uint8_t>& data);
+
+  /**
+   * @brief Compresses the data.
+   *
+   * @param encoding The content encoding.
+   * @param source The source of the data, read in chunks.
+   * @param statistics Receives the sizes and the time spent, optional.
+   *
+   * @return The compressed data or `nullptr` if the source cannot be read or
+   * the encoding is not supported.
+   */
+  static std::shared_ptr<std::vector<std::uint8_t>> Compress(
+      ContentEncoding encoding, const http::BodySource& source,
+      CompressionStatistics* statistics = nullptr);
+
+  /**
+   * @brief Decompresses the data.
+   *
+   * @param encoding The content encoding.
+   * @param data The compressed data.
+   * @param statistics Receives the sizes and the time spent, optional.
+   *
+   * @return The decompressed data or `nullptr` if the data is corrupted or
+   * the encoding is not supported.
+   */
+  static std::shared_ptr<std::vector<std::uint8_t>> Decompress(
+      ContentEncoding encoding, const std::vector<std::uint8_t>& data,
+      CompressionStatistics* statistics = nullptr);
+};
+
+}  // namespace utils
+}  // namespace olp
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <olp/core/CoreApi.h>
+
+namespace olp {
+namespace utils {
+
+/**
+ * @brief Computes the SHA-256 digest (FIPS 180-4) of data that is provided in
+ * chunks.
+ */
+class CORE_API Sha256 {
+ public:
+  /// The digest bytes.
+  using Digest = std::array<std::uint8_t, 32>;
+
+  Sha256();
+
+  /**
+   * @brief Adds the next chunk of the data.
+   *
+   * @param data The chunk of the data.
+   * @param size The size of the chunk in bytes.
+   */
+  void Update(const std::uint8_t* data, size_t size);
+
+  /**
+   * @brief Finishes the computation.
+   *
+   * No data can be added afterwards.
+   *
+   * @return The digest of all the added data.
+   */
+  Digest Final();
+
+  /**
+   * @brief Converts the digest to lowercase hexadecimal characters.
+   *
+   * @param digest The digest to convert.
+   *
+   * @return The hexadecimal string.
+   */
+  static std::string ToHexString(const Digest& digest);
+
+ private:
+  void Transform(const std::uint8_t* block);
+
+  std::array<std::uint32_t, 8> state_;
+  std::array<std::uint8_t, 64> block_;
+  size_t block_size_;
+  std::uint64_t total_size_;
+};
+
+}  // namespace utils
+}  // namespace olp
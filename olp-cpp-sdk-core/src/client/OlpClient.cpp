@@ -285,7 +285,9 @@ class OlpClient::OlpClientImpl {
   HttpResponse CallApi(std::string path, std::string method,
                        ParametersType query_params,
                        ParametersType header_params, ParametersType form_params,
-                       RequestBodyType post_body, std::string content_type,
+                       RequestBodyType post_body,
+                       RequestBodySourceType body_source,
+                       std::string content_type,
                        CancellationContext context) const;
 
   std::shared_ptr<http::NetworkRequest> CreateRequest(
@@ -427,7 +429,8 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
     OlpClient::ParametersType query_params,
     OlpClient::ParametersType header_params,
     OlpClient::ParametersType /*forms_params*/,
-    OlpClient::RequestBodyType post_body, std::string content_type,
+    OlpClient::RequestBodyType post_body,
+    OlpClient::RequestBodySourceType body_source, std::string content_type,
     CancellationContext context) const {
   if (!settings_.network_request_handler) {
     return HttpResponse(static_cast<int>(olp::http::ErrorCode::OFFLINE_ERROR),
@@ -447,6 +450,7 @@ HttpResponse OlpClient::OlpClientImpl::CallApi(
 
   network_request.WithVerb(GetHttpVerb(method))
       .WithBody(std::move(post_body))
+      .WithBodySource(std::move(body_source))
       .WithSettings(std::move(network_settings));
 
   for (const auto& header : default_headers_) {
@@ -558,7 +562,19 @@ HttpResponse OlpClient::CallApi(std::string path, std::string method,
                                 CancellationContext context) const {
   return impl_->CallApi(std::move(path), std::move(method),
                         std::move(query_params), std::move(header_params),
-                        std::move(form_params), std::move(post_body),
+                        std::move(form_params), std::move(post_body), nullptr,
+                        std::move(content_type), std::move(context));
+}
+
+HttpResponse OlpClient::CallApi(std::string path, std::string method,
+                                ParametersType query_params,
+                                ParametersType header_params,
+                                RequestBodySourceType body_source,
+                                std::string content_type,
+                                CancellationContext context) const {
+  return impl_->CallApi(std::move(path), std::move(method),
+                        std::move(query_params), std::move(header_params), {},
+                        nullptr, std::move(body_source),
                         std::move(content_type), std::move(context));
 }
 
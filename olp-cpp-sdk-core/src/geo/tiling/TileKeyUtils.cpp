@@ -19,11 +19,14 @@
 
 #include "olp/core/geo/tiling/TileKeyUtils.h"
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "olp/core/geo/coordinates/GeoCoordinates.h"
 #include "olp/core/geo/coordinates/GeoCoordinates3d.h"
 #include "olp/core/geo/coordinates/GeoRectangle.h"
+#include "olp/core/geo/projection/EarthConstants.h"
 #include "olp/core/geo/projection/IProjection.h"
 #include "olp/core/geo/tiling/ISubdivisionScheme.h"
 #include "olp/core/geo/tiling/ITilingScheme.h"
@@ -33,6 +36,317 @@
 
 namespace olp {
 namespace geo {
+namespace {
+// The tiles of a level that overlap with a geo rectangle. The columns may
+// exceed the column count when the rectangle crosses the date line.
+struct TileBounds {
+  std::uint32_t min_row;
+  std::uint32_t max_row;
+  std::uint32_t min_column;
+  std::uint32_t max_column;
+  std::uint32_t column_count;
+};
+
+TileBounds GetTileBounds(const ITilingScheme& tiling_scheme,
+                         const GeoRectangle& geo_rectangle,
+                         const std::uint32_t level) {
+  GeoCoordinates south_west = geo_rectangle.SouthWest();
+  GeoCoordinates north_east = geo_rectangle.NorthEast();
+
+  // Clamp at the poles and wrap around the international date line.
+  south_west.SetLongitude(
+      math::Wrap(south_west.GetLongitude(), -math::pi, math::pi));
+  south_west.SetLatitude(
+      math::Clamp(south_west.GetLatitude(), -math::half_pi, math::half_pi));
+
+  north_east.SetLongitude(
+      math::Wrap(north_east.GetLongitude(), -math::pi, math::pi));
+  north_east.SetLatitude(
+      math::Clamp(north_east.GetLatitude(), -math::half_pi, math::half_pi));
+
+  const TileKey min_tile_key =
+      TileKeyUtils::GeoCoordinatesToTileKey(tiling_scheme, south_west, level);
+  const TileKey max_tile_key =
+      TileKeyUtils::GeoCoordinatesToTileKey(tiling_scheme, north_east, level);
+
+  TileBounds bounds;
+  bounds.min_row = min_tile_key.Row();
+  bounds.max_row = max_tile_key.Row();
+  bounds.min_column = min_tile_key.Column();
+  bounds.max_column = max_tile_key.Column();
+  bounds.column_count =
+      tiling_scheme.GetSubdivisionScheme().GetLevelSize(level).Width();
+
+  // wrap around case
+  if (south_west.GetLongitude() > north_east.GetLongitude()) {
+    if (bounds.max_column != bounds.min_column) {
+      bounds.max_column += bounds.column_count;
+    } else {
+      bounds.max_column += bounds.column_count - 1;
+    }
+  }
+  return bounds;
+}
+
+// Appends the tiles on `level` that are under `tile`, merging them with the
+// last range when they are adjacent.
+void AppendSubtreeRange(const TileKey& tile, std::uint32_t level,
+                        std::vector<TileKeyRange>& ranges) {
+  const std::uint32_t shift = level - tile.Level();
+  TileKeyRange range;
+  range.first = tile.ChangedLevelTo(level).ToQuadKey64();
+  range.last = range.first + (1ull << (2 * shift)) - 1;
+  if (!ranges.empty() && ranges.back().last + 1 == range.first) {
+    ranges.back().last = range.last;
+  } else {
+    ranges.push_back(range);
+  }
+}
+
+// Appends the ranges of the tiles on `level` that are under `tile` and in the
+// given rows and columns, in the order of their morton codes.
+void AppendTileKeyRanges(const TileKey& tile, std::uint32_t level,
+                         std::uint32_t min_row, std::uint32_t max_row,
+                         std::uint32_t min_column, std::uint32_t max_column,
+                         std::vector<TileKeyRange>& ranges) {
+  const std::uint32_t shift = level - tile.Level();
+  const std::uint64_t first_row = std::uint64_t(tile.Row()) << shift;
+  const std::uint64_t last_row = first_row + (1ull << shift) - 1;
+  const std::uint64_t first_column = std::uint64_t(tile.Column()) << shift;
+  const std::uint64_t last_column = first_column + (1ull << shift) - 1;
+
+  if (last_row < min_row || first_row > max_row || last_column < min_column ||
+      first_column > max_column) {
+    return;
+  }
+
+  if (min_row <= first_row && last_row <= max_row &&
+      min_column <= first_column && last_column <= max_column) {
+    AppendSubtreeRange(tile, level, ranges);
+    return;
+  }
+
+  // The children are in the order of their morton codes.
+  for (std::uint8_t index = 0; index < 4; ++index) {
+    AppendTileKeyRanges(tile.GetChild(index), level, min_row, max_row,
+                        min_column, max_column, ranges);
+  }
+}
+
+// How a shape overlaps with the world box of a tile.
+enum class Overlap { kNone, kPartial, kFull };
+
+// Descends the quadtree from `tile` and appends the ranges of the tiles on
+// `level` that overlap with the shape. Only the tiles on the outline of the
+// shape are visited down to `level`.
+template <typename Classify>
+void AppendShapeTileKeyRanges(const ITilingScheme& tiling_scheme,
+                              const TileKey& tile, std::uint32_t level,
+                              const Classify& classify,
+                              std::vector<TileKeyRange>& ranges) {
+  const auto overlap = classify(CalculateTileBox(tiling_scheme, tile));
+  if (overlap == Overlap::kNone) {
+    return;
+  }
+
+  if (overlap == Overlap::kFull || tile.Level() == level) {
+    AppendSubtreeRange(tile, level, ranges);
+    return;
+  }
+
+  for (std::uint8_t index = 0; index < 4; ++index) {
+    AppendShapeTileKeyRanges(tiling_scheme, tile.GetChild(index), level,
+                             classify, ranges);
+  }
+}
+
+// Projects the points to the world space of the tiling scheme, the points
+// that can not be projected are skipped.
+std::vector<WorldCoordinates> ProjectPoints(
+    const ITilingScheme& tiling_scheme,
+    const std::vector<GeoCoordinates>& geo_points) {
+  const IProjection& projection = tiling_scheme.GetProjection();
+  std::vector<WorldCoordinates> world_points;
+  world_points.reserve(geo_points.size());
+  for (const auto& geo_point : geo_points) {
+    WorldCoordinates world_point;
+    if (projection.Project(GeoCoordinates3d(geo_point, 0), world_point)) {
+      world_points.push_back(world_point);
+    }
+  }
+  return world_points;
+}
+
+// Clips the segment with the box in the XY plane (Liang-Barsky).
+bool SegmentIntersectsBox(const WorldCoordinates& a, const WorldCoordinates& b,
+                          const math::AlignedBox3d& box) {
+  double t_min = 0.0;
+  double t_max = 1.0;
+  const double delta[2] = {b.x - a.x, b.y - a.y};
+  const double start[2] = {a.x, a.y};
+  const double box_min[2] = {box.Minimum().x, box.Minimum().y};
+  const double box_max[2] = {box.Maximum().x, box.Maximum().y};
+  for (int axis = 0; axis < 2; ++axis) {
+    if (delta[axis] == 0.0) {
+      if (start[axis] < box_min[axis] || start[axis] > box_max[axis]) {
+        return false;
+      }
+      continue;
+    }
+    double t_near = (box_min[axis] - start[axis]) / delta[axis];
+    double t_far = (box_max[axis] - start[axis]) / delta[axis];
+    if (t_near > t_far) {
+      std::swap(t_near, t_far);
+    }
+    t_min = std::max(t_min, t_near);
+    t_max = std::min(t_max, t_far);
+    if (t_min > t_max) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Even-odd rule in the XY plane.
+bool PolygonContains(const std::vector<WorldCoordinates>& polygon,
+                     const WorldCoordinates& point) {
+  bool inside = false;
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const auto& a = polygon[i];
+    const auto& b = polygon[j];
+    if ((a.y > point.y) != (b.y > point.y) &&
+        point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+double SquaredDistanceToSegment(const WorldCoordinates& point,
+                                const WorldCoordinates& a,
+                                const WorldCoordinates& b) {
+  const double dx = b.x - a.x;
+  const double dy = b.y - a.y;
+  const double length = dx * dx + dy * dy;
+  double t = 0.0;
+  if (length > 0.0) {
+    t = math::Clamp(((point.x - a.x) * dx + (point.y - a.y) * dy) / length,
+                    0.0, 1.0);
+  }
+  const double px = a.x + t * dx - point.x;
+  const double py = a.y + t * dy - point.y;
+  return px * px + py * py;
+}
+
+double SquaredDistanceToBox(const WorldCoordinates& point,
+                            const math::AlignedBox3d& box) {
+  const double dx = std::max(
+      {box.Minimum().x - point.x, 0.0, point.x - box.Maximum().x});
+  const double dy = std::max(
+      {box.Minimum().y - point.y, 0.0, point.y - box.Maximum().y});
+  return dx * dx + dy * dy;
+}
+
+// The corners of the box in the XY plane.
+std::vector<WorldCoordinates> GetCorners(const math::AlignedBox3d& box) {
+  const auto& min = box.Minimum();
+  const auto& max = box.Maximum();
+  return {{min.x, min.y, 0}, {max.x, min.y, 0}, {max.x, max.y, 0},
+          {min.x, max.y, 0}};
+}
+
+// A segment of a corridor with its buffer in world units.
+struct CorridorSegment {
+  WorldCoordinates a;
+  WorldCoordinates b;
+  double radius;
+};
+
+// Gets the largest distance in the world space that the given distance on the
+// ground spans around the point, so that the corridor never misses a tile.
+double GetWorldRadius(const ITilingScheme& tiling_scheme,
+                      const GeoCoordinates& geo_point,
+                      const WorldCoordinates& world_point, double meters) {
+  const IProjection& projection = tiling_scheme.GetProjection();
+  const double latitude_delta = meters / EarthConstants::EquatorialRadius();
+  const double longitude_delta =
+      latitude_delta / std::max(std::cos(geo_point.GetLatitude()), 1e-6);
+
+  double radius = 0.0;
+  const GeoCoordinates offsets[] = {
+      {geo_point.GetLatitude() + latitude_delta, geo_point.GetLongitude()},
+      {geo_point.GetLatitude() - latitude_delta, geo_point.GetLongitude()},
+      {geo_point.GetLatitude(), geo_point.GetLongitude() + longitude_delta},
+      {geo_point.GetLatitude(), geo_point.GetLongitude() - longitude_delta}};
+  for (auto offset : offsets) {
+    offset.SetLatitude(
+        math::Clamp(offset.GetLatitude(), -math::half_pi, math::half_pi));
+    WorldCoordinates world_offset;
+    if (projection.Project(GeoCoordinates3d(offset, 0), world_offset)) {
+      const double dx = world_offset.x - world_point.x;
+      const double dy = world_offset.y - world_point.y;
+      radius = std::max(radius, std::sqrt(dx * dx + dy * dy));
+    }
+  }
+  return radius;
+}
+
+using CorridorSegments = std::vector<const CorridorSegment*>;
+
+// Classifies the box against the buffers of the segments, and collects the
+// segments that overlap the box without covering it.
+Overlap ClassifyCorridorBox(const math::AlignedBox3d& box,
+                            const CorridorSegments& segments,
+                            CorridorSegments& overlapping) {
+  const auto corners = GetCorners(box);
+  for (const auto* segment : segments) {
+    const double squared_radius = segment->radius * segment->radius;
+    auto is_inside = [&](const WorldCoordinates& point) {
+      return SquaredDistanceToSegment(point, segment->a, segment->b) <=
+             squared_radius;
+    };
+
+    // The buffer around a segment is convex, so the box is inside of it when
+    // all its corners are.
+    if (std::all_of(corners.begin(), corners.end(), is_inside)) {
+      return Overlap::kFull;
+    }
+
+    if (SegmentIntersectsBox(segment->a, segment->b, box) ||
+        SquaredDistanceToBox(segment->a, box) <= squared_radius ||
+        SquaredDistanceToBox(segment->b, box) <= squared_radius ||
+        std::any_of(corners.begin(), corners.end(), is_inside)) {
+      overlapping.push_back(segment);
+    }
+  }
+  return overlapping.empty() ? Overlap::kNone : Overlap::kPartial;
+}
+
+// Descends the quadtree like `AppendShapeTileKeyRanges`. A segment that does
+// not overlap a tile does not overlap its children either, so only the
+// overlapping segments are passed down.
+void AppendCorridorTileKeyRanges(const ITilingScheme& tiling_scheme,
+                                 const TileKey& tile, std::uint32_t level,
+                                 const CorridorSegments& segments,
+                                 std::vector<TileKeyRange>& ranges) {
+  CorridorSegments overlapping;
+  const auto overlap = ClassifyCorridorBox(
+      CalculateTileBox(tiling_scheme, tile), segments, overlapping);
+  if (overlap == Overlap::kNone) {
+    return;
+  }
+
+  if (overlap == Overlap::kFull || tile.Level() == level) {
+    AppendSubtreeRange(tile, level, ranges);
+    return;
+  }
+
+  for (std::uint8_t index = 0; index < 4; ++index) {
+    AppendCorridorTileKeyRanges(tiling_scheme, tile.GetChild(index), level,
+                                overlapping, ranges);
+  }
+}
+}  // namespace
 
 TileKey TileKeyUtils::GeoCoordinatesToTileKey(
     const ITilingScheme& tiling_scheme, const GeoCoordinates& geo_point,
@@ -78,49 +392,165 @@ std::vector<TileKey> TileKeyUtils::GeoRectangleToTileKeys(
     return std::vector<TileKey>();
   }
 
-  GeoCoordinates south_west = geo_rectangle.SouthWest();
-  GeoCoordinates north_east = geo_rectangle.NorthEast();
+  const auto bounds = GetTileBounds(tiling_scheme, geo_rectangle, level);
 
-  // Clamp at the poles and wrap around the international date line.
-  south_west.SetLongitude(
-      math::Wrap(south_west.GetLongitude(), -math::pi, math::pi));
-  south_west.SetLatitude(
-      math::Clamp(south_west.GetLatitude(), -math::half_pi, math::half_pi));
+  std::vector<TileKey> keys;
+  for (uint32_t row = bounds.min_row; row <= bounds.max_row; ++row) {
+    for (uint32_t column = bounds.min_column; column <= bounds.max_column;
+         ++column) {
+      keys.push_back(TileKey::FromRowColumnLevel(
+          row, column % bounds.column_count, level));
+    }
+  }
 
-  north_east.SetLongitude(
-      math::Wrap(north_east.GetLongitude(), -math::pi, math::pi));
-  north_east.SetLatitude(
-      math::Clamp(north_east.GetLatitude(), -math::half_pi, math::half_pi));
+  return keys;
+}
 
-  const TileKey min_tile_key =
-      GeoCoordinatesToTileKey(tiling_scheme, south_west, level);
-  const TileKey max_tile_key =
-      GeoCoordinatesToTileKey(tiling_scheme, north_east, level);
+std::vector<TileKeyRange> TileKeyUtils::GeoRectangleToTileKeyRanges(
+    const ITilingScheme& tiling_scheme, const GeoRectangle& geo_rectangle,
+    const std::uint32_t level) {
+  std::vector<TileKeyRange> ranges;
+  if (geo_rectangle.IsEmpty() || level > TileKey::MaxLevel) {
+    return ranges;
+  }
 
-  const uint32_t column_count =
-      tiling_scheme.GetSubdivisionScheme().GetLevelSize(level).Width();
+  const auto bounds = GetTileBounds(tiling_scheme, geo_rectangle, level);
+  const auto root = TileKey::FromRowColumnLevel(0, 0, 0);
+  if (bounds.max_column < bounds.column_count) {
+    AppendTileKeyRanges(root, level, bounds.min_row, bounds.max_row,
+                        bounds.min_column, bounds.max_column, ranges);
+    return ranges;
+  }
 
-  const uint32_t min_column = min_tile_key.Column();
-  uint32_t max_column = max_tile_key.Column();
+  // The rectangle crosses the date line.
+  AppendTileKeyRanges(root, level, bounds.min_row, bounds.max_row,
+                      bounds.min_column, bounds.column_count - 1, ranges);
+  AppendTileKeyRanges(root, level, bounds.min_row, bounds.max_row, 0,
+                      bounds.max_column - bounds.column_count, ranges);
+  return MergeTileKeyRanges(std::move(ranges));
+}
 
-  // wrap around case
-  if (south_west.GetLongitude() > north_east.GetLongitude()) {
-    if (max_column != min_column) {
-      max_column += column_count;
-    } else {
-      max_column += column_count - 1;
+std::vector<TileKeyRange> TileKeyUtils::GeoPolygonToTileKeyRanges(
+    const ITilingScheme& tiling_scheme,
+    const std::vector<GeoCoordinates>& geo_polygon, const std::uint32_t level) {
+  std::vector<TileKeyRange> ranges;
+  if (level > TileKey::MaxLevel) {
+    return ranges;
+  }
+
+  const auto polygon = ProjectPoints(tiling_scheme, geo_polygon);
+  if (polygon.size() < 3) {
+    return ranges;
+  }
+
+  auto classify = [&](const math::AlignedBox3d& box) {
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+      if (SegmentIntersectsBox(polygon[j], polygon[i], box)) {
+        return Overlap::kPartial;
+      }
     }
+    // No edge crosses the box, so it is either inside or outside as a whole.
+    const WorldCoordinates center = (box.Minimum() + box.Maximum()) * 0.5;
+    return PolygonContains(polygon, center) ? Overlap::kFull : Overlap::kNone;
+  };
+
+  AppendShapeTileKeyRanges(tiling_scheme, TileKey::FromRowColumnLevel(0, 0, 0),
+                           level, classify, ranges);
+  return ranges;
+}
+
+std::vector<TileKeyRange> TileKeyUtils::GeoCorridorToTileKeyRanges(
+    const ITilingScheme& tiling_scheme,
+    const std::vector<GeoCoordinates>& geo_polyline, const double buffer,
+    const std::uint32_t level) {
+  std::vector<TileKeyRange> ranges;
+  if (level > TileKey::MaxLevel || buffer < 0.0) {
+    return ranges;
   }
 
-  std::vector<TileKey> keys;
-  for (uint32_t row = min_tile_key.Row(); row <= max_tile_key.Row(); ++row) {
-    for (uint32_t column = min_column; column <= max_column; ++column) {
-      keys.push_back(
-          TileKey::FromRowColumnLevel(row, column % column_count, level));
+  const IProjection& projection = tiling_scheme.GetProjection();
+  std::vector<WorldCoordinates> points;
+  std::vector<double> radiuses;
+  for (const auto& geo_point : geo_polyline) {
+    WorldCoordinates world_point;
+    if (projection.Project(GeoCoordinates3d(geo_point, 0), world_point)) {
+      points.push_back(world_point);
+      radiuses.push_back(
+          GetWorldRadius(tiling_scheme, geo_point, world_point, buffer));
     }
   }
+  if (points.empty()) {
+    return ranges;
+  }
 
-  return keys;
+  // A single point makes a circle around it.
+  std::vector<CorridorSegment> segments;
+  for (size_t i = 0; i + 1 < std::max<size_t>(points.size(), 2); ++i) {
+    const size_t next = std::min(i + 1, points.size() - 1);
+    segments.push_back(CorridorSegment{
+        points[i], points[next], std::max(radiuses[i], radiuses[next])});
+  }
+
+  CorridorSegments root_segments;
+  root_segments.reserve(segments.size());
+  for (const auto& segment : segments) {
+    root_segments.push_back(&segment);
+  }
+
+  AppendCorridorTileKeyRanges(tiling_scheme,
+                              TileKey::FromRowColumnLevel(0, 0, 0), level,
+                              root_segments, ranges);
+  return ranges;
+}
+
+std::vector<TileKeyRange> TileKeyUtils::MergeTileKeyRanges(
+    std::vector<TileKeyRange> ranges) {
+  std::sort(ranges.begin(), ranges.end(),
+            [](const TileKeyRange& lhs, const TileKeyRange& rhs) {
+              return lhs.first < rhs.first;
+            });
+
+  auto merged = ranges.begin();
+  for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+    if (it == merged) {
+      continue;
+    }
+    if (it->first <= merged->last + 1) {
+      merged->last = std::max(merged->last, it->last);
+    } else {
+      *++merged = *it;
+    }
+  }
+  if (merged != ranges.end()) {
+    ranges.erase(merged + 1, ranges.end());
+  }
+  return ranges;
+}
+
+std::vector<TileKey> TileKeyUtils::GetCoveringTileKeys(
+    const TileKeyRange& range) {
+  std::vector<TileKey> tile_keys;
+  const auto level = TileKey::FromQuadKey64(range.first).Level();
+  if (range.first == 0 || range.first > range.last ||
+      TileKey::FromQuadKey64(range.last).Level() != level) {
+    return tile_keys;
+  }
+
+  // Take the largest aligned block of 4^n tiles that starts at each position.
+  const std::uint64_t level_bit = 1ull << (2 * level);
+  std::uint64_t position = range.first - level_bit;
+  const std::uint64_t end = range.last - level_bit + 1;
+  while (position < end) {
+    std::uint32_t depth = 0;
+    while (depth < level && position % (1ull << (2 * (depth + 1))) == 0 &&
+           position + (1ull << (2 * (depth + 1))) <= end) {
+      ++depth;
+    }
+    tile_keys.push_back(
+        TileKey::FromQuadKey64((level_bit + position) >> (2 * depth)));
+    position += 1ull << (2 * depth);
+  }
+  return tile_keys;
 }
 
 geo::TileKey TileKeyUtils::GetRelativeSubTileKey(const geo::TileKey& key,
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/http/BodySource.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+namespace olp {
+namespace http {
+
+namespace {
+struct FileState {
+  std::mutex mutex;
+  std::ifstream stream;
+};
+}  // namespace
+
+BodySource::BodySource(std::uint64_t size, ReadFunction read)
+    : size_(size), read_(std::move(read)) {}
+
+BodySource BodySource::FromData(
+    std::shared_ptr<const std::vector<std::uint8_t>> data) {
+  const std::uint64_t size = data ? data->size() : 0u;
+  return BodySource(size, [data](std::uint64_t offset, size_t size,
+                                 std::uint8_t* buffer) {
+    if (!data || offset + size > data->size()) {
+      return false;
+    }
+    std::copy_n(data->begin() + offset, size, buffer);
+    return true;
+  });
+}
+
+boost::optional<BodySource> BodySource::FromFile(const std::string& path) {
+  return FromFile(path, 0u, std::numeric_limits<std::uint64_t>::max());
+}
+
+boost::optional<BodySource> BodySource::FromFile(const std::string& path,
+                                                 std::uint64_t offset,
+                                                 std::uint64_t length) {
+  auto state = std::make_shared<FileState>();
+  state->stream.open(path, std::ios::binary | std::ios::ate);
+  if (!state->stream.is_open()) {
+    return boost::none;
+  }
+
+  const auto end = state->stream.tellg();
+  if (end < 0 || offset > static_cast<std::uint64_t>(end)) {
+    return boost::none;
+  }
+
+  const auto file_size = static_cast<std::uint64_t>(end);
+  if (length == std::numeric_limits<std::uint64_t>::max()) {
+    length = file_size - offset;
+  } else if (length > file_size - offset) {
+    return boost::none;
+  }
+
+  return BodySource(length, [state, offset](std::uint64_t position,
+                                            size_t size,
+                                            std::uint8_t* buffer) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->stream.clear();
+    state->stream.seekg(static_cast<std::streamoff>(offset + position));
+    state->stream.read(reinterpret_cast<char*>(buffer),
+                       static_cast<std::streamsize>(size));
+    return state->stream.gcount() == static_cast<std::streamsize>(size);
+  });
+}
+
+bool BodySource::Read(std::uint64_t offset, size_t size,
+                      std::uint8_t* buffer) const {
+  if (offset > size_ || size > size_ - offset) {
+    return false;
+  }
+  return size == 0u || (read_ && read_(offset, size, buffer));
+}
+
+BodySource BodySource::Slice(std::uint64_t offset,
+                             std::uint64_t length) const {
+  offset = std::min(offset, size_);
+  length = std::min(length, size_ - offset);
+
+  auto read = read_;
+  return BodySource(length, [read, offset](std::uint64_t position,
+                                           size_t size,
+                                           std::uint8_t* buffer) {
+    return read && read(offset + position, size, buffer);
+  });
+}
+
+std::shared_ptr<const std::vector<std::uint8_t>> BodySource::ReadAll() const {
+  if (size_ > std::numeric_limits<size_t>::max()) {
+    return nullptr;
+  }
+
+  auto data = std::make_shared<std::vector<std::uint8_t>>(
+      static_cast<size_t>(size_));
+  if (!Read(0u, data->size(), data->data())) {
+    return nullptr;
+  }
+  return data;
+}
+
+}  // namespace http
+}  // namespace olp
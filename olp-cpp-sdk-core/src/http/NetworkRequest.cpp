@@ -35,6 +35,10 @@ NetworkRequest::RequestBodyType NetworkRequest::GetBody() const {
   return body_;
 }
 
+NetworkRequest::RequestBodySourceType NetworkRequest::GetBodySource() const {
+  return body_source_;
+}
+
 const NetworkSettings& NetworkRequest::GetSettings() const { return settings_; }
 
 NetworkRequest& NetworkRequest::WithHeader(std::string name,
@@ -58,6 +62,12 @@ NetworkRequest& NetworkRequest::WithBody(RequestBodyType body) {
   return *this;
 }
 
+NetworkRequest& NetworkRequest::WithBodySource(
+    RequestBodySourceType body_source) {
+  body_source_ = std::move(body_source);
+  return *this;
+}
+
 NetworkRequest& NetworkRequest::WithSettings(NetworkSettings settings) {
   settings_ = std::move(settings);
   return *this;
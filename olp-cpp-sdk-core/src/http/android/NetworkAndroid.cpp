@@ -925,6 +925,14 @@ SendOutcome NetworkAndroid::Send(NetworkRequest request,
     size_t size = 0;
     const uint8_t* body_data = nullptr;
     auto body = request.GetBody();
+    if (!body && request.GetBodySource()) {
+      body = request.GetBodySource()->ReadAll();
+      if (!body) {
+        OLP_SDK_LOG_ERROR(kLogTag, "Send failed - can't read a body, url="
+                                       << request.GetUrl());
+        return SendOutcome(ErrorCode::IO_ERROR);
+      }
+    }
     if (body && !body->empty()) {
       body_data = body->data();
       size = body->size();
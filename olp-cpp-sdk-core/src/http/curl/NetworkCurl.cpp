@@ -439,8 +439,9 @@ ErrorCode NetworkCurl::SendImplementation(
 
   const auto& config = request.GetSettings();
 
-  RequestHandle* handle = GetHandle(id, callback, header_callback,
-                                    data_callback, payload, request.GetBody());
+  RequestHandle* handle =
+      GetHandle(id, callback, header_callback, data_callback, payload,
+                request.GetBody(), request.GetBodySource());
   if (!handle) {
     return ErrorCode::NETWORK_OVERLOAD_ERROR;
   }
@@ -504,6 +505,19 @@ ErrorCode NetworkCurl::SendImplementation(
                        handle->body->size());
       curl_easy_setopt(handle->handle, CURLOPT_POSTFIELDS,
                        &handle->body->front());
+    } else if (handle->body_source) {
+      // The body is read in chunks while it is sent, the custom request
+      // methods keep the verb.
+      curl_easy_setopt(handle->handle, CURLOPT_POST, 1L);
+      curl_easy_setopt(
+          handle->handle, CURLOPT_POSTFIELDSIZE_LARGE,
+          static_cast<curl_off_t>(handle->body_source->GetSize()));
+      curl_easy_setopt(handle->handle, CURLOPT_READFUNCTION,
+                       &NetworkCurl::TxFunction);
+      curl_easy_setopt(handle->handle, CURLOPT_READDATA, handle);
+      curl_easy_setopt(handle->handle, CURLOPT_SEEKFUNCTION,
+                       &NetworkCurl::SeekFunction);
+      curl_easy_setopt(handle->handle, CURLOPT_SEEKDATA, handle);
     } else {
       // Some services (eg. Google) require the field size even if zero
       curl_easy_setopt(handle->handle, CURLOPT_POSTFIELDSIZE, 0);
@@ -629,7 +643,8 @@ NetworkCurl::RequestHandle* NetworkCurl::GetHandle(
     RequestId id, Network::Callback callback,
     Network::HeaderCallback header_callback,
     Network::DataCallback data_callback, Network::Payload payload,
-    NetworkRequest::RequestBodyType body) {
+    NetworkRequest::RequestBodyType body,
+    NetworkRequest::RequestBodySourceType body_source) {
   if (!IsStarted()) {
     OLP_SDK_LOG_ERROR(kLogTag,
                       "GetHandle failed - network is offline, id=" << id);
@@ -659,6 +674,8 @@ NetworkCurl::RequestHandle* NetworkCurl::GetHandle(
       handle.transfer_timeout = 30;
       handle.payload = std::move(payload);
       handle.body = std::move(body);
+      handle.body_source = std::move(body_source);
+      handle.body_offset = 0;
       handle.send_time = std::chrono::steady_clock::now();
       handle.error_text[0] = 0;
       handle.skip_content = false;
@@ -689,6 +706,7 @@ void NetworkCurl::ReleaseHandleUnlocked(RequestHandle* handle) {
   handle->data_callback = nullptr;
   handle->payload.reset();
   handle->body.reset();
+  handle->body_source.reset();
 }
 
 size_t NetworkCurl::RxFunction(void* ptr, size_t size, size_t nmemb,
@@ -750,6 +768,46 @@ size_t NetworkCurl::RxFunction(void* ptr, size_t size, size_t nmemb,
   return len;
 }
 
+size_t NetworkCurl::TxFunction(char* ptr, size_t size, size_t nmemb,
+                               RequestHandle* handle) {
+  if (handle->cancelled || !handle->body_source) {
+    return CURL_READFUNC_ABORT;
+  }
+
+  const auto& source = *handle->body_source;
+  const auto remaining = source.GetSize() - std::min(handle->body_offset,
+                                                     source.GetSize());
+  const auto len =
+      static_cast<size_t>(std::min<std::uint64_t>(size * nmemb, remaining));
+  if (len == 0) {
+    return 0;
+  }
+
+  if (!source.Read(handle->body_offset, len,
+                   reinterpret_cast<std::uint8_t*>(ptr))) {
+    OLP_SDK_LOG_ERROR(kLogTag, "Unable to read the request body, id="
+                                   << handle->id
+                                   << ", offset=" << handle->body_offset);
+    return CURL_READFUNC_ABORT;
+  }
+
+  OLP_SDK_LOG_TRACE(kLogTag, "Sent " << len << " bytes for id=" << handle->id);
+
+  handle->body_offset += len;
+  return len;
+}
+
+int NetworkCurl::SeekFunction(RequestHandle* handle, curl_off_t offset,
+                              int origin) {
+  if (!handle->body_source || origin != SEEK_SET || offset < 0 ||
+      static_cast<std::uint64_t>(offset) > handle->body_source->GetSize()) {
+    return CURL_SEEKFUNC_FAIL;
+  }
+
+  handle->body_offset = static_cast<std::uint64_t>(offset);
+  return CURL_SEEKFUNC_OK;
+}
+
 size_t NetworkCurl::HeaderFunction(char* ptr, size_t size, size_t nitems,
                                    RequestHandle* handle) {
   const size_t len = size * nitems;
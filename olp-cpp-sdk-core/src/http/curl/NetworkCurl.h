@@ -96,6 +96,8 @@ class NetworkCurl : public olp::http::Network,
   struct RequestHandle {
     std::chrono::steady_clock::time_point send_time{};
     NetworkRequest::RequestBodyType body{};
+    NetworkRequest::RequestBodySourceType body_source{};
+    std::uint64_t body_offset{};
     Network::Payload payload{};
     std::weak_ptr<NetworkCurl> self{};
     Callback callback{};
@@ -206,13 +208,16 @@ class NetworkCurl : public olp::http::Network,
    * @param[in] header_callback Request's header callback.
    * @param[in] data_callback Request's data callback.
    * @param[in] payload Stream for response body.
+   * @param[in] body Request body.
+   * @param[in] body_source Request body that is read while it is sent.
    * @return Pointer to allocated RequestHandle.
    */
   RequestHandle* GetHandle(RequestId id, Network::Callback callback,
                            Network::HeaderCallback headerCallback,
                            Network::DataCallback dataCallback,
                            Network::Payload payload,
-                           NetworkRequest::RequestBodyType body);
+                           NetworkRequest::RequestBodyType body,
+                           NetworkRequest::RequestBodySourceType body_source);
 
   /**
    * @brief Release handle after network request is done.
@@ -242,6 +247,18 @@ class NetworkCurl : public olp::http::Network,
   static size_t RxFunction(void* ptr, size_t size, size_t nmemb,
                            RequestHandle* handle);
 
+  /**
+   * @brief CURL upload callback, reads the request body from its source.
+   */
+  static size_t TxFunction(char* ptr, size_t size, size_t nmemb,
+                           RequestHandle* handle);
+
+  /**
+   * @brief CURL seek callback, rewinds the request body source.
+   */
+  static int SeekFunction(RequestHandle* handle, curl_off_t offset,
+                          int origin);
+
   /**
    * @brief CURL header callback.
    */
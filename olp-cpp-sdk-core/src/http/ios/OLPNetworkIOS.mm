@@ -60,7 +60,11 @@ NSData* ParseBodyDataFromRequest(const olp::http::NetworkRequest& request) {
     return nil;
   }
 
-  const auto body = request.GetBody();
+  auto body = request.GetBody();
+  if (!body && request.GetBodySource()) {
+    // The task uploads NSData, so the source is read into memory.
+    body = request.GetBodySource()->ReadAll();
+  }
   if (!body || body->empty()) {
     return nil;
   }
@@ -1060,7 +1060,12 @@ NetworkWinHttp::RequestData::RequestData(
       ignore_data(request.GetVerb() == NetworkRequest::HttpVerb::HEAD),
       no_compression(false),
       uncompress(false),
-      in_use(false) {}
+      in_use(false) {
+  // WinHttpSendRequest takes the whole body at once.
+  if (!body && request.GetBodySource()) {
+    body = request.GetBodySource()->ReadAll();
+  }
+}
 
 NetworkWinHttp::RequestData::RequestData()
     : self(nullptr),
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "olp/core/utils/Compression.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef OLP_SDK_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+namespace olp {
+namespace utils {
+
+namespace {
+// The codecs read and write at most this many bytes at once.
+constexpr size_t kChunkSize = 64u * 1024u;
+
+using Clock = std::chrono::steady_clock;
+
+#ifdef OLP_SDK_HAS_ZLIB
+// Adds the gzip header and trailer to the deflate stream.
+constexpr int kGzipWindowBits = 15 + 16;
+
+// Moves the produced output of the stream to the end of the data.
+void AppendOutput(z_stream& stream, std::vector<std::uint8_t>& chunk,
+                  std::vector<std::uint8_t>& data) {
+  const auto size = chunk.size() - stream.avail_out;
+  data.insert(data.end(), chunk.begin(), chunk.begin() + size);
+  stream.next_out = chunk.data();
+  stream.avail_out = static_cast<uInt>(chunk.size());
+}
+
+std::shared_ptr<std::vector<std::uint8_t>> GzipCompress(
+    const http::BodySource& source) {
+  z_stream stream{};
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                   kGzipWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return nullptr;
+  }
+
+  auto result = std::make_shared<std::vector<std::uint8_t>>();
+
+  std::vector<std::uint8_t> input(kChunkSize);
+  std::vector<std::uint8_t> output(kChunkSize);
+  stream.next_out = output.data();
+  stream.avail_out = static_cast<uInt>(output.size());
+
+  bool success = true;
+  std::uint64_t offset = 0u;
+  int status = Z_OK;
+  while (status != Z_STREAM_END) {
+    const auto size = static_cast<size_t>(
+        std::min<std::uint64_t>(source.GetSize() - offset, input.size()));
+    if (!source.Read(offset, size, input.data())) {
+      success = false;
+      break;
+    }
+    offset += size;
+
+    stream.next_in = input.data();
+    stream.avail_in = static_cast<uInt>(size);
+    const int flush = offset == source.GetSize() ? Z_FINISH : Z_NO_FLUSH;
+    do {
+      status = deflate(&stream, flush);
+      AppendOutput(stream, output, *result);
+    } while (stream.avail_in > 0u || (flush == Z_FINISH && status == Z_OK));
+
+    if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+      success = false;
+      break;
+    }
+  }
+
+  deflateEnd(&stream);
+  return success ? result : nullptr;
+}
+
+std::shared_ptr<std::vector<std::uint8_t>> GzipDecompress(
+    const std::vector<std::uint8_t>& data) {
+  if (data.size() > std::numeric_limits<uInt>::max()) {
+    return nullptr;
+  }
+
+  z_stream stream{};
+  if (inflateInit2(&stream, kGzipWindowBits) != Z_OK) {
+    return nullptr;
+  }
+
+  auto result = std::make_shared<std::vector<std::uint8_t>>();
+  result->reserve(data.size() * 2u);
+
+  std::vector<std::uint8_t> output(kChunkSize);
+  stream.next_in = const_cast<Bytef*>(data.data());
+  stream.avail_in = static_cast<uInt>(data.size());
+  stream.next_out = output.data();
+  stream.avail_out = static_cast<uInt>(output.size());
+
+  // The output chunk is emptied after every call, so the inflation stops
+  // only at the end of the stream, or on corrupted or truncated data.
+  int status = Z_OK;
+  while (status == Z_OK) {
+    status = inflate(&stream, Z_NO_FLUSH);
+    AppendOutput(stream, output, *result);
+  }
+
+  inflateEnd(&stream);
+  return status == Z_STREAM_END ? result : nullptr;
+}
+#endif
+}  // namespace
+
+double CompressionStatistics::GetRatio() const {
+  if (compressed_size == 0u) {
+    return 0.0;
+  }
+  return static_cast<double>(uncompressed_size) /
+         static_cast<double>(compressed_size);
+}
+
+boost::optional<ContentEncoding> Compression::ParseContentEncoding(
+    const std::string& name) {
+  if (name == "gzip") {
+    return ContentEncoding::kGzip;
+  }
+  return boost::none;
+}
+
+bool Compression::IsSupported(ContentEncoding encoding) {
+#ifdef OLP_SDK_HAS_ZLIB
+  return encoding == ContentEncoding::kGzip;
+#else
+  (void)encoding;
+  return false;
+#endif
+}
+
+bool Compression::IsCompressed(ContentEncoding encoding,
+                               const std::vector<std::uint8_t>& data) {
+  switch (encoding) {
+    case ContentEncoding::kGzip:
+      return data.size() >= 2u && data[0] == 0x1f && data[1] == 0x8b;
+  }
+  return false;
+}
+
+std::shared_ptr<std::vector<std::uint8_t>> Compression::Compress(
+    ContentEncoding encoding, const http::BodySource& source,
+    CompressionStatistics* statistics) {
+  const auto start = Clock::now();
+
+  std::shared_ptr<std::vector<std::uint8_t>> result;
+#ifdef OLP_SDK_HAS_ZLIB
+  if (encoding == ContentEncoding::kGzip) {
+    result = GzipCompress(source);
+  }
+#else
+  (void)encoding;
+#endif
+
+  if (result && statistics) {
+    statistics->uncompressed_size = source.GetSize();
+    statistics->compressed_size = result->size();
+    statistics->duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                              start);
+  }
+  return result;
+}
+
+std::shared_ptr<std::vector<std::uint8_t>> Compression::Decompress(
+    ContentEncoding encoding, const std::vector<std::uint8_t>& data,
+    CompressionStatistics* statistics) {
+  const auto start = Clock::now();
+
+  std::shared_ptr<std::vector<std::uint8_t>> result;
+#ifdef OLP_SDK_HAS_ZLIB
+  if (encoding == ContentEncoding::kGzip) {
+    result = GzipDecompress(data);
+  }
+#else
+  (void)encoding;
+#endif
+
+  if (result && statistics) {
+    statistics->uncompressed_size = result->size();
+    statistics->compressed_size = data.size();
+    statistics->duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                              start);
+  }
+  return result;
+}
+
+}  // namespace utils
+}  // namespace olp
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <olp/core/utils/Sha256.h>
+
+#include <algorithm>
+
+namespace olp {
+namespace utils {
+
+namespace {
+constexpr std::uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+inline std::uint32_t RotateRight(std::uint32_t value, unsigned bits) {
+  return (value >> bits) | (value << (32u - bits));
+}
+}  // namespace
+
+Sha256::Sha256()
+    : state_{{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f,
+              0x9b05688c, 0x1f83d9ab, 0x5be0cd19}},
+      block_(),
+      block_size_(0u),
+      total_size_(0u) {}
+
+void Sha256::Update(const std::uint8_t* data, size_t size) {
+  total_size_ += size;
+  while (size > 0u) {
+    const auto count = std::min(size, block_.size() - block_size_);
+    std::copy_n(data, count, block_.begin() + block_size_);
+    block_size_ += count;
+    data += count;
+    size -= count;
+
+    if (block_size_ == block_.size()) {
+      Transform(block_.data());
+      block_size_ = 0u;
+    }
+  }
+}
+
+Sha256::Digest Sha256::Final() {
+  const std::uint64_t total_bits = total_size_ * 8u;
+
+  // The padding is a single set bit, zeros, and the length in bits, so that
+  // the message ends on a block boundary.
+  std::uint8_t padding[72] = {0x80};
+  const size_t padding_size =
+      (block_size_ < 56u ? 56u : 120u) - block_size_ + 8u;
+  for (size_t i = 0; i < 8u; ++i) {
+    padding[padding_size - 1u - i] =
+        static_cast<std::uint8_t>(total_bits >> (8u * i));
+  }
+  Update(padding, padding_size);
+
+  Digest digest;
+  for (size_t i = 0; i < state_.size(); ++i) {
+    digest[i * 4u] = static_cast<std::uint8_t>(state_[i] >> 24u);
+    digest[i * 4u + 1u] = static_cast<std::uint8_t>(state_[i] >> 16u);
+    digest[i * 4u + 2u] = static_cast<std::uint8_t>(state_[i] >> 8u);
+    digest[i * 4u + 3u] = static_cast<std::uint8_t>(state_[i]);
+  }
+  return digest;
+}
+
+void Sha256::Transform(const std::uint8_t* block) {
+  std::uint32_t w[64];
+  for (size_t i = 0; i < 16u; ++i) {
+    w[i] = (static_cast<std::uint32_t>(block[i * 4u]) << 24u) |
+           (static_cast<std::uint32_t>(block[i * 4u + 1u]) << 16u) |
+           (static_cast<std::uint32_t>(block[i * 4u + 2u]) << 8u) |
+           static_cast<std::uint32_t>(block[i * 4u + 3u]);
+  }
+  for (size_t i = 16u; i < 64u; ++i) {
+    const auto s0 = RotateRight(w[i - 15u], 7u) ^
+                    RotateRight(w[i - 15u], 18u) ^ (w[i - 15u] >> 3u);
+    const auto s1 = RotateRight(w[i - 2u], 17u) ^
+                    RotateRight(w[i - 2u], 19u) ^ (w[i - 2u] >> 10u);
+    w[i] = w[i - 16u] + s0 + w[i - 7u] + s1;
+  }
+
+  auto a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+  auto e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+  for (size_t i = 0; i < 64u; ++i) {
+    const auto s1 =
+        RotateRight(e, 6u) ^ RotateRight(e, 11u) ^ RotateRight(e, 25u);
+    const auto choice = (e & f) ^ (~e & g);
+    const auto temp1 = h + s1 + choice + kRoundConstants[i] + w[i];
+    const auto s0 =
+        RotateRight(a, 2u) ^ RotateRight(a, 13u) ^ RotateRight(a, 22u);
+    const auto majority = (a & b) ^ (a & c) ^ (b & c);
+    const auto temp2 = s0 + majority;
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + temp2;
+  }
+
+  state_[0] += a;
+  state_[1] += b;
+  state_[2] += c;
+  state_[3] += d;
+  state_[4] += e;
+  state_[5] += f;
+  state_[6] += g;
+  state_[7] += h;
+}
+
+std::string Sha256::ToHexString(const Digest& digest) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  std::string result;
+  result.reserve(digest.size() * 2u);
+  for (const auto byte : digest) {
+    result.push_back(kHexDigits[byte >> 4u]);
+    result.push_back(kHexDigits[byte & 0x0fu]);
+  }
+  return result;
+}
+
+}  // namespace utils
+}  // namespace olp
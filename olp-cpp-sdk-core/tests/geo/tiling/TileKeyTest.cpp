@@ -20,7 +20,10 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <random>
+#include <vector>
 
 #include <olp/core/geo/tiling/TileKey.h>
 
@@ -135,6 +138,78 @@ TEST(TileKeyTest, HereTiles) {
   ASSERT_FALSE(invalid.IsValid());
 }
 
+TEST(TileKeyTest, HereTileBuffer) {
+  char buffer[TileKey::HereTileMaxLength + 1];
+
+  auto quad = TileKey::FromRowColumnLevel(3, 5, 3);
+  ASSERT_EQ(2u, quad.ToHereTile(buffer, sizeof(buffer)));
+  EXPECT_STREQ("91", buffer);
+
+  quad = TileKey::FromRowColumnLevel(0x7FFFFFFF, 0x7FFFFFFF, 31);
+  const auto length = quad.ToHereTile(buffer, sizeof(buffer));
+  EXPECT_EQ(quad.ToHereTile(), std::string(buffer, length));
+  EXPECT_EQ(quad, TileKey::FromHereTile(buffer));
+
+  // The code and the null character must fit into the buffer.
+  EXPECT_EQ(0u, quad.ToHereTile(buffer, length));
+  EXPECT_EQ(length, quad.ToHereTile(buffer, length + 1));
+}
+
+TEST(TileKeyTest, QuadKey64Conversions) {
+  // The conversions as they were done bit by bit.
+  auto to_quad_key = [](std::uint32_t row, std::uint32_t column,
+                        std::uint32_t level) {
+    std::uint64_t key = 1ull << (2 * level);
+    for (std::uint32_t bit = 0; bit < 32; ++bit) {
+      key |= std::uint64_t((column >> bit) & 1) << (2 * bit);
+      key |= std::uint64_t((row >> bit) & 1) << (2 * bit + 1);
+    }
+    return key;
+  };
+  auto from_quad_key = [](std::uint64_t key) {
+    std::uint32_t row = 0, column = 0, level = 0;
+    for (; key > 1; ++level, key >>= 2) {
+      column |= std::uint32_t(key & 0x1) << level;
+      row |= std::uint32_t((key >> 1) & 0x1) << level;
+    }
+    return TileKey::FromRowColumnLevel(row, column, level);
+  };
+
+  std::mt19937 random(42);
+  std::vector<TileKey> tile_keys;
+  for (std::uint32_t level = 0; level < TileKey::LevelCount; ++level) {
+    const std::uint32_t mask = (std::uint32_t(1) << level) - 1;
+    for (int i = 0; i < 100; ++i) {
+      tile_keys.push_back(
+          TileKey::FromRowColumnLevel(random() & mask, random() & mask, level));
+    }
+  }
+
+  std::vector<std::uint64_t> quad_keys(tile_keys.size());
+  ToQuadKey64(tile_keys.data(), tile_keys.size(), quad_keys.data());
+
+  std::vector<TileKey> result(tile_keys.size());
+  FromQuadKey64(quad_keys.data(), quad_keys.size(), result.data());
+
+  for (size_t i = 0; i < tile_keys.size(); ++i) {
+    const auto& tile_key = tile_keys[i];
+    const auto expected =
+        to_quad_key(tile_key.Row(), tile_key.Column(), tile_key.Level());
+    ASSERT_EQ(expected, tile_key.ToQuadKey64()) << tile_key;
+    ASSERT_EQ(expected, quad_keys[i]) << tile_key;
+    ASSERT_EQ(tile_key, TileKey::FromQuadKey64(expected));
+    ASSERT_EQ(tile_key, result[i]);
+    ASSERT_EQ(tile_key, TileKey::FromQuadKey(tile_key.ToQuadKey()));
+    ASSERT_EQ(tile_key, TileKey::FromHereTile(tile_key.ToHereTile()));
+  }
+
+  // Codes without a leading 1 on an even bit are read as before.
+  for (const std::uint64_t key : {0ull, 2ull, 3ull, 0x8000000000000000ull,
+                                  0xFFFFFFFFFFFFFFFFull}) {
+    ASSERT_EQ(from_quad_key(key), TileKey::FromQuadKey64(key)) << key;
+  }
+}
+
 TEST(TileKeyTest, MoveToLevel) {
   TileKey quad = TileKey::FromRowColumnLevel(0, 0, 5);
   ASSERT_EQ(quad.ChangedLevelBy(-2), quad.ChangedLevelTo(3));
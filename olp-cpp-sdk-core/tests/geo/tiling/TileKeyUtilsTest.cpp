@@ -19,13 +19,16 @@
 
 #include <olp/core/geo/coordinates/GeoCoordinates.h>
 #include <olp/core/geo/coordinates/GeoRectangle.h>
+#include <olp/core/geo/projection/EarthConstants.h>
 #include <olp/core/geo/tiling/TileKey.h>
 #include <olp/core/geo/tiling/TileKeyUtils.h>
 #include <olp/core/geo/tiling/TilingSchemeRegistry.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <queue>
+#include <set>
 #include <vector>
 
 namespace olp {
@@ -187,6 +190,299 @@ TEST(TileKeyUtilsTest, GeoRectangleToTileKeysBoundaries) {
   }
 }
 
+TEST(TileKeyUtilsTest, GeoRectangleToTileKeyRanges) {
+  const HalfQuadTreeEquirectangularTilingScheme tiling_scheme;
+
+  const std::vector<GeoRectangle> rectangles = {
+      // Berlin
+      GeoRectangle(GeoCoordinates::FromDegrees(52.3, 13.0),
+                   GeoCoordinates::FromDegrees(52.7, 13.8)),
+      // Crosses the date line
+      GeoRectangle(GeoCoordinates::FromDegrees(-20.0, 170.0),
+                   GeoCoordinates::FromDegrees(10.0, -160.0)),
+      // Whole world
+      GeoRectangle(GeoCoordinates::FromDegrees(-90.0, -180.0),
+                   GeoCoordinates::FromDegrees(90.0, 180.0))};
+
+  for (const auto& rectangle : rectangles) {
+    for (std::uint32_t level = 0; level <= 9; ++level) {
+      const auto ranges = TileKeyUtils::GeoRectangleToTileKeyRanges(
+          tiling_scheme, rectangle, level);
+      const auto tile_keys =
+          TileKeyUtils::GeoRectangleToTileKeys(tiling_scheme, rectangle, level);
+
+      std::set<std::uint64_t> expected;
+      for (const auto& tile_key : tile_keys) {
+        expected.insert(tile_key.ToQuadKey64());
+      }
+
+      std::set<std::uint64_t> actual;
+      for (size_t i = 0; i < ranges.size(); ++i) {
+        ASSERT_LE(ranges[i].first, ranges[i].last);
+        if (i > 0) {
+          // Sorted, and adjacent ranges are merged.
+          ASSERT_LT(ranges[i - 1].last + 1, ranges[i].first);
+        }
+        for (auto key = ranges[i].first; key <= ranges[i].last; ++key) {
+          actual.insert(key);
+        }
+      }
+      ASSERT_EQ(expected, actual) << "level " << level;
+    }
+  }
+
+  {
+    SCOPED_TRACE("Large area");
+
+    const GeoRectangle europe(GeoCoordinates::FromDegrees(35.0, -10.0),
+                              GeoCoordinates::FromDegrees(70.0, 40.0));
+    const std::uint32_t level = 14;
+    const auto ranges = TileKeyUtils::GeoRectangleToTileKeyRanges(
+        tiling_scheme, europe, level);
+
+    const auto south_west = TileKeyUtils::GeoCoordinatesToTileKey(
+        tiling_scheme, europe.SouthWest(), level);
+    const auto north_east = TileKeyUtils::GeoCoordinatesToTileKey(
+        tiling_scheme, europe.NorthEast(), level);
+    const std::uint64_t expected_count =
+        std::uint64_t(north_east.Row() - south_west.Row() + 1) *
+        (north_east.Column() - south_west.Column() + 1);
+
+    std::uint64_t count = 0;
+    for (const auto& range : ranges) {
+      count += range.last - range.first + 1;
+    }
+    EXPECT_EQ(expected_count, count);
+    // The ranges follow the outline, there are far fewer of them than tiles.
+    EXPECT_LT(ranges.size() * 100, expected_count);
+  }
+
+  {
+    SCOPED_TRACE("Empty rectangle");
+
+    EXPECT_TRUE(TileKeyUtils::GeoRectangleToTileKeyRanges(
+                    tiling_scheme, GeoRectangle(), 10)
+                    .empty());
+  }
+}
+
+TEST(TileKeyUtilsTest, GeoPolygonToTileKeyRanges) {
+  const HalfQuadTreeEquirectangularTilingScheme tiling_scheme;
+  const auto south_west = GeoCoordinates::FromDegrees(52.3, 13.0);
+  const auto north_east = GeoCoordinates::FromDegrees(52.7, 13.8);
+  const auto south_east = GeoCoordinates::FromDegrees(52.3, 13.8);
+  const auto north_west = GeoCoordinates::FromDegrees(52.7, 13.0);
+  const std::uint32_t level = 13;
+
+  auto count_tiles = [](const std::vector<TileKeyRange>& ranges) {
+    std::uint64_t count = 0;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      EXPECT_LE(ranges[i].first, ranges[i].last);
+      if (i > 0) {
+        EXPECT_LT(ranges[i - 1].last + 1, ranges[i].first);
+      }
+      count += ranges[i].last - ranges[i].first + 1;
+    }
+    return count;
+  };
+
+  auto contains = [](const std::vector<TileKeyRange>& ranges,
+                     const TileKey& tile_key) {
+    return std::any_of(ranges.begin(), ranges.end(),
+                       [&](const TileKeyRange& range) {
+                         return range.Contains(tile_key.ToQuadKey64());
+                       });
+  };
+
+  const auto rectangle_ranges = TileKeyUtils::GeoRectangleToTileKeyRanges(
+      tiling_scheme, GeoRectangle(south_west, north_east), level);
+
+  {
+    SCOPED_TRACE("Rectangle");
+
+    const auto ranges = TileKeyUtils::GeoPolygonToTileKeyRanges(
+        tiling_scheme, {south_west, south_east, north_east, north_west},
+        level);
+    EXPECT_EQ(rectangle_ranges, ranges);
+  }
+
+  {
+    SCOPED_TRACE("Triangle");
+
+    const auto ranges = TileKeyUtils::GeoPolygonToTileKeyRanges(
+        tiling_scheme, {south_west, south_east, north_east}, level);
+    const auto count = count_tiles(ranges);
+    const auto rectangle_count = count_tiles(rectangle_ranges);
+    // Half of the rectangle and the tiles on the diagonal.
+    EXPECT_GT(count * 2, rectangle_count);
+    EXPECT_LT(count * 3, rectangle_count * 2);
+
+    EXPECT_TRUE(contains(ranges, TileKeyUtils::GeoCoordinatesToTileKey(
+                                     tiling_scheme,
+                                     GeoCoordinates::FromDegrees(52.35, 13.7),
+                                     level)));
+    EXPECT_FALSE(contains(ranges, TileKeyUtils::GeoCoordinatesToTileKey(
+                                      tiling_scheme,
+                                      GeoCoordinates::FromDegrees(52.65, 13.1),
+                                      level)));
+  }
+
+  {
+    SCOPED_TRACE("Invalid polygon");
+
+    EXPECT_TRUE(TileKeyUtils::GeoPolygonToTileKeyRanges(
+                    tiling_scheme, {south_west, north_east}, level)
+                    .empty());
+  }
+}
+
+TEST(TileKeyUtilsTest, GeoCorridorToTileKeyRanges) {
+  const HalfQuadTreeEquirectangularTilingScheme tiling_scheme;
+  // Berlin - Leipzig - Munich
+  const std::vector<GeoCoordinates> route = {
+      GeoCoordinates::FromDegrees(52.52, 13.40),
+      GeoCoordinates::FromDegrees(51.34, 12.37),
+      GeoCoordinates::FromDegrees(48.14, 11.58)};
+  const std::uint32_t level = 14;
+  const double buffer = 2000.0;
+
+  const auto ranges = TileKeyUtils::GeoCorridorToTileKeyRanges(
+      tiling_scheme, route, buffer, level);
+  ASSERT_FALSE(ranges.empty());
+
+  auto contains = [&](const GeoCoordinates& point) {
+    const auto quad_key =
+        TileKeyUtils::GeoCoordinatesToTileKey(tiling_scheme, point, level)
+            .ToQuadKey64();
+    return std::any_of(
+        ranges.begin(), ranges.end(),
+        [&](const TileKeyRange& range) { return range.Contains(quad_key); });
+  };
+
+  // Every point of the route and the points next to it are covered.
+  const double offset = 0.9 * buffer / EarthConstants::EquatorialRadius();
+  for (size_t i = 0; i + 1 < route.size(); ++i) {
+    for (int step = 0; step <= 100; ++step) {
+      const double t = step / 100.0;
+      const GeoCoordinates point(
+          route[i].GetLatitude() +
+              t * (route[i + 1].GetLatitude() - route[i].GetLatitude()),
+          route[i].GetLongitude() +
+              t * (route[i + 1].GetLongitude() - route[i].GetLongitude()));
+      ASSERT_TRUE(contains(point)) << "step " << step;
+      ASSERT_TRUE(contains(GeoCoordinates(point.GetLatitude() + offset,
+                                          point.GetLongitude())));
+      ASSERT_TRUE(contains(GeoCoordinates(point.GetLatitude() - offset,
+                                          point.GetLongitude())));
+    }
+  }
+
+  // Far from the route.
+  EXPECT_FALSE(contains(GeoCoordinates::FromDegrees(50.0, 8.68)));
+  EXPECT_FALSE(contains(GeoCoordinates::FromDegrees(52.0, 13.4)));
+
+  // The corridor is a small part of its bounding rectangle.
+  const auto rectangle_ranges = TileKeyUtils::GeoRectangleToTileKeyRanges(
+      tiling_scheme,
+      GeoRectangle(GeoCoordinates::FromDegrees(48.14, 11.58),
+                   GeoCoordinates::FromDegrees(52.52, 13.40)),
+      level);
+  std::uint64_t count = 0;
+  for (const auto& range : ranges) {
+    count += range.last - range.first + 1;
+  }
+  std::uint64_t rectangle_count = 0;
+  for (const auto& range : rectangle_ranges) {
+    rectangle_count += range.last - range.first + 1;
+  }
+  EXPECT_LT(count * 5, rectangle_count);
+
+  {
+    SCOPED_TRACE("Single point");
+
+    const auto circle = TileKeyUtils::GeoCorridorToTileKeyRanges(
+        tiling_scheme, {route.front()}, buffer, level);
+    EXPECT_FALSE(circle.empty());
+  }
+
+  {
+    SCOPED_TRACE("Invalid corridor");
+
+    EXPECT_TRUE(TileKeyUtils::GeoCorridorToTileKeyRanges(tiling_scheme, {},
+                                                         buffer, level)
+                    .empty());
+    EXPECT_TRUE(TileKeyUtils::GeoCorridorToTileKeyRanges(tiling_scheme, route,
+                                                         -1.0, level)
+                    .empty());
+  }
+}
+
+TEST(TileKeyUtilsTest, MergeTileKeyRanges) {
+  std::vector<TileKeyRange> ranges(4);
+  ranges[0].first = 40, ranges[0].last = 50;
+  ranges[1].first = 16, ranges[1].last = 20;
+  ranges[2].first = 21, ranges[2].last = 25;
+  ranges[3].first = 45, ranges[3].last = 60;
+
+  const auto merged = TileKeyUtils::MergeTileKeyRanges(ranges);
+  ASSERT_EQ(2u, merged.size());
+  EXPECT_EQ(16u, merged[0].first);
+  EXPECT_EQ(25u, merged[0].last);
+  EXPECT_EQ(40u, merged[1].first);
+  EXPECT_EQ(60u, merged[1].last);
+
+  EXPECT_TRUE(TileKeyUtils::MergeTileKeyRanges({}).empty());
+}
+
+TEST(TileKeyUtilsTest, GetCoveringTileKeys) {
+  const auto parent = TileKey::FromRowColumnLevel(1, 2, 3);
+
+  {
+    SCOPED_TRACE("Aligned range");
+
+    TileKeyRange range;
+    range.first = parent.ChangedLevelBy(2).ToQuadKey64();
+    range.last = range.first + 15;
+    const auto tile_keys = TileKeyUtils::GetCoveringTileKeys(range);
+    ASSERT_EQ(1u, tile_keys.size());
+    EXPECT_EQ(parent, tile_keys.front());
+  }
+
+  {
+    SCOPED_TRACE("Unaligned range");
+
+    TileKeyRange range;
+    range.first = parent.ChangedLevelBy(2).ToQuadKey64() + 3;
+    range.last = range.first + 17;
+    const auto tile_keys = TileKeyUtils::GetCoveringTileKeys(range);
+
+    std::uint64_t next = range.first;
+    for (const auto& tile_key : tile_keys) {
+      const auto first = tile_key.ChangedLevelTo(5).ToQuadKey64();
+      const auto count = 1ull << (2 * (5 - tile_key.Level()));
+      EXPECT_EQ(next, first);
+      next = first + count;
+    }
+    EXPECT_EQ(range.last + 1, next);
+    // One tile, four blocks of 2x2 tiles and one more tile.
+    EXPECT_EQ(6u, tile_keys.size());
+  }
+
+  {
+    SCOPED_TRACE("Invalid ranges");
+
+    TileKeyRange reversed;
+    reversed.first = 100;
+    reversed.last = 90;
+    EXPECT_TRUE(TileKeyUtils::GetCoveringTileKeys(reversed).empty());
+
+    TileKeyRange levels;
+    levels.first = parent.ToQuadKey64();
+    levels.last = parent.ChangedLevelBy(1).ToQuadKey64();
+    EXPECT_TRUE(TileKeyUtils::GetCoveringTileKeys(levels).empty());
+  }
+}
+
 struct TileKeyUtilsSubTileTest {
   TileKey parentTileKey;
   TileKey relativeSubtileKey;
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <olp/core/http/BodySource.h>
+#include <olp/core/utils/Dir.h>
+
+namespace {
+
+using olp::http::BodySource;
+using Bytes = std::vector<std::uint8_t>;
+
+TEST(BodySourceTest, FromData) {
+  auto data = std::make_shared<Bytes>(Bytes{'a', 'b', 'c', 'd', 'e'});
+  auto source = BodySource::FromData(data);
+
+  EXPECT_EQ(5u, source.GetSize());
+
+  Bytes buffer(3u);
+  ASSERT_TRUE(source.Read(2u, 3u, buffer.data()));
+  EXPECT_EQ((Bytes{'c', 'd', 'e'}), buffer);
+
+  EXPECT_FALSE(source.Read(3u, 3u, buffer.data()));
+  EXPECT_FALSE(source.Read(6u, 0u, buffer.data()));
+
+  auto all = source.ReadAll();
+  ASSERT_TRUE(all);
+  EXPECT_EQ(*data, *all);
+}
+
+TEST(BodySourceTest, Slice) {
+  auto source = BodySource::FromData(
+      std::make_shared<Bytes>(Bytes{'a', 'b', 'c', 'd', 'e'}));
+
+  {
+    SCOPED_TRACE("Middle");
+    auto slice = source.Slice(1u, 3u);
+    EXPECT_EQ(3u, slice.GetSize());
+    auto data = slice.ReadAll();
+    ASSERT_TRUE(data);
+    EXPECT_EQ((Bytes{'b', 'c', 'd'}), *data);
+    Bytes buffer(2u);
+    EXPECT_FALSE(slice.Read(2u, 2u, buffer.data()));
+  }
+
+  {
+    SCOPED_TRACE("Clamped to the end");
+    auto slice = source.Slice(3u, 10u);
+    EXPECT_EQ(2u, slice.GetSize());
+    auto data = slice.ReadAll();
+    ASSERT_TRUE(data);
+    EXPECT_EQ((Bytes{'d', 'e'}), *data);
+  }
+
+  {
+    SCOPED_TRACE("Out of the content");
+    EXPECT_EQ(0u, source.Slice(10u, 10u).GetSize());
+  }
+}
+
+TEST(BodySourceTest, FromCallback) {
+  BodySource source(
+      4u, [](std::uint64_t, size_t, std::uint8_t*) { return false; });
+
+  EXPECT_EQ(4u, source.GetSize());
+  EXPECT_FALSE(source.ReadAll());
+}
+
+TEST(BodySourceTest, FromFile) {
+  const auto path = olp::utils::Dir::TempDirectory() + "/body_source_test";
+
+  {
+    SCOPED_TRACE("Missing file");
+    std::remove(path.c_str());
+    EXPECT_FALSE(BodySource::FromFile(path));
+  }
+
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "0123456789";
+  }
+
+  {
+    SCOPED_TRACE("Whole file");
+    auto source = BodySource::FromFile(path);
+    ASSERT_TRUE(source);
+    EXPECT_EQ(10u, source->GetSize());
+
+    Bytes buffer(4u);
+    ASSERT_TRUE(source->Read(8u, 2u, buffer.data()));
+    ASSERT_TRUE(source->Read(3u, 4u, buffer.data()));
+    EXPECT_EQ((Bytes{'3', '4', '5', '6'}), buffer);
+    EXPECT_FALSE(source->Read(8u, 4u, buffer.data()));
+  }
+
+  {
+    SCOPED_TRACE("Range");
+    auto source = BodySource::FromFile(path, 2u, 5u);
+    ASSERT_TRUE(source);
+    auto data = source->ReadAll();
+    ASSERT_TRUE(data);
+    EXPECT_EQ((Bytes{'2', '3', '4', '5', '6'}), *data);
+
+    EXPECT_FALSE(BodySource::FromFile(path, 8u, 5u));
+  }
+
+  std::remove(path.c_str());
+}
+
+}  // namespace
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <olp/core/utils/Compression.h>
+
+namespace {
+
+using olp::http::BodySource;
+using olp::utils::Compression;
+using olp::utils::CompressionStatistics;
+using olp::utils::ContentEncoding;
+
+std::shared_ptr<const std::vector<std::uint8_t>> MakeData(size_t size) {
+  // Repeated text compresses well, but spans several chunks.
+  const std::string pattern = "The quick brown fox jumps over the lazy dog. ";
+  auto data = std::make_shared<std::vector<std::uint8_t>>();
+  data->reserve(size);
+  while (data->size() < size) {
+    data->push_back(
+        static_cast<std::uint8_t>(pattern[data->size() % pattern.size()]));
+  }
+  return data;
+}
+
+TEST(CompressionTest, ParseContentEncoding) {
+  EXPECT_TRUE(Compression::ParseContentEncoding("gzip") ==
+              ContentEncoding::kGzip);
+  EXPECT_FALSE(Compression::ParseContentEncoding(""));
+  EXPECT_FALSE(Compression::ParseContentEncoding("identity"));
+}
+
+TEST(CompressionTest, Gzip) {
+  if (!Compression::IsSupported(ContentEncoding::kGzip)) {
+    GTEST_SKIP() << "Built without zlib";
+  }
+
+  for (const size_t size : {0u, 10u, 1024u * 1024u}) {
+    SCOPED_TRACE(size);
+    const auto data = MakeData(size);
+
+    CompressionStatistics compression;
+    auto compressed = Compression::Compress(
+        ContentEncoding::kGzip, BodySource::FromData(data), &compression);
+    ASSERT_TRUE(compressed);
+    EXPECT_TRUE(Compression::IsCompressed(ContentEncoding::kGzip, *compressed));
+    EXPECT_EQ(size, compression.uncompressed_size);
+    EXPECT_EQ(compressed->size(), compression.compressed_size);
+
+    CompressionStatistics decompression;
+    auto decompressed = Compression::Decompress(
+        ContentEncoding::kGzip, *compressed, &decompression);
+    ASSERT_TRUE(decompressed);
+    EXPECT_EQ(*data, *decompressed);
+    EXPECT_EQ(size, decompression.uncompressed_size);
+  }
+
+  const auto data = MakeData(1024u * 1024u);
+  CompressionStatistics statistics;
+  ASSERT_TRUE(Compression::Compress(ContentEncoding::kGzip,
+                                    BodySource::FromData(data), &statistics));
+  EXPECT_GT(statistics.GetRatio(), 10.0);
+}
+
+TEST(CompressionTest, GzipInvalidData) {
+  if (!Compression::IsSupported(ContentEncoding::kGzip)) {
+    GTEST_SKIP() << "Built without zlib";
+  }
+
+  const auto data = MakeData(1000u);
+  EXPECT_FALSE(Compression::IsCompressed(ContentEncoding::kGzip, *data));
+  EXPECT_FALSE(Compression::Decompress(ContentEncoding::kGzip, *data));
+
+  auto compressed = Compression::Compress(ContentEncoding::kGzip,
+                                          BodySource::FromData(data));
+  ASSERT_TRUE(compressed);
+  compressed->resize(compressed->size() / 2u);
+  EXPECT_FALSE(Compression::Decompress(ContentEncoding::kGzip, *compressed));
+
+  BodySource failing_source(
+      10u, [](std::uint64_t, size_t, std::uint8_t*) { return false; });
+  EXPECT_FALSE(Compression::Compress(ContentEncoding::kGzip, failing_source));
+}
+
+}  // namespace
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <olp/core/utils/Sha256.h>
+
+namespace {
+
+using olp::utils::Sha256;
+
+std::string Hash(const std::string& data) {
+  Sha256 hash;
+  hash.Update(reinterpret_cast<const std::uint8_t*>(data.data()),
+              data.size());
+  return Sha256::ToHexString(hash.Final());
+}
+
+TEST(Sha256Test, Digest) {
+  EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+            Hash(""));
+  EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+            Hash("abc"));
+  EXPECT_EQ("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+            Hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+  EXPECT_EQ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+            Hash(std::string(1000000u, 'a')));
+}
+
+TEST(Sha256Test, DataInChunks) {
+  const std::string data(1000u, 'x');
+
+  // Chunks that do not end on the block boundary.
+  Sha256 hash;
+  for (size_t offset = 0u; offset < data.size(); offset += 100u) {
+    hash.Update(reinterpret_cast<const std::uint8_t*>(data.data()) + offset,
+                100u);
+  }
+  EXPECT_EQ(Hash(data), Sha256::ToHexString(hash.Final()));
+}
+
+}  // namespace
@@ -198,6 +198,29 @@ class DATASERVICE_READ_API DataRequest final {
     return *this;
   }
 
+  /**
+   * @brief Checks whether compressed data is decompressed.
+   *
+   * @return True if the data is decompressed; false otherwise.
+   */
+  inline bool GetDecompression() const { return decompression_; }
+
+  /**
+   * @brief Sets whether the data of layers with the gzip content encoding
+   * is decompressed.
+   *
+   * The data is decompressed when it is accessed, unless the network already
+   * decoded it, and the cache keeps the compressed data.
+   *
+   * @param decompression True if the data is decompressed; false otherwise.
+   *
+   * @return A reference to the updated `DataRequest` instance.
+   */
+  inline DataRequest& WithDecompression(bool decompression) {
+    decompression_ = decompression;
+    return *this;
+  }
+
   /**
    * @brief Creates a readable format for the request.
    *
@@ -222,6 +245,9 @@ class DATASERVICE_READ_API DataRequest final {
       out << "$" << GetBillingTag().get();
     }
     out << "^" << GetFetchOption();
+    if (GetDecompression()) {
+      out << "#decompressed";
+    }
     return out.str();
   }
 
@@ -231,6 +257,7 @@ class DATASERVICE_READ_API DataRequest final {
   boost::optional<std::string> data_handle_;
   boost::optional<std::string> billing_tag_;
   FetchOptions fetch_option_{OnlineIfNotFound};
+  bool decompression_{false};
 };
 
 }  // namespace read
@@ -179,6 +179,30 @@ class DATASERVICE_READ_API PartitionsRequest final {
     return *this;
   }
 
+  /**
+   * @brief Gets the maximum number of partitions in a page.
+   *
+   * Only used by the `StreamPartitions` methods of the layer clients, which
+   * pass the partitions to the page callback one page at a time.
+   *
+   * @return The page size.
+   */
+  inline size_t GetPageSize() const { return page_size_; }
+
+  /**
+   * @brief Sets the maximum number of partitions in a page.
+   *
+   * @see `GetPageSize()` for information on usage.
+   *
+   * @param page_size The page size. The default value is 1000.
+   *
+   * @return A reference to the updated `PartitionsRequest` instance.
+   */
+  inline PartitionsRequest& WithPageSize(size_t page_size) {
+    page_size_ = page_size;
+    return *this;
+  }
+
   /**
    * @brief Creates a readable format for the request.
    *
@@ -205,6 +229,7 @@ class DATASERVICE_READ_API PartitionsRequest final {
   AdditionalFields additional_fields_;
   boost::optional<std::string> billing_tag_;
   FetchOptions fetch_option_{OnlineIfNotFound};
+  size_t page_size_{1000u};
 };
 
 }  // namespace read
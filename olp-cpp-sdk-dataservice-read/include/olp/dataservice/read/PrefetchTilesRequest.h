@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include <olp/core/geo/coordinates/GeoCoordinates.h>
 #include <olp/core/geo/tiling/TileKey.h>
 #include <olp/core/porting/deprecated.h>
 #include <olp/dataservice/read/DataServiceReadApi.h>
@@ -67,6 +68,101 @@ class DATASERVICE_READ_API PrefetchTilesRequest final {
     return *this;
   }
 
+  /**
+   * @brief Gets the ranges of the tile keys.
+   *
+   * @return The vector with the tile key ranges.
+   */
+  inline const std::vector<geo::TileKeyRange>& GetTileKeyRanges() const {
+    return tile_key_ranges_;
+  }
+
+  /**
+   * @brief Sets the ranges of tile keys that are prefetched in addition to
+   * the tile keys.
+   *
+   * The tiles of the ranges are treated like the tile keys set with
+   * `WithTileKeys`, but are never expanded into separate tile keys, so that
+   * large areas can be prefetched with little memory. Use
+   * `geo::TileKeyUtils::GeoRectangleToTileKeyRanges` to get the ranges of an
+   * area. If the minimum and maximum tile levels are not set, only the tiles
+   * of the ranges are prefetched.
+   *
+   * @param tile_key_ranges The vector with the tile key ranges.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithTileKeyRanges(
+      std::vector<geo::TileKeyRange> tile_key_ranges) {
+    tile_key_ranges_ = std::move(tile_key_ranges);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the vertices of the polygon to prefetch.
+   *
+   * @return The vector with the vertices of the polygon.
+   */
+  inline const std::vector<geo::GeoCoordinates>& GetPolygon() const {
+    return polygon_;
+  }
+
+  /**
+   * @brief Sets the polygon that is prefetched in addition to the tile keys.
+   *
+   * The polygon is covered with the tiles of the maximum tile level, and
+   * their ancestors down to the minimum tile level are prefetched as well.
+   * The tiles inside of the polygon are requested through their common
+   * parents, so the number of quadtree queries depends on the outline of the
+   * polygon rather than on its area. The minimum and maximum tile levels must
+   * be set.
+   *
+   * @param polygon The vertices of the polygon, it is closed implicitly.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithPolygon(
+      std::vector<geo::GeoCoordinates> polygon) {
+    polygon_ = std::move(polygon);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the vertices of the polyline of the corridor to prefetch.
+   *
+   * @return The vector with the vertices of the polyline.
+   */
+  inline const std::vector<geo::GeoCoordinates>& GetCorridor() const {
+    return corridor_;
+  }
+
+  /**
+   * @brief Gets the distance in meters to each side of the corridor
+   * polyline.
+   *
+   * @return The buffer of the corridor.
+   */
+  inline double GetCorridorBuffer() const { return corridor_buffer_; }
+
+  /**
+   * @brief Sets the corridor that is prefetched in addition to the tile keys,
+   * for example, along a route.
+   *
+   * The corridor is covered like the polygon set with `WithPolygon`. The
+   * minimum and maximum tile levels must be set.
+   *
+   * @param polyline The vertices of the polyline.
+   * @param buffer The distance in meters to each side of the polyline.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithCorridor(
+      std::vector<geo::GeoCoordinates> polyline, double buffer) {
+    corridor_ = std::move(polyline);
+    corridor_buffer_ = buffer;
+    return *this;
+  }
+
   /**
    * @brief Gets the minimum tiles level to prefetch.
    *
@@ -180,6 +276,88 @@ class DATASERVICE_READ_API PrefetchTilesRequest final {
     return *this;
   }
 
+  /**
+   * @brief Gets the maximum number of quadtree index requests that are
+   * executed in parallel.
+   *
+   * @return The maximum number of parallel quadtree index requests.
+   */
+  inline std::uint32_t GetQuadTreeConcurrency() const {
+    return quad_tree_concurrency_;
+  }
+
+  /**
+   * @brief Sets the maximum number of quadtree index requests that are
+   * executed in parallel.
+   *
+   * A wide prefetch is split into several subtrees, and each subtree requires
+   * a separate quadtree index request. The subtrees are resolved by up to
+   * `concurrency` tasks on the task scheduler, and the data download for the
+   * tiles of a resolved subtree starts while the other subtrees are still
+   * being resolved. Set to 1 to resolve the subtrees one by one.
+   *
+   * @param concurrency The maximum number of parallel quadtree index requests.
+   * Zero is treated as 1.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithQuadTreeConcurrency(
+      std::uint32_t concurrency) {
+    quad_tree_concurrency_ = concurrency;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the maximum number of tile downloads that are scheduled at
+   * the same time.
+   *
+   * @return The maximum number of pending tile downloads.
+   */
+  inline std::uint32_t GetMaxPendingTiles() const { return max_pending_tiles_; }
+
+  /**
+   * @brief Sets the maximum number of tile downloads that are scheduled at
+   * the same time.
+   *
+   * The prefetch resolves further subtrees only while the number of pending
+   * downloads is below this limit. This keeps the memory usage of a prefetch
+   * independent of the number of tiles.
+   *
+   * @param max_pending_tiles The maximum number of pending tile downloads.
+   * Zero is treated as 1.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithMaxPendingTiles(
+      std::uint32_t max_pending_tiles) {
+    max_pending_tiles_ = max_pending_tiles;
+    return *this;
+  }
+
+  /**
+   * @brief Checks whether an interrupted prefetch can be resumed.
+   *
+   * @return True if the prefetch stores a checkpoint; false otherwise.
+   */
+  inline bool IsResumable() const { return resumable_; }
+
+  /**
+   * @brief Sets whether an interrupted prefetch can be resumed.
+   *
+   * A resumable prefetch stores the progress in the cache. When the same
+   * request is prefetched again, the subtrees that were completed without
+   * errors are skipped, and their tiles are not part of the result. The
+   * checkpoint is removed once the prefetch completes without errors.
+   *
+   * @param resumable True to store a checkpoint; false otherwise.
+   *
+   * @return A reference to the updated `PrefetchTilesRequest` instance.
+   */
+  inline PrefetchTilesRequest& WithResumable(bool resumable) {
+    resumable_ = resumable;
+    return *this;
+  }
+
   /**
    * @brief Creates a readable format for the request.
    *
@@ -203,10 +381,17 @@ class DATASERVICE_READ_API PrefetchTilesRequest final {
  private:
   std::string layer_id_;
   std::vector<geo::TileKey> tile_keys_;
+  std::vector<geo::TileKeyRange> tile_key_ranges_;
+  std::vector<geo::GeoCoordinates> polygon_;
+  std::vector<geo::GeoCoordinates> corridor_;
+  double corridor_buffer_{0.0};
   unsigned int min_level_{geo::TileKey::LevelCount};
   unsigned int max_level_{geo::TileKey::LevelCount};
   boost::optional<int64_t> catalog_version_;
   boost::optional<std::string> billing_tag_;
+  std::uint32_t quad_tree_concurrency_{4u};
+  std::uint32_t max_pending_tiles_{1024u};
+  bool resumable_{false};
 };
 
 }  // namespace read
@@ -150,6 +150,8 @@ class DATASERVICE_READ_API StreamLayerClient final {
   /**
    * @brief Deletes the current subscription for the stream layer.
    *
+   * Commits the offsets of the polled messages that are not committed yet.
+   *
    * @param callback The `UnsubscribeResponseCallback` object that is invoked
    * when the unsubscription request is completed.
    *
@@ -160,6 +162,8 @@ class DATASERVICE_READ_API StreamLayerClient final {
   /**
    * @brief Deletes the current subscription for the stream layer.
    *
+   * Commits the offsets of the polled messages that are not committed yet.
+   *
    * @return `CancellableFuture` that contains the `SubscribeId` instance of
    * the deleted subscription or an error. You can also use `CancellableFuture`
    * to cancel this request.
@@ -201,13 +205,60 @@ class DATASERVICE_READ_API StreamLayerClient final {
   client::CancellableFuture<DataResponse> GetData(
       const model::Message& message);
 
+  /**
+   * @brief Downloads the data of the given messages in parallel.
+   *
+   * The messages with embedded data are not downloaded. The data handles
+   * of the other messages are downloaded with one Blob API lookup per call
+   * and with up to `max_parallel_requests` downloads at a time. Without
+   * a task scheduler in the client settings, the data is downloaded
+   * sequentially.
+   *
+   * @param messages The `Messages` instance that was retrieved using the
+   * `Poll` method.
+   * @param max_parallel_requests The maximum number of parallel downloads.
+   * @param callback The `MessagesDataResponseCallback` object that is invoked
+   * when the data of all the messages is available.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken GetData(const model::Messages& messages,
+                                    size_t max_parallel_requests,
+                                    MessagesDataResponseCallback callback);
+
+  /**
+   * @brief Downloads the data of the given messages in parallel.
+   *
+   * The messages with embedded data are not downloaded. The data handles
+   * of the other messages are downloaded with one Blob API lookup per call
+   * and with up to `max_parallel_requests` downloads at a time. Without
+   * a task scheduler in the client settings, the data is downloaded
+   * sequentially.
+   *
+   * @param messages The `Messages` instance that was retrieved using the
+   * `Poll` method.
+   * @param max_parallel_requests The maximum number of parallel downloads.
+   *
+   * @return `CancellableFuture` that contains the data of every message in
+   * the order of the messages, or an error. A failed download of one message
+   * is reported in its own `DataResponse`. You can also use
+   * `CancellableFuture` to cancel this request.
+   */
+  client::CancellableFuture<MessagesDataResponse> GetData(
+      const model::Messages& messages, size_t max_parallel_requests);
+
   /**
    * @brief Reads messages from a stream layer and commits successfully
    * consumed messages before returning them to you.
    *
    * Only possible if subscribed successfully.
    * If the payload is more than 1 MB, then it is not embedded into the metadata.
-   * To download the data, call `GetData(Message)`.
+   * To download the data, call `GetData(Message)`, or `GetData(Messages)` to
+   * download the data of the whole batch in parallel.
+   *
+   * The next batches can be consumed in the background and the offsets can be
+   * committed in the background; see `SubscribeRequest::WithPollPrefetch` and
+   * `SubscribeRequest::WithCommitInterval`.
    *
    * @param callback The `PollResponseCallback` object that is invoked when
    * the `Poll` request is completed.
@@ -222,7 +273,12 @@ class DATASERVICE_READ_API StreamLayerClient final {
    *
    * Only possible if subscribed successfully.
    * If the payload is more than 1 MB, then it is not embedded into the metadata.
-   * To download the data, call `GetData(Message)`.
+   * To download the data, call `GetData(Message)`, or `GetData(Messages)` to
+   * download the data of the whole batch in parallel.
+   *
+   * The next batches can be consumed in the background and the offsets can be
+   * committed in the background; see `SubscribeRequest::WithPollPrefetch` and
+   * `SubscribeRequest::WithCommitInterval`.
    *
    * @return `CancellableFuture` that contains `PollResponse` or an error. You
    * can also use `CancellableFuture` to cancel this request.
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <utility>
 
@@ -153,11 +154,90 @@ class DATASERVICE_READ_API SubscribeRequest final {
     return consumer_properties_;
   }
 
+  /**
+   * @brief Sets the number of message batches that are consumed in the
+   * background while you process the batch returned by `Poll`.
+   *
+   * The prefetched batches are kept in memory until `Poll` returns them, so
+   * the number limits the memory usage. Prefetching requires a task
+   * scheduler in the client settings.
+   *
+   * @param batches The number of batches to prefetch. The default is zero,
+   * which disables the prefetch.
+   *
+   * @return A reference to the updated `SubscribeRequest` instance.
+   */
+  inline SubscribeRequest& WithPollPrefetch(size_t batches) {
+    poll_prefetch_ = batches;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the number of message batches that are consumed in the
+   * background.
+   *
+   * @return The number of batches to prefetch.
+   */
+  inline size_t GetPollPrefetch() const { return poll_prefetch_; }
+
+  /**
+   * @brief Sets the interval for committing the offsets of the polled
+   * messages in the background.
+   *
+   * If the interval is set, `Poll` returns the messages without waiting for
+   * the commit, and the offsets are committed once per interval or as soon as
+   * the number of uncommitted messages reaches the commit batch size. The
+   * remaining offsets are committed on `Unsubscribe`. If the interval is not
+   * set, `Poll` commits the offsets before it returns the messages.
+   *
+   * @param interval The commit interval.
+   *
+   * @return A reference to the updated `SubscribeRequest` instance.
+   */
+  inline SubscribeRequest& WithCommitInterval(
+      boost::optional<std::chrono::milliseconds> interval) {
+    commit_interval_ = std::move(interval);
+    return *this;
+  }
+
+  /**
+   * @brief Gets the interval for committing the offsets in the background.
+   *
+   * @return The commit interval.
+   */
+  inline const boost::optional<std::chrono::milliseconds>& GetCommitInterval()
+      const {
+    return commit_interval_;
+  }
+
+  /**
+   * @brief Sets the number of uncommitted messages that triggers a commit
+   * before the commit interval passes.
+   *
+   * @param messages The number of messages. The default is 1000.
+   *
+   * @return A reference to the updated `SubscribeRequest` instance.
+   */
+  inline SubscribeRequest& WithCommitBatchSize(size_t messages) {
+    commit_batch_size_ = messages;
+    return *this;
+  }
+
+  /**
+   * @brief Gets the number of uncommitted messages that triggers a commit.
+   *
+   * @return The number of messages.
+   */
+  inline size_t GetCommitBatchSize() const { return commit_batch_size_; }
+
  private:
   SubscriptionMode subscription_mode_{SubscriptionMode::kSerial};
   boost::optional<SubscriptionId> subscription_id_;
   boost::optional<std::string> consumer_id_;
   boost::optional<ConsumerProperties> consumer_properties_;
+  size_t poll_prefetch_{0u};
+  boost::optional<std::chrono::milliseconds> commit_interval_;
+  size_t commit_batch_size_{1000u};
 };
 
 }  // namespace read
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -68,6 +70,14 @@ using PartitionsResult = model::Partitions;
 using PartitionsResponse = Response<PartitionsResult>;
 /// The callback type of the partition metadata response.
 using PartitionsResponseCallback = Callback<PartitionsResult>;
+/// The callback type that is invoked for each page of the partition metadata.
+using PartitionsPageCallback = std::function<void(PartitionsResult)>;
+/// The alias type of the streamed partitions result, the number of partitions.
+using StreamPartitionsResult = uint64_t;
+/// The streamed partitions response type.
+using StreamPartitionsResponse = Response<StreamPartitionsResult>;
+/// The callback type of the streamed partitions completion.
+using StreamPartitionsResponseCallback = Callback<StreamPartitionsResult>;
 
 /// The data alias type.
 using DataResult = model::Data;
@@ -87,6 +97,8 @@ using PrefetchTilesResult = std::vector<std::shared_ptr<PrefetchTileResult>>;
 using PrefetchTilesResponse = Response<PrefetchTilesResult>;
 /// The callback type of the prefetch completion.
 using PrefetchTilesResponseCallback = Callback<PrefetchTilesResult>;
+/// The callback type that is invoked for each prefetched tile.
+using PrefetchTileCallback = std::function<void(const PrefetchTileResult&)>;
 
 /// The subscribe ID type of the stream layer client.
 using SubscriptionId = std::string;
@@ -107,6 +119,13 @@ using PollResponse = Response<MessagesResult>;
 /// The poll completion callback type of the stream layer client.
 using PollResponseCallback = Callback<MessagesResult>;
 
+/// The data of the messages in the order of the messages.
+using MessagesDataResult = std::vector<DataResponse>;
+/// The messages data response type of the stream layer client.
+using MessagesDataResponse = Response<MessagesDataResult>;
+/// The messages data completion callback type of the stream layer client.
+using MessagesDataResponseCallback = Callback<MessagesDataResult>;
+
 /** @brief The alias of the seek response result.
  *
  * The status of the HTTP request.
@@ -141,6 +141,31 @@ class DATASERVICE_READ_API VolatileLayerClient final {
   olp::client::CancellableFuture<PartitionsResponse> GetPartitions(
       PartitionsRequest request);
 
+  /**
+   * @brief Fetches the list of partitions of the given volatile layer
+   * asynchronously, and passes it to `page_callback` one page at a time.
+   *
+   * Unlike `GetPartitions`, only one page of partitions is held in memory by
+   * the SDK, and every page is written to the cache as soon as it is received.
+   * Use it for layers with lots of partitions. The page size is set with
+   * `PartitionsRequest::WithPageSize`.
+   *
+   * @param request The `PartitionsRequest` instance that contains a complete
+   * set of request parameters.
+   * @note CacheWithUpdate fetch option is not supported.
+   * @param page_callback The `PartitionsPageCallback` object that is invoked,
+   * in order, for each page of partitions.
+   * @param callback The `StreamPartitionsResponseCallback` object that is
+   * invoked with the number of partitions after the last page, or if an error
+   * is encountered. The pages received before the error are already passed to
+   * `page_callback`.
+   *
+   * @return A token that can be used to cancel this request.
+   */
+  client::CancellationToken StreamPartitions(
+      PartitionsRequest request, PartitionsPageCallback page_callback,
+      StreamPartitionsResponseCallback callback);
+
   /**
    * @brief Fetches data asynchronously using a partition ID or data handle.
    *
@@ -214,11 +239,17 @@ class DATASERVICE_READ_API VolatileLayerClient final {
    * @param callback The `PrefetchTilesResponseCallback` object that is invoked
    * if the `PrefetchTilesResult` instance is available or an error is
    * encountered.
+   * @param tile_callback The optional `PrefetchTileCallback` object that is
+   * invoked for each tile once it is prefetched. It can be invoked from
+   * different threads at the same time. When set, the tile results are not
+   * collected, and the `PrefetchTilesResult` instance passed to `callback` is
+   * empty. This keeps the memory usage of large prefetches low.
    *
    * @return A token that can be used to cancel this request.
    */
   client::CancellationToken PrefetchTiles(
-      PrefetchTilesRequest request, PrefetchTilesResponseCallback callback);
+      PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
+      PrefetchTileCallback tile_callback = nullptr);
 
   /**
    * @brief Prefetches a set of tiles asynchronously.
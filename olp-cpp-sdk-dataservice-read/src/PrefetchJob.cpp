@@ -19,8 +19,10 @@
 
 #include "PrefetchJob.h"
 
+#include <algorithm>
+
 #include <olp/core/logging/Log.h>
-#include <olp/dataservice/read/PrefetchTileResult.h>
+#include "Common.h"
 
 namespace {
 constexpr auto kLogTag = "PrefetchJob";
@@ -30,56 +32,296 @@ namespace olp {
 namespace dataservice {
 namespace read {
 
-PrefetchJob::PrefetchJob(PrefetchTilesResponseCallback user_callback,
-                         uint32_t task_count)
-    : user_callback_(std::move(user_callback)),
-      task_count_{task_count},
-      canceled_{false} {
-  tasks_contexts_.reserve(task_count_);
-  prefetch_result_.reserve(task_count_);
-}
+PrefetchJob::PrefetchJob(
+    std::vector<RootTile> root_tiles, size_t first_root, Stages stages,
+    const PrefetchTilesRequest& request,
+    std::shared_ptr<thread::TaskScheduler> task_scheduler,
+    std::shared_ptr<client::PendingRequests> pending_requests,
+    PrefetchTilesResponseCallback user_callback,
+    PrefetchTileCallback tile_callback)
+    : root_tiles_(std::move(root_tiles)),
+      first_root_{std::min(first_root, root_tiles_.size())},
+      stages_(std::move(stages)),
+      roots_per_batch_{std::max<size_t>(1u, request.GetQuadTreeConcurrency())},
+      max_pending_tiles_{std::max<size_t>(1u, request.GetMaxPendingTiles())},
+      task_scheduler_(std::move(task_scheduler)),
+      pending_requests_(std::move(pending_requests)),
+      user_callback_(std::move(user_callback)),
+      tile_callback_(std::move(tile_callback)),
+      next_root_{first_root_},
+      completed_roots_{first_root_},
+      checkpoint_blocked_{false},
+      pumping_{false},
+      canceled_{false},
+      tiles_count_{0u},
+      pending_tiles_{0u},
+      next_task_id_{0u},
+      stored_checkpoint_{first_root_} {}
 
 PrefetchJob::~PrefetchJob() = default;
 
-client::CancellationContext PrefetchJob::AddTask() {
-  std::lock_guard<std::mutex> lock(mutex_);
-  tasks_contexts_.emplace_back();
-  return tasks_contexts_.back();
+void PrefetchJob::Start() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pumping_ = true;
+  }
+  SchedulePump();
 }
 
-void PrefetchJob::CompleteTask(geo::TileKey tile) {
-  CompleteTask(
-      std::make_shared<PrefetchTileResult>(tile, PrefetchTileNoError()));
+void PrefetchJob::CancelOperation() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  canceled_ = true;
+
+  pump_context_.CancelOperation();
+  for (auto& task_context : tasks_contexts_) {
+    task_context.second.CancelOperation();
+  }
 }
 
-void PrefetchJob::CompleteTask(geo::TileKey tile,
-                               const client::ApiError& error) {
-  CompleteTask(std::make_shared<PrefetchTileResult>(tile, error));
+void PrefetchJob::SchedulePump() {
+  auto self = shared_from_this();
+  AddTask(
+      task_scheduler_, pending_requests_,
+      [=](client::CancellationContext context) { return self->Pump(context); },
+      [=](EmptyResponse response) {
+        PrefetchTilesResponseCallback user_callback;
+        PrefetchTilesResponse user_response;
+        bool resume = false;
+        {
+          std::lock_guard<std::mutex> lock(self->mutex_);
+          if (!response.IsSuccessful() && !self->error_ && !self->canceled_) {
+            self->error_ = response.GetError();
+          }
+          self->pumping_ = false;
+
+          // Downloads could complete while the pump was stopping.
+          resume = self->ShouldResume();
+          self->pumping_ = resume;
+          user_callback = self->TakeCallbackIfDone(user_response);
+        }
+        if (resume) {
+          self->SchedulePump();
+        }
+        if (user_callback) {
+          user_callback(std::move(user_response));
+        }
+      },
+      pump_context_);
 }
 
-void PrefetchJob::CancelOperation() {
-  std::lock_guard<std::mutex> lock(mutex_);
-  canceled_ = true;
+PrefetchJob::EmptyResponse PrefetchJob::Pump(
+    client::CancellationContext context) {
+  while (true) {
+    repository::RootTilesForRequest batch;
+    std::map<geo::TileKey, size_t> batch_indexes;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (canceled_ || error_ || next_root_ >= root_tiles_.size() ||
+          pending_tiles_ >= max_pending_tiles_) {
+        break;
+      }
+
+      const auto end_root =
+          std::min(root_tiles_.size(), next_root_ + roots_per_batch_);
+      for (; next_root_ < end_root; ++next_root_) {
+        batch.insert(root_tiles_[next_root_]);
+        batch_indexes.emplace(root_tiles_[next_root_].first, next_root_);
+        roots_in_progress_[next_root_];
+      }
+    }
 
-  for (auto& context : tasks_contexts_) {
-    context.CancelOperation();
+    auto response = stages_.resolve(
+        batch, context,
+        [&](const geo::TileKey& root_tile,
+            repository::SubQuadsResult sub_quads) {
+          const auto root_index = batch_indexes[root_tile];
+          for (const auto& sub_quad : stages_.filter(std::move(sub_quads))) {
+            ScheduleDownload(root_index, sub_quad.first, sub_quad.second);
+          }
+        });
+
+    boost::optional<size_t> checkpoint;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!response.IsSuccessful() && !error_) {
+        OLP_SDK_LOG_WARNING_F(kLogTag, "Resolving root tiles failed, error=%s",
+                              response.GetError().GetMessage().c_str());
+        error_ = response.GetError();
+        for (auto& task_context : tasks_contexts_) {
+          task_context.second.CancelOperation();
+        }
+      }
+
+      const auto completed_roots = completed_roots_;
+      for (const auto& batch_index : batch_indexes) {
+        roots_in_progress_[batch_index.second].resolved = true;
+        CompleteRootIfDone(batch_index.second);
+      }
+      if (completed_roots != completed_roots_) {
+        checkpoint = completed_roots_;
+      }
+    }
+
+    if (checkpoint) {
+      StoreCheckpoint(*checkpoint);
+    }
   }
+
+  return EmptyResponse(PrefetchTileNoError());
 }
 
-void PrefetchJob::CompleteTask(std::shared_ptr<PrefetchTileResult> result) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  prefetch_result_.push_back(std::move(result));
+void PrefetchJob::ScheduleDownload(size_t root_index, const geo::TileKey& tile,
+                                   const std::string& data_handle) {
+  client::CancellationContext task_context;
+  size_t task_id = 0u;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_id = next_task_id_++;
+    ++tiles_count_;
+    ++pending_tiles_;
+    ++roots_in_progress_[root_index].pending_tiles;
+    tasks_contexts_.emplace(task_id, task_context);
+    if (canceled_ || error_) {
+      task_context.CancelOperation();
+    }
+  }
+
+  auto self = shared_from_this();
+  AddTask(
+      task_scheduler_, pending_requests_,
+      [=](client::CancellationContext context) {
+        return self->stages_.download(data_handle, context);
+      },
+      [=](DataResponse response) {
+        self->CompleteTask(
+            task_id, root_index,
+            response.IsSuccessful()
+                ? std::make_shared<PrefetchTileResult>(tile,
+                                                       PrefetchTileNoError())
+                : std::make_shared<PrefetchTileResult>(tile,
+                                                       response.GetError()));
+      },
+      task_context);
+}
+
+void PrefetchJob::CompleteTask(size_t task_id, size_t root_index,
+                               std::shared_ptr<PrefetchTileResult> result) {
+  if (tile_callback_) {
+    tile_callback_(*result);
+  }
+
+  PrefetchTilesResponseCallback user_callback;
+  PrefetchTilesResponse user_response;
+  boost::optional<size_t> checkpoint;
+  bool resume = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_contexts_.erase(task_id);
+    --pending_tiles_;
+
+    auto& root = roots_in_progress_[root_index];
+    --root.pending_tiles;
+    root.failed = root.failed || !result->IsSuccessful();
 
-  if (!--task_count_) {
-    OLP_SDK_LOG_INFO_F(kLogTag, "Prefetch done, tiles=%zu",
-                       prefetch_result_.size());
+    if (!tile_callback_) {
+      prefetch_result_.push_back(std::move(result));
+    }
+
+    const auto completed_roots = completed_roots_;
+    CompleteRootIfDone(root_index);
+    if (completed_roots != completed_roots_) {
+      checkpoint = completed_roots_;
+    }
 
-    PrefetchTilesResponseCallback user_callback = std::move(user_callback_);
-    if (canceled_) {
-      user_callback({{client::ErrorCode::Cancelled, "Cancelled"}});
-    } else {
-      user_callback(std::move(prefetch_result_));
+    resume = ShouldResume();
+    if (resume) {
+      pumping_ = true;
     }
+    user_callback = TakeCallbackIfDone(user_response);
+  }
+
+  if (checkpoint) {
+    StoreCheckpoint(*checkpoint);
+  }
+  if (resume) {
+    SchedulePump();
+  }
+  if (user_callback) {
+    user_callback(std::move(user_response));
+  }
+}
+
+void PrefetchJob::CompleteRootIfDone(size_t root_index) {
+  auto it = roots_in_progress_.find(root_index);
+  if (it == roots_in_progress_.end() || !it->second.resolved ||
+      it->second.pending_tiles) {
+    return;
+  }
+
+  if (it->second.failed) {
+    // The failed root tile must be processed again by a resumed prefetch.
+    checkpoint_blocked_ = true;
+  }
+
+  if (checkpoint_blocked_) {
+    roots_in_progress_.erase(it);
+    return;
+  }
+
+  // Advance over all the root tiles completed in a row.
+  for (it = roots_in_progress_.begin();
+       it != roots_in_progress_.end() && it->first == completed_roots_ &&
+       it->second.resolved && !it->second.pending_tiles;) {
+    ++completed_roots_;
+    it = roots_in_progress_.erase(it);
+  }
+}
+
+bool PrefetchJob::ShouldResume() const {
+  // Resume once half of the pending downloads are completed, so that each
+  // resolved batch is large enough to keep the downloads busy.
+  return !pumping_ && !canceled_ && !error_ &&
+         next_root_ < root_tiles_.size() &&
+         pending_tiles_ <= max_pending_tiles_ / 2;
+}
+
+PrefetchTilesResponseCallback PrefetchJob::TakeCallbackIfDone(
+    PrefetchTilesResponse& response) {
+  const bool done = pumping_ == false && pending_tiles_ == 0u &&
+                    (canceled_ || error_ || next_root_ >= root_tiles_.size());
+  if (!done || !user_callback_) {
+    return nullptr;
+  }
+
+  OLP_SDK_LOG_INFO_F(kLogTag, "Prefetch done, tiles=%zu", tiles_count_);
+
+  if (error_) {
+    response = error_.get();
+  } else if (canceled_) {
+    response = client::ApiError(client::ErrorCode::Cancelled, "Cancelled");
+  } else if (tiles_count_ == 0u && first_root_ < root_tiles_.size()) {
+    response = client::ApiError(client::ErrorCode::InvalidArgument,
+                                "Subquads retrieval failed");
+  } else {
+    response = std::move(prefetch_result_);
+  }
+
+  PrefetchTilesResponseCallback user_callback = std::move(user_callback_);
+  user_callback_ = nullptr;
+  return user_callback;
+}
+
+void PrefetchJob::StoreCheckpoint(size_t completed_roots) {
+  if (!stages_.checkpoint) {
+    return;
+  }
+
+  // Checkpoints can be reported from several threads, never store an older
+  // one over a newer one.
+  std::lock_guard<std::mutex> lock(checkpoint_mutex_);
+  if (completed_roots > stored_checkpoint_) {
+    stored_checkpoint_ = completed_roots;
+    stages_.checkpoint(completed_roots);
   }
 }
 
@@ -19,17 +19,78 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/PendingRequests.h>
 #include <olp/core/geo/tiling/TileKey.h>
+#include <olp/core/thread/TaskScheduler.h>
+#include <olp/dataservice/read/PrefetchTileResult.h>
 #include <olp/dataservice/read/Types.h>
+#include <boost/optional.hpp>
+#include "repositories/PrefetchTilesRepository.h"
 
 namespace olp {
 namespace dataservice {
 namespace read {
 
-class PrefetchJob {
+/*
+ * @brief A pipeline that resolves and downloads the tiles of one prefetch
+ * operation.
+ *
+ * The root tiles are resolved in batches, and the tiles of each resolved
+ * subtree are downloaded right away. A new batch is resolved only while the
+ * number of pending downloads is below the limit, so the memory usage depends
+ * on the limit and not on the number of prefetched tiles. The number of
+ * completed root tiles is reported to the checkpoint stage, which allows
+ * resuming an interrupted prefetch.
+ */
+class PrefetchJob : public std::enable_shared_from_this<PrefetchJob> {
  public:
-  PrefetchJob(PrefetchTilesResponseCallback user_callback, uint32_t task_count);
+  using RootTile = std::pair<geo::TileKey, std::uint32_t>;
+
+  /// Resolves the root tiles, and passes the tiles of each subtree to the
+  /// callback.
+  using ResolveFunction = std::function<repository::SubTilesResponse(
+      const repository::RootTilesForRequest& root_tiles,
+      client::CancellationContext context,
+      repository::SubQuadsCallback on_sub_quads)>;
+
+  /// Removes the tiles that were not requested.
+  using FilterFunction =
+      std::function<repository::SubQuadsResult(repository::SubQuadsResult)>;
+
+  /// Downloads the data of one tile.
+  using DownloadFunction = std::function<DataResponse(
+      const std::string& data_handle, client::CancellationContext context)>;
+
+  /// Stores the number of the root tiles that completed without errors.
+  using CheckpointFunction = std::function<void(size_t completed_roots)>;
+
+  struct Stages {
+    ResolveFunction resolve;
+    FilterFunction filter;
+    DownloadFunction download;
+    CheckpointFunction checkpoint;
+  };
+
+  /**
+   * @param root_tiles The root tiles in the order of processing.
+   * @param first_root The index of the first root tile to process, all the
+   * previous root tiles were completed by an earlier prefetch.
+   * @param stages The functions used to process the tiles.
+   * @param request The request with the pipeline limits.
+   */
+  PrefetchJob(std::vector<RootTile> root_tiles, size_t first_root,
+              Stages stages, const PrefetchTilesRequest& request,
+              std::shared_ptr<thread::TaskScheduler> task_scheduler,
+              std::shared_ptr<client::PendingRequests> pending_requests,
+              PrefetchTilesResponseCallback user_callback,
+              PrefetchTileCallback tile_callback);
 
   PrefetchJob(const PrefetchJob&) = delete;
   PrefetchJob(PrefetchJob&&) = delete;
@@ -38,25 +99,72 @@ class PrefetchJob {
 
   ~PrefetchJob();
 
-  client::CancellationContext AddTask();
-
-  void CompleteTask(geo::TileKey tile);
-
-  void CompleteTask(geo::TileKey tile, const client::ApiError& error);
+  /// Starts processing the root tiles.
+  void Start();
 
   void CancelOperation();
 
  protected:
-  void CompleteTask(std::shared_ptr<PrefetchTileResult> result);
+  using EmptyResponse = Response<PrefetchTileNoError>;
+
+  struct RootState {
+    size_t pending_tiles{0u};
+    bool resolved{false};
+    bool failed{false};
+  };
+
+  void SchedulePump();
+
+  EmptyResponse Pump(client::CancellationContext context);
+
+  void ScheduleDownload(size_t root_index, const geo::TileKey& tile,
+                        const std::string& data_handle);
+
+  void CompleteTask(size_t task_id, size_t root_index,
+                    std::shared_ptr<PrefetchTileResult> result);
+
+  /// Updates the checkpoint, must be called with the mutex locked.
+  void CompleteRootIfDone(size_t root_index);
+
+  /// Decides whether the next batch should be resolved, must be called with
+  /// the mutex locked.
+  bool ShouldResume() const;
+
+  /// Takes the user callback once the job is done, must be called with the
+  /// mutex locked.
+  PrefetchTilesResponseCallback TakeCallbackIfDone(
+      PrefetchTilesResponse& response);
+
+  void StoreCheckpoint(size_t completed_roots);
 
  private:
+  const std::vector<RootTile> root_tiles_;
+  const size_t first_root_;
+  const Stages stages_;
+  const size_t roots_per_batch_;
+  const size_t max_pending_tiles_;
+  std::shared_ptr<thread::TaskScheduler> task_scheduler_;
+  std::shared_ptr<client::PendingRequests> pending_requests_;
   PrefetchTilesResponseCallback user_callback_;
-  uint32_t task_count_;
-  bool canceled_;
+  PrefetchTileCallback tile_callback_;
 
   std::mutex mutex_;
-  std::vector<client::CancellationContext> tasks_contexts_;
+  size_t next_root_;
+  size_t completed_roots_;
+  bool checkpoint_blocked_;
+  bool pumping_;
+  bool canceled_;
+  boost::optional<client::ApiError> error_;
+  size_t tiles_count_;
+  size_t pending_tiles_;
+  size_t next_task_id_;
+  client::CancellationContext pump_context_;
+  std::map<size_t, RootState> roots_in_progress_;
+  std::map<size_t, client::CancellationContext> tasks_contexts_;
   PrefetchTilesResult prefetch_result_;
+
+  std::mutex checkpoint_mutex_;
+  size_t stored_checkpoint_;
 };
 
 }  // namespace read
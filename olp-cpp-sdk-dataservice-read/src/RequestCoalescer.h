@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <olp/core/client/ApiError.h>
+#include <olp/core/client/CancellationToken.h>
+#include <olp/dataservice/read/Types.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/*
+ * @brief Coalesces identical requests, so that only one of them is executed.
+ *
+ * The first request for a key schedules the task. The requests with the same
+ * key that arrive before the task completes do not schedule anything, their
+ * callbacks are attached to the running task and receive a copy of its
+ * response. No thread is blocked while waiting for the response.
+ *
+ * Cancelling one request detaches its callback, which is then invoked with the
+ * `Cancelled` error. The task itself is cancelled only when all the attached
+ * requests are cancelled.
+ *
+ * The pending requests are kept in several shards, so that the requests with
+ * different keys rarely contend for the same lock.
+ */
+template <typename Result>
+class RequestCoalescer final {
+ public:
+  using ResponseType = Response<Result>;
+  using CallbackType = Callback<Result>;
+  /// Schedules the task, and returns a token to cancel it.
+  using ScheduleFunction =
+      std::function<client::CancellationToken(CallbackType)>;
+
+  RequestCoalescer() : impl_(std::make_shared<Impl>()) {}
+
+  /*
+   * @brief Executes the request, or attaches it to an identical request that
+   * is already running.
+   *
+   * @param key The key that identifies identical requests.
+   * @param callback The callback that receives the response.
+   * @param schedule The function used to schedule the task, if no identical
+   * request is running.
+   *
+   * @return The token to cancel the request.
+   */
+  client::CancellationToken Execute(const std::string& key,
+                                    CallbackType callback,
+                                    const ScheduleFunction& schedule) {
+    auto impl = impl_;
+    auto& shard = impl->GetShard(key);
+    const auto id = impl->next_id++;
+
+    std::shared_ptr<Flight> flight;
+    bool leader = false;
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto& entry = shard.flights[key];
+      if (!entry) {
+        entry = std::make_shared<Flight>();
+        leader = true;
+      }
+      flight = entry;
+      flight->callbacks.emplace(id, std::move(callback));
+    }
+
+    if (leader) {
+      auto token = schedule([=](ResponseType response) {
+        impl->Complete(key, flight, std::move(response));
+      });
+
+      bool cancel = false;
+      {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        flight->token = token;
+        cancel = flight->cancelled;
+      }
+      if (cancel) {
+        token.Cancel();
+      }
+    }
+
+    return client::CancellationToken(
+        [=]() { impl->Detach(key, flight, id); });
+  }
+
+ private:
+  static constexpr size_t kShardsCount = 16u;
+
+  struct Flight {
+    std::map<size_t, CallbackType> callbacks;
+    client::CancellationToken token;
+    bool cancelled{false};
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Flight>> flights;
+  };
+
+  struct Impl {
+    Shard& GetShard(const std::string& key) {
+      return shards[std::hash<std::string>()(key) % kShardsCount];
+    }
+
+    void Complete(const std::string& key, const std::shared_ptr<Flight>& flight,
+                  ResponseType response) {
+      std::map<size_t, CallbackType> callbacks;
+      {
+        auto& shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Erase(shard, key, flight);
+        callbacks.swap(flight->callbacks);
+      }
+
+      std::vector<CallbackType> user_callbacks;
+      user_callbacks.reserve(callbacks.size());
+      for (auto& callback : callbacks) {
+        if (callback.second) {
+          user_callbacks.push_back(std::move(callback.second));
+        }
+      }
+
+      for (size_t index = 0; index < user_callbacks.size(); ++index) {
+        if (index + 1 < user_callbacks.size()) {
+          user_callbacks[index](response);
+        } else {
+          user_callbacks[index](std::move(response));
+        }
+      }
+    }
+
+    void Detach(const std::string& key, const std::shared_ptr<Flight>& flight,
+                size_t id) {
+      CallbackType callback;
+      client::CancellationToken token;
+      {
+        auto& shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = flight->callbacks.find(id);
+        if (it == flight->callbacks.end()) {
+          // Already completed or cancelled.
+          return;
+        }
+
+        if (flight->callbacks.size() > 1u) {
+          callback = std::move(it->second);
+          flight->callbacks.erase(it);
+        } else {
+          // The last request cancels the task, and receives the response of
+          // the cancelled task. New requests must not attach to it.
+          Erase(shard, key, flight);
+          flight->cancelled = true;
+          token = flight->token;
+        }
+      }
+
+      token.Cancel();
+      if (callback) {
+        callback(client::ApiError(client::ErrorCode::Cancelled, "Cancelled"));
+      }
+    }
+
+    void Erase(Shard& shard, const std::string& key,
+               const std::shared_ptr<Flight>& flight) {
+      auto it = shard.flights.find(key);
+      if (it != shard.flights.end() && it->second == flight) {
+        shard.flights.erase(it);
+      }
+    }
+
+    std::array<Shard, kShardsCount> shards;
+    std::atomic<size_t> next_id{0u};
+  };
+
+  std::shared_ptr<Impl> impl_;
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
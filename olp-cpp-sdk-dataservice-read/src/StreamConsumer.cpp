@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "StreamConsumer.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <olp/core/http/HttpStatusCode.h>
+#include <olp/core/logging/Log.h>
+#include "Common.h"
+
+namespace {
+constexpr auto kLogTag = "StreamConsumer";
+}
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+StreamConsumer::StreamConsumer(
+    const SubscribeRequest& request, std::string correlation_id,
+    ConsumeFunction consume, CommitFunction commit,
+    std::shared_ptr<thread::TaskScheduler> task_scheduler,
+    std::shared_ptr<client::PendingRequests> pending_requests)
+    : prefetch_batches_{request.GetPollPrefetch()},
+      commit_interval_{request.GetCommitInterval()},
+      commit_batch_size_{std::max<size_t>(1u, request.GetCommitBatchSize())},
+      consume_(std::move(consume)),
+      commit_(std::move(commit)),
+      task_scheduler_(std::move(task_scheduler)),
+      pending_requests_(std::move(pending_requests)),
+      consuming_{false},
+      prefetch_scheduled_{false},
+      committing_{false},
+      generation_{0u},
+      uncommitted_messages_{0u},
+      last_commit_{std::chrono::steady_clock::now()},
+      correlation_id_(std::move(correlation_id)) {}
+
+StreamConsumer::~StreamConsumer() = default;
+
+PollResponse StreamConsumer::Poll(client::CancellationContext context) {
+  PollResponse response;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // A running consume returns the next batch, wait for it to keep the
+    // order of the messages.
+    condition_.wait(lock, [&] { return !batches_.empty() || !consuming_; });
+
+    if (!batches_.empty()) {
+      response = std::move(batches_.front());
+      batches_.pop_front();
+    } else {
+      consuming_ = true;
+      lock.unlock();
+      response = Consume(context);
+      lock.lock();
+      consuming_ = false;
+      condition_.notify_all();
+    }
+  }
+
+  bool prefetch = false;
+  bool commit = false;
+  Offsets offsets;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (response.IsSuccessful()) {
+      AddOffsets(response.GetResult());
+      prefetch =
+          !response.GetResult().GetMessages().empty() && ShouldPrefetch();
+      prefetch_scheduled_ = prefetch_scheduled_ || prefetch;
+    }
+
+    commit = ShouldCommit();
+    if (commit) {
+      offsets.swap(offsets_);
+      uncommitted_messages_ = 0u;
+      committing_ = true;
+    }
+  }
+
+  if (prefetch) {
+    SchedulePrefetch();
+  }
+
+  if (!commit) {
+    return response;
+  }
+
+  if (commit_interval_ && task_scheduler_) {
+    ScheduleCommit(std::move(offsets));
+    return response;
+  }
+
+  auto commit_response = Commit(offsets, context);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    committing_ = false;
+    last_commit_ = std::chrono::steady_clock::now();
+    if (!commit_response.IsSuccessful()) {
+      RestoreOffsets(offsets);
+    }
+    condition_.notify_all();
+  }
+
+  if (!commit_response.IsSuccessful()) {
+    OLP_SDK_LOG_WARNING_F(kLogTag,
+                          "Poll: commit offsets unsuccessful, error=%s",
+                          commit_response.GetError().GetMessage().c_str());
+    return commit_response.GetError();
+  }
+  return response;
+}
+
+Response<int> StreamConsumer::Flush(client::CancellationContext context) {
+  Offsets offsets;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [&] { return !committing_; });
+    if (offsets_.empty()) {
+      return http::HttpStatusCode::OK;
+    }
+
+    offsets.swap(offsets_);
+    uncommitted_messages_ = 0u;
+    committing_ = true;
+  }
+
+  auto response = Commit(offsets, context);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    committing_ = false;
+    last_commit_ = std::chrono::steady_clock::now();
+    if (!response.IsSuccessful()) {
+      RestoreOffsets(offsets);
+    }
+    condition_.notify_all();
+  }
+  return response;
+}
+
+void StreamConsumer::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++generation_;
+  batches_.clear();
+  offsets_.clear();
+  uncommitted_messages_ = 0u;
+}
+
+std::string StreamConsumer::GetCorrelationId() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return correlation_id_;
+}
+
+void StreamConsumer::SchedulePrefetch() {
+  auto self = shared_from_this();
+  auto started = std::make_shared<bool>(false);
+  size_t generation = 0u;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation = generation_;
+  }
+
+  AddTask(
+      task_scheduler_, pending_requests_,
+      [=](client::CancellationContext context) -> PollResponse {
+        {
+          std::lock_guard<std::mutex> lock(self->mutex_);
+          // `Poll` consumes the next batch itself.
+          if (self->consuming_ || generation != self->generation_) {
+            return client::ApiError(client::ErrorCode::Cancelled,
+                                    "Prefetch skipped");
+          }
+          self->consuming_ = true;
+          *started = true;
+        }
+        return self->Consume(context);
+      },
+      [=](PollResponse response) {
+        bool prefetch = false;
+        {
+          std::lock_guard<std::mutex> lock(self->mutex_);
+          self->prefetch_scheduled_ = false;
+          if (*started) {
+            self->consuming_ = false;
+
+            const bool cancelled =
+                !response.IsSuccessful() &&
+                response.GetError().GetErrorCode() ==
+                    client::ErrorCode::Cancelled;
+            if (!cancelled && generation == self->generation_) {
+              const bool has_messages =
+                  response.IsSuccessful() &&
+                  !response.GetResult().GetMessages().empty();
+              self->batches_.push_back(std::move(response));
+
+              // Stop at the first empty batch or error, `Poll` resumes.
+              prefetch = has_messages && self->ShouldPrefetch();
+              self->prefetch_scheduled_ = prefetch;
+            }
+          }
+          self->condition_.notify_all();
+        }
+        if (prefetch) {
+          self->SchedulePrefetch();
+        }
+      });
+}
+
+void StreamConsumer::ScheduleCommit(Offsets offsets) {
+  auto self = shared_from_this();
+  auto shared_offsets = std::make_shared<Offsets>(std::move(offsets));
+
+  AddTask(
+      task_scheduler_, pending_requests_,
+      [=](client::CancellationContext context) {
+        return self->Commit(*shared_offsets, context);
+      },
+      [=](Response<int> response) {
+        std::lock_guard<std::mutex> lock(self->mutex_);
+        self->committing_ = false;
+        self->last_commit_ = std::chrono::steady_clock::now();
+        if (!response.IsSuccessful()) {
+          OLP_SDK_LOG_WARNING_F(kLogTag,
+                                "Commit offsets unsuccessful, error=%s",
+                                response.GetError().GetMessage().c_str());
+          self->RestoreOffsets(*shared_offsets);
+        }
+        self->condition_.notify_all();
+      });
+}
+
+PollResponse StreamConsumer::Consume(client::CancellationContext context) {
+  const auto sent = GetCorrelationId();
+  auto correlation_id = sent;
+  auto response = consume_(std::move(context), correlation_id);
+  UpdateCorrelationId(sent, std::move(correlation_id));
+  return response;
+}
+
+Response<int> StreamConsumer::Commit(const Offsets& offsets,
+                                     client::CancellationContext context) {
+  const auto sent = GetCorrelationId();
+  auto correlation_id = sent;
+  auto response =
+      commit_(ToStreamOffsets(offsets), std::move(context), correlation_id);
+  UpdateCorrelationId(sent, std::move(correlation_id));
+  return response;
+}
+
+void StreamConsumer::UpdateCorrelationId(const std::string& sent,
+                                         std::string received) {
+  if (received == sent) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  correlation_id_ = std::move(received);
+}
+
+void StreamConsumer::AddOffsets(const model::Messages& messages) {
+  for (const auto& message : messages.GetMessages()) {
+    const auto& offset = message.GetOffset();
+    auto it = offsets_.find(offset.GetPartition());
+    if (it == offsets_.end()) {
+      offsets_.emplace(offset.GetPartition(), offset);
+    } else if (it->second.GetOffset() < offset.GetOffset()) {
+      it->second = offset;
+    }
+  }
+  uncommitted_messages_ += messages.GetMessages().size();
+}
+
+void StreamConsumer::RestoreOffsets(const Offsets& offsets) {
+  // A newer offset of the same partition commits the older one as well.
+  for (const auto& offset : offsets) {
+    offsets_.insert(offset);
+  }
+}
+
+bool StreamConsumer::ShouldPrefetch() const {
+  return task_scheduler_ && prefetch_batches_ > 0u && !prefetch_scheduled_ &&
+         !consuming_ && batches_.size() < prefetch_batches_;
+}
+
+bool StreamConsumer::ShouldCommit() const {
+  if (committing_ || offsets_.empty()) {
+    return false;
+  }
+  return !commit_interval_ || uncommitted_messages_ >= commit_batch_size_ ||
+         std::chrono::steady_clock::now() - last_commit_ >= *commit_interval_;
+}
+
+model::StreamOffsets StreamConsumer::ToStreamOffsets(const Offsets& offsets) {
+  std::vector<model::StreamOffset> values;
+  values.reserve(offsets.size());
+  for (const auto& offset : offsets) {
+    values.push_back(offset.second);
+  }
+
+  model::StreamOffsets stream_offsets;
+  stream_offsets.SetOffsets(std::move(values));
+  return stream_offsets;
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/PendingRequests.h>
+#include <olp/core/thread/TaskScheduler.h>
+#include <olp/dataservice/read/SubscribeRequest.h>
+#include <olp/dataservice/read/Types.h>
+#include <olp/dataservice/read/model/StreamOffsets.h>
+#include <boost/optional.hpp>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/**
+ * @brief Polls the messages of one stream layer subscription.
+ *
+ * Up to `SubscribeRequest::GetPollPrefetch` batches are consumed in the
+ * background while the user processes the batch returned by `Poll`, and the
+ * offsets of the returned messages are committed in the background once per
+ * commit interval or when enough messages are uncommitted. Without a commit
+ * interval the offsets are committed by `Poll` before it returns, and without
+ * a task scheduler nothing runs in the background.
+ *
+ * Only one consume and one commit request run at a time, so the messages are
+ * returned in order and an older commit never overrides a newer one.
+ */
+class StreamConsumer : public std::enable_shared_from_this<StreamConsumer> {
+ public:
+  /// Consumes the next batch of messages, and updates the correlation id
+  /// from the response.
+  using ConsumeFunction = std::function<PollResponse(
+      client::CancellationContext context, std::string& correlation_id)>;
+
+  /// Commits the offsets, and updates the correlation id from the response.
+  using CommitFunction = std::function<Response<int>(
+      const model::StreamOffsets& offsets, client::CancellationContext context,
+      std::string& correlation_id)>;
+
+  /**
+   * @param request The request with the prefetch and commit settings.
+   * @param correlation_id The correlation id returned by the subscription.
+   * @param consume The function that consumes the messages.
+   * @param commit The function that commits the offsets.
+   */
+  StreamConsumer(const SubscribeRequest& request, std::string correlation_id,
+                 ConsumeFunction consume, CommitFunction commit,
+                 std::shared_ptr<thread::TaskScheduler> task_scheduler,
+                 std::shared_ptr<client::PendingRequests> pending_requests);
+
+  StreamConsumer(const StreamConsumer&) = delete;
+  StreamConsumer(StreamConsumer&&) = delete;
+  StreamConsumer& operator=(const StreamConsumer&) = delete;
+  StreamConsumer& operator=(StreamConsumer&&) = delete;
+
+  ~StreamConsumer();
+
+  /// Returns the next batch, from the prefetched ones if possible.
+  PollResponse Poll(client::CancellationContext context);
+
+  /// Commits the offsets of all the returned messages, waits for the running
+  /// commit first.
+  Response<int> Flush(client::CancellationContext context);
+
+  /// Drops the prefetched batches and the uncommitted offsets, for example,
+  /// after seeking to other offsets.
+  void Reset();
+
+  /// Returns the correlation id of the latest response.
+  std::string GetCorrelationId();
+
+ protected:
+  using Offsets = std::map<std::int32_t, model::StreamOffset>;
+
+  void SchedulePrefetch();
+
+  void ScheduleCommit(Offsets offsets);
+
+  /// Consumes with the latest correlation id, must be called with the mutex
+  /// unlocked.
+  PollResponse Consume(client::CancellationContext context);
+
+  /// Commits with the latest correlation id, must be called with the mutex
+  /// unlocked.
+  Response<int> Commit(const Offsets& offsets,
+                       client::CancellationContext context);
+
+  /// Stores the correlation id returned for the sent one, unless another
+  /// response has updated it meanwhile.
+  void UpdateCorrelationId(const std::string& sent, std::string received);
+
+  /// Stores the offsets of the messages, must be called with the mutex locked.
+  void AddOffsets(const model::Messages& messages);
+
+  /// Puts back the offsets of a failed commit unless there are newer ones,
+  /// must be called with the mutex locked.
+  void RestoreOffsets(const Offsets& offsets);
+
+  /// Decides whether a prefetch should be scheduled, must be called with the
+  /// mutex locked.
+  bool ShouldPrefetch() const;
+
+  /// Decides whether the offsets should be committed, must be called with the
+  /// mutex locked.
+  bool ShouldCommit() const;
+
+  static model::StreamOffsets ToStreamOffsets(const Offsets& offsets);
+
+ private:
+  const size_t prefetch_batches_;
+  const boost::optional<std::chrono::milliseconds> commit_interval_;
+  const size_t commit_batch_size_;
+  ConsumeFunction consume_;
+  CommitFunction commit_;
+  std::shared_ptr<thread::TaskScheduler> task_scheduler_;
+  std::shared_ptr<client::PendingRequests> pending_requests_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<PollResponse> batches_;
+  bool consuming_;
+  bool prefetch_scheduled_;
+  bool committing_;
+  size_t generation_;
+  Offsets offsets_;
+  size_t uncommitted_messages_;
+  std::chrono::steady_clock::time_point last_commit_;
+  std::string correlation_id_;
+};
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
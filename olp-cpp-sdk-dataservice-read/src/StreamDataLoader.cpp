@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "StreamDataLoader.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <olp/core/client/CancellationToken.h>
+#include "Common.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+namespace {
+using WorkerResponse = Response<bool>;
+
+struct LoadState {
+  std::mutex mutex;
+  std::condition_variable condition;
+  /// The message index and the data handle of every message to download.
+  std::vector<std::pair<size_t, std::string>> handles;
+  size_t next_handle{0u};
+  size_t running{0u};
+  bool cancelled{false};
+  MessagesDataResult results;
+};
+
+// Downloads the data handles one by one until none is left.
+void DownloadHandles(const std::shared_ptr<LoadState>& state,
+                     const DownloadFunction& download,
+                     client::CancellationContext context) {
+  while (true) {
+    size_t handle_index = 0u;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->cancelled || state->next_handle >= state->handles.size()) {
+        return;
+      }
+      handle_index = state->next_handle++;
+      ++state->running;
+    }
+
+    const auto& handle = state->handles[handle_index];
+    auto response = download(handle.second, context);
+
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->results[handle.first] = std::move(response);
+      --state->running;
+    }
+    state->condition.notify_all();
+  }
+}
+}  // namespace
+
+MessagesDataResponse LoadMessagesData(
+    const model::Messages& messages, size_t max_parallel_requests,
+    DownloadFunction download,
+    const std::shared_ptr<thread::TaskScheduler>& task_scheduler,
+    const std::shared_ptr<client::PendingRequests>& pending_requests,
+    client::CancellationContext context) {
+  auto state = std::make_shared<LoadState>();
+
+  const auto& list = messages.GetMessages();
+  state->results.resize(list.size());
+  for (size_t index = 0; index < list.size(); ++index) {
+    const auto& metadata = list[index].GetMetaData();
+    if (metadata.GetDataHandle()) {
+      state->handles.emplace_back(index, metadata.GetDataHandle().get());
+    } else {
+      state->results[index] = metadata.GetData();
+    }
+  }
+
+  // The calling thread is one of the workers.
+  std::vector<client::CancellationToken> tokens;
+  if (task_scheduler) {
+    const auto workers = std::min(max_parallel_requests, state->handles.size());
+    for (size_t worker = 1u; worker < workers; ++worker) {
+      tokens.push_back(AddTask(
+          task_scheduler, pending_requests,
+          [=](client::CancellationContext worker_context) -> WorkerResponse {
+            DownloadHandles(state, download, worker_context);
+            return true;
+          },
+          [](WorkerResponse) {}));
+    }
+  }
+
+  client::CancellationContext inner_context;
+  auto cancel = [=]() mutable {
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->cancelled = true;
+    }
+    inner_context.CancelOperation();
+    for (auto& token : tokens) {
+      token.Cancel();
+    }
+  };
+
+  if (!context.ExecuteOrCancelled(
+          [&]() { return client::CancellationToken(cancel); })) {
+    cancel();
+    return client::ApiError(client::ErrorCode::Cancelled, "Cancelled");
+  }
+
+  DownloadHandles(state, download, inner_context);
+
+  // Wait for the downloads that other workers started, no download starts
+  // afterwards.
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&] { return state->running == 0u; });
+  }
+
+  if (context.IsCancelled()) {
+    return client::ApiError(client::ErrorCode::Cancelled, "Cancelled");
+  }
+
+  return std::move(state->results);
+}
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/PendingRequests.h>
+#include <olp/core/thread/TaskScheduler.h>
+#include <olp/dataservice/read/Types.h>
+#include <olp/dataservice/read/model/Messages.h>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+
+/// Downloads the data of one data handle.
+using DownloadFunction = std::function<DataResponse(
+    const std::string& data_handle, client::CancellationContext context)>;
+
+/**
+ * @brief Loads the data of the stream messages.
+ *
+ * The embedded data is returned as is, and the data handles are downloaded
+ * with up to `max_parallel_requests` downloads at a time. The calling thread
+ * downloads as well, so the loading completes even if the task scheduler has
+ * no free threads, and without a task scheduler the data handles are
+ * downloaded one by one.
+ *
+ * @param messages The messages.
+ * @param max_parallel_requests The maximum number of parallel downloads.
+ * @param download The function that downloads one data handle.
+ * @param context The context used to cancel all the downloads.
+ *
+ * @return The data of every message in the order of the messages, or
+ * an error if the loading is cancelled.
+ */
+MessagesDataResponse LoadMessagesData(
+    const model::Messages& messages, size_t max_parallel_requests,
+    DownloadFunction download,
+    const std::shared_ptr<thread::TaskScheduler>& task_scheduler,
+    const std::shared_ptr<client::PendingRequests>& pending_requests,
+    client::CancellationContext context);
+
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -73,6 +73,17 @@ client::CancellableFuture<DataResponse> StreamLayerClient::GetData(
   return impl_->GetData(message);
 }
 
+client::CancellationToken StreamLayerClient::GetData(
+    const model::Messages& messages, size_t max_parallel_requests,
+    MessagesDataResponseCallback callback) {
+  return impl_->GetData(messages, max_parallel_requests, std::move(callback));
+}
+
+client::CancellableFuture<MessagesDataResponse> StreamLayerClient::GetData(
+    const model::Messages& messages, size_t max_parallel_requests) {
+  return impl_->GetData(messages, max_parallel_requests);
+}
+
 client::CancellationToken StreamLayerClient::Poll(
     PollResponseCallback callback) {
   return impl_->Poll(callback);
@@ -19,8 +19,7 @@
 
 #include "StreamLayerClientImpl.h"
 
-#include <iterator>
-#include <set>
+#include <algorithm>
 
 #include <olp/core/cache/DefaultCache.h>
 #include <olp/core/client/CancellationContext.h>
@@ -30,6 +29,7 @@
 #include <olp/core/thread/TaskScheduler.h>
 #include "ApiClientLookup.h"
 #include "Common.h"
+#include "StreamDataLoader.h"
 #include "generated/api/BlobApi.h"
 #include "generated/api/StreamApi.h"
 #include "repositories/ExecuteOrSchedule.inl"
@@ -137,6 +137,25 @@ client::CancellationToken StreamLayerClientImpl::Subscribe(
       client_context_->client->SetBaseUrl(
           subscription.GetResult().GetNodeBaseURL());
       client_context_->client->SetSettings(settings_);
+
+      auto olp_client = client_context_->client;
+      auto layer_id = layer_id_;
+      auto consume = [=](client::CancellationContext context,
+                         std::string& x_correlation_id) -> PollResponse {
+        return StreamApi::ConsumeData(*olp_client, layer_id, subscripton_id,
+                                      subscription_mode, context,
+                                      x_correlation_id);
+      };
+      auto commit = [=](const model::StreamOffsets& offsets,
+                        client::CancellationContext context,
+                        std::string& x_correlation_id) {
+        return StreamApi::CommitOffsets(*olp_client, layer_id, offsets,
+                                        subscripton_id, subscription_mode,
+                                        context, x_correlation_id);
+      };
+      client_context_->consumer = std::make_shared<StreamConsumer>(
+          request, correlation_id, std::move(consume), std::move(commit),
+          settings_.task_scheduler, pending_requests_);
     }
 
     OLP_SDK_LOG_INFO_F(kLogTag,
@@ -173,6 +192,7 @@ client::CancellationToken StreamLayerClientImpl::Unsubscribe(
     std::string subscription_mode;
     std::string x_correlation_id;
     std::shared_ptr<client::OlpClient> client;
+    std::shared_ptr<StreamConsumer> consumer;
 
     {
       std::lock_guard<std::mutex> lock(mutex_);
@@ -186,16 +206,30 @@ client::CancellationToken StreamLayerClientImpl::Unsubscribe(
 
       subscription_id = client_context_->subscription_id;
       subscription_mode = client_context_->subscription_mode;
-      x_correlation_id = client_context_->x_correlation_id;
       client = client_context_->client;
+      consumer = client_context_->consumer;
     }
 
+    x_correlation_id = consumer->GetCorrelationId();
+
     OLP_SDK_LOG_INFO_F(kLogTag,
                        "Unsubscribe: started, subscription_id=%s, "
                        "subscription_mode=%s, x_correlation_id=%s",
                        subscription_id.c_str(), subscription_mode.c_str(),
                        x_correlation_id.c_str());
 
+    // Commit the offsets that are left from the background commits.
+    const auto flush_response = consumer->Flush(context);
+    if (!flush_response.IsSuccessful()) {
+      OLP_SDK_LOG_WARNING_F(kLogTag,
+                            "Unsubscribe: commit offsets unsuccessful, "
+                            "error=%s",
+                            flush_response.GetError().GetMessage().c_str());
+    }
+
+    // The commit may have returned a new correlation id.
+    x_correlation_id = consumer->GetCorrelationId();
+
     const auto response = StreamApi::DeleteSubscription(
         *client, layer_id_, subscription_id, subscription_mode,
         x_correlation_id, context);
@@ -282,13 +316,76 @@ client::CancellableFuture<DataResponse> StreamLayerClientImpl::GetData(
                                                       std::move(promise));
 }
 
+client::CancellationToken StreamLayerClientImpl::GetData(
+    const model::Messages& messages, size_t max_parallel_requests,
+    MessagesDataResponseCallback callback) {
+  auto get_data_task =
+      [=](client::CancellationContext context) -> MessagesDataResponse {
+    OLP_SDK_LOG_INFO_F(kLogTag,
+                       "GetData: started, messages=%zu, "
+                       "max_parallel_requests=%zu",
+                       messages.GetMessages().size(), max_parallel_requests);
+
+    const auto& list = messages.GetMessages();
+    const bool has_handles = std::any_of(
+        list.begin(), list.end(), [](const model::Message& message) {
+          return static_cast<bool>(message.GetMetaData().GetDataHandle());
+        });
+
+    // One lookup serves all the downloads of the batch.
+    client::OlpClient blob_client;
+    if (has_handles) {
+      auto blob_api = ApiClientLookup::LookupApi(
+          catalog_, context, kBlobService, kBlobVersion,
+          FetchOptions::OnlineIfNotFound, settings_);
+
+      if (!blob_api.IsSuccessful()) {
+        return blob_api.GetError();
+      }
+      blob_client = blob_api.MoveResult();
+    }
+
+    auto layer_id = layer_id_;
+    auto download = [=](const std::string& data_handle,
+                        client::CancellationContext inner_context) {
+      return BlobApi::GetBlob(blob_client, layer_id, data_handle, boost::none,
+                              boost::none, inner_context);
+    };
+
+    auto response = LoadMessagesData(
+        messages, std::max<size_t>(1u, max_parallel_requests),
+        std::move(download), settings_.task_scheduler, pending_requests_,
+        context);
+
+    OLP_SDK_LOG_INFO_F(kLogTag, "GetData: done, response is successful: %s",
+                       response.IsSuccessful() ? "true" : "false");
+
+    return response;
+  };
+
+  return AddTask(settings_.task_scheduler, pending_requests_,
+                 std::move(get_data_task), std::move(callback));
+}
+
+client::CancellableFuture<MessagesDataResponse> StreamLayerClientImpl::GetData(
+    const model::Messages& messages, size_t max_parallel_requests) {
+  auto promise = std::make_shared<std::promise<MessagesDataResponse>>();
+  auto cancel_token = GetData(messages, max_parallel_requests,
+                              [promise](MessagesDataResponse response) {
+                                promise->set_value(std::move(response));
+                              });
+
+  return olp::client::CancellableFuture<MessagesDataResponse>(
+      std::move(cancel_token), std::move(promise));
+}
+
 client::CancellationToken StreamLayerClientImpl::Poll(
     PollResponseCallback callback) {
   auto poll_task = [=](client::CancellationContext context) -> PollResponse {
     std::string subscription_id;
     std::string subscription_mode;
     std::string x_correlation_id;
-    std::shared_ptr<client::OlpClient> client;
+    std::shared_ptr<StreamConsumer> consumer;
 
     {
       std::lock_guard<std::mutex> lock(mutex_);
@@ -302,66 +399,29 @@ client::CancellationToken StreamLayerClientImpl::Poll(
 
       subscription_id = client_context_->subscription_id;
       subscription_mode = client_context_->subscription_mode;
-      x_correlation_id = client_context_->x_correlation_id;
-      client = client_context_->client;
+      consumer = client_context_->consumer;
     }
 
+    x_correlation_id = consumer->GetCorrelationId();
+
     OLP_SDK_LOG_INFO_F(kLogTag,
                        "Poll: started, subscription_id=%s, "
                        "subscription_mode=%s, x_correlation_id=%s",
                        subscription_id.c_str(), subscription_mode.c_str(),
                        x_correlation_id.c_str());
 
-    auto data =
-        StreamApi::ConsumeData(*client, layer_id_, subscription_id,
-                               subscription_mode, context, x_correlation_id);
-
-    if (!data.IsSuccessful()) {
-      OLP_SDK_LOG_WARNING_F(kLogTag, "Poll: couldn't consume data, error=%s",
-                            data.GetError().GetMessage().c_str());
-      return data.GetError();
-    }
-
-    auto res = data.MoveResult();
-
-    const auto& messages = res.GetMessages();
+    // Returns a prefetched batch if there is one, and commits the offsets
+    // before returning unless they are committed in the background.
+    auto response = consumer->Poll(context);
 
-    if (messages.empty()) {
-      OLP_SDK_LOG_INFO_F(kLogTag, "Poll: done, no new messages received.");
-      return res;
-    }
-
-    // Get offsets for all partitions presented in messages.
-    struct Compare {
-      bool operator()(const model::StreamOffset& lhs,
-                      const model::StreamOffset& rhs) const {
-        return lhs.GetPartition() < rhs.GetPartition();
-      }
-    };
-
-    std::set<model::StreamOffset, Compare> stream_offsets;
-
-    std::transform(messages.rbegin(), messages.rend(),
-                   std::inserter(stream_offsets, stream_offsets.end()),
-                   [](const model::Message& msg) { return msg.GetOffset(); });
-
-    // Commit offsets
-    model::StreamOffsets offsets_request;
-    offsets_request.SetOffsets(std::vector<model::StreamOffset>(
-        stream_offsets.begin(), stream_offsets.end()));
-    auto commit_res = StreamApi::CommitOffsets(
-        *client, layer_id_, offsets_request, subscription_id, subscription_mode,
-        context, x_correlation_id);
-
-    if (!commit_res.IsSuccessful()) {
-      OLP_SDK_LOG_WARNING_F(kLogTag,
-                            "Poll: commit offsets unsuccessful, error=%s",
-                            commit_res.GetError().GetMessage().c_str());
-      return commit_res.GetError();
+    if (!response.IsSuccessful()) {
+      OLP_SDK_LOG_WARNING_F(kLogTag, "Poll: unsuccessful, error=%s",
+                            response.GetError().GetMessage().c_str());
+      return response;
     }
     OLP_SDK_LOG_INFO_F(kLogTag, "Poll: done, response is successful.");
 
-    return res;
+    return response;
   };
 
   return AddTask(settings_.task_scheduler, pending_requests_,
@@ -385,6 +445,7 @@ client::CancellationToken StreamLayerClientImpl::Seek(
     std::string subscription_mode;
     std::string x_correlation_id;
     std::shared_ptr<client::OlpClient> client;
+    std::shared_ptr<StreamConsumer> consumer;
 
     {
       std::lock_guard<std::mutex> lock(mutex_);
@@ -397,10 +458,12 @@ client::CancellationToken StreamLayerClientImpl::Seek(
 
       subscription_id = client_context_->subscription_id;
       subscription_mode = client_context_->subscription_mode;
-      x_correlation_id = client_context_->x_correlation_id;
       client = client_context_->client;
+      consumer = client_context_->consumer;
     }
 
+    x_correlation_id = consumer->GetCorrelationId();
+
     auto const& offsets = request.GetOffsets();
     if (offsets.GetOffsets().empty()) {
       OLP_SDK_LOG_WARNING_F(kLogTag,
@@ -409,6 +472,10 @@ client::CancellationToken StreamLayerClientImpl::Seek(
                               "Stream offsets missing", false);
     }
 
+    // The prefetched messages and the offsets to commit are from before the
+    // seek.
+    consumer->Reset();
+
     auto res =
         StreamApi::SeekToOffset(*client, layer_id_, offsets, subscription_id,
                                 subscription_mode, context, x_correlation_id);
@@ -29,6 +29,7 @@
 #include <olp/dataservice/read/SubscribeRequest.h>
 #include <olp/dataservice/read/Types.h>
 #include <olp/dataservice/read/model/Messages.h>
+#include "StreamConsumer.h"
 
 namespace olp {
 namespace client {
@@ -64,6 +65,13 @@ class StreamLayerClientImpl {
   virtual client::CancellableFuture<DataResponse> GetData(
       const model::Message& message);
 
+  virtual client::CancellationToken GetData(
+      const model::Messages& messages, size_t max_parallel_requests,
+      MessagesDataResponseCallback callback);
+
+  virtual client::CancellableFuture<MessagesDataResponse> GetData(
+      const model::Messages& messages, size_t max_parallel_requests);
+
   virtual client::CancellationToken Poll(PollResponseCallback callback);
   virtual client::CancellableFuture<PollResponse> Poll();
 
@@ -87,6 +95,7 @@ class StreamLayerClientImpl {
     std::string subscription_mode;
     std::string x_correlation_id;
     std::shared_ptr<client::OlpClient> client;
+    std::shared_ptr<StreamConsumer> consumer;
   };
 
   client::HRN catalog_;
@@ -74,9 +74,18 @@ VersionedLayerClient::GetPartitions(PartitionsRequest partitions_request) {
   return impl_->GetPartitions(std::move(partitions_request));
 }
 
+client::CancellationToken VersionedLayerClient::StreamPartitions(
+    PartitionsRequest request, PartitionsPageCallback page_callback,
+    StreamPartitionsResponseCallback callback) {
+  return impl_->StreamPartitions(std::move(request), std::move(page_callback),
+                                 std::move(callback));
+}
+
 client::CancellationToken VersionedLayerClient::PrefetchTiles(
-    PrefetchTilesRequest request, PrefetchTilesResponseCallback callback) {
-  return impl_->PrefetchTiles(std::move(request), std::move(callback));
+    PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
+    PrefetchTileCallback tile_callback) {
+  return impl_->PrefetchTiles(std::move(request), std::move(callback),
+                              std::move(tile_callback));
 }
 
 client::CancellableFuture<PrefetchTilesResponse>
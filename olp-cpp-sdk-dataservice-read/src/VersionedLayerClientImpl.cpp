@@ -41,6 +41,7 @@
 #include "repositories/DataRepository.h"
 #include "repositories/PartitionsRepository.h"
 #include "repositories/PrefetchTilesRepository.h"
+#include "repositories/QuadTreeIndexCache.h"
 
 // Needed to avoid endless warnings from GetVersion/WithVersion
 #include <olp/core/porting/warning_disable.h>
@@ -70,6 +71,9 @@ VersionedLayerClientImpl::VersionedLayerClientImpl(
   if (!settings_.cache) {
     settings_.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
   }
+
+  repository::QuadTreeIndexCache::Instance().SetMaxSize(
+      settings_.quad_tree_memory_cache_size);
 }
 
 VersionedLayerClientImpl::~VersionedLayerClientImpl() {
@@ -131,6 +135,40 @@ VersionedLayerClientImpl::GetPartitions(PartitionsRequest partitions_request) {
                                                        std::move(promise));
 }
 
+client::CancellationToken VersionedLayerClientImpl::StreamPartitions(
+    PartitionsRequest request, PartitionsPageCallback page_callback,
+    StreamPartitionsResponseCallback callback) {
+  if (request.GetFetchOption() == CacheWithUpdate) {
+    auto task = [](client::CancellationContext) -> StreamPartitionsResponse {
+      return {{client::ErrorCode::InvalidArgument,
+               "CacheWithUpdate option can not be used for versioned "
+               "layer"}};
+    };
+    return AddTask(settings_.task_scheduler, pending_requests_, std::move(task),
+                   std::move(callback));
+  }
+
+  auto catalog = catalog_;
+  auto layer_id = layer_id_;
+  auto settings = settings_;
+
+  auto partitions_task =
+      [=](client::CancellationContext context) -> StreamPartitionsResponse {
+    auto version_response =
+        GetVersion(request.GetBillingTag(), request.GetFetchOption(), context);
+    if (!version_response.IsSuccessful()) {
+      return version_response.GetError();
+    }
+
+    return repository::PartitionsRepository::StreamVersionedPartitions(
+        catalog, layer_id, version_response.GetResult().GetVersion(), context,
+        request, settings, page_callback);
+  };
+
+  return AddTask(settings.task_scheduler, pending_requests_,
+                 std::move(partitions_task), std::move(callback));
+}
+
 client::CancellationToken VersionedLayerClientImpl::GetData(
     DataRequest request, DataResponseCallback callback) {
   if (request.GetFetchOption() == CacheWithUpdate) {
@@ -166,8 +204,22 @@ client::CancellationToken VersionedLayerClientImpl::GetData(
           context, std::move(settings));
     };
 
-    return AddTask(settings.task_scheduler, pending_requests_,
-                   std::move(data_task), std::move(callback));
+    auto schedule = [&](DataResponseCallback callback) {
+      return AddTask(settings.task_scheduler, pending_requests_,
+                     std::move(data_task), std::move(callback));
+    };
+
+    // Requests with both or none of partition ID and data handle fail
+    // validation, there is nothing to share between them.
+    if (static_cast<bool>(request.GetPartitionId()) ==
+        static_cast<bool>(request.GetDataHandle())) {
+      return schedule(std::move(callback));
+    }
+
+    // Partition IDs and data handles share the key format.
+    auto key = (request.GetDataHandle() ? "handle:" : "partition:") +
+               request.CreateKey(layer_id, boost::none);
+    return data_coalescer_.Execute(key, std::move(callback), schedule);
   };
 
   return ScheduleFetch(std::move(schedule_get_data), std::move(request),
@@ -186,7 +238,8 @@ client::CancellableFuture<DataResponse> VersionedLayerClientImpl::GetData(
 }
 
 client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
-    PrefetchTilesRequest request, PrefetchTilesResponseCallback callback) {
+    PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
+    PrefetchTileCallback tile_callback) {
   // Used as empty response to be able to execute initial task
   using EmptyResponse = Response<PrefetchTileNoError>;
   using client::CancellationContext;
@@ -200,7 +253,12 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
   auto token = AddTask(
       settings.task_scheduler, pending_requests,
       [=](CancellationContext context) mutable -> EmptyResponse {
-        if (request.GetTileKeys().empty()) {
+        // Cover the polygon and the corridor, the merged ranges are looked up
+        // with a binary search when filtering.
+        request.WithTileKeyRanges(
+            repository::PrefetchTilesRepository::GetTileKeyRanges(request));
+        if (request.GetTileKeys().empty() &&
+            request.GetTileKeyRanges().empty()) {
           OLP_SDK_LOG_WARNING_F(kLogTag,
                                 "PrefetchTiles : invalid request, layer=%s",
                                 layer_id.c_str());
@@ -237,7 +295,7 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
                  : request.GetMaxLevel());
 
         auto sliced_tiles = repository::PrefetchTilesRepository::GetSlicedTiles(
-            request.GetTileKeys(), min_level, max_level);
+            request, min_level, max_level);
 
         if (sliced_tiles.empty()) {
           OLP_SDK_LOG_WARNING_F(kLogTag,
@@ -249,74 +307,81 @@ client::CancellationToken VersionedLayerClientImpl::PrefetchTiles(
         OLP_SDK_LOG_DEBUG_F(kLogTag, "PrefetchTiles, subquads=%zu, key=%s",
                             sliced_tiles.size(), key.c_str());
 
-        auto sub_tiles = repository::PrefetchTilesRepository::GetSubTiles(
-            catalog, layer_id, request, version, sliced_tiles, context,
-            settings);
-
-        if (!sub_tiles.IsSuccessful()) {
-          return sub_tiles.GetError();
-        }
-
-        auto tiles_result =
-            repository::PrefetchTilesRepository::FilterSkippedTiles(
-                request, request_only_input_tiles, sub_tiles.MoveResult());
-
-        if (tiles_result.empty()) {
-          OLP_SDK_LOG_WARNING_F(
-              kLogTag, "PrefetchTiles: subtiles empty, key=%s", key.c_str());
-          return {{ErrorCode::InvalidArgument, "Subquads retrieval failed"}};
-        }
-
-        OLP_SDK_LOG_INFO_F(kLogTag, "Prefetch start, key=%s, tiles=%zu",
-                           key.c_str(), tiles_result.size());
-
         // Settings structure consumes a 536 bytes of heap memory when captured
         // in lambda, shared pointer (16 bytes) saves 520 bytes of heap memory.
         // When users prefetch few hundreds tiles it could save few mb.
         auto shared_settings =
             std::make_shared<client::OlpClientSettings>(settings);
+        auto shared_request = std::make_shared<PrefetchTilesRequest>(request);
+
+        PrefetchJob::Stages stages;
+        stages.resolve = [=](const repository::RootTilesForRequest& root_tiles,
+                             CancellationContext inner_context,
+                             repository::SubQuadsCallback on_sub_quads) {
+          return repository::PrefetchTilesRepository::GetSubTiles(
+              catalog, layer_id, *shared_request, version, root_tiles,
+              inner_context, *shared_settings, std::move(on_sub_quads));
+        };
+        stages.filter = [=](repository::SubQuadsResult sub_quads) {
+          return repository::PrefetchTilesRepository::FilterSkippedTiles(
+              *shared_request, request_only_input_tiles, std::move(sub_quads));
+        };
+        stages.download = [=](const std::string& handle,
+                              CancellationContext inner_context) {
+          repository::DataCacheRepository data_cache_repository(
+              catalog, shared_settings->cache);
+          if (data_cache_repository.IsCached(layer_id, handle)) {
+            // Cached, return an empty success
+            return DataResponse(nullptr);
+          }
+          // Fetch from online
+          return repository::DataRepository::GetVersionedData(
+              catalog, layer_id, version,
+              DataRequest().WithDataHandle(handle).WithBillingTag(
+                  shared_request->GetBillingTag()),
+              inner_context, *shared_settings);
+        };
+
+        std::vector<PrefetchJob::RootTile> root_tiles(sliced_tiles.begin(),
+                                                      sliced_tiles.end());
+        size_t first_root = 0u;
+        if (request.IsResumable()) {
+          const auto checkpoint_key =
+              repository::PrefetchTilesRepository::CreateCheckpointKey(
+                  catalog, layer_id, request, version);
+          first_root = repository::PrefetchTilesRepository::GetCheckpoint(
+              settings, checkpoint_key);
+
+          const auto roots_count = root_tiles.size();
+          stages.checkpoint = [=](size_t completed_roots) {
+            if (completed_roots < roots_count) {
+              repository::PrefetchTilesRepository::PutCheckpoint(
+                  *shared_settings, checkpoint_key, completed_roots);
+            } else {
+              repository::PrefetchTilesRepository::RemoveCheckpoint(
+                  *shared_settings, checkpoint_key);
+            }
+          };
+        }
+
+        OLP_SDK_LOG_INFO_F(kLogTag,
+                           "Prefetch start, key=%s, root_tiles=%zu, "
+                           "first_root=%zu",
+                           key.c_str(), root_tiles.size(), first_root);
 
         auto prefetch_job = std::make_shared<PrefetchJob>(
-            std::move(callback), tiles_result.size());
-
-        std::for_each(
-            tiles_result.begin(), tiles_result.end(),
-            [&](const repository::SubQuadsResult::value_type& sub_quad) {
-              const auto& tile = sub_quad.first;
-              const auto& handle = sub_quad.second;
-              const auto& biling_tag = request.GetBillingTag();
-
-              AddTask(
-                  settings.task_scheduler, pending_requests,
-                  [=](CancellationContext inner_context) {
-                    repository::DataCacheRepository data_cache_repository(
-                        catalog, shared_settings->cache);
-                    if (data_cache_repository.IsCached(layer_id, handle)) {
-                      // Cached, return an empty success
-                      return DataResponse(nullptr);
-                    } else {
-                      // Fetch from online
-                      return repository::DataRepository::GetVersionedData(
-                          catalog, layer_id, version,
-                          DataRequest().WithDataHandle(handle).WithBillingTag(
-                              biling_tag),
-                          inner_context, *shared_settings);
-                    }
-                  },
-                  [=](DataResponse result) {
-                    if (result.IsSuccessful()) {
-                      prefetch_job->CompleteTask(tile);
-                    } else {
-                      prefetch_job->CompleteTask(tile, result.GetError());
-                    }
-                  },
-                  prefetch_job->AddTask());
-            });
-
-        context.ExecuteOrCancelled([&]() {
-          return client::CancellationToken(
-              [=]() { prefetch_job->CancelOperation(); });
-        });
+            std::move(root_tiles), first_root, std::move(stages), request,
+            settings.task_scheduler, pending_requests, std::move(callback),
+            std::move(tile_callback));
+
+        if (!context.ExecuteOrCancelled([&]() {
+              return client::CancellationToken(
+                  [=]() { prefetch_job->CancelOperation(); });
+            })) {
+          return {{ErrorCode::Cancelled, "Cancelled"}};
+        }
+
+        prefetch_job->Start();
 
         return EmptyResponse(PrefetchTileNoError());
       },
@@ -417,8 +482,13 @@ client::CancellationToken VersionedLayerClientImpl::GetData(
           std::move(settings));
     };
 
-    return AddTask(settings.task_scheduler, pending_requests,
-                   std::move(data_task), std::move(callback));
+    auto schedule = [&](DataResponseCallback callback) {
+      return AddTask(settings.task_scheduler, pending_requests,
+                     std::move(data_task), std::move(callback));
+    };
+
+    return data_coalescer_.Execute(request.CreateKey(layer_id),
+                                   std::move(callback), schedule);
   };
 
   return ScheduleFetch(std::move(schedule_get_data), std::move(request),
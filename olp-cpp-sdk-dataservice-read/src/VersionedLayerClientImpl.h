@@ -33,6 +33,7 @@
 #include <olp/dataservice/read/PrefetchTilesRequest.h>
 #include <olp/dataservice/read/TileRequest.h>
 #include <olp/dataservice/read/Types.h>
+#include "RequestCoalescer.h"
 #include "repositories/ExecuteOrSchedule.inl"
 
 namespace olp {
@@ -75,8 +76,13 @@ class VersionedLayerClientImpl {
   virtual client::CancellableFuture<PartitionsResponse> GetPartitions(
       PartitionsRequest partitions_request);
 
+  virtual client::CancellationToken StreamPartitions(
+      PartitionsRequest request, PartitionsPageCallback page_callback,
+      StreamPartitionsResponseCallback callback);
+
   virtual client::CancellationToken PrefetchTiles(
-      PrefetchTilesRequest request, PrefetchTilesResponseCallback callback);
+      PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
+      PrefetchTileCallback tile_callback = nullptr);
 
   virtual client::CancellableFuture<PrefetchTilesResponse> PrefetchTiles(
       PrefetchTilesRequest request);
@@ -107,6 +113,7 @@ class VersionedLayerClientImpl {
   client::OlpClientSettings settings_;
   std::shared_ptr<client::PendingRequests> pending_requests_;
   std::atomic<int64_t> catalog_version_;
+  RequestCoalescer<model::Data> data_coalescer_;
 };
 
 }  // namespace read
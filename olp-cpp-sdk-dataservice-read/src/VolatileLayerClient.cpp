@@ -54,6 +54,13 @@ VolatileLayerClient::GetPartitions(PartitionsRequest request) {
   return impl_->GetPartitions(std::move(request));
 }
 
+client::CancellationToken VolatileLayerClient::StreamPartitions(
+    PartitionsRequest request, PartitionsPageCallback page_callback,
+    StreamPartitionsResponseCallback callback) {
+  return impl_->StreamPartitions(std::move(request), std::move(page_callback),
+                                 std::move(callback));
+}
+
 client::CancellationToken VolatileLayerClient::GetData(
     DataRequest request, DataResponseCallback callback) {
   return impl_->GetData(std::move(request), std::move(callback));
@@ -73,8 +80,10 @@ bool VolatileLayerClient::RemoveFromCache(const geo::TileKey& tile) {
 }
 
 client::CancellationToken VolatileLayerClient::PrefetchTiles(
-    PrefetchTilesRequest request, PrefetchTilesResponseCallback callback) {
-  return impl_->PrefetchTiles(std::move(request), std::move(callback));
+    PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
+    PrefetchTileCallback tile_callback) {
+  return impl_->PrefetchTiles(std::move(request), std::move(callback),
+                              std::move(tile_callback));
 }
 
 client::CancellableFuture<PrefetchTilesResponse>
@@ -29,6 +29,7 @@
 #include <olp/dataservice/read/PrefetchTileResult.h>
 
 #include "Common.h"
+#include "PrefetchJob.h"
 #include "repositories/CatalogRepository.h"
 #include "repositories/DataCacheRepository.h"
 #include "repositories/DataRepository.h"
@@ -36,6 +37,7 @@
 #include "repositories/PartitionsCacheRepository.h"
 #include "repositories/PartitionsRepository.h"
 #include "repositories/PrefetchTilesRepository.h"
+#include "repositories/QuadTreeIndexCache.h"
 
 namespace olp {
 namespace dataservice {
@@ -61,6 +63,9 @@ VolatileLayerClientImpl::VolatileLayerClientImpl(
   if (!settings_.cache) {
     settings_.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
   }
+
+  repository::QuadTreeIndexCache::Instance().SetMaxSize(
+      settings_.quad_tree_memory_cache_size);
 }
 
 VolatileLayerClientImpl::~VolatileLayerClientImpl() {
@@ -104,6 +109,32 @@ VolatileLayerClientImpl::GetPartitions(PartitionsRequest request) {
   return olp::client::CancellableFuture<PartitionsResponse>(token, promise);
 }
 
+client::CancellationToken VolatileLayerClientImpl::StreamPartitions(
+    PartitionsRequest request, PartitionsPageCallback page_callback,
+    StreamPartitionsResponseCallback callback) {
+  if (request.GetFetchOption() == CacheWithUpdate) {
+    auto task = [](client::CancellationContext) -> StreamPartitionsResponse {
+      return {{client::ErrorCode::InvalidArgument,
+               "CacheWithUpdate option can not be used to stream "
+               "partitions"}};
+    };
+    return AddTask(settings_.task_scheduler, pending_requests_, std::move(task),
+                   std::move(callback));
+  }
+
+  auto catalog = catalog_;
+  auto layer_id = layer_id_;
+  auto settings = settings_;
+
+  auto partitions_task = [=](client::CancellationContext context) {
+    return repository::PartitionsRepository::StreamVolatilePartitions(
+        catalog, layer_id, context, request, settings, page_callback);
+  };
+
+  return AddTask(settings.task_scheduler, pending_requests_,
+                 std::move(partitions_task), std::move(callback));
+}
+
 client::CancellationToken VolatileLayerClientImpl::GetData(
     DataRequest request, DataResponseCallback callback) {
   auto schedule_get_data = [&](DataRequest request,
@@ -117,8 +148,20 @@ client::CancellationToken VolatileLayerClientImpl::GetData(
           catalog, layer_id, request, context, settings);
     };
 
-    return AddTask(settings.task_scheduler, pending_requests_,
-                   std::move(partitions_task), std::move(callback));
+    auto schedule = [&](DataResponseCallback callback) {
+      return AddTask(settings.task_scheduler, pending_requests_,
+                     std::move(partitions_task), std::move(callback));
+    };
+
+    if (static_cast<bool>(request.GetPartitionId()) ==
+        static_cast<bool>(request.GetDataHandle())) {
+      return schedule(std::move(callback));
+    }
+
+    // Partition IDs and data handles share the key format.
+    auto key = (request.GetDataHandle() ? "handle:" : "partition:") +
+               request.CreateKey(layer_id, boost::none);
+    return data_coalescer_.Execute(key, std::move(callback), schedule);
   };
 
   return ScheduleFetch(std::move(schedule_get_data), std::move(request),
@@ -159,12 +202,10 @@ bool VolatileLayerClientImpl::RemoveFromCache(const geo::TileKey& tile) {
 }
 
 client::CancellationToken VolatileLayerClientImpl::PrefetchTiles(
-    PrefetchTilesRequest request, PrefetchTilesResponseCallback callback) {
+    PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
+    PrefetchTileCallback tile_callback) {
   // Used as empty response to be able to execute initial task
   using EmptyResponse = Response<PrefetchTileNoError>;
-  using PrefetchResult = PrefetchTilesResult::value_type;
-  using PrefetchResultFuture = std::future<PrefetchResult>;
-  using PrefetchResultPromise = std::promise<PrefetchResult>;
   using client::CancellationContext;
   using client::ErrorCode;
 
@@ -176,8 +217,12 @@ client::CancellationToken VolatileLayerClientImpl::PrefetchTiles(
   auto token = AddTask(
       settings.task_scheduler, pending_requests,
       [=](CancellationContext context) mutable -> EmptyResponse {
-        const auto& tile_keys = request.GetTileKeys();
-        if (tile_keys.empty()) {
+        // Cover the polygon and the corridor, the merged ranges are looked up
+        // with a binary search when filtering.
+        request.WithTileKeyRanges(
+            repository::PrefetchTilesRepository::GetTileKeyRanges(request));
+        if (request.GetTileKeys().empty() &&
+            request.GetTileKeyRanges().empty()) {
           OLP_SDK_LOG_WARNING_F(kLogTag,
                                 "PrefetchTiles : invalid request, layer=%s",
                                 layer_id.c_str());
@@ -198,7 +243,7 @@ client::CancellationToken VolatileLayerClientImpl::PrefetchTiles(
                                       : request.GetMaxLevel());
 
         auto sliced_tiles = repository::PrefetchTilesRepository::GetSlicedTiles(
-            tile_keys, min_level, max_level);
+            request, min_level, max_level);
 
         if (sliced_tiles.empty()) {
           OLP_SDK_LOG_WARNING_F(kLogTag,
@@ -210,121 +255,80 @@ client::CancellationToken VolatileLayerClientImpl::PrefetchTiles(
         OLP_SDK_LOG_DEBUG_F(kLogTag, "PrefetchTiles, subquads=%zu, key=%s",
                             sliced_tiles.size(), key.c_str());
 
-        auto sub_tiles = repository::PrefetchTilesRepository::GetSubTiles(
-            catalog, layer_id, request, boost::none, sliced_tiles, context,
-            settings);
-
-        if (!sub_tiles.IsSuccessful()) {
-          return sub_tiles.GetError();
-        }
-
-        const auto& tiles_result = sub_tiles.GetResult();
-        if (tiles_result.empty()) {
-          OLP_SDK_LOG_WARNING_F(
-              kLogTag, "PrefetchTiles: subtiles empty, key=%s", key.c_str());
-          return {{ErrorCode::InvalidArgument, "Subquads retrieval failed"}};
-        }
-
-        OLP_SDK_LOG_INFO_F(kLogTag, "Prefetch start, key=%s, tiles=%zu",
-                           key.c_str(), tiles_result.size());
-
-        // Once we have the data create for each subtile a task and push it
-        // onto the TaskScheduler. One additional last task is added which
-        // waits for all previous tasks to finish so that it may call the user
-        // with the result.
-        auto futures = std::make_shared<std::vector<PrefetchResultFuture>>();
-        std::vector<CancellationContext> contexts;
-        contexts.reserve(tiles_result.size() + 1u);
-        auto it = tiles_result.begin();
-        auto skip_tile = [&](const geo::TileKey& tile_key) {
-          if (request_only_input_tiles) {
-            return (std::find(tile_keys.begin(), tile_keys.end(), tile_key) ==
-                    tile_keys.end());
-          }
-          // skip tiles outside min/max segment
-          return (tile_key.Level() < request.GetMinLevel() ||
-                  tile_key.Level() > request.GetMaxLevel());
-        };
-
         // Settings structure consumes a 536 bytes of heap memory when captured
         // in lambda, shared pointer (16 bytes) saves 520 bytes of heap memory.
         // When users prefetch few hundreds tiles it could save few mb.
         auto shared_settings =
             std::make_shared<client::OlpClientSettings>(settings);
-
-        while (!context.IsCancelled() && it != tiles_result.end()) {
-          auto const& tile = it->first;
-          if (skip_tile(tile)) {
-            it++;
-            continue;
+        auto shared_request = std::make_shared<PrefetchTilesRequest>(request);
+
+        PrefetchJob::Stages stages;
+        stages.resolve = [=](const repository::RootTilesForRequest& root_tiles,
+                             CancellationContext inner_context,
+                             repository::SubQuadsCallback on_sub_quads) {
+          return repository::PrefetchTilesRepository::GetSubTiles(
+              catalog, layer_id, *shared_request, boost::none, root_tiles,
+              inner_context, *shared_settings, std::move(on_sub_quads));
+        };
+        stages.filter = [=](repository::SubQuadsResult sub_quads) {
+          return repository::PrefetchTilesRepository::FilterSkippedTiles(
+              *shared_request, request_only_input_tiles, std::move(sub_quads));
+        };
+        stages.download = [=](const std::string& handle,
+                              CancellationContext inner_context) {
+          repository::DataCacheRepository data_cache_repository(
+              catalog, shared_settings->cache);
+          if (data_cache_repository.IsCached(layer_id, handle)) {
+            // Return an empty success
+            return DataResponse(nullptr);
           }
+          return repository::DataRepository::GetVolatileData(
+              catalog, layer_id,
+              DataRequest().WithDataHandle(handle).WithBillingTag(
+                  shared_request->GetBillingTag()),
+              inner_context, *shared_settings);
+        };
 
-          auto const& handle = it->second;
-          auto const& biling_tag = request.GetBillingTag();
-          auto promise = std::make_shared<PrefetchResultPromise>();
-          futures->emplace_back(promise->get_future());
-          auto context_it = contexts.emplace(contexts.end());
-
-          AddTask(
-              settings.task_scheduler, pending_requests,
-              [=](CancellationContext inner_context) {
-                repository::DataCacheRepository data_cache_repository(
-                    catalog, shared_settings->cache);
-                if (data_cache_repository.IsCached(layer_id, handle)) {
-                  // Return an empty success
-                  return DataResponse(nullptr);
-                } else {
-                  return repository::DataRepository::GetVolatileData(
-                      catalog, layer_id,
-                      DataRequest().WithDataHandle(handle).WithBillingTag(
-                          biling_tag),
-                      inner_context, *shared_settings);
-                }
-              },
-              [=](DataResponse result) {
-                if (result.IsSuccessful()) {
-                  promise->set_value(std::make_shared<PrefetchTileResult>(
-                      tile, PrefetchTileNoError()));
-                } else {
-                  promise->set_value(std::make_shared<PrefetchTileResult>(
-                      tile, result.GetError()));
-                }
-              },
-              *context_it);
-          it++;
+        std::vector<PrefetchJob::RootTile> root_tiles(sliced_tiles.begin(),
+                                                      sliced_tiles.end());
+        size_t first_root = 0u;
+        if (request.IsResumable()) {
+          const auto checkpoint_key =
+              repository::PrefetchTilesRepository::CreateCheckpointKey(
+                  catalog, layer_id, request, boost::none);
+          first_root = repository::PrefetchTilesRepository::GetCheckpoint(
+              settings, checkpoint_key);
+
+          const auto roots_count = root_tiles.size();
+          stages.checkpoint = [=](size_t completed_roots) {
+            if (completed_roots < roots_count) {
+              repository::PrefetchTilesRepository::PutCheckpoint(
+                  *shared_settings, checkpoint_key, completed_roots);
+            } else {
+              repository::PrefetchTilesRepository::RemoveCheckpoint(
+                  *shared_settings, checkpoint_key);
+            }
+          };
         }
 
-        // Task to wait for previously triggered data download to collect
-        // responses and trigger user callback.
-        AddTask(
-            settings.task_scheduler, pending_requests,
-            [=](CancellationContext inner_context) -> PrefetchTilesResponse {
-              PrefetchTilesResult result;
-              result.reserve(futures->size());
-
-              for (auto& future : *futures) {
-                // Check if cancelled in between.
-                if (inner_context.IsCancelled()) {
-                  return {{ErrorCode::Cancelled, "Cancelled"}};
-                }
-
-                auto tile_result = future.get();
-                result.emplace_back(std::move(tile_result));
-              }
-
-              OLP_SDK_LOG_INFO_F(kLogTag, "Prefetch done, key=%s, tiles=%zu",
-                                 key.c_str(), result.size());
-              return PrefetchTilesResponse(std::move(result));
-            },
-            callback, *contexts.emplace(contexts.end()));
-
-        context.ExecuteOrCancelled([&]() {
-          return client::CancellationToken([contexts]() {
-            for (auto context : contexts) {
-              context.CancelOperation();
-            }
-          });
-        });
+        OLP_SDK_LOG_INFO_F(kLogTag,
+                           "Prefetch start, key=%s, root_tiles=%zu, "
+                           "first_root=%zu",
+                           key.c_str(), root_tiles.size(), first_root);
+
+        auto prefetch_job = std::make_shared<PrefetchJob>(
+            std::move(root_tiles), first_root, std::move(stages), request,
+            settings.task_scheduler, pending_requests, std::move(callback),
+            std::move(tile_callback));
+
+        if (!context.ExecuteOrCancelled([&]() {
+              return client::CancellationToken(
+                  [=]() { prefetch_job->CancelOperation(); });
+            })) {
+          return {{ErrorCode::Cancelled, "Cancelled"}};
+        }
+
+        prefetch_job->Start();
 
         return EmptyResponse(PrefetchTileNoError());
       },
@@ -27,6 +27,7 @@
 #include <olp/dataservice/read/PartitionsRequest.h>
 #include <olp/dataservice/read/PrefetchTilesRequest.h>
 #include <olp/dataservice/read/Types.h>
+#include "RequestCoalescer.h"
 
 namespace olp {
 
@@ -56,6 +57,10 @@ class VolatileLayerClientImpl {
   virtual client::CancellableFuture<PartitionsResponse> GetPartitions(
       PartitionsRequest request);
 
+  virtual client::CancellationToken StreamPartitions(
+      PartitionsRequest request, PartitionsPageCallback page_callback,
+      StreamPartitionsResponseCallback callback);
+
   virtual client::CancellationToken GetData(DataRequest request,
                                             DataResponseCallback callback);
 
@@ -66,7 +71,8 @@ class VolatileLayerClientImpl {
   virtual bool RemoveFromCache(const geo::TileKey& tile);
 
   virtual client::CancellationToken PrefetchTiles(
-      PrefetchTilesRequest request, PrefetchTilesResponseCallback callback);
+      PrefetchTilesRequest request, PrefetchTilesResponseCallback callback,
+      PrefetchTileCallback tile_callback = nullptr);
 
   virtual client::CancellableFuture<PrefetchTilesResponse> PrefetchTiles(
       PrefetchTilesRequest request);
@@ -76,6 +82,7 @@ class VolatileLayerClientImpl {
   std::string layer_id_;
   client::OlpClientSettings settings_;
   std::shared_ptr<client::PendingRequests> pending_requests_;
+  RequestCoalescer<model::Data> data_coalescer_;
 };
 
 }  // namespace read
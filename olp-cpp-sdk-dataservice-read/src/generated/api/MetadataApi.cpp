@@ -28,7 +28,7 @@
 
 // clang-format off
 #include "generated/parser/LayerVersionsParser.h"
-#include "generated/parser/PartitionsParser.h"
+#include "generated/parser/SaxParser.h"
 #include "generated/parser/VersionResponseParser.h"
 #include "generated/parser/VersionInfosParser.h"
 #include <olp/core/generated/parser/JsonParser.h>
@@ -88,6 +88,52 @@ MetadataApi::PartitionsResponse MetadataApi::GetPartitions(
     boost::optional<std::string> range,
     boost::optional<std::string> billing_tag,
     const client::CancellationContext& context) {
+  auto api_response =
+      CallPartitionsApi(client, layer_id, version, additional_fields,
+                        std::move(range), std::move(billing_tag), context);
+
+  if (api_response.status != http::HttpStatusCode::OK) {
+    return {{api_response.status, api_response.response.str()}};
+  }
+
+  return PartitionsResponse(
+      olp::parser::parse_sax<model::Partitions>(api_response.response));
+}
+
+MetadataApi::PartitionsPagesResponse MetadataApi::GetPartitionsPages(
+    const client::OlpClient& client, const std::string& layer_id,
+    boost::optional<std::int64_t> version,
+    const std::vector<std::string>& additional_fields,
+    boost::optional<std::string> billing_tag, size_t page_size,
+    const PartitionsPageCallback& page_callback,
+    const client::CancellationContext& context) {
+  auto api_response =
+      CallPartitionsApi(client, layer_id, version, additional_fields,
+                        boost::none, std::move(billing_tag), context);
+
+  if (api_response.status != http::HttpStatusCode::OK) {
+    return {{api_response.status, api_response.response.str()}};
+  }
+
+  if (!olp::parser::parse_sax_pages(api_response.response, page_size,
+                                    page_callback)) {
+    if (context.IsCancelled()) {
+      return {{client::ErrorCode::Cancelled, "Cancelled"}};
+    }
+    return {{client::ErrorCode::Unknown,
+             "Failed to parse the partitions response"}};
+  }
+
+  return client::ApiNoResult{};
+}
+
+client::HttpResponse MetadataApi::CallPartitionsApi(
+    const client::OlpClient& client, const std::string& layer_id,
+    boost::optional<std::int64_t> version,
+    const std::vector<std::string>& additional_fields,
+    boost::optional<std::string> range,
+    boost::optional<std::string> billing_tag,
+    const client::CancellationContext& context) {
   std::multimap<std::string, std::string> header_params;
   header_params.emplace("Accept", "application/json");
   if (range) {
@@ -108,15 +154,8 @@ MetadataApi::PartitionsResponse MetadataApi::GetPartitions(
 
   std::string metadataUri = "/layers/" + layer_id + "/partitions";
 
-  auto api_response = client.CallApi(metadataUri, "GET", query_params,
-                                     header_params, {}, nullptr, "", context);
-
-  if (api_response.status != http::HttpStatusCode::OK) {
-    return {{api_response.status, api_response.response.str()}};
-  }
-
-  return PartitionsResponse(
-      olp::parser::parse<model::Partitions>(api_response.response));
+  return client.CallApi(metadataUri, "GET", query_params, header_params, {},
+                        nullptr, "", context);
 }
 
 MetadataApi::CatalogVersionResponse MetadataApi::GetLatestCatalogVersion(
@@ -19,11 +19,14 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 
 #include <olp/core/client/ApiError.h>
+#include <olp/core/client/ApiNoResult.h>
 #include <olp/core/client/ApiResponse.h>
+#include <olp/core/client/HttpResponse.h>
 #include <boost/optional.hpp>
 #include "generated/model/LayerVersions.h"
 #include "olp/dataservice/read/model/Partitions.h"
@@ -47,6 +50,10 @@ class MetadataApi {
       client::ApiResponse<model::VersionInfos, client::ApiError>;
   using PartitionsResponse =
       client::ApiResponse<model::Partitions, client::ApiError>;
+  using PartitionsPagesResponse =
+      client::ApiResponse<client::ApiNoResult, client::ApiError>;
+  /// Consumes a page of partitions, returns false to stop the download.
+  using PartitionsPageCallback = std::function<bool(model::Partitions)>;
 
   using CatalogVersionResponse =
       client::ApiResponse<model::VersionResponse, client::ApiError>;
@@ -101,6 +108,33 @@ class MetadataApi {
       boost::optional<std::string> billing_tag,
       const client::CancellationContext& context);
 
+  /**
+   * @brief Retrieves metadata for all partitions in a specified layer, and
+   * passes it to the callback page by page while the response is parsed.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id Layer id.
+   * @param version Specify the version for a versioned layer. Doesn't apply for
+   * other layer types.
+   * @param additional_fields Additional fields - dataSize, checksum,
+   * compressedDataSize.
+   * @param billing_tag An optional free-form tag which is used for grouping
+   * billing records together. If supplied, it must be between 4 - 16
+   * characters, contain only alpha/numeric ASCII characters  [A-Za-z0-9].
+   * @param page_size The maximum number of partitions in a page.
+   * @param page_callback Is invoked for each page of partitions.
+   * @param context A CancellationContext, which can be used to cancel request.
+   *
+   * @return An empty response or an error. The pages received before
+   * the error are already passed to the callback.
+   */
+  static PartitionsPagesResponse GetPartitionsPages(
+      const client::OlpClient& client, const std::string& layer_id,
+      boost::optional<int64_t> version,
+      const std::vector<std::string>& additional_fields,
+      boost::optional<std::string> billing_tag, size_t page_size,
+      const PartitionsPageCallback& page_callback,
+      const client::CancellationContext& context);
+
   /**
    * @brief Retrieves the latest metadata version for the catalog.
    * @param client Instance of OlpClient used to make REST request.
@@ -124,6 +158,15 @@ class MetadataApi {
       const client::OlpClient& client, int64_t start_version,
       int64_t end_version, boost::optional<std::string> billing_tag,
       const client::CancellationContext& context);
+
+ private:
+  static client::HttpResponse CallPartitionsApi(
+      const client::OlpClient& client, const std::string& layer_id,
+      boost::optional<int64_t> version,
+      const std::vector<std::string>& additional_fields,
+      boost::optional<std::string> range,
+      boost::optional<std::string> billing_tag,
+      const client::CancellationContext& context);
 };
 
 }  // namespace read
@@ -28,7 +28,7 @@
 #include <olp/core/logging/Log.h>
 // clang-format off
 #include "generated/parser/IndexParser.h"
-#include "generated/parser/PartitionsParser.h"
+#include "generated/parser/SaxParser.h"
 #include <olp/core/generated/parser/JsonParser.h>
 // clang-format on
 
@@ -96,7 +96,7 @@ QueryApi::PartitionsResponse QueryApi::GetPartitionsbyId(
   OLP_SDK_LOG_TRACE_F(kLogTag, "GetPartitionsbyId, uri=%s, status=%d",
                       metadata_uri.c_str(), response.status);
 
-  return olp::parser::parse<model::Partitions>(response.response);
+  return olp::parser::parse_sax<model::Partitions>(response.response);
 }
 
 olp::client::HttpResponse QueryApi::QuadTreeIndex(
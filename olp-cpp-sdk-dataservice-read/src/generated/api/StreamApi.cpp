@@ -27,7 +27,7 @@
 #include <olp/core/logging/Log.h>
 #include <olp/dataservice/read/model/Data.h>
 // clang-format off
-#include "generated/parser/MessagesParser.h"
+#include "generated/parser/SaxParser.h"
 #include "generated/parser/StreamOffsetParser.h"
 #include "generated/parser/SubscribeResponseParser.h"
 #include <olp/core/generated/parser/JsonParser.h>
@@ -137,7 +137,7 @@ StreamApi::ConsumeDataApiResponse StreamApi::ConsumeData(
                       metadata_uri.c_str(), http_response.status);
 
   HandleCorrelationId(http_response.headers, x_correlation_id);
-  return parser::parse<model::Messages>(http_response.response);
+  return parser::parse_sax<model::Messages>(http_response.response);
 }
 
 StreamApi::CommitOffsetsApiResponse StreamApi::CommitOffsets(
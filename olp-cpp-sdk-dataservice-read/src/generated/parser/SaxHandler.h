@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/reader.h>
+
+namespace olp {
+namespace parser {
+
+/*
+ * A base for the handlers of `rapidjson::Reader` that decode a JSON document
+ * straight into the models, without building a DOM.
+ *
+ * Tracks the nesting level of the current container and the key of the
+ * current value, and passes all the integers that fit into `int64_t` to
+ * `OnInteger`. Values of other types are ignored, the same way the DOM
+ * parsers skip the members of the unexpected type.
+ *
+ * The derived handler hides the `On*` hooks it is interested in. The level of
+ * the root container is 1, and `Level()` returns the level of the container
+ * that is started or ended, or which the value belongs to.
+ */
+template <typename Handler>
+class SaxHandler
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Handler> {
+ public:
+  bool Default() {
+    key_.clear();
+    return true;
+  }
+
+  bool Int(int value) { return Integer(value); }
+  bool Uint(unsigned value) { return Integer(value); }
+  bool Int64(int64_t value) { return Integer(value); }
+  bool Uint64(uint64_t value) {
+    if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+      return Default();
+    }
+    return Integer(static_cast<int64_t>(value));
+  }
+
+  bool String(const char* str, rapidjson::SizeType length, bool) {
+    const bool result = Self().OnString(str, length);
+    key_.clear();
+    return result;
+  }
+
+  bool Key(const char* str, rapidjson::SizeType length, bool) {
+    key_.assign(str, length);
+    return true;
+  }
+
+  bool StartObject() {
+    ++level_;
+    const bool result = Self().OnStartObject();
+    key_.clear();
+    return result;
+  }
+
+  bool EndObject(rapidjson::SizeType) {
+    const bool result = Self().OnEndObject();
+    --level_;
+    return result;
+  }
+
+  bool StartArray() {
+    ++level_;
+    const bool result = Self().OnStartArray();
+    key_.clear();
+    return result;
+  }
+
+  bool EndArray(rapidjson::SizeType) {
+    const bool result = Self().OnEndArray();
+    --level_;
+    return result;
+  }
+
+  bool OnString(const char*, rapidjson::SizeType) { return true; }
+  bool OnInteger(int64_t) { return true; }
+  bool OnStartObject() { return true; }
+  bool OnEndObject() { return true; }
+  bool OnStartArray() { return true; }
+  bool OnEndArray() { return true; }
+
+ protected:
+  int Level() const { return level_; }
+
+  bool IsKey(const char* key) const { return key_ == key; }
+
+ private:
+  Handler& Self() { return static_cast<Handler&>(*this); }
+
+  bool Integer(int64_t value) {
+    const bool result = Self().OnInteger(value);
+    key_.clear();
+    return result;
+  }
+
+  int level_{0};
+  std::string key_;
+};
+
+/// The size of the chunks in which `parse_stream` reads the stream.
+constexpr size_t kParseChunkSize = 64u * 1024u;
+
+/*
+ * Parses the JSON stream with the SAX `handler`.
+ *
+ * The stream is read in chunks, so the document is neither copied into one
+ * buffer nor read char by char.
+ *
+ * @return True if the document is valid; false otherwise.
+ */
+template <typename Handler>
+bool parse_stream(std::stringstream& json_stream, Handler& handler) {
+  std::vector<char> chunk(kParseChunkSize);
+  rapidjson::IStreamWrapper stream(json_stream, chunk.data(), chunk.size());
+  rapidjson::Reader reader;
+  return !reader.Parse(stream, handler).IsError();
+}
+
+}  // namespace parser
+}  // namespace olp
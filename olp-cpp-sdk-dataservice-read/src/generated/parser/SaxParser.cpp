@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include "SaxParser.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SaxHandler.h"
+
+namespace olp {
+namespace parser {
+namespace {
+using namespace olp::dataservice::read;
+
+// Levels of the `{"partitions": [{...}]}` document.
+constexpr int kPartitionsLevel = 2;
+constexpr int kPartitionLevel = 3;
+
+// Collects the partitions, or passes them to the page callback every
+// `page_size` partitions when one is set.
+class PartitionsHandler : public SaxHandler<PartitionsHandler> {
+ public:
+  explicit PartitionsHandler(
+      std::vector<model::Partition>& partitions, size_t page_size = 0u,
+      const PartitionsPageCallback* page_callback = nullptr)
+      : partitions_(partitions),
+        page_size_(page_size),
+        page_callback_(page_callback) {}
+
+  bool OnStartArray() {
+    if (Level() == kPartitionsLevel && IsKey("partitions")) {
+      in_partitions_ = true;
+    }
+    return true;
+  }
+
+  bool OnEndArray() {
+    if (Level() != kPartitionsLevel || !in_partitions_) {
+      return true;
+    }
+
+    in_partitions_ = false;
+    return partitions_.empty() || FlushPage();
+  }
+
+  bool OnEndObject() {
+    if (page_callback_ && in_partitions_ && Level() == kPartitionLevel &&
+        partitions_.size() >= page_size_) {
+      return FlushPage();
+    }
+    return true;
+  }
+
+  bool OnStartObject() {
+    if (in_partitions_ && Level() == kPartitionLevel) {
+      partitions_.emplace_back();
+    }
+    return true;
+  }
+
+  bool OnString(const char* str, rapidjson::SizeType length) {
+    if (!in_partitions_ || Level() != kPartitionLevel) {
+      return true;
+    }
+
+    auto& partition = partitions_.back();
+    if (IsKey("partition")) {
+      partition.GetMutablePartition().assign(str, length);
+    } else if (IsKey("dataHandle")) {
+      partition.GetMutableDataHandle().assign(str, length);
+    } else if (IsKey("checksum")) {
+      partition.GetMutableChecksum() = std::string(str, length);
+    } else if (IsKey("crc")) {
+      partition.GetMutableCrc() = std::string(str, length);
+    }
+    return true;
+  }
+
+  bool OnInteger(int64_t value) {
+    if (!in_partitions_ || Level() != kPartitionLevel) {
+      return true;
+    }
+
+    auto& partition = partitions_.back();
+    if (IsKey("version")) {
+      partition.GetMutableVersion() = value;
+    } else if (IsKey("dataSize")) {
+      partition.GetMutableDataSize() = value;
+    } else if (IsKey("compressedDataSize")) {
+      partition.GetMutableCompressedDataSize() = value;
+    }
+    return true;
+  }
+
+ private:
+  bool FlushPage() {
+    if (!page_callback_) {
+      return true;
+    }
+
+    model::Partitions page;
+    page.GetMutablePartitions().swap(partitions_);
+    partitions_.reserve(page_size_);
+    return (*page_callback_)(std::move(page));
+  }
+
+  std::vector<model::Partition>& partitions_;
+  size_t page_size_;
+  const PartitionsPageCallback* page_callback_;
+  bool in_partitions_{false};
+};
+
+// Levels of the `{"messages": [{"metaData": {...}, "offset": {...}}]}`
+// document.
+constexpr int kMessagesLevel = 2;
+constexpr int kMessageLevel = 3;
+constexpr int kMessageMemberLevel = 4;
+
+class MessagesHandler : public SaxHandler<MessagesHandler> {
+ public:
+  explicit MessagesHandler(std::vector<model::Message>& messages)
+      : messages_(messages) {}
+
+  bool OnStartArray() {
+    if (Level() == kMessagesLevel && IsKey("messages")) {
+      in_messages_ = true;
+    }
+    return true;
+  }
+
+  bool OnEndArray() {
+    if (Level() == kMessagesLevel) {
+      in_messages_ = false;
+    }
+    return true;
+  }
+
+  bool OnStartObject() {
+    if (!in_messages_) {
+      return true;
+    }
+
+    if (Level() == kMessageLevel) {
+      metadata_ = model::Metadata();
+      offset_ = model::StreamOffset();
+    } else if (Level() == kMessageMemberLevel) {
+      member_ = IsKey("metaData")
+                    ? Member::kMetadata
+                    : IsKey("offset") ? Member::kOffset : Member::kNone;
+    }
+    return true;
+  }
+
+  bool OnEndObject() {
+    if (!in_messages_) {
+      return true;
+    }
+
+    if (Level() == kMessageLevel) {
+      model::Message message;
+      message.SetMetaData(std::move(metadata_));
+      message.SetOffset(std::move(offset_));
+      messages_.push_back(std::move(message));
+    } else if (Level() == kMessageMemberLevel) {
+      member_ = Member::kNone;
+    }
+    return true;
+  }
+
+  bool OnString(const char* str, rapidjson::SizeType length) {
+    if (!in_messages_ || Level() != kMessageMemberLevel ||
+        member_ != Member::kMetadata) {
+      return true;
+    }
+
+    if (IsKey("partition")) {
+      metadata_.SetPartition(std::string(str, length));
+    } else if (IsKey("data")) {
+      metadata_.SetData(
+          std::make_shared<std::vector<unsigned char>>(str, str + length));
+    } else if (IsKey("dataHandle")) {
+      metadata_.SetDataHandle(std::string(str, length));
+    } else if (IsKey("checksum")) {
+      metadata_.SetChecksum(std::string(str, length));
+    }
+    return true;
+  }
+
+  bool OnInteger(int64_t value) {
+    if (!in_messages_ || Level() != kMessageMemberLevel) {
+      return true;
+    }
+
+    if (member_ == Member::kMetadata) {
+      if (IsKey("dataSize")) {
+        metadata_.SetDataSize(value);
+      } else if (IsKey("compressedDataSize")) {
+        metadata_.SetCompressedDataSize(value);
+      } else if (IsKey("timestamp")) {
+        metadata_.SetTimestamp(value);
+      }
+    } else if (member_ == Member::kOffset) {
+      if (IsKey("offset")) {
+        offset_.SetOffset(value);
+      } else if (IsKey("partition") &&
+                 value >= std::numeric_limits<int32_t>::min() &&
+                 value <= std::numeric_limits<int32_t>::max()) {
+        offset_.SetPartition(static_cast<int32_t>(value));
+      }
+    }
+    return true;
+  }
+
+ private:
+  enum class Member { kNone, kMetadata, kOffset };
+
+  std::vector<model::Message>& messages_;
+  bool in_messages_{false};
+  Member member_{Member::kNone};
+  model::Metadata metadata_;
+  model::StreamOffset offset_;
+};
+
+}  // namespace
+
+template <>
+model::Partitions parse_sax(std::stringstream& json_stream) {
+  std::vector<model::Partition> partitions;
+  PartitionsHandler handler(partitions);
+
+  model::Partitions result;
+  if (parse_stream(json_stream, handler)) {
+    result.GetMutablePartitions().swap(partitions);
+  }
+  return result;
+}
+
+bool parse_sax_pages(std::stringstream& json_stream, size_t page_size,
+                     const PartitionsPageCallback& page_callback) {
+  std::vector<model::Partition> partitions;
+  partitions.reserve(page_size);
+  PartitionsHandler handler(partitions, page_size, &page_callback);
+  return parse_stream(json_stream, handler);
+}
+
+template <>
+model::Messages parse_sax(std::stringstream& json_stream) {
+  std::vector<model::Message> messages;
+  MessagesHandler handler(messages);
+
+  model::Messages result;
+  if (parse_stream(json_stream, handler)) {
+    result.SetMessages(std::move(messages));
+  }
+  return result;
+}
+
+}  // namespace parser
+}  // namespace olp
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <sstream>
+
+#include <olp/dataservice/read/model/Messages.h>
+#include <olp/dataservice/read/model/Partitions.h>
+
+namespace olp {
+namespace parser {
+
+/*
+ * Parses the JSON stream with `rapidjson::Reader` and decodes the values
+ * straight into the model, without the intermediate DOM.
+ *
+ * Produces the same result as `parse<T>`: the members of the unexpected type
+ * are skipped, and an empty model is returned when the JSON is malformed.
+ * Only the models that can be large are supported.
+ */
+template <typename T>
+T parse_sax(std::stringstream& json_stream);
+
+template <>
+dataservice::read::model::Partitions parse_sax(
+    std::stringstream& json_stream);
+
+template <>
+dataservice::read::model::Messages parse_sax(std::stringstream& json_stream);
+
+/// Consumes a page of partitions, returns false to stop the parsing.
+using PartitionsPageCallback =
+    std::function<bool(dataservice::read::model::Partitions)>;
+
+/*
+ * Parses the partitions response with `rapidjson::Reader` and passes the
+ * partitions to `page_callback` in pages of up to `page_size` partitions, so
+ * only one page of models is held in memory.
+ *
+ * @return False if the JSON is malformed, or if the callback stopped the
+ * parsing; true otherwise.
+ */
+bool parse_sax_pages(std::stringstream& json_stream, size_t page_size,
+                     const PartitionsPageCallback& page_callback);
+
+}  // namespace parser
+}  // namespace olp
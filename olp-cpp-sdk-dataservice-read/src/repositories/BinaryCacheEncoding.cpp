@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include "BinaryCacheEncoding.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace {
+namespace model = olp::dataservice::read::model;
+
+// Can not be the first byte of a JSON document.
+constexpr unsigned char kMarker = 0xB1;
+constexpr unsigned char kFormatVersion = 1;
+constexpr size_t kHeaderSize = 3;
+
+enum class ModelType : unsigned char {
+  kPartition = 1,
+  kPartitionIds = 2,
+  kLayerVersions = 3
+};
+
+// Optional fields of the partition.
+constexpr std::uint64_t kChecksum = 1u << 0;
+constexpr std::uint64_t kCompressedDataSize = 1u << 1;
+constexpr std::uint64_t kDataSize = 1u << 2;
+constexpr std::uint64_t kCrc = 1u << 3;
+constexpr std::uint64_t kVersion = 1u << 4;
+
+class Writer {
+ public:
+  explicit Writer(ModelType type, size_t reserve = 0u) {
+    buffer_.reserve(kHeaderSize + reserve);
+    buffer_.push_back(static_cast<char>(kMarker));
+    buffer_.push_back(static_cast<char>(kFormatVersion));
+    buffer_.push_back(static_cast<char>(type));
+  }
+
+  void WriteVarint(std::uint64_t value) {
+    while (value >= 0x80u) {
+      buffer_.push_back(static_cast<char>((value & 0x7Fu) | 0x80u));
+      value >>= 7;
+    }
+    buffer_.push_back(static_cast<char>(value));
+  }
+
+  void WriteInt(std::int64_t value) {
+    // Zigzag, so that small negative values are short too.
+    WriteVarint((static_cast<std::uint64_t>(value) << 1) ^
+                static_cast<std::uint64_t>(value >> 63));
+  }
+
+  void WriteString(const std::string& value) {
+    WriteVarint(value.size());
+    buffer_.append(value);
+  }
+
+  std::string Release() { return std::move(buffer_); }
+
+ private:
+  std::string buffer_;
+};
+
+class Reader {
+ public:
+  explicit Reader(const std::string& value)
+      : it_(value.data()), end_(value.data() + value.size()) {}
+
+  bool ReadHeader(ModelType type) {
+    if (end_ - it_ < static_cast<std::ptrdiff_t>(kHeaderSize) ||
+        static_cast<unsigned char>(it_[0]) != kMarker ||
+        static_cast<unsigned char>(it_[1]) != kFormatVersion ||
+        static_cast<ModelType>(it_[2]) != type) {
+      return false;
+    }
+    it_ += kHeaderSize;
+    return true;
+  }
+
+  bool ReadVarint(std::uint64_t& value) {
+    value = 0u;
+    for (unsigned shift = 0u; shift < 64u && it_ != end_; shift += 7u) {
+      const auto byte = static_cast<unsigned char>(*it_++);
+      value |= static_cast<std::uint64_t>(byte & 0x7Fu) << shift;
+      if ((byte & 0x80u) == 0u) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadInt(std::int64_t& value) {
+    std::uint64_t encoded = 0u;
+    if (!ReadVarint(encoded)) {
+      return false;
+    }
+    value = static_cast<std::int64_t>((encoded >> 1) ^ (~(encoded & 1u) + 1u));
+    return true;
+  }
+
+  bool ReadString(std::string& value) {
+    std::uint64_t size = 0u;
+    if (!ReadVarint(size) || size > static_cast<std::uint64_t>(end_ - it_)) {
+      return false;
+    }
+    value.assign(it_, static_cast<size_t>(size));
+    it_ += size;
+    return true;
+  }
+
+  bool ReadOptionalString(std::uint64_t fields, std::uint64_t field,
+                          boost::optional<std::string>& value) {
+    if ((fields & field) == 0u) {
+      value = boost::none;
+      return true;
+    }
+    value = std::string();
+    return ReadString(*value);
+  }
+
+  bool ReadOptionalInt(std::uint64_t fields, std::uint64_t field,
+                       boost::optional<std::int64_t>& value) {
+    if ((fields & field) == 0u) {
+      value = boost::none;
+      return true;
+    }
+    value = std::int64_t(0);
+    return ReadInt(*value);
+  }
+
+  /// Checks that the whole value is read.
+  bool IsEnd() const { return it_ == end_; }
+
+  size_t Remaining() const { return static_cast<size_t>(end_ - it_); }
+
+ private:
+  const char* it_;
+  const char* end_;
+};
+
+}  // namespace
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+namespace binary {
+
+bool IsEncoded(const std::string& value) {
+  return !value.empty() && static_cast<unsigned char>(value[0]) == kMarker;
+}
+
+std::string Encode(const model::Partition& partition) {
+  const auto& checksum = partition.GetChecksum();
+  const auto& compressed_data_size = partition.GetCompressedDataSize();
+  const auto& data_size = partition.GetDataSize();
+  const auto& crc = partition.GetCrc();
+  const auto& version = partition.GetVersion();
+
+  std::uint64_t fields = 0u;
+  fields |= checksum ? kChecksum : 0u;
+  fields |= compressed_data_size ? kCompressedDataSize : 0u;
+  fields |= data_size ? kDataSize : 0u;
+  fields |= crc ? kCrc : 0u;
+  fields |= version ? kVersion : 0u;
+
+  Writer writer(ModelType::kPartition, partition.GetPartition().size() +
+                                           partition.GetDataHandle().size() +
+                                           16u);
+  writer.WriteVarint(fields);
+  writer.WriteString(partition.GetPartition());
+  writer.WriteString(partition.GetDataHandle());
+  if (checksum) {
+    writer.WriteString(*checksum);
+  }
+  if (compressed_data_size) {
+    writer.WriteInt(*compressed_data_size);
+  }
+  if (data_size) {
+    writer.WriteInt(*data_size);
+  }
+  if (crc) {
+    writer.WriteString(*crc);
+  }
+  if (version) {
+    writer.WriteInt(*version);
+  }
+  return writer.Release();
+}
+
+std::string Encode(const std::vector<std::string>& partition_ids) {
+  size_t size = 0u;
+  for (const auto& partition_id : partition_ids) {
+    size += partition_id.size() + 1u;
+  }
+
+  Writer writer(ModelType::kPartitionIds, size + 8u);
+  writer.WriteVarint(partition_ids.size());
+  for (const auto& partition_id : partition_ids) {
+    writer.WriteString(partition_id);
+  }
+  return writer.Release();
+}
+
+std::string Encode(const model::LayerVersions& layer_versions) {
+  const auto& versions = layer_versions.GetLayerVersions();
+
+  Writer writer(ModelType::kLayerVersions);
+  writer.WriteInt(layer_versions.GetVersion());
+  writer.WriteVarint(versions.size());
+  for (const auto& layer_version : versions) {
+    writer.WriteString(layer_version.GetLayer());
+    writer.WriteInt(layer_version.GetVersion());
+    writer.WriteInt(layer_version.GetTimestamp());
+  }
+  return writer.Release();
+}
+
+bool Decode(const std::string& value, model::Partition& partition) {
+  Reader reader(value);
+  std::uint64_t fields = 0u;
+  if (!reader.ReadHeader(ModelType::kPartition) || !reader.ReadVarint(fields) ||
+      !reader.ReadString(partition.GetMutablePartition()) ||
+      !reader.ReadString(partition.GetMutableDataHandle())) {
+    return false;
+  }
+
+  return reader.ReadOptionalString(fields, kChecksum,
+                                   partition.GetMutableChecksum()) &&
+         reader.ReadOptionalInt(fields, kCompressedDataSize,
+                                partition.GetMutableCompressedDataSize()) &&
+         reader.ReadOptionalInt(fields, kDataSize,
+                                partition.GetMutableDataSize()) &&
+         reader.ReadOptionalString(fields, kCrc, partition.GetMutableCrc()) &&
+         reader.ReadOptionalInt(fields, kVersion,
+                                partition.GetMutableVersion()) &&
+         reader.IsEnd();
+}
+
+bool Decode(const std::string& value, std::vector<std::string>& partition_ids) {
+  Reader reader(value);
+  std::uint64_t count = 0u;
+  // Every ID takes at least one byte, a larger count is corrupted.
+  if (!reader.ReadHeader(ModelType::kPartitionIds) ||
+      !reader.ReadVarint(count) || count > reader.Remaining()) {
+    return false;
+  }
+
+  partition_ids.clear();
+  partition_ids.resize(static_cast<size_t>(count));
+  for (auto& partition_id : partition_ids) {
+    if (!reader.ReadString(partition_id)) {
+      return false;
+    }
+  }
+  return reader.IsEnd();
+}
+
+bool Decode(const std::string& value, model::LayerVersions& layer_versions) {
+  Reader reader(value);
+  std::uint64_t count = 0u;
+  if (!reader.ReadHeader(ModelType::kLayerVersions) ||
+      !reader.ReadInt(layer_versions.GetMutableVersion()) ||
+      !reader.ReadVarint(count) || count > reader.Remaining()) {
+    return false;
+  }
+
+  auto& versions = layer_versions.GetMutableLayerVersions();
+  versions.clear();
+  versions.resize(static_cast<size_t>(count));
+  for (auto& layer_version : versions) {
+    if (!reader.ReadString(layer_version.GetMutableLayer()) ||
+        !reader.ReadInt(layer_version.GetMutableVersion()) ||
+        !reader.ReadInt(layer_version.GetMutableTimestamp())) {
+      return false;
+    }
+  }
+  return reader.IsEnd();
+}
+
+}  // namespace binary
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <olp/dataservice/read/model/Partitions.h>
+#include "generated/model/LayerVersions.h"
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+namespace binary {
+
+/*
+ * A compact binary encoding of the metadata models stored in the cache.
+ *
+ * Every value starts with a header: a marker byte that can not start a JSON
+ * document, the format version, and the model type. Integers are stored as
+ * zigzag varints, strings are prefixed with their varint length, and the
+ * optional fields are flagged in a bit mask.
+ *
+ * The decoders read the values directly, without building a DOM, and reject
+ * the values with an unexpected header or a truncated payload.
+ */
+
+/// Checks whether the value has the binary encoding header.
+bool IsEncoded(const std::string& value);
+
+std::string Encode(const model::Partition& partition);
+std::string Encode(const std::vector<std::string>& partition_ids);
+std::string Encode(const model::LayerVersions& layer_versions);
+
+bool Decode(const std::string& value, model::Partition& partition);
+bool Decode(const std::string& value, std::vector<std::string>& partition_ids);
+bool Decode(const std::string& value, model::LayerVersions& layer_versions);
+
+}  // namespace binary
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
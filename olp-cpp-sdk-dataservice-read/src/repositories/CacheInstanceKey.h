@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace olp {
+namespace cache {
+class KeyValueCache;
+}
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/*
+ * @brief Identifies a key of a cache instance in the in-memory indexes.
+ *
+ * The cache instance is held weakly. While the key exists, the weak reference
+ * keeps the identity of the instance, so the keys of a destroyed cache are
+ * never mixed up with the keys of a new one.
+ */
+using CacheInstanceKey =
+    std::pair<std::weak_ptr<cache::KeyValueCache>, std::string>;
+
+/// Orders the `CacheInstanceKey` keys by the cache instance, then by the key.
+struct CacheInstanceKeyLess {
+  bool operator()(const CacheInstanceKey& lhs,
+                  const CacheInstanceKey& rhs) const {
+    if (lhs.first.owner_before(rhs.first)) {
+      return true;
+    }
+    if (rhs.first.owner_before(lhs.first)) {
+      return false;
+    }
+    return lhs.second < rhs.second;
+  }
+};
+
+/// Checks whether the key belongs to the cache instance.
+inline bool IsSameCache(const CacheInstanceKey& key,
+                        const std::shared_ptr<cache::KeyValueCache>& cache) {
+  return !key.first.owner_before(cache) && !cache.owner_before(key.first);
+}
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -26,6 +26,7 @@
 
 #include <olp/core/client/Condition.h>
 #include <olp/core/logging/Log.h>
+#include <olp/core/utils/Compression.h>
 #include "ApiClientLookup.h"
 #include "CatalogRepository.h"
 #include "DataCacheRepository.h"
@@ -54,6 +55,62 @@ namespace {
 constexpr auto kLogTag = "DataRepository";
 constexpr auto kBlobService = "blob";
 constexpr auto kVolatileBlobService = "volatile-blob";
+
+// Decompresses the data of gzip layers that is still compressed, the network
+// decodes it only if the response has the matching content encoding. The
+// layer is checked in the catalog configuration, so the data of other layers
+// that only starts like gzip is not changed.
+DataResponse DecompressData(DataResponse response, const client::HRN& catalog,
+                            const std::string& layer,
+                            const DataRequest& data_request,
+                            client::CancellationContext context,
+                            const client::OlpClientSettings& settings) {
+  using utils::Compression;
+  constexpr auto kGzip = utils::ContentEncoding::kGzip;
+
+  if (!data_request.GetDecompression() || !response.IsSuccessful() ||
+      !response.GetResult() ||
+      !Compression::IsCompressed(kGzip, *response.GetResult())) {
+    return response;
+  }
+
+  const auto fetch_option = data_request.GetFetchOption() == CacheOnly
+                                ? CacheOnly
+                                : OnlineIfNotFound;
+  auto catalog_response =
+      CatalogRepository(catalog, settings)
+          .GetCatalog(CatalogRequest()
+                          .WithBillingTag(data_request.GetBillingTag())
+                          .WithFetchOption(fetch_option),
+                      context);
+  if (!catalog_response.IsSuccessful()) {
+    return catalog_response.GetError();
+  }
+
+  const auto& layers = catalog_response.GetResult().GetLayers();
+  auto layer_it = std::find_if(
+      layers.begin(), layers.end(),
+      [&](const model::Layer& item) { return item.GetId() == layer; });
+  if (layer_it == layers.end() || layer_it->GetContentEncoding() != "gzip") {
+    return response;
+  }
+
+  utils::CompressionStatistics statistics;
+  auto data = Compression::Decompress(kGzip, *response.GetResult(),
+                                      &statistics);
+  if (!data) {
+    return {{client::ErrorCode::Unknown, "Unable to decompress the data"}};
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag,
+                      "Decompressed data, size=%llu B, ratio=%.2f, "
+                      "time=%lld us",
+                      static_cast<unsigned long long>(
+                          statistics.uncompressed_size),
+                      statistics.GetRatio(),
+                      static_cast<long long>(statistics.duration.count()));
+  return model::Data(std::move(data));
+}
 }  // namespace
 
 DataResponse DataRepository::GetVersionedTile(
@@ -152,7 +209,8 @@ DataResponse DataRepository::GetBlobData(
       OLP_SDK_LOG_DEBUG_F(
           kLogTag, "GetBlobData found in cache, hrn='%s', key='%s'",
           catalog.ToCatalogHRNString().c_str(), data_handle->c_str());
-      return cached_data.value();
+      return DecompressData(cached_data.value(), catalog, layer, data_request,
+                            cancellation_context, settings);
     } else if (fetch_option == CacheOnly) {
       OLP_SDK_LOG_INFO_F(
           kLogTag, "GetBlobData not found in cache, hrn='%s', key='%s'",
@@ -196,7 +254,8 @@ DataResponse DataRepository::GetBlobData(
     }
   }
 
-  return blob_response;
+  return DecompressData(std::move(blob_response), catalog, layer, data_request,
+                        cancellation_context, settings);
 }
 
 DataResponse DataRepository::GetVolatileData(
@@ -19,6 +19,8 @@
 
 #include "NamedMutex.h"
 
+#include <array>
+#include <functional>
 #include <unordered_map>
 
 namespace olp {
@@ -28,27 +30,40 @@ namespace repository {
 
 namespace {
 
-static std::mutex gMutex;
-
 struct RefCounterMutex {
   std::mutex mutex;
   uint32_t use_count{0};
 };
 
-static std::unordered_map<std::string, RefCounterMutex> gMutexes;
+// Named mutexes are distributed over several shards, so that the unrelated
+// resources do not contend for the same lock.
+struct MutexesShard {
+  std::mutex mutex;
+  std::unordered_map<std::string, RefCounterMutex> mutexes;
+};
+
+constexpr size_t kShardsCount = 16u;
+
+static std::array<MutexesShard, kShardsCount> gShards;
+
+MutexesShard& GetShard(const std::string& resource) {
+  return gShards[std::hash<std::string>()(resource) % kShardsCount];
+}
 
 std::mutex& AquireLock(const std::string& resource) {
-  std::unique_lock<std::mutex> lock(gMutex);
-  RefCounterMutex& ref_mutex = gMutexes[resource];
+  MutexesShard& shard = GetShard(resource);
+  std::unique_lock<std::mutex> lock(shard.mutex);
+  RefCounterMutex& ref_mutex = shard.mutexes[resource];
   ref_mutex.use_count++;
   return ref_mutex.mutex;
 }
 
 void ReleaseLock(const std::string& resource) {
-  std::unique_lock<std::mutex> lock(gMutex);
-  RefCounterMutex& ref_mutex = gMutexes[resource];
+  MutexesShard& shard = GetShard(resource);
+  std::unique_lock<std::mutex> lock(shard.mutex);
+  RefCounterMutex& ref_mutex = shard.mutexes[resource];
   if (--ref_mutex.use_count == 0) {
-    gMutexes.erase(resource);
+    shard.mutexes.erase(resource);
   }
 }
 
@@ -19,6 +19,9 @@
 
 #include "PartitionsCacheRepository.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
 #include <limits>
 #include <string>
 #include <utility>
@@ -26,14 +29,13 @@
 
 #include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/logging/Log.h>
+#include "BinaryCacheEncoding.h"
+#include "QuadTreeIndexCache.h"
+#include "QuadTreeRootIndex.h"
 // clang-format off
 #include "generated/parser/PartitionsParser.h"
 #include "generated/parser/LayerVersionsParser.h"
 #include <olp/core/generated/parser/JsonParser.h>
-#include <olp/core/generated/serializer/SerializerWrapper.h>
-#include "generated/serializer/PartitionsSerializer.h"
-#include "generated/serializer/LayerVersionsSerializer.h"
-#include "generated/serializer/JsonSerializer.h"
 // clang-format on
 
 // Needed to avoid endless warnings from GetVersion/WithVersion
@@ -57,10 +59,40 @@ std::string CreateKey(const std::string& hrn, const std::string& layer_id,
   return hrn + "::" + layer_id +
          "::" + (version ? std::to_string(*version) + "::" : "") + "partitions";
 }
+// The partition ids of the streamed layers are stored in pages.
+std::string CreatePageKey(const std::string& ids_key, size_t page_index) {
+  return ids_key + "::" + std::to_string(page_index);
+}
+std::string CreatePageCountKey(const std::string& ids_key) {
+  return ids_key + "::pages";
+}
+std::string CreateQuadTreeLayerKey(const std::string& hrn,
+                                   const std::string& layer_id,
+                                   const boost::optional<int64_t>& version) {
+  return hrn + "::" + layer_id + "::" +
+         (version ? std::to_string(*version) + "::" : "");
+}
 std::string CreateKey(const std::string& hrn, const int64_t catalogVersion) {
   return hrn + "::" + std::to_string(catalogVersion) + "::layerVersions";
 }
 
+// Decodes the cached metadata. The entries stored by the previous versions
+// of the SDK are JSON.
+template <typename T>
+boost::any Decode(const std::string& value) {
+  namespace binary = olp::dataservice::read::repository::binary;
+  if (!binary::IsEncoded(value)) {
+    return olp::parser::parse<T>(value);
+  }
+
+  T result;
+  if (!binary::Decode(value, result)) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Failed to decode the cached value");
+    return boost::any();
+  }
+  return result;
+}
+
 time_t ConvertTime(std::chrono::seconds time) {
   return time == kChronoSecondsMax ? kTimetMax : time.count();
 }
@@ -90,7 +122,7 @@ void PartitionsCacheRepository::Put(const model::Partitions& partitions,
     OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
 
     cache_->Put(
-        key, partition, [&]() { return olp::serializer::serialize(partition); },
+        key, partition, [&]() { return binary::Encode(partition); },
         expiry.get_value_or(default_expiry_));
 
     if (layer_metadata) {
@@ -99,14 +131,119 @@ void PartitionsCacheRepository::Put(const model::Partitions& partitions,
   }
 
   if (layer_metadata) {
-    auto key = CreateKey(hrn, layer_id, version);
-    OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
+    PutPartitionIds(partition_ids, layer_id, version, expiry);
+  }
+}
 
-    cache_->Put(
-        key, partition_ids,
-        [&]() { return olp::serializer::serialize(partition_ids); },
-        expiry.get_value_or(default_expiry_));
+void PartitionsCacheRepository::PutPartitionIds(
+    const std::vector<std::string>& partition_ids, const std::string& layer_id,
+    const boost::optional<int64_t>& version,
+    const boost::optional<time_t>& expiry) {
+  const auto key = CreateKey(hrn_.ToCatalogHRNString(), layer_id, version);
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
+
+  // The complete list replaces the pages stored by a stream.
+  cache_->Remove(CreatePageCountKey(key));
+  cache_->Put(
+      key, partition_ids, [&]() { return binary::Encode(partition_ids); },
+      expiry.get_value_or(default_expiry_));
+}
+
+boost::optional<std::vector<std::string>>
+PartitionsCacheRepository::GetPartitionIds(
+    const std::string& layer_id, const boost::optional<int64_t>& version) {
+  auto key = CreateKey(hrn_.ToCatalogHRNString(), layer_id, version);
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Get '%s'", key.c_str());
+
+  auto cached_ids = cache_->Get(key, Decode<std::vector<std::string>>);
+  if (!cached_ids.empty()) {
+    return boost::any_cast<std::vector<std::string>>(cached_ids);
+  }
+
+  // The streamed layers keep the ids in pages.
+  const auto page_count = GetPartitionIdsPageCount(layer_id, version);
+  if (!page_count) {
+    return boost::none;
+  }
+
+  std::vector<std::string> partition_ids;
+  for (size_t page_index = 0u; page_index < *page_count; ++page_index) {
+    auto page = GetPartitionIdsPage(page_index, layer_id, version);
+    if (!page) {
+      return boost::none;
+    }
+    partition_ids.insert(partition_ids.end(),
+                         std::make_move_iterator(page->begin()),
+                         std::make_move_iterator(page->end()));
+  }
+  return partition_ids;
+}
+
+void PartitionsCacheRepository::PutPartitionIdsPage(
+    const model::Partitions& page, size_t page_index,
+    const std::string& layer_id, const boost::optional<int64_t>& version,
+    const boost::optional<time_t>& expiry) {
+  std::vector<std::string> partition_ids;
+  partition_ids.reserve(page.GetPartitions().size());
+  for (const auto& partition : page.GetPartitions()) {
+    partition_ids.push_back(partition.GetPartition());
   }
+
+  const auto key = CreatePageKey(
+      CreateKey(hrn_.ToCatalogHRNString(), layer_id, version), page_index);
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
+
+  cache_->Put(
+      key, partition_ids, [&]() { return binary::Encode(partition_ids); },
+      expiry.get_value_or(default_expiry_));
+}
+
+void PartitionsCacheRepository::PutPartitionIdsPageCount(
+    size_t page_count, const std::string& layer_id,
+    const boost::optional<int64_t>& version,
+    const boost::optional<time_t>& expiry) {
+  const auto ids_key = CreateKey(hrn_.ToCatalogHRNString(), layer_id, version);
+  const auto key = CreatePageCountKey(ids_key);
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
+
+  // The pages replace the complete list stored before.
+  cache_->Remove(ids_key);
+  const auto value = std::to_string(page_count);
+  cache_->Put(
+      key, value, [&]() { return value; },
+      expiry.get_value_or(default_expiry_));
+}
+
+boost::optional<size_t> PartitionsCacheRepository::GetPartitionIdsPageCount(
+    const std::string& layer_id, const boost::optional<int64_t>& version) {
+  const auto key = CreatePageCountKey(
+      CreateKey(hrn_.ToCatalogHRNString(), layer_id, version));
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Get '%s'", key.c_str());
+
+  auto value =
+      cache_->Get(key, [](const std::string& value) { return value; });
+  if (value.empty()) {
+    return boost::none;
+  }
+
+  return static_cast<size_t>(std::strtoull(
+      boost::any_cast<std::string>(value).c_str(), nullptr, 10));
+}
+
+boost::optional<std::vector<std::string>>
+PartitionsCacheRepository::GetPartitionIdsPage(
+    size_t page_index, const std::string& layer_id,
+    const boost::optional<int64_t>& version) {
+  const auto key = CreatePageKey(
+      CreateKey(hrn_.ToCatalogHRNString(), layer_id, version), page_index);
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Get '%s'", key.c_str());
+
+  auto cached_ids = cache_->Get(key, Decode<std::vector<std::string>>);
+  if (cached_ids.empty()) {
+    return boost::none;
+  }
+
+  return boost::any_cast<std::vector<std::string>>(cached_ids);
 }
 
 model::Partitions PartitionsCacheRepository::Get(
@@ -122,9 +259,7 @@ model::Partitions PartitionsCacheRepository::Get(
     OLP_SDK_LOG_DEBUG_F(kLogTag, "Get '%s'", key.c_str());
 
     auto cached_partition =
-        cache_->Get(key, [](const std::string& serialized_object) {
-          return parser::parse<model::Partition>(serialized_object);
-        });
+        cache_->Get(key, Decode<model::Partition>);
 
     if (!cached_partition.empty()) {
       cached_partitions.emplace_back(
@@ -139,23 +274,14 @@ model::Partitions PartitionsCacheRepository::Get(
 boost::optional<model::Partitions> PartitionsCacheRepository::Get(
     const PartitionsRequest& request, const std::string& layer_id,
     const boost::optional<int64_t>& version) {
-  std::string hrn(hrn_.ToCatalogHRNString());
-  auto key = CreateKey(hrn, layer_id, version);
   boost::optional<model::Partitions> partitions;
   const auto& partition_ids = request.GetPartitionIds();
 
   if (partition_ids.empty()) {
-    auto cached_ids = cache_->Get(key, [](const std::string& serialized_ids) {
-      return parser::parse<std::vector<std::string>>(serialized_ids);
-    });
-
-    partitions =
-        cached_ids.empty()
-            ? boost::none
-            : boost::optional<model::Partitions>(
-                  Get(boost::any_cast<std::vector<std::string>>(cached_ids),
-                      layer_id, version));
-
+    auto cached_ids = GetPartitionIds(layer_id, version);
+    if (cached_ids) {
+      partitions = Get(*cached_ids, layer_id, version);
+    }
   } else {
     auto available_partitions = Get(partition_ids, layer_id, version);
     // In the case when not all partitions are available, we fail the cache
@@ -178,7 +304,7 @@ void PartitionsCacheRepository::Put(
 
   cache_->Put(
       key, layer_versions,
-      [&]() { return olp::serializer::serialize(layer_versions); },
+      [&]() { return binary::Encode(layer_versions); },
       default_expiry_);
 }
 
@@ -189,9 +315,7 @@ boost::optional<model::LayerVersions> PartitionsCacheRepository::Get(
   OLP_SDK_LOG_DEBUG_F(kLogTag, "Get -> '%s'", key.c_str());
 
   auto cached_layer_versions =
-      cache_->Get(key, [](const std::string& serialized_object) {
-        return parser::parse<model::LayerVersions>(serialized_object);
-      });
+      cache_->Get(key, Decode<model::LayerVersions>);
 
   if (cached_layer_versions.empty()) {
     return boost::none;
@@ -213,7 +337,14 @@ void PartitionsCacheRepository::Put(const std::string& layer,
   }
 
   OLP_SDK_LOG_DEBUG_F(kLogTag, "Put -> '%s'", key.c_str());
-  cache_->Put(key, quad_tree.GetRawData(), default_expiry_);
+  if (cache_->Put(key, quad_tree.GetRawData(), default_expiry_)) {
+    QuadTreeIndexCache::Instance().Put(cache_, key, quad_tree,
+                                       default_expiry_);
+    QuadTreeRootIndex::Instance().Add(
+        cache_,
+        CreateQuadTreeLayerKey(hrn_.ToCatalogHRNString(), layer, version),
+        tile_key);
+  }
 }
 
 bool PartitionsCacheRepository::Get(const std::string& layer,
@@ -222,12 +353,57 @@ bool PartitionsCacheRepository::Get(const std::string& layer,
                                     QuadTreeIndex& tree) {
   auto key = CreateQuadKey(layer, tile_key, depth, version);
   OLP_SDK_LOG_DEBUG_F(kLogTag, "Get -> '%s'", key.c_str());
+  auto& root_index = QuadTreeRootIndex::Instance();
+  auto& tree_cache = QuadTreeIndexCache::Instance();
+  const auto layer_key =
+      CreateQuadTreeLayerKey(hrn_.ToCatalogHRNString(), layer, version);
+
+  if (tree_cache.Get(cache_, key, tree)) {
+    root_index.Add(cache_, layer_key, tile_key);
+    return true;
+  }
+
   auto data = cache_->Get(key);
   if (data) {
     tree = QuadTreeIndex(data);
+    // The remaining expiry of a stored quadtree is unknown, so it is kept in
+    // memory only when the quadtrees do not expire.
+    if (default_expiry_ == kTimetMax) {
+      tree_cache.Put(cache_, key, tree, default_expiry_);
+    }
+    root_index.Add(cache_, layer_key, tile_key);
+    return true;
+  }
+
+  tree_cache.Remove(cache_, key);
+  root_index.Remove(cache_, layer_key, tile_key);
+  return false;
+}
+
+bool PartitionsCacheRepository::FindQuadTree(
+    const std::string& layer, geo::TileKey tile_key, int32_t depth,
+    const boost::optional<int64_t>& version, QuadTreeIndex& tree) {
+  const auto max_depth =
+      std::min<std::uint32_t>(tile_key.Level(), static_cast<uint32_t>(depth));
+
+  // Most of the time the root is already indexed, and is resolved with a
+  // single cache lookup.
+  const auto indexed_root = QuadTreeRootIndex::Instance().Find(
+      cache_,
+      CreateQuadTreeLayerKey(hrn_.ToCatalogHRNString(), layer, version),
+      tile_key, max_depth);
+  if (indexed_root && Get(layer, *indexed_root, depth, version, tree)) {
     return true;
   }
 
+  for (int i = max_depth; i >= 0; --i) {
+    const auto root_tile_key = tile_key.ChangedLevelBy(-i);
+    if ((!indexed_root || root_tile_key != *indexed_root) &&
+        Get(layer, root_tile_key, depth, version, tree)) {
+      return true;
+    }
+  }
+
   return false;
 }
 
@@ -235,6 +411,8 @@ void PartitionsCacheRepository::Clear(const std::string& layer_id) {
   std::string hrn(hrn_.ToCatalogHRNString());
   auto key = hrn + "::" + layer_id + "::";
   OLP_SDK_LOG_INFO_F(kLogTag, "Clear -> '%s'", key.c_str());
+  QuadTreeIndexCache::Instance().RemoveWithPrefix(cache_, key);
+  QuadTreeRootIndex::Instance().RemoveWithPrefix(cache_, key);
   cache_->RemoveKeysWithPrefix(key);
 }
 
@@ -259,6 +437,11 @@ bool PartitionsCacheRepository::ClearQuadTree(
     const boost::optional<int64_t>& version) {
   const auto key = CreateQuadKey(layer, tile_key, depth, version);
   OLP_SDK_LOG_INFO_F(kLogTag, "ClearQuadTree -> '%s'", key.c_str());
+  QuadTreeIndexCache::Instance().Remove(cache_, key);
+  QuadTreeRootIndex::Instance().Remove(
+      cache_,
+      CreateQuadTreeLayerKey(hrn_.ToCatalogHRNString(), layer, version),
+      tile_key);
   return cache_->RemoveKeysWithPrefix(key);
 }
 
@@ -271,9 +454,7 @@ bool PartitionsCacheRepository::ClearPartitionMetadata(
   OLP_SDK_LOG_INFO_F(kLogTag, "ClearPartitionMetadata -> '%s'", key.c_str());
 
   auto cached_partition =
-      cache_->Get(key, [](const std::string& serialized_object) {
-        return parser::parse<model::Partition>(serialized_object);
-      });
+      cache_->Get(key, Decode<model::Partition>);
 
   if (cached_partition.empty()) {
     return true;
@@ -291,9 +472,7 @@ bool PartitionsCacheRepository::GetPartitionHandle(
   auto key = CreateKey(hrn, layer_id, partition_id, catalog_version);
   OLP_SDK_LOG_DEBUG_F(kLogTag, "IsPartitionCached -> '%s'", key.c_str());
   auto cached_partition =
-      cache_->Get(key, [](const std::string& serialized_object) {
-        return parser::parse<model::Partition>(serialized_object);
-      });
+      cache_->Get(key, Decode<model::Partition>);
 
   if (cached_partition.empty()) {
     return false;
@@ -57,6 +57,39 @@ class PartitionsCacheRepository final {
       const PartitionsRequest& request, const std::string& layer_id,
       const boost::optional<int64_t>& version);
 
+  /// Stores the list of all the partition ids of the layer.
+  void PutPartitionIds(const std::vector<std::string>& partition_ids,
+                       const std::string& layer_id,
+                       const boost::optional<int64_t>& version,
+                       const boost::optional<time_t>& expiry);
+
+  /// Gets the list of all the partition ids of the layer, if it is cached.
+  boost::optional<std::vector<std::string>> GetPartitionIds(
+      const std::string& layer_id, const boost::optional<int64_t>& version);
+
+  /// Stores the partition ids of one page of the streamed layer. The pages
+  /// are numbered from 0.
+  void PutPartitionIdsPage(const model::Partitions& page, size_t page_index,
+                           const std::string& layer_id,
+                           const boost::optional<int64_t>& version,
+                           const boost::optional<time_t>& expiry);
+
+  /// Stores the number of the pages of the partition ids after all the pages
+  /// of the streamed layer are stored.
+  void PutPartitionIdsPageCount(size_t page_count, const std::string& layer_id,
+                                const boost::optional<int64_t>& version,
+                                const boost::optional<time_t>& expiry);
+
+  /// Gets the number of the pages of the partition ids, if the layer was
+  /// streamed completely.
+  boost::optional<size_t> GetPartitionIdsPageCount(
+      const std::string& layer_id, const boost::optional<int64_t>& version);
+
+  /// Gets the partition ids of one page of the streamed layer.
+  boost::optional<std::vector<std::string>> GetPartitionIdsPage(
+      size_t page_index, const std::string& layer_id,
+      const boost::optional<int64_t>& version);
+
   void Put(int64_t catalogVersion, const model::LayerVersions& layerVersions);
 
   boost::optional<model::LayerVersions> Get(int64_t catalogVersion);
@@ -68,6 +101,12 @@ class PartitionsCacheRepository final {
   bool Get(const std::string& layer, geo::TileKey key, int32_t depth,
            const boost::optional<int64_t>& version, QuadTreeIndex& tree);
 
+  /// Finds the cached quadtree that covers the tile, the quadtree root can be
+  /// up to `depth` levels above the tile.
+  bool FindQuadTree(const std::string& layer, geo::TileKey tile_key,
+                    int32_t depth, const boost::optional<int64_t>& version,
+                    QuadTreeIndex& tree);
+
   void Clear(const std::string& layer_id);
 
   void ClearPartitions(const std::vector<std::string>& partitionIds,
@@ -19,6 +19,8 @@
 
 #include "PartitionsRepository.h"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include <olp/core/client/Condition.h>
@@ -46,7 +48,6 @@ namespace model = olp::dataservice::read::model;
 namespace repository = olp::dataservice::read::repository;
 
 constexpr auto kLogTag = "PartitionsRepository";
-constexpr uint32_t kMaxQuadTreeIndexDepth = 4u;
 constexpr auto kAggregateQuadTreeDepth = 4;
 
 using LayerVersionReponse =
@@ -119,20 +120,8 @@ PartitionsResponse PartitionsRepository::GetVolatilePartitions(
     client::HRN catalog, std::string layer,
     client::CancellationContext cancellation_context, PartitionsRequest request,
     client::OlpClientSettings settings) {
-  auto catalog_request = CatalogRequest()
-                             .WithBillingTag(request.GetBillingTag())
-                             .WithFetchOption(request.GetFetchOption());
-
-  CatalogRepository repository(catalog, settings);
-  auto catalog_response =
-      repository.GetCatalog(catalog_request, cancellation_context);
-
-  if (!catalog_response.IsSuccessful()) {
-    return catalog_response.GetError();
-  }
-
-  auto expiry_response =
-      TtlForLayer(catalog_response.GetResult().GetLayers(), layer);
+  auto expiry_response = GetVolatileLayerExpiry(catalog, layer, request,
+                                                cancellation_context, settings);
   if (!expiry_response.IsSuccessful()) {
     return expiry_response.GetError();
   }
@@ -142,6 +131,32 @@ PartitionsResponse PartitionsRepository::GetVolatilePartitions(
                        std::move(settings), expiry_response.MoveResult());
 }
 
+StreamPartitionsResponse PartitionsRepository::StreamVersionedPartitions(
+    client::HRN catalog, std::string layer, int64_t version,
+    client::CancellationContext cancellation_context, PartitionsRequest request,
+    client::OlpClientSettings settings,
+    const PartitionsPageCallback& page_callback) {
+  return StreamPartitions(std::move(catalog), std::move(layer), version,
+                          std::move(cancellation_context), std::move(request),
+                          settings, page_callback);
+}
+
+StreamPartitionsResponse PartitionsRepository::StreamVolatilePartitions(
+    client::HRN catalog, std::string layer,
+    client::CancellationContext cancellation_context, PartitionsRequest request,
+    client::OlpClientSettings settings,
+    const PartitionsPageCallback& page_callback) {
+  auto expiry_response = GetVolatileLayerExpiry(catalog, layer, request,
+                                                cancellation_context, settings);
+  if (!expiry_response.IsSuccessful()) {
+    return expiry_response.GetError();
+  }
+
+  return StreamPartitions(std::move(catalog), std::move(layer), boost::none,
+                          cancellation_context, std::move(request), settings,
+                          page_callback, expiry_response.MoveResult());
+}
+
 PartitionsResponse PartitionsRepository::GetPartitions(
     client::HRN catalog, std::string layer, boost::optional<int64_t> version,
     client::CancellationContext cancellation_context, PartitionsRequest request,
@@ -221,6 +236,207 @@ PartitionsResponse PartitionsRepository::GetPartitions(
   return response;
 }
 
+StreamPartitionsResponse PartitionsRepository::StreamPartitions(
+    client::HRN catalog, std::string layer, boost::optional<int64_t> version,
+    client::CancellationContext cancellation_context, PartitionsRequest request,
+    const client::OlpClientSettings& settings,
+    const PartitionsPageCallback& page_callback,
+    boost::optional<time_t> expiry) {
+  const auto page_size = std::max<size_t>(request.GetPageSize(), 1u);
+  StreamPartitionsResult count = 0u;
+
+  auto deliver_pages = [&](std::vector<model::Partition>& partitions) {
+    for (auto it = partitions.begin(); it != partitions.end();) {
+      const auto page_end =
+          it + std::min<size_t>(page_size, std::distance(it, partitions.end()));
+      model::Partitions page;
+      page.GetMutablePartitions().assign(std::make_move_iterator(it),
+                                         std::make_move_iterator(page_end));
+      count += page.GetPartitions().size();
+      page_callback(std::move(page));
+      it = page_end;
+    }
+  };
+
+  // The partitions requested by id are few, they are fetched at once and
+  // split into pages.
+  if (!request.GetPartitionIds().empty()) {
+    auto response = GetPartitions(std::move(catalog), std::move(layer), version,
+                                  std::move(cancellation_context),
+                                  std::move(request), settings, expiry);
+    if (!response.IsSuccessful()) {
+      return response.GetError();
+    }
+
+    auto partitions = response.MoveResult();
+    deliver_pages(partitions.GetMutablePartitions());
+    return count;
+  }
+
+  auto fetch_option = request.GetFetchOption();
+  const auto key = request.CreateKey(layer, version);
+
+  repository::PartitionsCacheRepository repository(
+      catalog, settings.cache, settings.default_cache_expiration);
+
+  if (fetch_option != OnlineOnly && fetch_option != CacheWithUpdate) {
+    // A streamed layer keeps its ids in pages, so only one page of the ids is
+    // loaded at a time. The ids stored by `GetPartitions` are one list.
+    const auto id_pages = repository.GetPartitionIdsPageCount(layer, version);
+    boost::optional<std::vector<std::string>> cached_ids;
+    if (!id_pages) {
+      cached_ids = repository.GetPartitionIds(layer, version);
+    }
+    if (id_pages || cached_ids) {
+      OLP_SDK_LOG_DEBUG_F(kLogTag,
+                          "StreamPartitions found in cache, hrn='%s', key='%s'",
+                          catalog.ToCatalogHRNString().c_str(), key.c_str());
+
+      std::vector<std::string> ids;
+      if (cached_ids) {
+        ids = std::move(*cached_ids);
+      }
+
+      // Delivers the cached partitions in pages of the requested size, the
+      // ids that do not fill a page wait for the next page of the ids.
+      auto deliver_cached_pages = [&](bool last) {
+        auto it = ids.begin();
+        while (it != ids.end() &&
+               (last || static_cast<size_t>(std::distance(it, ids.end())) >=
+                            page_size)) {
+          if (cancellation_context.IsCancelled()) {
+            return false;
+          }
+
+          const auto page_end =
+              it + std::min<size_t>(page_size, std::distance(it, ids.end()));
+          auto page = repository.Get(std::vector<std::string>(it, page_end),
+                                     layer, version);
+          count += page.GetPartitions().size();
+          page_callback(std::move(page));
+          it = page_end;
+        }
+        ids.erase(ids.begin(), it);
+        return true;
+      };
+
+      bool complete = true;
+      for (size_t id_page = 0u; id_pages && id_page < *id_pages; ++id_page) {
+        auto page_ids = repository.GetPartitionIdsPage(id_page, layer, version);
+        if (!page_ids) {
+          complete = false;
+          break;
+        }
+
+        ids.insert(ids.end(), std::make_move_iterator(page_ids->begin()),
+                   std::make_move_iterator(page_ids->end()));
+        if (!deliver_cached_pages(false)) {
+          return {{client::ErrorCode::Cancelled, "Cancelled"}};
+        }
+      }
+
+      if (complete) {
+        if (!deliver_cached_pages(true)) {
+          return {{client::ErrorCode::Cancelled, "Cancelled"}};
+        }
+        return count;
+      }
+
+      // A page of the ids was evicted, the layer is fetched again if none of
+      // its partitions was delivered yet.
+      OLP_SDK_LOG_WARNING_F(
+          kLogTag,
+          "StreamPartitions ids incomplete in cache, hrn='%s', key='%s'",
+          catalog.ToCatalogHRNString().c_str(), key.c_str());
+      if (count > 0u || fetch_option == CacheOnly) {
+        return {{client::ErrorCode::NotFound,
+                 "The cached partition ids are incomplete"}};
+      }
+    } else if (fetch_option == CacheOnly) {
+      OLP_SDK_LOG_INFO_F(
+          kLogTag, "StreamPartitions not found in cache, hrn='%s', key='%s'",
+          catalog.ToCatalogHRNString().c_str(), key.c_str());
+      return {{client::ErrorCode::NotFound,
+               "CacheOnly: resource not found in cache"}};
+    }
+  }
+
+  auto metadata_api =
+      ApiClientLookup::LookupApi(catalog, cancellation_context, "metadata",
+                                 "v1", fetch_option, settings);
+  if (!metadata_api.IsSuccessful()) {
+    return metadata_api.GetError();
+  }
+
+  // Each page and its partition ids are cached as soon as they are parsed,
+  // the number of the pages is stored only when the whole layer is received.
+  const bool write_cache = fetch_option != OnlineOnly;
+  size_t id_pages = 0u;
+
+  auto response = MetadataApi::GetPartitionsPages(
+      metadata_api.GetResult(), layer, version, request.GetAdditionalFields(),
+      request.GetBillingTag(), page_size,
+      [&](model::Partitions page) {
+        if (cancellation_context.IsCancelled()) {
+          return false;
+        }
+
+        if (write_cache) {
+          repository.Put(page, layer, version, expiry);
+          repository.PutPartitionIdsPage(page, id_pages++, layer, version,
+                                         expiry);
+        }
+
+        count += page.GetPartitions().size();
+        page_callback(std::move(page));
+        return true;
+      },
+      cancellation_context);
+
+  if (!response.IsSuccessful()) {
+    const auto& error = response.GetError();
+    if (error.GetHttpStatusCode() == http::HttpStatusCode::FORBIDDEN) {
+      OLP_SDK_LOG_WARNING_F(
+          kLogTag,
+          "StreamPartitions 403 received, remove from cache, hrn='%s', "
+          "key='%s'",
+          catalog.ToCatalogHRNString().c_str(), key.c_str());
+      repository.Clear(layer);
+    }
+    return error;
+  }
+
+  if (write_cache) {
+    OLP_SDK_LOG_DEBUG_F(kLogTag,
+                        "StreamPartitions put to cache, hrn='%s', key='%s'",
+                        catalog.ToCatalogHRNString().c_str(), key.c_str());
+    repository.PutPartitionIdsPageCount(id_pages, layer, version, expiry);
+  }
+
+  return count;
+}
+
+client::ApiResponse<boost::optional<time_t>, client::ApiError>
+PartitionsRepository::GetVolatileLayerExpiry(
+    const client::HRN& catalog, const std::string& layer,
+    const PartitionsRequest& request,
+    client::CancellationContext cancellation_context,
+    const client::OlpClientSettings& settings) {
+  auto catalog_request = CatalogRequest()
+                             .WithBillingTag(request.GetBillingTag())
+                             .WithFetchOption(request.GetFetchOption());
+
+  CatalogRepository repository(catalog, settings);
+  auto catalog_response =
+      repository.GetCatalog(catalog_request, cancellation_context);
+
+  if (!catalog_response.IsSuccessful()) {
+    return catalog_response.GetError();
+  }
+
+  return TtlForLayer(catalog_response.GetResult().GetLayers(), layer);
+}
+
 PartitionsResponse PartitionsRepository::GetPartitionById(
     const client::HRN& catalog, const std::string& layer,
     boost::optional<int64_t> version,
@@ -436,23 +652,17 @@ bool PartitionsRepository::FindQuadTree(
     const olp::geo::TileKey& tile_key, read::QuadTreeIndex& tree) {
   repository::PartitionsCacheRepository repository(
       catalog, settings.cache, settings.default_cache_expiration);
-  auto max_depth =
-      std::min<std::uint32_t>(tile_key.Level(), kMaxQuadTreeIndexDepth);
-  for (int i = max_depth; i >= 0; --i) {
-    const auto& root_tile_key = tile_key.ChangedLevelBy(-i);
-    QuadTreeIndex cached_tree;
-    if (repository.Get(layer, root_tile_key, kAggregateQuadTreeDepth, version,
-                       cached_tree)) {
-      OLP_SDK_LOG_DEBUG_F(kLogTag,
-                          "FindQuadTreeInCache found in cache, tile='%s', "
-                          "root='%s', depth='%" PRId32 "'",
-                          tile_key.ToHereTile().c_str(),
-                          root_tile_key.ToHereTile().c_str(),
-                          kAggregateQuadTreeDepth);
-      tree = std::move(cached_tree);
-
-      return true;
-    }
+  QuadTreeIndex cached_tree;
+  if (repository.FindQuadTree(layer, tile_key, kAggregateQuadTreeDepth,
+                              version, cached_tree)) {
+    OLP_SDK_LOG_DEBUG_F(kLogTag,
+                        "FindQuadTreeInCache found in cache, tile='%s', "
+                        "root='%s', depth='%" PRId32 "'",
+                        tile_key.ToHereTile().c_str(),
+                        cached_tree.GetRootTile().ToHereTile().c_str(),
+                        kAggregateQuadTreeDepth);
+    tree = std::move(cached_tree);
+    return true;
   }
 
   return false;
@@ -57,6 +57,18 @@ class PartitionsRepository {
       client::CancellationContext cancellation_context,
       read::PartitionsRequest data_request, client::OlpClientSettings settings);
 
+  static StreamPartitionsResponse StreamVersionedPartitions(
+      client::HRN catalog, std::string layer, int64_t version,
+      client::CancellationContext cancellation_context,
+      read::PartitionsRequest request, client::OlpClientSettings settings,
+      const PartitionsPageCallback& page_callback);
+
+  static StreamPartitionsResponse StreamVolatilePartitions(
+      client::HRN catalog, std::string layer,
+      client::CancellationContext cancellation_context,
+      read::PartitionsRequest request, client::OlpClientSettings settings,
+      const PartitionsPageCallback& page_callback);
+
   static PartitionsResponse GetPartitionById(
       const client::HRN& catalog, const std::string& layer,
       boost::optional<int64_t> version,
@@ -98,6 +110,20 @@ class PartitionsRepository {
       read::PartitionsRequest request,
       const client::OlpClientSettings& settings,
       boost::optional<time_t> expiry = boost::none);
+
+  static StreamPartitionsResponse StreamPartitions(
+      client::HRN catalog, std::string layer, boost::optional<int64_t> version,
+      client::CancellationContext cancellation_context,
+      read::PartitionsRequest request,
+      const client::OlpClientSettings& settings,
+      const PartitionsPageCallback& page_callback,
+      boost::optional<time_t> expiry = boost::none);
+
+  static client::ApiResponse<boost::optional<time_t>, client::ApiError>
+  GetVolatileLayerExpiry(const client::HRN& catalog, const std::string& layer,
+                         const read::PartitionsRequest& request,
+                         client::CancellationContext cancellation_context,
+                         const client::OlpClientSettings& settings);
 };
 }  // namespace repository
 }  // namespace read
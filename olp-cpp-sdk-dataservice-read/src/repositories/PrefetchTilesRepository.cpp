@@ -21,17 +21,26 @@
 
 #include <inttypes.h>
 #include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <utility>
 #include <vector>
 
+#include <olp/core/cache/KeyValueCache.h>
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/geo/tiling/TileKey.h>
+#include <olp/core/geo/tiling/TileKeyUtils.h>
+#include <olp/core/geo/tiling/TilingSchemeRegistry.h>
 #include <olp/core/logging/Log.h>
 #include <olp/core/thread/Atomic.h>
 #include <olp/core/thread/TaskScheduler.h>
 #include "ApiClientLookup.h"
+#include "ExecuteOrSchedule.inl"
 #include "PartitionsRepository.h"
 #include "QuadTreeIndex.h"
 #include "generated/api/QueryApi.h"
@@ -49,6 +58,57 @@ namespace repository {
 namespace {
 constexpr auto kLogTag = "PrefetchTilesRepository";
 constexpr std::uint32_t kMaxQuadTreeIndexDepth = 4u;
+
+// State shared by the workers resolving the quadtree indexes of root tiles.
+struct SubTilesFetchState {
+  std::mutex mutex;
+  // Serializes the calls to the sub quads callback, which are made without
+  // holding `mutex`.
+  std::mutex callback_mutex;
+  std::condition_variable workers_done;
+  std::vector<std::pair<geo::TileKey, std::uint32_t>> root_tiles;
+  size_t next_root{0u};
+  size_t active_workers{0u};
+  boost::optional<client::ApiError> error;
+  SubTilesResult result;
+  std::set<geo::TileKey> reported_tiles;
+};
+
+// Checks whether the tile is one of the tiles of the ranges, a parent or a
+// child of one of them.
+bool IsRelatedToTileKeyRanges(const std::vector<geo::TileKeyRange>& ranges,
+                              const geo::TileKey& tile_key) {
+  if (ranges.empty()) {
+    return false;
+  }
+
+  const auto quad_key = tile_key.ToQuadKey64();
+  for (std::uint32_t level = 0; level < geo::TileKey::LevelCount; ++level) {
+    if (level <= tile_key.Level()) {
+      const auto parent_key = quad_key >> (2 * (tile_key.Level() - level));
+      if (PrefetchTilesRepository::IsInTileKeyRanges(
+              ranges, geo::TileKey::FromQuadKey64(parent_key))) {
+        return true;
+      }
+      continue;
+    }
+
+    // The children of the tile on the level have consecutive codes, look for
+    // the first range that ends after the first child.
+    const auto shift = 2 * (level - tile_key.Level());
+    const auto first_child = quad_key << shift;
+    const auto last_child = ((quad_key + 1) << shift) - 1;
+    auto it = std::lower_bound(
+        ranges.begin(), ranges.end(), first_child,
+        [](const geo::TileKeyRange& range, std::uint64_t key) {
+          return range.last < key;
+        });
+    if (it != ranges.end() && it->first <= last_child) {
+      return true;
+    }
+  }
+  return false;
+}
 }  // namespace
 
 void PrefetchTilesRepository::SplitSubtree(
@@ -150,41 +210,178 @@ RootTilesForRequest PrefetchTilesRepository::GetSlicedTiles(
   return root_tiles_depth;
 }
 
+RootTilesForRequest PrefetchTilesRepository::GetSlicedTiles(
+    const PrefetchTilesRequest& request, std::uint32_t min, std::uint32_t max) {
+  auto root_tiles = GetSlicedTiles(request.GetTileKeys(), min, max);
+  for (const auto& range : request.GetTileKeyRanges()) {
+    const auto level = geo::TileKey::FromQuadKey64(range.first).Level();
+    const auto range_min = min == geo::TileKey::LevelCount ? level : min;
+    const auto range_max = max == geo::TileKey::LevelCount ? level : max;
+
+    const auto range_tiles = GetSlicedTiles(
+        geo::TileKeyUtils::GetCoveringTileKeys(range), range_min, range_max);
+    for (const auto& tile : range_tiles) {
+      auto it = root_tiles.insert(tile);
+      if (!it.second) {
+        it.first->second = std::max(it.first->second, tile.second);
+      }
+    }
+  }
+  return root_tiles;
+}
+
+std::vector<geo::TileKeyRange> PrefetchTilesRepository::GetTileKeyRanges(
+    const PrefetchTilesRequest& request) {
+  auto ranges = request.GetTileKeyRanges();
+  const auto level = request.GetMaxLevel();
+  if (level < geo::TileKey::LevelCount) {
+    const geo::HalfQuadTreeEquirectangularTilingScheme tiling_scheme;
+    if (!request.GetPolygon().empty()) {
+      auto polygon_ranges = geo::TileKeyUtils::GeoPolygonToTileKeyRanges(
+          tiling_scheme, request.GetPolygon(), level);
+      ranges.insert(ranges.end(), polygon_ranges.begin(),
+                    polygon_ranges.end());
+    }
+    if (!request.GetCorridor().empty()) {
+      auto corridor_ranges = geo::TileKeyUtils::GeoCorridorToTileKeyRanges(
+          tiling_scheme, request.GetCorridor(), request.GetCorridorBuffer(),
+          level);
+      ranges.insert(ranges.end(), corridor_ranges.begin(),
+                    corridor_ranges.end());
+    }
+  }
+  return geo::TileKeyUtils::MergeTileKeyRanges(std::move(ranges));
+}
+
+bool PrefetchTilesRepository::IsInTileKeyRanges(
+    const std::vector<geo::TileKeyRange>& ranges,
+    const geo::TileKey& tile_key) {
+  const auto quad_key = tile_key.ToQuadKey64();
+  auto it = std::upper_bound(
+      ranges.begin(), ranges.end(), quad_key,
+      [](std::uint64_t key, const geo::TileKeyRange& range) {
+        return key < range.first;
+      });
+  return it != ranges.begin() && std::prev(it)->Contains(quad_key);
+}
+
 SubTilesResponse PrefetchTilesRepository::GetSubTiles(
     const client::HRN& catalog, const std::string& layer_id,
     const PrefetchTilesRequest& request, boost::optional<std::int64_t> version,
     const RootTilesForRequest& root_tiles, client::CancellationContext context,
-    const client::OlpClientSettings& settings) {
-  SubTilesResult result;
-  OLP_SDK_LOG_INFO_F(kLogTag,
-                     "GetSubTiles: hrn='%s', layer='%s', root_tiles=%zu",
-                     catalog.ToCatalogHRNString().c_str(), layer_id.c_str(),
-                     root_tiles.size());
+    const client::OlpClientSettings& settings, SubQuadsCallback on_sub_quads) {
+  const auto workers_count = std::max<size_t>(
+      1u,
+      std::min<size_t>(request.GetQuadTreeConcurrency(), root_tiles.size()));
+
+  OLP_SDK_LOG_INFO_F(
+      kLogTag, "GetSubTiles: hrn='%s', layer='%s', root_tiles=%zu, workers=%zu",
+      catalog.ToCatalogHRNString().c_str(), layer_id.c_str(), root_tiles.size(),
+      workers_count);
+
+  auto state = std::make_shared<SubTilesFetchState>();
+  state->root_tiles.assign(root_tiles.begin(), root_tiles.end());
+
+  // Each worker needs its own context, as a context tracks one operation only.
+  std::vector<client::CancellationContext> contexts(workers_count);
+  if (!context.ExecuteOrCancelled([&]() {
+        return client::CancellationToken([contexts]() {
+          for (auto worker_context : contexts) {
+            worker_context.CancelOperation();
+          }
+        });
+      })) {
+    return {{client::ErrorCode::Cancelled, "Cancelled", true}};
+  }
 
-  for (const auto& quad : root_tiles) {
-    if (context.IsCancelled()) {
-      return {{client::ErrorCode::Cancelled, "Cancelled", true}};
+  auto fetch_sub_quads = [&](const geo::TileKey& tile, std::int32_t depth,
+                             client::CancellationContext worker_context) {
+    if (worker_context.IsCancelled()) {
+      return SubQuadsResponse(
+          client::ApiError(client::ErrorCode::Cancelled, "Cancelled", true));
     }
+    return version ? GetSubQuads(catalog, layer_id, request, version.get(),
+                                 tile, depth, settings, worker_context)
+                   : GetVolatileSubQuads(catalog, layer_id, request, tile,
+                                         depth, settings, worker_context);
+  };
 
-    auto& tile = quad.first;
-    auto& depth = quad.second;
-    auto response = version
-                        ? GetSubQuads(catalog, layer_id, request, version.get(),
-                                      tile, depth, settings, context)
-                        : GetVolatileSubQuads(catalog, layer_id, request, tile,
-                                              depth, settings, context);
-    if (!response.IsSuccessful()) {
-      // Just abort if something else then 404 Not Found is returned
-      auto& error = response.GetError();
-      if (error.GetHttpStatusCode() != http::HttpStatusCode::NOT_FOUND) {
-        return error;
+  // A worker may start after this function returned. It touches the
+  // references captured by `fetch_sub_quads` and `on_sub_quads` only while it
+  // owns a root tile, and this function waits for such workers to finish.
+  auto worker = [state, fetch_sub_quads, contexts,
+                 &on_sub_quads](client::CancellationContext worker_context) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    ++state->active_workers;
+
+    while (!state->error && state->next_root < state->root_tiles.size()) {
+      const auto quad = state->root_tiles[state->next_root++];
+      lock.unlock();
+      auto response = fetch_sub_quads(quad.first, quad.second, worker_context);
+      lock.lock();
+
+      if (!response.IsSuccessful()) {
+        // Just abort if something else then 404 Not Found is returned
+        const auto& error = response.GetError();
+        if (error.GetHttpStatusCode() != http::HttpStatusCode::NOT_FOUND &&
+            !state->error) {
+          state->error = error;
+
+          // The other workers stop their requests instead of finishing them.
+          lock.unlock();
+          for (auto context : contexts) {
+            context.CancelOperation();
+          }
+          lock.lock();
+        }
+        continue;
       }
+
+      auto sub_quads = response.MoveResult();
+      if (on_sub_quads) {
+        for (auto it = sub_quads.begin(); it != sub_quads.end();) {
+          it = state->reported_tiles.insert(it->first).second
+                   ? std::next(it)
+                   : sub_quads.erase(it);
+        }
+        if (!sub_quads.empty()) {
+          // The other workers keep resolving while the tiles are passed on.
+          lock.unlock();
+          {
+            std::lock_guard<std::mutex> callback_lock(state->callback_mutex);
+            on_sub_quads(quad.first, std::move(sub_quads));
+          }
+          lock.lock();
+        }
+      } else {
+        state->result.insert(std::make_move_iterator(sub_quads.begin()),
+                             std::make_move_iterator(sub_quads.end()));
+      }
+    }
+
+    if (--state->active_workers == 0) {
+      state->workers_done.notify_all();
     }
-    auto subtiles = response.MoveResult();
-    result.insert(std::make_move_iterator(subtiles.begin()),
-                  std::make_move_iterator(subtiles.end()));
+  };
+
+  for (size_t index = 1u; index < workers_count; ++index) {
+    auto worker_context = contexts[index];
+    ExecuteOrSchedule(settings.task_scheduler,
+                      [=]() { worker(worker_context); });
   }
-  return result;
+
+  // The calling thread works as well, so the fetch never depends on free
+  // threads in the task scheduler.
+  worker(contexts.front());
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->workers_done.wait(lock,
+                           [&]() { return state->active_workers == 0u; });
+
+  if (state->error) {
+    return state->error.get();
+  }
+  return std::move(state->result);
 }
 
 SubQuadsResponse PrefetchTilesRepository::GetSubQuads(
@@ -330,11 +527,13 @@ SubQuadsResponse PrefetchTilesRepository::GetVolatileSubQuads(
 SubQuadsResult PrefetchTilesRepository::FilterSkippedTiles(
     const PrefetchTilesRequest& request, bool request_only_input_tiles,
     SubQuadsResult sub_tiles) {
+  const auto& ranges = request.GetTileKeyRanges();
   auto skip_tile = [&](const geo::TileKey& tile_key) {
     const auto& tile_keys = request.GetTileKeys();
     if (request_only_input_tiles) {
       return std::find(tile_keys.begin(), tile_keys.end(), tile_key) ==
-             tile_keys.end();
+                 tile_keys.end() &&
+             !IsInTileKeyRanges(ranges, tile_key);
     } else if (tile_key.Level() < request.GetMinLevel() ||
                tile_key.Level() > request.GetMaxLevel()) {
       // tile outside min/max segment, skip this tile
@@ -347,7 +546,8 @@ SubQuadsResult PrefetchTilesRepository::FilterSkippedTiles(
                             return (root_key.IsParentOf(tile_key) ||
                                     tile_key.IsParentOf(root_key) ||
                                     root_key == tile_key);
-                          }) == tile_keys.end();
+                          }) == tile_keys.end() &&
+             !IsRelatedToTileKeyRanges(ranges, tile_key);
     }
   };
 
@@ -361,6 +561,73 @@ SubQuadsResult PrefetchTilesRepository::FilterSkippedTiles(
   return sub_tiles;
 }
 
+std::string PrefetchTilesRepository::CreateCheckpointKey(
+    const client::HRN& catalog, const std::string& layer_id,
+    const PrefetchTilesRequest& request,
+    boost::optional<std::int64_t> version) {
+  // FNV-1a over the quad keys, the order of the tile keys matters as the
+  // order of the root tiles depends on it.
+  std::uint64_t tiles_hash = 14695981039346656037ull;
+  for (const auto& tile_key : request.GetTileKeys()) {
+    tiles_hash = (tiles_hash ^ tile_key.ToQuadKey64()) * 1099511628211ull;
+  }
+  for (const auto& range : request.GetTileKeyRanges()) {
+    tiles_hash = (tiles_hash ^ range.first) * 1099511628211ull;
+    tiles_hash = (tiles_hash ^ range.last) * 1099511628211ull;
+  }
+
+  std::stringstream key;
+  key << catalog.ToCatalogHRNString() << "::" << layer_id << "::"
+      << request.GetMinLevel() << "::" << request.GetMaxLevel() << "::"
+      << std::hex << tiles_hash << std::dec;
+  if (version) {
+    key << "::" << version.get();
+  }
+  key << "::prefetchCheckpoint";
+  return key.str();
+}
+
+size_t PrefetchTilesRepository::GetCheckpoint(
+    const client::OlpClientSettings& settings, const std::string& key) {
+  if (!settings.cache) {
+    return 0u;
+  }
+
+  auto value = settings.cache->Get(key, [](const std::string& value) {
+    return static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 10));
+  });
+
+  if (value.empty()) {
+    return 0u;
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "GetCheckpoint -> '%s'", key.c_str());
+  return boost::any_cast<size_t>(value);
+}
+
+void PrefetchTilesRepository::PutCheckpoint(
+    const client::OlpClientSettings& settings, const std::string& key,
+    size_t completed_roots) {
+  if (!settings.cache) {
+    return;
+  }
+
+  const auto expiry = settings.default_cache_expiration;
+  settings.cache->Put(
+      key, completed_roots,
+      [=]() { return std::to_string(completed_roots); },
+      expiry == std::chrono::seconds::max()
+          ? cache::KeyValueCache::kDefaultExpiry
+          : static_cast<time_t>(expiry.count()));
+}
+
+void PrefetchTilesRepository::RemoveCheckpoint(
+    const client::OlpClientSettings& settings, const std::string& key) {
+  if (settings.cache) {
+    settings.cache->Remove(key);
+  }
+}
+
 PORTING_POP_WARNINGS()
 }  // namespace repository
 }  // namespace read
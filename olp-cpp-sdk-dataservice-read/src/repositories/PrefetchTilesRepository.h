@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -43,6 +44,8 @@ using SubQuadsResult = std::map<geo::TileKey, std::string>;
 using SubQuadsResponse = client::ApiResponse<SubQuadsResult, client::ApiError>;
 using SubTilesResult = SubQuadsResult;
 using SubTilesResponse = client::ApiResponse<SubTilesResult, client::ApiError>;
+using SubQuadsCallback =
+    std::function<void(const geo::TileKey& root_tile, SubQuadsResult)>;
 
 class PrefetchTilesRepository {
  public:
@@ -60,18 +63,94 @@ class PrefetchTilesRepository {
       const std::vector<geo::TileKey>& tile_keys, std::uint32_t min,
       std::uint32_t max);
 
+  /**
+   * @brief Slices the tile keys and the tile key ranges of the request like
+   * `GetSlicedTiles` above.
+   *
+   * The ranges are sliced from the fewest tiles that cover them, so the work
+   * depends on the outline of a range rather than on its number of tiles. If
+   * the levels are not set, the tiles of a range are sliced on its own level.
+   */
+  static RootTilesForRequest GetSlicedTiles(const PrefetchTilesRequest& request,
+                                            std::uint32_t min,
+                                            std::uint32_t max);
+
+  /**
+   * @brief Gets the merged tile key ranges of the request, together with the
+   * tiles that cover its polygon and corridor on the maximum tile level.
+   *
+   * The polygon and the corridor are skipped if the maximum tile level is not
+   * set.
+   */
+  static std::vector<geo::TileKeyRange> GetTileKeyRanges(
+      const PrefetchTilesRequest& request);
+
+  /**
+   * @brief Checks whether the tile is one of the tiles of the ranges.
+   *
+   * @param ranges The ranges merged with
+   * `geo::TileKeyUtils::MergeTileKeyRanges`.
+   * @param tile_key The tile key to check.
+   */
+  static bool IsInTileKeyRanges(const std::vector<geo::TileKeyRange>& ranges,
+                                const geo::TileKey& tile_key);
+
+  /**
+   * @brief Resolves the quadtree indexes of the root tiles.
+   *
+   * The root tiles are resolved by up to
+   * `PrefetchTilesRequest::GetQuadTreeConcurrency()` tasks in parallel. The
+   * calling thread takes part in the work and returns once all the subtrees
+   * are resolved, or on the first error other than 404 Not Found. Such an
+   * error cancels the requests of the other tasks.
+   *
+   * @param on_sub_quads Optional callback. When set, the tiles of each
+   * resolved subtree are passed to it together with the subtree root tile as
+   * soon as the subtree is available, each tile only once, and are not
+   * accumulated in the result. Calls to the callback are serialized.
+   */
   static SubTilesResponse GetSubTiles(
       const client::HRN& catalog, const std::string& layer_id,
       const PrefetchTilesRequest& request,
       boost::optional<std::int64_t> version,
       const RootTilesForRequest& root_tiles,
       client::CancellationContext context,
-      const client::OlpClientSettings& settings);
+      const client::OlpClientSettings& settings,
+      SubQuadsCallback on_sub_quads = nullptr);
 
   static SubQuadsResult FilterSkippedTiles(const PrefetchTilesRequest& request,
                                            bool request_only_input_tiles,
                                            SubQuadsResult sub_tiles);
 
+  /**
+   * @brief Creates the cache key of the prefetch checkpoint.
+   *
+   * The key depends on the tile keys and ranges, the levels and the version,
+   * so that a checkpoint is only used to resume the same prefetch.
+   */
+  static std::string CreateCheckpointKey(const client::HRN& catalog,
+                                         const std::string& layer_id,
+                                         const PrefetchTilesRequest& request,
+                                         boost::optional<std::int64_t> version);
+
+  /**
+   * @brief Gets the number of root tiles that were completely prefetched by
+   * an interrupted prefetch.
+   *
+   * @return The number of the completed root tiles, or zero if there is no
+   * checkpoint.
+   */
+  static size_t GetCheckpoint(const client::OlpClientSettings& settings,
+                              const std::string& key);
+
+  /// Stores the number of the completed root tiles.
+  static void PutCheckpoint(const client::OlpClientSettings& settings,
+                            const std::string& key, size_t completed_roots);
+
+  /// Removes the checkpoint once the prefetch is complete.
+  static void RemoveCheckpoint(const client::OlpClientSettings& settings,
+                               const std::string& key);
+
  protected:
   static SubQuadsResponse GetSubQuads(const client::HRN& catalog,
                                       const std::string& layer_id,
@@ -21,13 +21,13 @@
 
 #include <algorithm>
 #include <bitset>
+#include <cstring>
 #include <iostream>
+#include <limits>
 
 #include <olp/core/logging/Log.h>
-#include <rapidjson/document.h>
-#include <rapidjson/istreamwrapper.h>
 #include "BlobDataReader.h"
-#include "BlobDataWriter.h"
+#include "generated/parser/SaxHandler.h"
 
 namespace {
 constexpr auto kParentQuadsKey = "parentQuads";
@@ -43,33 +43,133 @@ constexpr auto kCompressedDataSize = "compressedDataSize";
 
 constexpr auto kLogTag = "QuadTreeIndex";
 
-olp::dataservice::read::QuadTreeIndex::IndexData ParseCommonIndexData(
-    rapidjson::Value& value) {
-  olp::dataservice::read::QuadTreeIndex::IndexData data;
-  auto obj = value.GetObject();
-  if (obj.HasMember(kAdditionalMetadataKey) &&
-      obj[kAdditionalMetadataKey].IsString()) {
-    data.additional_metadata = obj[kAdditionalMetadataKey].GetString();
+// The first layout was written with version 0.
+constexpr std::uint16_t kBlobVersionV1 = 0u;
+constexpr std::uint16_t kBlobVersionV2 = 2u;
+
+// The data handle, the checksum and the additional metadata of an entry.
+constexpr size_t kEntryStringCount = 3u;
+
+size_t AlignColumn(size_t offset) { return (offset + 7u) & ~size_t(7u); }
+
+// Levels of the `{"parentQuads": [{...}], "subQuads": [{...}]}` document.
+constexpr int kRootLevel = 1;
+constexpr int kQuadsLevel = 2;
+constexpr int kQuadLevel = 3;
+
+using IndexData = olp::dataservice::read::QuadTreeIndex::IndexData;
+
+// Collects the quads of the JSON response while it is read, so the document
+// is never held in memory as a whole.
+class QuadsHandler : public olp::parser::SaxHandler<QuadsHandler> {
+ public:
+  QuadsHandler(const olp::geo::TileKey& root, std::vector<IndexData>& parents,
+               std::vector<IndexData>& subs)
+      : root_(root), parents_(parents), subs_(subs) {}
+
+  bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+    SaxHandler::Key(str, length, copy);
+    if (Level() == kRootLevel &&
+        (IsKey(kParentQuadsKey) || IsKey(kSubQuadsKey))) {
+      has_quads_ = true;
+    }
+    return true;
   }
 
-  if (obj.HasMember(kChecksumKey) && obj[kChecksumKey].IsString()) {
-    data.checksum = obj[kChecksumKey].GetString();
+  bool OnStartArray() {
+    if (Level() == kQuadsLevel) {
+      quads_ = IsKey(kParentQuadsKey)
+                   ? Quads::kParents
+                   : IsKey(kSubQuadsKey) ? Quads::kSubs : Quads::kNone;
+    }
+    return true;
   }
 
-  if (obj.HasMember(kDataSizeKey) && obj[kDataSizeKey].IsInt64()) {
-    data.data_size = obj[kDataSizeKey].GetInt64();
+  bool OnEndArray() {
+    if (Level() == kQuadsLevel) {
+      quads_ = Quads::kNone;
+    }
+    return true;
   }
 
-  if (obj.HasMember(kCompressedDataSize) &&
-      obj[kCompressedDataSize].IsInt64()) {
-    data.compressed_data_size = obj[kCompressedDataSize].GetInt64();
+  bool OnStartObject() {
+    if (quads_ != Quads::kNone && Level() == kQuadLevel) {
+      data_ = IndexData();
+      quad_key_.clear();
+      has_data_handle_ = false;
+      has_quad_key_ = false;
+    }
+    return true;
   }
 
-  if (obj.HasMember(kVersionKey) && obj[kVersionKey].IsUint64()) {
-    data.version = obj[kVersionKey].GetUint64();
+  bool OnEndObject() {
+    if (quads_ == Quads::kNone || Level() != kQuadLevel || !has_data_handle_ ||
+        !has_quad_key_) {
+      return true;
+    }
+
+    if (quads_ == Quads::kParents) {
+      data_.tile_key = root_.FromHereTile(quad_key_);
+      parents_.push_back(std::move(data_));
+    } else {
+      data_.tile_key = root_.AddedSubHereTile(quad_key_);
+      subs_.push_back(std::move(data_));
+    }
+    return true;
   }
-  return data;
-}
+
+  bool OnString(const char* str, rapidjson::SizeType length) {
+    if (quads_ == Quads::kNone || Level() != kQuadLevel) {
+      return true;
+    }
+
+    if (IsKey(kDataHandleKey)) {
+      data_.data_handle.assign(str, length);
+      has_data_handle_ = true;
+    } else if (IsKey(quads_ == Quads::kParents ? kPartitionKey
+                                               : kSubQuadKeyKey)) {
+      quad_key_.assign(str, length);
+      has_quad_key_ = true;
+    } else if (IsKey(kAdditionalMetadataKey)) {
+      data_.additional_metadata.assign(str, length);
+    } else if (IsKey(kChecksumKey)) {
+      data_.checksum.assign(str, length);
+    }
+    return true;
+  }
+
+  bool OnInteger(int64_t value) {
+    if (quads_ == Quads::kNone || Level() != kQuadLevel) {
+      return true;
+    }
+
+    if (IsKey(kVersionKey)) {
+      if (value >= 0) {
+        data_.version = static_cast<uint64_t>(value);
+      }
+    } else if (IsKey(kDataSizeKey)) {
+      data_.data_size = value;
+    } else if (IsKey(kCompressedDataSize)) {
+      data_.compressed_data_size = value;
+    }
+    return true;
+  }
+
+  bool HasQuads() const { return has_quads_; }
+
+ private:
+  enum class Quads { kNone, kParents, kSubs };
+
+  const olp::geo::TileKey& root_;
+  std::vector<IndexData>& parents_;
+  std::vector<IndexData>& subs_;
+  Quads quads_{Quads::kNone};
+  IndexData data_;
+  std::string quad_key_;
+  bool has_data_handle_{false};
+  bool has_quad_key_{false};
+  bool has_quads_{false};
+};
 }  // namespace
 
 namespace olp {
@@ -83,6 +183,13 @@ QuadTreeIndex::QuadTreeIndex(cache::KeyValueCache::ValueTypePtr data) {
   data_ = reinterpret_cast<DataHeader*>(data->data());
   raw_data_ = data;
   size_ = data->size();
+
+  if (!IsValid()) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Unsupported or truncated blob");
+    data_ = nullptr;
+    raw_data_ = nullptr;
+    size_ = 0;
+  }
 }
 
 QuadTreeIndex::QuadTreeIndex(const olp::geo::TileKey& root, int depth,
@@ -90,58 +197,48 @@ QuadTreeIndex::QuadTreeIndex(const olp::geo::TileKey& root, int depth,
   std::vector<IndexData> subs;
   std::vector<IndexData> parents;
 
-  rapidjson::Document doc;
-  rapidjson::IStreamWrapper stream(json_stream);
-  doc.ParseStream(stream);
-
-  if (!doc.IsObject()) {
+  QuadsHandler handler(root, parents, subs);
+  if (!parser::parse_stream(json_stream, handler) || !handler.HasQuads()) {
     return;
   }
 
-  auto parent_quads_value = doc.FindMember(kParentQuadsKey);
-  auto sub_quads_value = doc.FindMember(kSubQuadsKey);
-
-  if (parent_quads_value == doc.MemberEnd() &&
-      sub_quads_value == doc.MemberEnd()) {
-    return;
-  }
-
-  if (parent_quads_value != doc.MemberEnd() &&
-      parent_quads_value->value.IsArray()) {
-    parents.reserve(parent_quads_value->value.Size());
-    for (auto& value : parent_quads_value->value.GetArray()) {
-      auto obj = value.GetObject();
+  CreateBlob(root, depth, std::move(parents), std::move(subs));
+}
 
-      if (!obj.HasMember(kDataHandleKey) || !obj[kDataHandleKey].IsString() ||
-          !obj.HasMember(kPartitionKey) || !obj[kPartitionKey].IsString()) {
-        continue;
-      }
+QuadTreeIndex::Columns QuadTreeIndex::GetColumns(size_t subkey_count,
+                                                 size_t parent_count) {
+  const size_t entry_count = subkey_count + parent_count;
+
+  Columns columns;
+  columns.sub_quadkeys = sizeof(DataHeaderV2);
+  columns.parent_keys = AlignColumn(columns.sub_quadkeys +
+                                    subkey_count * sizeof(std::uint16_t));
+  columns.versions =
+      columns.parent_keys + parent_count * sizeof(std::uint64_t);
+  columns.data_sizes = columns.versions + entry_count * sizeof(std::uint64_t);
+  columns.compressed_data_sizes =
+      columns.data_sizes + entry_count * sizeof(std::int64_t);
+  columns.strings =
+      columns.compressed_data_sizes + entry_count * sizeof(std::int64_t);
+  columns.heap =
+      columns.strings + entry_count * kEntryStringCount * sizeof(StringRef);
+  return columns;
+}
 
-      IndexData data = ParseCommonIndexData(value);
-      data.data_handle = obj[kDataHandleKey].GetString();
-      data.tile_key = root.FromHereTile(obj[kPartitionKey].GetString());
-      parents.push_back(std::move(data));
-    }
+bool QuadTreeIndex::IsValid() const {
+  if (size_ < sizeof(DataHeaderV2)) {
+    return false;
   }
-
-  if (sub_quads_value != doc.MemberEnd() && sub_quads_value->value.IsArray()) {
-    subs.reserve(sub_quads_value->value.Size());
-    for (auto& value : sub_quads_value->value.GetArray()) {
-      auto obj = value.GetObject();
-
-      if (!obj.HasMember(kDataHandleKey) || !obj[kDataHandleKey].IsString() ||
-          !obj.HasMember(kSubQuadKeyKey) || !obj[kSubQuadKeyKey].IsString()) {
-        continue;
-      }
-
-      IndexData data = ParseCommonIndexData(value);
-      data.data_handle = obj[kDataHandleKey].GetString();
-      data.tile_key = root.AddedSubHereTile(obj[kSubQuadKeyKey].GetString());
-      subs.push_back(std::move(data));
-    }
+  if (IsV2()) {
+    return GetColumns(data_->subkey_count, data_->parent_count).heap <= size_;
   }
+  return data_->blob_version == kBlobVersionV1 &&
+         static_cast<size_t>(DataBegin() -
+                             reinterpret_cast<const uint8_t*>(data_)) <= size_;
+}
 
-  CreateBlob(root, depth, std::move(parents), std::move(subs));
+bool QuadTreeIndex::IsV2() const {
+  return data_->blob_version == kBlobVersionV2;
 }
 
 bool QuadTreeIndex::ReadIndexData(QuadTreeIndex::IndexData& data,
@@ -158,15 +255,29 @@ bool QuadTreeIndex::ReadIndexData(QuadTreeIndex::IndexData& data,
   return success;
 }
 
-bool QuadTreeIndex::WriteIndexData(const IndexData& data,
-                                   BlobDataWriter& writer) {
-  bool success = writer.Write(data.version);
-  success &= writer.Write(data.data_size);
-  success &= writer.Write(data.compressed_data_size);
-  success &= writer.Write(data.data_handle);
-  success &= writer.Write(data.checksum);
-  success &= writer.Write(data.additional_metadata);
-  return success;
+bool QuadTreeIndex::ReadColumns(QuadTreeIndex::IndexData& data,
+                                size_t entry) const {
+  const auto columns = GetColumns(data_->subkey_count, data_->parent_count);
+  data.version = GetColumn<std::uint64_t>(columns.versions)[entry];
+  data.data_size = GetColumn<std::int64_t>(columns.data_sizes)[entry];
+  data.compressed_data_size =
+      GetColumn<std::int64_t>(columns.compressed_data_sizes)[entry];
+
+  const auto* strings =
+      GetColumn<StringRef>(columns.strings) + entry * kEntryStringCount;
+  const auto* heap = GetColumn<char>(columns.heap);
+  const size_t heap_size = size_ - columns.heap;
+
+  std::string* values[kEntryStringCount] = {
+      &data.data_handle, &data.checksum, &data.additional_metadata};
+  for (size_t index = 0u; index < kEntryStringCount; ++index) {
+    const StringRef& ref = strings[index];
+    if (ref.offset > heap_size || ref.size > heap_size - ref.offset) {
+      return false;
+    }
+    values[index]->assign(heap + ref.offset, ref.size);
+  }
+  return true;
 }
 
 void QuadTreeIndex::CreateBlob(olp::geo::TileKey root, int depth,
@@ -183,69 +294,71 @@ void QuadTreeIndex::CreateBlob(olp::geo::TileKey root, int depth,
               return lhs.tile_key.ToQuadKey64() < rhs.tile_key.ToQuadKey64();
             });
 
-  // count data size(for now it is header version and data handle)
-  size_t additional_data_size = 0;
-  for (const IndexData& data : subs) {
-    additional_data_size +=
-        data.data_handle.size() + 1 + data.checksum.size() + 1 +
-        data.additional_metadata.size() + 1 + sizeof(IndexData::data_size) +
-        sizeof(IndexData::compressed_data_size) + sizeof(IndexData::version);
+  size_t heap_size = 0;
+  for (const auto* quads : {&subs, &parents}) {
+    for (const IndexData& data : *quads) {
+      heap_size += data.data_handle.size() + data.checksum.size() +
+                   data.additional_metadata.size();
+    }
   }
-  for (const IndexData& data : parents) {
-    additional_data_size +=
-        data.data_handle.size() + 1 + data.checksum.size() + 1 +
-        data.additional_metadata.size() + 1 + sizeof(IndexData::data_size) +
-        sizeof(IndexData::compressed_data_size) + sizeof(IndexData::version);
+  if (heap_size > std::numeric_limits<std::uint32_t>::max()) {
+    OLP_SDK_LOG_ERROR(kLogTag, "Could not write IndexData");
+    return;
   }
 
-  // calculate and allocate size
-  size_ = sizeof(DataHeader) - sizeof(SubEntry) +
-          (subs.size() * sizeof(SubEntry)) +
-          (parents.size() * sizeof(ParentEntry)) + additional_data_size;
+  const auto columns = GetColumns(subs.size(), parents.size());
+  size_ = columns.heap + heap_size;
 
   raw_data_ = std::make_shared<cache::KeyValueCache::ValueType>(size_);
   data_ = reinterpret_cast<DataHeader*>(&(raw_data_->front()));
 
-  data_->root_tilekey = root.ToQuadKey64();
-  data_->blob_version = 0;
-  data_->depth = static_cast<int8_t>(depth);
-  data_->subkey_count = static_cast<uint16_t>(subs.size());
-  data_->parent_count = static_cast<uint8_t>(parents.size());
-
-  // write SubEntry tiles
-  SubEntry* entry_ptr = data_->entries;
+  auto* header = reinterpret_cast<DataHeaderV2*>(data_);
+  header->root_tilekey = root.ToQuadKey64();
+  header->blob_version = kBlobVersionV2;
+  header->depth = static_cast<int8_t>(depth);
+  header->subkey_count = static_cast<uint16_t>(subs.size());
+  header->parent_count = static_cast<uint8_t>(parents.size());
+
+  auto* blob = raw_data_->data();
+  auto* sub_quadkeys =
+      reinterpret_cast<std::uint16_t*>(blob + columns.sub_quadkeys);
+  auto* parent_keys =
+      reinterpret_cast<std::uint64_t*>(blob + columns.parent_keys);
+  auto* versions = reinterpret_cast<std::uint64_t*>(blob + columns.versions);
+  auto* data_sizes = reinterpret_cast<std::int64_t*>(blob + columns.data_sizes);
+  auto* compressed_data_sizes =
+      reinterpret_cast<std::int64_t*>(blob + columns.compressed_data_sizes);
+  auto* strings = reinterpret_cast<StringRef*>(blob + columns.strings);
+  auto* heap = blob + columns.heap;
+
+  std::uint32_t heap_offset = 0;
+  size_t entry = 0;
+  auto write_entry = [&](const IndexData& data) {
+    versions[entry] = data.version;
+    data_sizes[entry] = data.data_size;
+    compressed_data_sizes[entry] = data.compressed_data_size;
+    for (const auto* value :
+         {&data.data_handle, &data.checksum, &data.additional_metadata}) {
+      const auto size = static_cast<std::uint32_t>(value->size());
+      *strings++ = {heap_offset, size};
+      std::memcpy(heap + heap_offset, value->data(), size);
+      heap_offset += size;
+    }
+    ++entry;
+  };
 
   auto root_quad_level = root.Level();
-
-  BlobDataWriter serializer(*raw_data_);
-  serializer.SetOffset(const_cast<unsigned char*>(DataBegin()) -
-                       raw_data_->data());
   for (const IndexData& data : subs) {
-    *entry_ptr++ = {
+    *sub_quadkeys++ =
         std::uint16_t(olp::geo::QuadKey64Helper{data.tile_key.ToQuadKey64()}
                           .GetSubkey(data.tile_key.Level() - root_quad_level)
-                          .key),
-        static_cast<uint32_t>(serializer.GetOffset())};
-    if (!WriteIndexData(data, serializer)) {
-      OLP_SDK_LOG_ERROR(kLogTag, "Could not write IndexData");
-      raw_data_ = nullptr;
-      data_ = nullptr;
-      size_ = 0;
-      return;
-    }
+                          .key);
+    write_entry(data);
   }
 
-  ParentEntry* parent_ptr = reinterpret_cast<ParentEntry*>(entry_ptr);
   for (const IndexData& data : parents) {
-    *parent_ptr++ = {data.tile_key.ToQuadKey64(),
-                     static_cast<uint32_t>(serializer.GetOffset())};
-    if (!WriteIndexData(data, serializer)) {
-      OLP_SDK_LOG_ERROR(kLogTag, "Could not write IndexData");
-      raw_data_ = nullptr;
-      data_ = nullptr;
-      size_ = 0;
-      return;
-    }
+    *parent_keys++ = data.tile_key.ToQuadKey64();
+    write_entry(data);
   }
 }
 
@@ -259,30 +372,22 @@ boost::optional<QuadTreeIndex::IndexData> QuadTreeIndex::Find(
 
   IndexData data;
   if (tile_key.Level() >= root_tile_key.Level()) {
-    std::uint16_t sub = std::uint16_t(
+    const auto position = FindSubEntry(
         tile_key.GetSubkey64(tile_key.Level() - root_tile_key.Level()));
-
-    const SubEntry* end = SubEntryEnd();
-    const SubEntry* entry =
-        std::lower_bound(SubEntryBegin(), end, SubEntry{sub, 0});
-    if (entry == end || entry->sub_quadkey != sub) {
+    if (!position) {
       return aggregated ? FindNearestParent(tile_key) : boost::none;
     }
-    if (!ReadIndexData(data, entry->tag_offset)) {
+    if (!ReadSubEntry(data, *position)) {
       return boost::none;
     }
     data.tile_key = tile_key;
     return data;
   } else {
-    std::uint64_t key = tile_key.ToQuadKey64();
-
-    const ParentEntry* end = ParentEntryEnd();
-    const ParentEntry* entry =
-        std::lower_bound(ParentEntryBegin(), end, ParentEntry{key, 0});
-    if (entry == end || entry->key != key) {
+    const auto position = FindParentEntry(tile_key.ToQuadKey64());
+    if (!position) {
       return aggregated ? FindNearestParent(tile_key) : boost::none;
     }
-    if (!ReadIndexData(data, entry->tag_offset)) {
+    if (!ReadParentEntry(data, *position)) {
       return boost::none;
     }
     data.tile_key = tile_key;
@@ -294,26 +399,29 @@ boost::optional<QuadTreeIndex::IndexData> QuadTreeIndex::FindNearestParent(
   const olp::geo::TileKey& root_tile_key =
       olp::geo::TileKey::FromQuadKey64(data_->root_tilekey);
 
-  if (tile_key.Level() >= root_tile_key.Level()) {
-    for (auto it = SubEntryEnd(); it-- != SubEntryBegin();) {
-      auto key = root_tile_key.AddedSubkey64(it->sub_quadkey);
-      if (tile_key.IsChildOf(key)) {
-        IndexData data;
-        data.tile_key = key;
-        if (!ReadIndexData(data, it->tag_offset)) {
-          return boost::none;
-        }
-        return data;
+  // The closest ancestor under the root is the nearest parent.
+  const bool under_root = tile_key.IsChildOf(root_tile_key);
+  for (auto key = tile_key.Parent();
+       under_root && key.Level() >= root_tile_key.Level();
+       key = key.Parent()) {
+    const auto position =
+        FindSubEntry(key.GetSubkey64(key.Level() - root_tile_key.Level()));
+    if (position) {
+      IndexData data;
+      data.tile_key = key;
+      if (!ReadSubEntry(data, *position)) {
+        return boost::none;
       }
+      return data;
     }
   }
 
-  for (auto it = ParentEntryEnd(); it-- != ParentEntryBegin();) {
-    auto key = geo::TileKey::FromQuadKey64(it->key);
+  for (size_t position = data_->parent_count; position-- > 0u;) {
+    auto key = geo::TileKey::FromQuadKey64(GetParentKey(position));
     if (tile_key.IsChildOf(key)) {
       IndexData data;
       data.tile_key = key;
-      if (!ReadIndexData(data, it->tag_offset)) {
+      if (!ReadParentEntry(data, position)) {
         return boost::none;
       }
       return data;
@@ -322,26 +430,138 @@ boost::optional<QuadTreeIndex::IndexData> QuadTreeIndex::FindNearestParent(
   return boost::none;
 }
 
+boost::optional<size_t> QuadTreeIndex::FindSubEntry(
+    std::uint64_t sub_quadkey) const {
+  if (sub_entry_lookup_) {
+    if (sub_quadkey >= sub_entry_lookup_->size()) {
+      return boost::none;
+    }
+    const auto position = (*sub_entry_lookup_)[sub_quadkey];
+    return position != 0u ? boost::make_optional<size_t>(position - 1u)
+                          : boost::none;
+  }
+
+  if (sub_quadkey > std::numeric_limits<std::uint16_t>::max()) {
+    return boost::none;
+  }
+
+  const auto sub = static_cast<std::uint16_t>(sub_quadkey);
+  if (IsV2()) {
+    const auto columns = GetColumns(data_->subkey_count, data_->parent_count);
+    const auto* begin = GetColumn<std::uint16_t>(columns.sub_quadkeys);
+    const auto* end = begin + data_->subkey_count;
+    const auto* entry = std::lower_bound(begin, end, sub);
+    if (entry == end || *entry != sub) {
+      return boost::none;
+    }
+    return static_cast<size_t>(entry - begin);
+  }
+
+  const SubEntry* end = SubEntryEnd();
+  const SubEntry* entry =
+      std::lower_bound(SubEntryBegin(), end, SubEntry{sub, 0});
+  if (entry == end || entry->sub_quadkey != sub) {
+    return boost::none;
+  }
+  return static_cast<size_t>(entry - SubEntryBegin());
+}
+
+boost::optional<size_t> QuadTreeIndex::FindParentEntry(
+    std::uint64_t key) const {
+  if (IsV2()) {
+    const auto columns = GetColumns(data_->subkey_count, data_->parent_count);
+    const auto* begin = GetColumn<std::uint64_t>(columns.parent_keys);
+    const auto* end = begin + data_->parent_count;
+    const auto* entry = std::lower_bound(begin, end, key);
+    if (entry == end || *entry != key) {
+      return boost::none;
+    }
+    return static_cast<size_t>(entry - begin);
+  }
+
+  const ParentEntry* end = ParentEntryEnd();
+  const ParentEntry* entry =
+      std::lower_bound(ParentEntryBegin(), end, ParentEntry{key, 0});
+  if (entry == end || entry->key != key) {
+    return boost::none;
+  }
+  return static_cast<size_t>(entry - ParentEntryBegin());
+}
+
+std::uint16_t QuadTreeIndex::GetSubQuadKey(size_t position) const {
+  if (IsV2()) {
+    const auto columns = GetColumns(data_->subkey_count, data_->parent_count);
+    return GetColumn<std::uint16_t>(columns.sub_quadkeys)[position];
+  }
+  return SubEntryBegin()[position].sub_quadkey;
+}
+
+std::uint64_t QuadTreeIndex::GetParentKey(size_t position) const {
+  if (IsV2()) {
+    const auto columns = GetColumns(data_->subkey_count, data_->parent_count);
+    return GetColumn<std::uint64_t>(columns.parent_keys)[position];
+  }
+  return ParentEntryBegin()[position].key;
+}
+
+bool QuadTreeIndex::ReadSubEntry(IndexData& data, size_t position) const {
+  return IsV2() ? ReadColumns(data, position)
+                : ReadIndexData(data, SubEntryBegin()[position].tag_offset);
+}
+
+bool QuadTreeIndex::ReadParentEntry(IndexData& data, size_t position) const {
+  return IsV2()
+             ? ReadColumns(data, data_->subkey_count + position)
+             : ReadIndexData(data, ParentEntryBegin()[position].tag_offset);
+}
+
+QuadTreeIndex QuadTreeIndex::Share() const {
+  QuadTreeIndex index;
+  index.data_ = data_;
+  index.raw_data_ = raw_data_;
+  index.size_ = size_;
+  index.sub_entry_lookup_ = sub_entry_lookup_;
+  return index;
+}
+
+void QuadTreeIndex::CreateSubEntryLookup() {
+  // Sub quadkeys of the tiles `depth` levels below the root take up to
+  // 2 * depth + 1 bits, and must fit into the 16 bits of the entry.
+  if (IsNull() || sub_entry_lookup_ || data_->depth < 0 || data_->depth > 7) {
+    return;
+  }
+
+  auto lookup = std::make_shared<std::vector<std::uint16_t>>(
+      size_t(1) << (2 * data_->depth + 1), std::uint16_t(0));
+  for (size_t position = 0; position < data_->subkey_count; ++position) {
+    const auto sub_quadkey = GetSubQuadKey(position);
+    if (sub_quadkey < lookup->size()) {
+      (*lookup)[sub_quadkey] = static_cast<std::uint16_t>(position + 1u);
+    }
+  }
+  sub_entry_lookup_ = std::move(lookup);
+}
+
 std::vector<QuadTreeIndex::IndexData> QuadTreeIndex::GetIndexData() const {
   std::vector<QuadTreeIndex::IndexData> result;
   if (IsNull()) {
     return result;
   }
   result.reserve(data_->parent_count + data_->subkey_count);
-  for (auto it = ParentEntryEnd(); it-- != ParentEntryBegin();) {
+  for (size_t position = data_->parent_count; position-- > 0u;) {
     QuadTreeIndex::IndexData data;
-    data.tile_key = geo::TileKey::FromQuadKey64(it->key);
-    if (ReadIndexData(data, it->tag_offset)) {
+    data.tile_key = geo::TileKey::FromQuadKey64(GetParentKey(position));
+    if (ReadParentEntry(data, position)) {
       result.emplace_back(std::move(data));
     }
   }
-  for (auto it = SubEntryEnd(); it-- != SubEntryBegin();) {
+  const olp::geo::TileKey& root_tile_key =
+      olp::geo::TileKey::FromQuadKey64(data_->root_tilekey);
+  for (size_t position = data_->subkey_count; position-- > 0u;) {
     QuadTreeIndex::IndexData data;
-    const olp::geo::TileKey& root_tile_key =
-        olp::geo::TileKey::FromQuadKey64(data_->root_tilekey);
-    auto subtile = root_tile_key.AddedSubkey64(std::uint64_t(it->sub_quadkey));
-    data.tile_key = subtile;
-    if (ReadIndexData(data, it->tag_offset)) {
+    data.tile_key =
+        root_tile_key.AddedSubkey64(std::uint64_t(GetSubQuadKey(position)));
+    if (ReadSubEntry(data, position)) {
       result.emplace_back(std::move(data));
     }
   }
@@ -31,8 +31,6 @@ namespace olp {
 namespace dataservice {
 namespace read {
 
-class BlobDataWriter;
-
 class QuadTreeIndex {
  public:
   struct IndexData {
@@ -71,12 +69,23 @@ class QuadTreeIndex {
 
   std::vector<QuadTreeIndex::IndexData> GetIndexData() const;
 
+  /// Creates an instance that shares the data and the lookup table with this
+  /// one.
+  QuadTreeIndex Share() const;
+
+  /// Creates a table that maps the sub quadkeys to the entries directly, so
+  /// that `Find` does not search for them. The table is shared with the
+  /// instances created by `Share`.
+  void CreateSubEntryLookup();
+
   olp::geo::TileKey GetRootTile() const {
     return data_ ? olp::geo::TileKey::FromQuadKey64(data_->root_tilekey)
                  : olp::geo::TileKey();
   }
 
  private:
+  // The first blob layout keeps the data of the entries as tagged values
+  // behind the `SubEntry` and `ParentEntry` tables. It is only read.
   struct SubEntry {
     std::uint16_t sub_quadkey;
     std::uint32_t tag_offset;
@@ -101,12 +110,58 @@ class QuadTreeIndex {
     SubEntry entries[1];
   };
 
+  // The second blob layout starts with the same fields as `DataHeader`,
+  // followed by 8-byte aligned columns, so that it can be read in place.
+  struct DataHeaderV2 {
+    std::uint64_t root_tilekey;
+    std::uint16_t blob_version;
+    std::int8_t depth;
+    std::uint8_t parent_count;
+    std::uint16_t subkey_count;
+    std::uint16_t reserved;
+  };
+
+  // A string of an entry in the string heap of the second layout.
+  struct StringRef {
+    std::uint32_t offset;
+    std::uint32_t size;
+  };
+
+  // Offsets of the columns of the second layout from the blob start. The
+  // sub quadkeys and the parent quadkeys are sorted, the other columns hold
+  // the sub entries first and then the parent entries.
+  struct Columns {
+    size_t sub_quadkeys;
+    size_t parent_keys;
+    size_t versions;
+    size_t data_sizes;
+    size_t compressed_data_sizes;
+    size_t strings;
+    size_t heap;
+  };
+
+  static Columns GetColumns(size_t subkey_count, size_t parent_count);
+
+  bool IsValid() const;
+  bool IsV2() const;
+
   void CreateBlob(geo::TileKey root, int depth, std::vector<IndexData> parents,
                   std::vector<IndexData> subs);
 
   boost::optional<QuadTreeIndex::IndexData> FindNearestParent(
       geo::TileKey tile_key) const;
 
+  /// Returns the position of the sub entry with the `sub_quadkey`.
+  boost::optional<size_t> FindSubEntry(std::uint64_t sub_quadkey) const;
+  /// Returns the position of the parent entry with the quadkey `key`.
+  boost::optional<size_t> FindParentEntry(std::uint64_t key) const;
+
+  std::uint16_t GetSubQuadKey(size_t position) const;
+  std::uint64_t GetParentKey(size_t position) const;
+
+  bool ReadSubEntry(IndexData& data, size_t position) const;
+  bool ReadParentEntry(IndexData& data, size_t position) const;
+
   const SubEntry* SubEntryBegin() const { return data_->entries; }
   const SubEntry* SubEntryEnd() const {
     return SubEntryBegin() + data_->subkey_count;
@@ -122,16 +177,21 @@ class QuadTreeIndex {
   const uint8_t* DataBegin() const {
     return reinterpret_cast<const uint8_t*>(ParentEntryEnd());
   }
-  const uint8_t* DataEnd() const {
-    return reinterpret_cast<const uint8_t*>(data_) + size_;
+
+  template <typename T>
+  const T* GetColumn(size_t offset) const {
+    return reinterpret_cast<const T*>(reinterpret_cast<const uint8_t*>(data_) +
+                                      offset);
   }
 
-  bool WriteIndexData(const IndexData& data, BlobDataWriter& writer);
   bool ReadIndexData(IndexData& data, uint32_t offset) const;
+  bool ReadColumns(IndexData& data, size_t entry) const;
 
   DataHeader* data_ = nullptr;
   cache::KeyValueCache::ValueTypePtr raw_data_ = nullptr;
   size_t size_ = 0;
+  // Sub quadkey -> entry position + 1, or 0 if there is no entry.
+  std::shared_ptr<const std::vector<std::uint16_t>> sub_entry_lookup_;
 };
 
 }  // namespace read
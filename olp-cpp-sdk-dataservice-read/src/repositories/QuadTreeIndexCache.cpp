@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include "QuadTreeIndexCache.h"
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+namespace {
+constexpr auto kTimetMax = std::numeric_limits<time_t>::max();
+}  // namespace
+
+QuadTreeIndexCache::QuadTreeIndexCache(size_t max_size) : trees_(max_size) {}
+
+void QuadTreeIndexCache::Put(const CachePtr& cache, const std::string& key,
+                             const QuadTreeIndex& tree, time_t expiry) {
+  if (tree.IsNull()) {
+    return;
+  }
+
+  if (expiry <= 0) {
+    Remove(cache, key);
+    return;
+  }
+
+  auto shared_tree = std::make_shared<QuadTreeIndex>(tree.Share());
+  shared_tree->CreateSubEntryLookup();
+
+  const auto now = std::time(nullptr);
+  const auto expiry_time =
+      expiry < kTimetMax - now ? now + expiry : kTimetMax;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  trees_.InsertOrAssign(CacheInstanceKey(cache, key),
+                        TreeEntry{std::move(shared_tree), expiry_time});
+}
+
+bool QuadTreeIndexCache::Get(const CachePtr& cache, const std::string& key,
+                             QuadTreeIndex& tree) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = trees_.Find(CacheInstanceKey(cache, key));
+  if (it == trees_.end()) {
+    return false;
+  }
+
+  if (it->value().expiry_time <= std::time(nullptr)) {
+    trees_.Erase(it);
+    return false;
+  }
+
+  tree = it->value().tree->Share();
+  return true;
+}
+
+void QuadTreeIndexCache::Remove(const CachePtr& cache, const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  trees_.Erase(CacheInstanceKey(cache, key));
+}
+
+void QuadTreeIndexCache::RemoveWithPrefix(const CachePtr& cache,
+                                          const std::string& prefix) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<CacheInstanceKey> keys;
+  for (const auto& tree : trees_) {
+    const auto& key = tree.key();
+    if (IsSameCache(key, cache) &&
+        key.second.compare(0, prefix.size(), prefix) == 0) {
+      keys.push_back(key);
+    }
+  }
+
+  for (const auto& key : keys) {
+    trees_.Erase(key);
+  }
+}
+
+void QuadTreeIndexCache::SetMaxSize(size_t max_size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  trees_.Resize(max_size);
+}
+
+QuadTreeIndexCache& QuadTreeIndexCache::Instance() {
+  static QuadTreeIndexCache cache;
+  return cache;
+}
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
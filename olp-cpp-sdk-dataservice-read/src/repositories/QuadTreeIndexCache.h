@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <ctime>
+#include <string>
+
+#include <olp/core/utils/LruCache.h>
+#include "CacheInstanceKey.h"
+#include "QuadTreeIndex.h"
+
+namespace olp {
+namespace cache {
+class KeyValueCache;
+}
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/*
+ * @brief An in-memory LRU cache of the quadtrees read from a cache instance.
+ *
+ * Keeps the quadtree blobs together with their sub quadkey lookup tables, so
+ * that the repeated lookups under the same root neither read and copy the
+ * blob, nor search for the entries.
+ *
+ * Every quadtree is kept with the expiry time it is stored with in the
+ * `KeyValueCache` instance, and is dropped once expired. The caller updates
+ * this cache when the quadtree is stored or removed.
+ */
+class QuadTreeIndexCache final {
+ public:
+  using CachePtr = std::shared_ptr<cache::KeyValueCache>;
+
+  /// @param max_size The maximum size of the cached quadtrees in bytes.
+  explicit QuadTreeIndexCache(size_t max_size = 16u * 1024u * 1024u);
+
+  /// Stores the quadtree, and creates its lookup table.
+  /// @param expiry The expiry time (in seconds) of the quadtree.
+  void Put(const CachePtr& cache, const std::string& key,
+           const QuadTreeIndex& tree, time_t expiry);
+
+  /// Finds the quadtree stored with the key, unless it is expired.
+  bool Get(const CachePtr& cache, const std::string& key, QuadTreeIndex& tree);
+
+  /// Removes the quadtree stored with the key.
+  void Remove(const CachePtr& cache, const std::string& key);
+
+  /// Removes all the quadtrees stored with the keys that start with the prefix.
+  void RemoveWithPrefix(const CachePtr& cache, const std::string& prefix);
+
+  /// Sets the maximum size of the cached quadtrees in bytes.
+  void SetMaxSize(size_t max_size);
+
+  /// Returns the cache shared by all the repositories of the process.
+  static QuadTreeIndexCache& Instance();
+
+ private:
+  struct TreeEntry {
+    std::shared_ptr<const QuadTreeIndex> tree;
+    time_t expiry_time;
+  };
+
+  struct TreeCost {
+    std::size_t operator()(const TreeEntry& entry) const {
+      const auto raw_data = entry.tree->GetRawData();
+      return raw_data ? raw_data->size() : 1u;
+    }
+  };
+
+  std::mutex mutex_;
+  utils::LruCache<CacheInstanceKey, TreeEntry, TreeCost, CacheInstanceKeyLess>
+      trees_;
+};
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
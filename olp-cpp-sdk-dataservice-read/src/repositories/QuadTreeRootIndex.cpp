@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include "QuadTreeRootIndex.h"
+
+#include <algorithm>
+
+namespace olp {
+namespace dataservice {
+namespace read {
+namespace repository {
+
+QuadTreeRootIndex::QuadTreeRootIndex(size_t max_roots)
+    : max_roots_(max_roots) {}
+
+void QuadTreeRootIndex::Add(const CachePtr& cache, const std::string& layer_key,
+                            const geo::TileKey& root) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The index is a hint, when it grows too large it is simply rebuilt by the
+  // following lookups.
+  if (roots_count_ >= max_roots_) {
+    roots_.clear();
+    roots_count_ = 0u;
+  }
+
+  auto it = roots_.find(CacheInstanceKey(cache, layer_key));
+  if (it == roots_.end()) {
+    RemoveExpiredCaches();
+    it = roots_.emplace(CacheInstanceKey(cache, layer_key), Roots()).first;
+  }
+
+  if (it->second.insert(root.ToQuadKey64()).second) {
+    ++roots_count_;
+  }
+}
+
+void QuadTreeRootIndex::Remove(const CachePtr& cache,
+                               const std::string& layer_key,
+                               const geo::TileKey& root) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = roots_.find(CacheInstanceKey(cache, layer_key));
+  if (it == roots_.end()) {
+    return;
+  }
+
+  roots_count_ -= it->second.erase(root.ToQuadKey64());
+  if (it->second.empty()) {
+    roots_.erase(it);
+  }
+}
+
+void QuadTreeRootIndex::RemoveWithPrefix(const CachePtr& cache,
+                                         const std::string& prefix) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = roots_.lower_bound(CacheInstanceKey(cache, prefix));
+  while (it != roots_.end() && IsSameCache(it->first, cache) &&
+         it->first.second.compare(0, prefix.size(), prefix) == 0) {
+    roots_count_ -= it->second.size();
+    it = roots_.erase(it);
+  }
+}
+
+boost::optional<geo::TileKey> QuadTreeRootIndex::Find(
+    const CachePtr& cache, const std::string& layer_key,
+    const geo::TileKey& tile_key, std::uint32_t max_depth) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = roots_.find(CacheInstanceKey(cache, layer_key));
+  if (it == roots_.end()) {
+    return boost::none;
+  }
+
+  const auto depth = std::min(tile_key.Level(), max_depth);
+  for (int i = static_cast<int>(depth); i >= 0; --i) {
+    const auto root = tile_key.ChangedLevelBy(-i);
+    if (it->second.count(root.ToQuadKey64()) != 0u) {
+      return root;
+    }
+  }
+
+  return boost::none;
+}
+
+void QuadTreeRootIndex::RemoveExpiredCaches() {
+  for (auto it = roots_.begin(); it != roots_.end();) {
+    if (it->first.first.expired()) {
+      roots_count_ -= it->second.size();
+      it = roots_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+QuadTreeRootIndex& QuadTreeRootIndex::Instance() {
+  static QuadTreeRootIndex index;
+  return index;
+}
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include <olp/core/geo/tiling/TileKey.h>
+#include <boost/optional.hpp>
+#include "CacheInstanceKey.h"
+
+namespace olp {
+namespace cache {
+class KeyValueCache;
+}
+namespace dataservice {
+namespace read {
+namespace repository {
+
+/*
+ * @brief An in-memory index of the quadtree roots stored in the cache.
+ *
+ * Resolves the cached quadtree that covers a tile without probing the cache
+ * for every possible root. The index is only a hint: the cache can evict or
+ * expire the quadtrees at any time, so the caller verifies the found root with
+ * a cache lookup and removes it when it is not there anymore.
+ *
+ * The roots are grouped by the cache instance and the layer key (catalog,
+ * layer, and version). The cache instances are held weakly, and the roots of
+ * the destroyed caches are dropped.
+ */
+class QuadTreeRootIndex final {
+ public:
+  using CachePtr = std::shared_ptr<cache::KeyValueCache>;
+
+  explicit QuadTreeRootIndex(size_t max_roots = 64u * 1024u);
+
+  /// Adds the root of a cached quadtree.
+  void Add(const CachePtr& cache, const std::string& layer_key,
+           const geo::TileKey& root);
+
+  /// Removes the root of a quadtree that is no longer cached.
+  void Remove(const CachePtr& cache, const std::string& layer_key,
+              const geo::TileKey& root);
+
+  /// Removes all the roots of the layer keys that start with the prefix.
+  void RemoveWithPrefix(const CachePtr& cache, const std::string& prefix);
+
+  /*
+   * @brief Finds the root that covers the tile.
+   *
+   * @param max_depth The maximum number of levels between the root and the
+   * tile.
+   *
+   * @return The indexed root that is the farthest from the tile, or
+   * `boost::none` if none of the tile ancestors are indexed.
+   */
+  boost::optional<geo::TileKey> Find(const CachePtr& cache,
+                                     const std::string& layer_key,
+                                     const geo::TileKey& tile_key,
+                                     std::uint32_t max_depth) const;
+
+  /// Returns the index shared by all the repositories of the process.
+  static QuadTreeRootIndex& Instance();
+
+ private:
+  using Roots = std::unordered_set<std::uint64_t>;
+
+  void RemoveExpiredCaches();
+
+  mutable std::mutex mutex_;
+  std::map<CacheInstanceKey, Roots, CacheInstanceKeyLess> roots_;
+  size_t roots_count_{0u};
+  size_t max_roots_;
+};
+
+}  // namespace repository
+}  // namespace read
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include "repositories/BinaryCacheEncoding.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/generated/serializer/SerializerWrapper.h>
+#include "generated/serializer/JsonSerializer.h"
+#include "generated/serializer/PartitionsSerializer.h"
+
+namespace {
+namespace model = olp::dataservice::read::model;
+namespace binary = olp::dataservice::read::repository::binary;
+
+model::Partition CreatePartition(int index) {
+  model::Partition partition;
+  partition.SetPartition(std::to_string(23618364 + index));
+  partition.SetDataHandle("7636348E50215979A39B5F3A429EDDB4." +
+                          std::to_string(index));
+  partition.SetChecksum(std::string("291f66029c232400e3403cd6e9cfd36e"));
+  partition.SetDataSize(100500 + index);
+  partition.SetVersion(-1 - index);
+  return partition;
+}
+
+TEST(BinaryCacheEncodingTest, Partition) {
+  {
+    SCOPED_TRACE("All fields");
+
+    auto partition = CreatePartition(1);
+    partition.SetCompressedDataSize(300);
+    partition.SetCrc(std::string("c3f276d7"));
+
+    const auto value = binary::Encode(partition);
+    ASSERT_TRUE(binary::IsEncoded(value));
+
+    model::Partition decoded;
+    ASSERT_TRUE(binary::Decode(value, decoded));
+    EXPECT_EQ(decoded.GetPartition(), partition.GetPartition());
+    EXPECT_EQ(decoded.GetDataHandle(), partition.GetDataHandle());
+    ASSERT_TRUE(decoded.GetChecksum());
+    EXPECT_EQ(*decoded.GetChecksum(), *partition.GetChecksum());
+    ASSERT_TRUE(decoded.GetCompressedDataSize());
+    EXPECT_EQ(*decoded.GetCompressedDataSize(), 300);
+    ASSERT_TRUE(decoded.GetDataSize());
+    EXPECT_EQ(*decoded.GetDataSize(), *partition.GetDataSize());
+    ASSERT_TRUE(decoded.GetCrc());
+    EXPECT_EQ(*decoded.GetCrc(), "c3f276d7");
+    ASSERT_TRUE(decoded.GetVersion());
+    EXPECT_EQ(*decoded.GetVersion(), -2);
+  }
+
+  {
+    SCOPED_TRACE("Required fields");
+
+    model::Partition partition;
+    partition.SetPartition("1");
+    partition.SetDataHandle("handle");
+
+    model::Partition decoded;
+    ASSERT_TRUE(binary::Decode(binary::Encode(partition), decoded));
+    EXPECT_EQ(decoded.GetPartition(), "1");
+    EXPECT_EQ(decoded.GetDataHandle(), "handle");
+    EXPECT_FALSE(decoded.GetChecksum());
+    EXPECT_FALSE(decoded.GetCompressedDataSize());
+    EXPECT_FALSE(decoded.GetDataSize());
+    EXPECT_FALSE(decoded.GetCrc());
+    EXPECT_FALSE(decoded.GetVersion());
+  }
+}
+
+TEST(BinaryCacheEncodingTest, PartitionIds) {
+  const std::vector<std::string> partition_ids = {"1", "", "23618364"};
+
+  std::vector<std::string> decoded;
+  ASSERT_TRUE(binary::Decode(binary::Encode(partition_ids), decoded));
+  EXPECT_EQ(decoded, partition_ids);
+}
+
+TEST(BinaryCacheEncodingTest, LayerVersions) {
+  model::LayerVersions layer_versions;
+  layer_versions.SetVersion(4);
+  model::LayerVersion layer_version;
+  layer_version.SetLayer("testlayer");
+  layer_version.SetVersion(3);
+  layer_version.SetTimestamp(1589523408);
+  layer_versions.GetMutableLayerVersions().push_back(layer_version);
+
+  model::LayerVersions decoded;
+  ASSERT_TRUE(binary::Decode(binary::Encode(layer_versions), decoded));
+  EXPECT_EQ(decoded.GetVersion(), 4);
+  ASSERT_EQ(decoded.GetLayerVersions().size(), 1u);
+  EXPECT_EQ(decoded.GetLayerVersions().front().GetLayer(), "testlayer");
+  EXPECT_EQ(decoded.GetLayerVersions().front().GetVersion(), 3);
+  EXPECT_EQ(decoded.GetLayerVersions().front().GetTimestamp(), 1589523408);
+}
+
+TEST(BinaryCacheEncodingTest, InvalidValues) {
+  const auto value = binary::Encode(CreatePartition(1));
+  model::Partition partition;
+
+  {
+    SCOPED_TRACE("JSON");
+
+    const auto json = olp::serializer::serialize(CreatePartition(1));
+    EXPECT_FALSE(binary::IsEncoded(json));
+    EXPECT_FALSE(binary::Decode(json, partition));
+  }
+
+  {
+    SCOPED_TRACE("Truncated");
+
+    for (size_t size = 0; size < value.size(); ++size) {
+      EXPECT_FALSE(binary::Decode(value.substr(0, size), partition));
+    }
+  }
+
+  {
+    SCOPED_TRACE("Other model");
+
+    model::LayerVersions layer_versions;
+    EXPECT_FALSE(binary::Decode(value, layer_versions));
+  }
+}
+
+}  // namespace
@@ -26,6 +26,7 @@
 #include <olp/core/client/OlpClientFactory.h>
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/utils/Compression.h>
 #include <olp/dataservice/read/DataRequest.h>
 #include <olp/dataservice/read/TileRequest.h>
 #include <repositories/DataRepository.h>
@@ -52,6 +53,21 @@ constexpr auto kUrlResponse403 =
 
 constexpr auto kUrlBlobDataHandle = R"(4eed6ed1-0d32-43b9-ae79-043cb4256432)";
 
+constexpr auto kUrlLookupConfig =
+    R"(https://api-lookup.data.api.platform.here.com/lookup/v1/platform/apis)";
+
+constexpr auto kUrlResponseLookupConfig =
+    R"jsonString([{"api":"config","version":"v1","baseURL":"https://config.data.api.platform.here.com/config/v1","parameters":{}}])jsonString";
+
+constexpr auto kUrlConfig =
+    R"(https://config.data.api.platform.here.com/config/v1/catalogs/hrn:here:data::olp-here-test:hereos-internal-test-v2)";
+
+constexpr auto kUrlResponseConfigGzip =
+    R"jsonString({"id":"hereos-internal-test-v2","hrn":"hrn:here:data::olp-here-test:hereos-internal-test-v2","layers":[{"id":"testlayer","contentType":"text/plain","contentEncoding":"gzip"}],"version":3})jsonString";
+
+constexpr auto kUrlResponseConfigUncompressed =
+    R"jsonString({"id":"hereos-internal-test-v2","hrn":"hrn:here:data::olp-here-test:hereos-internal-test-v2","layers":[{"id":"testlayer","contentType":"application/octet-stream"}],"version":3})jsonString";
+
 constexpr auto kUrlQueryTreeIndex =
     R"(https://sab.query.data.api.platform.here.com/query/v1/catalogs/hrn:here:data::olp-here-test:hereos-internal-test-v2/layers/testlayer/versions/4/quadkeys/23064/depths/4)";
 
@@ -206,6 +222,113 @@ TEST_F(DataRepositoryTest, GetBlobDataCache) {
   ASSERT_TRUE(response.IsSuccessful());
 }
 
+TEST_F(DataRepositoryTest, GetBlobDataDecompressed) {
+  using olp::utils::Compression;
+  using olp::utils::ContentEncoding;
+  if (!Compression::IsSupported(ContentEncoding::kGzip)) {
+    GTEST_SKIP() << "Built without zlib";
+  }
+
+  const std::string data = "someData";
+  const auto compressed = Compression::Compress(
+      ContentEncoding::kGzip,
+      olp::http::BodySource::FromData(
+          std::make_shared<std::vector<std::uint8_t>>(data.begin(),
+                                                      data.end())));
+  ASSERT_TRUE(compressed);
+
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kUrlResponseLookup));
+
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlBlobData269), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          std::string(compressed->begin(), compressed->end())));
+
+  EXPECT_CALL(*network_mock_,
+              Send(IsGetRequest(kUrlLookupConfig), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kUrlResponseLookupConfig));
+
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlConfig), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kUrlResponseConfigGzip));
+
+  olp::client::CancellationContext context;
+
+  olp::dataservice::read::DataRequest request;
+  request.WithDataHandle(kUrlBlobDataHandle).WithDecompression(true);
+
+  olp::client::HRN hrn(GetTestCatalog());
+
+  auto response =
+      olp::dataservice::read::repository::DataRepository::GetBlobData(
+          hrn, kLayerId, kService, request, context, *settings_);
+
+  ASSERT_TRUE(response.IsSuccessful());
+  ASSERT_TRUE(response.GetResult());
+  EXPECT_EQ(data, std::string(response.GetResult()->begin(),
+                              response.GetResult()->end()));
+
+  // The cache keeps the compressed data.
+  request.WithDecompression(false);
+  response = olp::dataservice::read::repository::DataRepository::GetBlobData(
+      hrn, kLayerId, kService, request, context, *settings_);
+
+  ASSERT_TRUE(response.IsSuccessful());
+  ASSERT_TRUE(response.GetResult());
+  EXPECT_EQ(*compressed, *response.GetResult());
+}
+
+TEST_F(DataRepositoryTest, GetBlobDataNotDecompressedInOtherLayers) {
+  // Binary data of a layer without content encoding that only starts like
+  // gzip.
+  const std::vector<std::uint8_t> data = {0x1f, 0x8b, 0x08, 0x00, 0x2a};
+  ASSERT_TRUE(olp::utils::Compression::IsCompressed(
+      olp::utils::ContentEncoding::kGzip, data));
+
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kUrlResponseLookup));
+
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlBlobData269), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   std::string(data.begin(), data.end())));
+
+  EXPECT_CALL(*network_mock_,
+              Send(IsGetRequest(kUrlLookupConfig), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kUrlResponseLookupConfig));
+
+  EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlConfig), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kUrlResponseConfigUncompressed));
+
+  olp::client::CancellationContext context;
+
+  olp::dataservice::read::DataRequest request;
+  request.WithDataHandle(kUrlBlobDataHandle).WithDecompression(true);
+
+  olp::client::HRN hrn(GetTestCatalog());
+
+  auto response =
+      olp::dataservice::read::repository::DataRepository::GetBlobData(
+          hrn, kLayerId, kService, request, context, *settings_);
+
+  ASSERT_TRUE(response.IsSuccessful());
+  ASSERT_TRUE(response.GetResult());
+  EXPECT_EQ(data, *response.GetResult());
+}
+
 TEST_F(DataRepositoryTest, GetBlobDataImmediateCancel) {
   ON_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
       .WillByDefault(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
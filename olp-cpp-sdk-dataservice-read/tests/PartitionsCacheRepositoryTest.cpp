@@ -164,7 +164,8 @@ TEST(PartitionsCacheRepositoryTest, QuadTree) {
         .WillOnce(DoAll(SaveArg<0>(&key), Return(true)));
     repository.Put(layer, tile_key, depth, quad_tree, version);
 
-    EXPECT_CALL(*cache, Get(key)).WillOnce(Return(quad_tree.GetRawData()));
+    // The stored quad tree is kept in memory
+    EXPECT_CALL(*cache, Get(_)).Times(0);
     read::QuadTreeIndex tree;
     const auto result = repository.Get(layer, tile_key, depth, version, tree);
 
@@ -173,6 +174,43 @@ TEST(PartitionsCacheRepositoryTest, QuadTree) {
     ASSERT_EQ(*tree.GetRawData(), *quad_tree.GetRawData());
   }
 
+  {
+    SCOPED_TRACE("Get expiring quad tree");
+
+    auto stream = std::stringstream(kQuadkeyResponse);
+    read::QuadTreeIndex quad_tree(tile_key, depth, stream);
+    auto cache = std::make_shared<CacheMock>();
+    repository::PartitionsCacheRepository repository(
+        hrn, cache, std::chrono::seconds(60));
+
+    // The remaining expiry of the cached quad tree is unknown, so it is read
+    // from the cache every time
+    EXPECT_CALL(*cache, Get(_))
+        .Times(2)
+        .WillRepeatedly(Return(quad_tree.GetRawData()));
+    for (auto i = 0; i < 2; ++i) {
+      read::QuadTreeIndex tree;
+      ASSERT_TRUE(repository.Get(layer, tile_key, depth, version, tree));
+      ASSERT_EQ(*tree.GetRawData(), *quad_tree.GetRawData());
+    }
+  }
+
+  {
+    SCOPED_TRACE("Get quad tree from memory");
+
+    auto stream = std::stringstream(kQuadkeyResponse);
+    read::QuadTreeIndex quad_tree(tile_key, depth, stream);
+    auto cache = std::make_shared<CacheMock>();
+    repository::PartitionsCacheRepository repository(hrn, cache);
+
+    EXPECT_CALL(*cache, Get(_)).WillOnce(Return(quad_tree.GetRawData()));
+    for (auto i = 0; i < 2; ++i) {
+      read::QuadTreeIndex tree;
+      ASSERT_TRUE(repository.Get(layer, tile_key, depth, version, tree));
+      ASSERT_EQ(*tree.GetRawData(), *quad_tree.GetRawData());
+    }
+  }
+
   {
     SCOPED_TRACE("Empty quad tree");
 
@@ -189,6 +227,29 @@ TEST(PartitionsCacheRepositoryTest, QuadTree) {
     ASSERT_FALSE(result);
     ASSERT_TRUE(tree.IsNull());
   }
+
+  {
+    SCOPED_TRACE("Find quad tree without a cache lookup");
+
+    const auto quad_tree_depth = 4;
+    auto stream = std::stringstream(kQuadkeyResponse);
+    read::QuadTreeIndex quad_tree(tile_key, quad_tree_depth, stream);
+    auto cache = std::make_shared<CacheMock>();
+    repository::PartitionsCacheRepository repository(hrn, cache);
+    std::string key;
+
+    EXPECT_CALL(*cache, Put(_, _, _))
+        .WillOnce(DoAll(SaveArg<0>(&key), Return(true)));
+    repository.Put(layer, tile_key, quad_tree_depth, quad_tree, version);
+
+    EXPECT_CALL(*cache, Get(_)).Times(0);
+    read::QuadTreeIndex tree;
+    const auto result = repository.FindQuadTree(
+        layer, tile_key.ChangedLevelBy(3), quad_tree_depth, version, tree);
+
+    ASSERT_TRUE(result);
+    ASSERT_EQ(tree.GetRootTile(), tile_key);
+  }
 }
 
 TEST(PartitionsCacheRepositoryTest, GetPartitionHandle) {
@@ -703,6 +703,138 @@ TEST_F(PartitionsRepositoryTest, GetVersionedPartitions) {
   }
 }
 
+TEST_F(PartitionsRepositoryTest, StreamVersionedPartitions) {
+  std::shared_ptr<cache::KeyValueCache> default_cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  auto mock_network = std::make_shared<NetworkMock>();
+  const auto catalog = HRN::FromString(kCatalog);
+
+  OlpClientSettings settings;
+  settings.cache = default_cache;
+  settings.network_request_handler = mock_network;
+  settings.retry_settings.timeout = 1;
+
+  std::vector<size_t> page_sizes;
+  std::vector<std::string> partition_ids;
+  auto page_callback = [&](model::Partitions page) {
+    page_sizes.push_back(page.GetPartitions().size());
+    for (const auto& partition : page.GetPartitions()) {
+      partition_ids.push_back(partition.GetPartition());
+    }
+  };
+
+  const std::vector<std::string> expected_ids = {"269", "270", "3",
+                                                 "here_van_wc2018_pool"};
+  const std::vector<size_t> expected_page_sizes = {3u, 1u};
+
+  read::PartitionsRequest request;
+  request.WithPageSize(3u);
+
+  {
+    SCOPED_TRACE("Cache only, not found");
+
+    client::CancellationContext context;
+    auto response = repository::PartitionsRepository::StreamVersionedPartitions(
+        catalog, kVersionedLayerId, kVersion, context,
+        read::PartitionsRequest(request).WithFetchOption(read::CacheOnly),
+        settings, page_callback);
+
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(), ErrorCode::NotFound);
+    EXPECT_TRUE(page_sizes.empty());
+  }
+
+  {
+    SCOPED_TRACE("Fetch from network in pages");
+
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlLookupMetadata2), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     kOlpSdkHttpResponseLookupMetadata2));
+
+    EXPECT_CALL(*mock_network,
+                Send(IsGetRequest(kOlpSdkUrlVersionedPartitions), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                         olp::http::HttpStatusCode::OK),
+                                     kOlpSdkHttpResponsePartitions));
+
+    client::CancellationContext context;
+    auto response = repository::PartitionsRepository::StreamVersionedPartitions(
+        catalog, kVersionedLayerId, kVersion, context, request, settings,
+        page_callback);
+
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    EXPECT_EQ(response.GetResult(), 4u);
+    EXPECT_EQ(page_sizes, expected_page_sizes);
+    EXPECT_EQ(partition_ids, expected_ids);
+    testing::Mock::VerifyAndClearExpectations(mock_network.get());
+  }
+
+  {
+    SCOPED_TRACE("Read from cache in pages");
+
+    page_sizes.clear();
+    partition_ids.clear();
+
+    client::CancellationContext context;
+    auto response = repository::PartitionsRepository::StreamVersionedPartitions(
+        catalog, kVersionedLayerId, kVersion, context,
+        read::PartitionsRequest(request).WithFetchOption(read::CacheOnly),
+        settings, page_callback);
+
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    EXPECT_EQ(response.GetResult(), 4u);
+    EXPECT_EQ(page_sizes, expected_page_sizes);
+    EXPECT_EQ(partition_ids, expected_ids);
+
+    auto partitions = repository::PartitionsRepository::GetVersionedPartitions(
+        catalog, kVersionedLayerId, kVersion, context,
+        read::PartitionsRequest().WithFetchOption(read::CacheOnly), settings);
+    ASSERT_TRUE(partitions.IsSuccessful());
+    EXPECT_EQ(partitions.GetResult().GetPartitions().size(), 4u);
+  }
+
+  {
+    SCOPED_TRACE("Read from cache in pages of another size");
+
+    page_sizes.clear();
+    partition_ids.clear();
+
+    client::CancellationContext context;
+    auto response = repository::PartitionsRepository::StreamVersionedPartitions(
+        catalog, kVersionedLayerId, kVersion, context,
+        read::PartitionsRequest(request).WithPageSize(2u).WithFetchOption(
+            read::CacheOnly),
+        settings, page_callback);
+
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    EXPECT_EQ(response.GetResult(), 4u);
+    EXPECT_EQ(page_sizes, std::vector<size_t>({2u, 2u}));
+    EXPECT_EQ(partition_ids, expected_ids);
+  }
+
+  {
+    SCOPED_TRACE("Partition ids evicted from cache");
+
+    // The ids are cached in the pages of the stream.
+    const auto ids_key = catalog.ToCatalogHRNString() + "::" +
+                         kVersionedLayerId + "::" + std::to_string(kVersion) +
+                         "::partitions";
+    ASSERT_TRUE(default_cache->Remove(ids_key + "::1"));
+
+    client::CancellationContext context;
+    auto response = repository::PartitionsRepository::StreamVersionedPartitions(
+        catalog, kVersionedLayerId, kVersion, context,
+        read::PartitionsRequest(request).WithFetchOption(read::CacheOnly),
+        settings, page_callback);
+
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(response.GetError().GetErrorCode(), ErrorCode::NotFound);
+  }
+}
+
 TEST_F(PartitionsRepositoryTest, GetVolatilePartitions) {
   using testing::Return;
 
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/thread/ThreadPoolTaskScheduler.h>
+#include "PrefetchJob.h"
+
+namespace {
+namespace read = olp::dataservice::read;
+namespace repository = olp::dataservice::read::repository;
+using olp::client::CancellationContext;
+using olp::geo::TileKey;
+
+constexpr auto kWaitTimeout = std::chrono::seconds(10);
+
+std::vector<read::PrefetchJob::RootTile> MakeRootTiles(size_t count) {
+  std::vector<read::PrefetchJob::RootTile> root_tiles;
+  const auto first = TileKey::FromRowColumnLevel(0, 0, 8).ToQuadKey64();
+  for (size_t index = 0; index < count; ++index) {
+    root_tiles.emplace_back(TileKey::FromQuadKey64(first + index), 0u);
+  }
+  return root_tiles;
+}
+
+// Every root tile resolves to itself and its first child.
+read::PrefetchJob::Stages MakeStages() {
+  read::PrefetchJob::Stages stages;
+  stages.resolve = [](const repository::RootTilesForRequest& root_tiles,
+                      CancellationContext,
+                      repository::SubQuadsCallback on_sub_quads) {
+    for (const auto& root : root_tiles) {
+      on_sub_quads(root.first,
+                   {{root.first, "handle"},
+                    {root.first.ChangedLevelBy(1), "child-handle"}});
+    }
+    return repository::SubTilesResponse(repository::SubTilesResult());
+  };
+  stages.filter = [](repository::SubQuadsResult sub_quads) {
+    return sub_quads;
+  };
+  stages.download = [](const std::string&, CancellationContext) {
+    return read::DataResponse(nullptr);
+  };
+  return stages;
+}
+
+TEST(PrefetchJobTest, DownloadsAllTiles) {
+  auto stages = MakeStages();
+  std::vector<size_t> checkpoints;
+  stages.checkpoint = [&](size_t completed_roots) {
+    checkpoints.push_back(completed_roots);
+  };
+
+  std::promise<read::PrefetchTilesResponse> promise;
+  auto job = std::make_shared<read::PrefetchJob>(
+      MakeRootTiles(3), 0u, std::move(stages), read::PrefetchTilesRequest(),
+      nullptr, std::make_shared<olp::client::PendingRequests>(),
+      [&](read::PrefetchTilesResponse response) {
+        promise.set_value(std::move(response));
+      },
+      nullptr);
+  job->Start();
+
+  auto future = promise.get_future();
+  ASSERT_EQ(future.wait_for(kWaitTimeout), std::future_status::ready);
+  auto response = future.get();
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().size(), 6u);
+  ASSERT_FALSE(checkpoints.empty());
+  EXPECT_EQ(checkpoints.back(), 3u);
+}
+
+TEST(PrefetchJobTest, ResumesFromCheckpoint) {
+  std::atomic<size_t> downloads{0u};
+  auto stages = MakeStages();
+  stages.download = [&](const std::string&, CancellationContext) {
+    ++downloads;
+    return read::DataResponse(nullptr);
+  };
+
+  std::promise<read::PrefetchTilesResponse> promise;
+  auto job = std::make_shared<read::PrefetchJob>(
+      MakeRootTiles(4), 3u, std::move(stages), read::PrefetchTilesRequest(),
+      nullptr, std::make_shared<olp::client::PendingRequests>(),
+      [&](read::PrefetchTilesResponse response) {
+        promise.set_value(std::move(response));
+      },
+      nullptr);
+  job->Start();
+
+  auto future = promise.get_future();
+  ASSERT_EQ(future.wait_for(kWaitTimeout), std::future_status::ready);
+  auto response = future.get();
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().size(), 2u);
+  EXPECT_EQ(downloads.load(), 2u);
+}
+
+TEST(PrefetchJobTest, FailedTileBlocksCheckpoint) {
+  auto stages = MakeStages();
+  stages.download = [](const std::string& handle, CancellationContext) {
+    if (handle == "child-handle") {
+      return read::DataResponse(
+          olp::client::ApiError(olp::client::ErrorCode::Unknown, "Failed"));
+    }
+    return read::DataResponse(nullptr);
+  };
+  std::vector<size_t> checkpoints;
+  stages.checkpoint = [&](size_t completed_roots) {
+    checkpoints.push_back(completed_roots);
+  };
+
+  std::promise<read::PrefetchTilesResponse> promise;
+  auto job = std::make_shared<read::PrefetchJob>(
+      MakeRootTiles(3), 0u, std::move(stages), read::PrefetchTilesRequest(),
+      nullptr, std::make_shared<olp::client::PendingRequests>(),
+      [&](read::PrefetchTilesResponse response) {
+        promise.set_value(std::move(response));
+      },
+      nullptr);
+  job->Start();
+
+  auto future = promise.get_future();
+  ASSERT_EQ(future.wait_for(kWaitTimeout), std::future_status::ready);
+  auto response = future.get();
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().size(), 6u);
+  EXPECT_TRUE(checkpoints.empty());
+}
+
+TEST(PrefetchJobTest, LimitsPendingTiles) {
+  constexpr size_t kMaxPendingTiles = 4u;
+  std::atomic<size_t> pending{0u};
+  std::atomic<size_t> max_pending{0u};
+  std::atomic<size_t> reported_tiles{0u};
+
+  auto stages = MakeStages();
+  stages.download = [&](const std::string&, CancellationContext) {
+    auto current = ++pending;
+    auto observed = max_pending.load();
+    while (current > observed &&
+           !max_pending.compare_exchange_weak(observed, current)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    --pending;
+    return read::DataResponse(nullptr);
+  };
+
+  std::promise<read::PrefetchTilesResponse> promise;
+  auto job = std::make_shared<read::PrefetchJob>(
+      MakeRootTiles(50), 0u, std::move(stages),
+      read::PrefetchTilesRequest()
+          .WithQuadTreeConcurrency(1u)
+          .WithMaxPendingTiles(kMaxPendingTiles),
+      std::make_shared<olp::thread::ThreadPoolTaskScheduler>(8u),
+      std::make_shared<olp::client::PendingRequests>(),
+      [&](read::PrefetchTilesResponse response) {
+        promise.set_value(std::move(response));
+      },
+      [&](const read::PrefetchTileResult& result) {
+        EXPECT_TRUE(result.IsSuccessful());
+        ++reported_tiles;
+      });
+  job->Start();
+
+  auto future = promise.get_future();
+  ASSERT_EQ(future.wait_for(kWaitTimeout), std::future_status::ready);
+  auto response = future.get();
+  ASSERT_TRUE(response.IsSuccessful());
+
+  // The results are streamed to the tile callback, and are not collected.
+  EXPECT_TRUE(response.GetResult().empty());
+  EXPECT_EQ(reported_tiles.load(), 100u);
+
+  // A resolved batch of one root tile can exceed the limit by its tiles.
+  EXPECT_LE(max_pending.load(), kMaxPendingTiles + 1u);
+}
+
+}  // namespace
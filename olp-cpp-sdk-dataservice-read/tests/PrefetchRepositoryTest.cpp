@@ -17,17 +17,121 @@
  * License-Filename: LICENSE
  */
 
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <matchers/NetworkUrlMatchers.h>
+#include <mocks/NetworkMock.h>
 
+#include <olp/core/cache/CacheSettings.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
 #include <repositories/PrefetchTilesRepository.h>
 
 namespace {
+namespace read = olp::dataservice::read;
 namespace repository = olp::dataservice::read::repository;
+using ::testing::_;
+
+const auto kHrn = olp::client::HRN::FromString(
+    "hrn:here:data::olp-here-test:hereos-internal-test-v2");
+constexpr auto kLayerId = "testlayer";
+constexpr auto kVersion = 4;
+constexpr auto kWaitTimeout = std::chrono::seconds(5);
+constexpr auto kUrlLookup =
+    R"(https://api-lookup.data.api.platform.here.com/lookup/v1/resources/hrn:here:data::olp-here-test:hereos-internal-test-v2/apis)";
+constexpr auto kHttpResponseLookup =
+    R"jsonString([{"api":"query","version":"v1","baseURL":"https://query.data.api.platform.here.com/query/v1/catalogs/hereos-internal-test-v2","parameters":{}}])jsonString";
+constexpr auto kUrlQuadPrefix =
+    R"(https://query.data.api.platform.here.com/query/v1/catalogs/hereos-internal-test-v2/layers/testlayer/versions/4/quadkeys/)";
+
+std::string QuadTreeUrl(const olp::geo::TileKey& root_tile) {
+  return kUrlQuadPrefix + root_tile.ToHereTile() + "/depths/0";
+}
+
+std::string QuadTreeResponse(const olp::geo::TileKey& root_tile) {
+  return R"({"subQuads":[{"subQuadKey":"1","version":4,"dataHandle":")" +
+         root_tile.ToHereTile() + R"(-handle"}],"parentQuads":[]})";
+}
+
+repository::RootTilesForRequest MakeRootTiles(std::uint32_t count,
+                                              std::uint32_t row = 0u) {
+  repository::RootTilesForRequest root_tiles;
+  for (std::uint32_t column = 0; column < count; ++column) {
+    root_tiles.emplace(olp::geo::TileKey::FromRowColumnLevel(row, column, 10),
+                       0u);
+  }
+  return root_tiles;
+}
+
+// Answers the quadtree requests with the root tile of the requested URL.
+NetworkCallback ReturnQuadTree() {
+  return [](olp::http::NetworkRequest request,
+            olp::http::Network::Payload payload,
+            olp::http::Network::Callback callback,
+            olp::http::Network::HeaderCallback header_callback,
+            olp::http::Network::DataCallback data_callback) {
+    const auto& url = request.GetUrl();
+    const auto begin = std::string(kUrlQuadPrefix).size();
+    const auto root_tile = olp::geo::TileKey::FromHereTile(
+        url.substr(begin, url.find('/', begin) - begin));
+    return ReturnHttpResponse(GetResponse(olp::http::HttpStatusCode::OK),
+                              QuadTreeResponse(root_tile))(
+        request, payload, callback, header_callback, data_callback);
+  };
+}
+
+class PrefetchSubTilesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    network_mock_ = std::make_shared<NetworkMock>();
+    settings_.network_request_handler = network_mock_;
+    settings_.cache =
+        olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+    settings_.task_scheduler =
+        olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(4);
+    settings_.retry_settings.timeout = 30;
+
+    ON_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+        .WillByDefault(ReturnHttpResponse(
+            GetResponse(olp::http::HttpStatusCode::OK), kHttpResponseLookup));
+    EXPECT_CALL(*network_mock_, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+        .Times(::testing::AnyNumber());
+  }
+
+  void TearDown() override {
+    settings_.task_scheduler.reset();
+    network_mock_.reset();
+  }
+
+  repository::SubTilesResponse GetSubTiles(
+      const repository::RootTilesForRequest& root_tiles,
+      std::uint32_t concurrency,
+      repository::SubQuadsCallback on_sub_quads = nullptr) {
+    auto request = read::PrefetchTilesRequest().WithQuadTreeConcurrency(
+        concurrency);
+    return repository::PrefetchTilesRepository::GetSubTiles(
+        kHrn, kLayerId, request, kVersion, root_tiles,
+        olp::client::CancellationContext(), settings_, on_sub_quads);
+  }
+
+  std::shared_ptr<NetworkMock> network_mock_;
+  olp::client::OlpClientSettings settings_;
+};
 
 class PrefetchRepositoryTestable
     : protected repository::PrefetchTilesRepository {
  public:
+  using repository::PrefetchTilesRepository::FilterSkippedTiles;
   using repository::PrefetchTilesRepository::GetSlicedTiles;
+  using repository::PrefetchTilesRepository::GetTileKeyRanges;
+  using repository::PrefetchTilesRepository::IsInTileKeyRanges;
   using repository::PrefetchTilesRepository::SplitSubtree;
 };
 
@@ -217,4 +321,255 @@ TEST(PrefetchRepositoryTest, GetSlicedTilesSiblings) {
   ASSERT_EQ(root_tiles_depth.begin()->first, parent1);
   ASSERT_EQ(root_tiles_depth.begin()->second, 4);
 }
+
+TEST(PrefetchRepositoryTest, GetSlicedTilesWithRanges) {
+  auto tile = olp::geo::TileKey::FromHereTile("5904591");
+  const auto first = tile.ToQuadKey64() << 4;
+  olp::geo::TileKeyRange range;
+  range.first = first;
+  range.last = first + 15;
+
+  olp::dataservice::read::PrefetchTilesRequest request;
+  request.WithTileKeyRanges({range});
+  {
+    SCOPED_TRACE("No levels");
+    auto root_tiles_depth = PrefetchRepositoryTestable::GetSlicedTiles(
+        request, olp::geo::TileKey::LevelCount, olp::geo::TileKey::LevelCount);
+    auto expected = PrefetchRepositoryTestable::GetSlicedTiles(
+        {tile}, tile.Level() + 2, tile.Level() + 2);
+    ASSERT_FALSE(root_tiles_depth.empty());
+    EXPECT_EQ(root_tiles_depth, expected);
+  }
+  {
+    SCOPED_TRACE("Levels specified");
+    auto root_tiles_depth =
+        PrefetchRepositoryTestable::GetSlicedTiles(request, 11, 13);
+    auto expected = PrefetchRepositoryTestable::GetSlicedTiles({tile}, 11, 13);
+    EXPECT_EQ(root_tiles_depth, expected);
+  }
+  {
+    SCOPED_TRACE("Ranges and tile keys");
+    request.WithTileKeys({tile});
+    auto root_tiles_depth =
+        PrefetchRepositoryTestable::GetSlicedTiles(request, 11, 13);
+    auto expected = PrefetchRepositoryTestable::GetSlicedTiles({tile}, 11, 13);
+    EXPECT_EQ(root_tiles_depth, expected);
+  }
+}
+
+TEST(PrefetchRepositoryTest, FilterSkippedTilesWithRanges) {
+  auto tile = olp::geo::TileKey::FromHereTile("5904591");
+  auto child = tile.GetChild(0).GetChild(1);
+  olp::geo::TileKeyRange range;
+  range.first = child.ToQuadKey64();
+  range.last = range.first + 1;
+  const std::vector<olp::geo::TileKeyRange> ranges = {range};
+
+  EXPECT_TRUE(PrefetchRepositoryTestable::IsInTileKeyRanges(ranges, child));
+  EXPECT_FALSE(PrefetchRepositoryTestable::IsInTileKeyRanges(ranges, tile));
+  EXPECT_FALSE(PrefetchRepositoryTestable::IsInTileKeyRanges(
+      ranges, tile.GetChild(0).GetChild(3)));
+
+  repository::SubQuadsResult sub_tiles = {
+      {tile, "tile"},
+      {tile.GetChild(0), "parent"},
+      {child, "child"},
+      {child.GetChild(1), "grandchild"},
+      {tile.GetChild(1), "sibling"}};
+
+  olp::dataservice::read::PrefetchTilesRequest request;
+  request.WithTileKeyRanges(ranges);
+  {
+    SCOPED_TRACE("Only input tiles");
+    auto result = PrefetchRepositoryTestable::FilterSkippedTiles(
+        request, true, sub_tiles);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result.begin()->first, child);
+  }
+  {
+    SCOPED_TRACE("Levels specified");
+    request.WithMinLevel(0).WithMaxLevel(child.Level() + 1);
+    auto result = PrefetchRepositoryTestable::FilterSkippedTiles(
+        request, false, sub_tiles);
+    EXPECT_EQ(result.size(), 4u);
+    EXPECT_EQ(result.count(tile.GetChild(1)), 0u);
+  }
+}
+
+TEST(PrefetchRepositoryTest, GetTileKeyRangesWithPolygon) {
+  const std::vector<olp::geo::GeoCoordinates> polygon = {
+      olp::geo::GeoCoordinates::FromDegrees(52.3, 13.0),
+      olp::geo::GeoCoordinates::FromDegrees(52.3, 13.8),
+      olp::geo::GeoCoordinates::FromDegrees(52.7, 13.4)};
+
+  olp::dataservice::read::PrefetchTilesRequest request;
+  request.WithPolygon(polygon);
+  {
+    SCOPED_TRACE("No levels");
+    EXPECT_TRUE(PrefetchRepositoryTestable::GetTileKeyRanges(request).empty());
+  }
+  {
+    SCOPED_TRACE("Levels specified");
+    request.WithMinLevel(10).WithMaxLevel(14);
+    const auto ranges = PrefetchRepositoryTestable::GetTileKeyRanges(request);
+    ASSERT_FALSE(ranges.empty());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      EXPECT_EQ(olp::geo::TileKey::FromQuadKey64(ranges[i].first).Level(), 14u);
+      if (i > 0) {
+        EXPECT_LT(ranges[i - 1].last + 1, ranges[i].first);
+      }
+    }
+
+    // One quadtree query per ancestor on the minimum level.
+    std::set<olp::geo::TileKey> ancestors;
+    for (const auto& range : ranges) {
+      for (auto key = range.first; key <= range.last; ++key) {
+        ancestors.insert(
+            olp::geo::TileKey::FromQuadKey64(key).ChangedLevelTo(10));
+      }
+    }
+    const auto root_tiles = PrefetchRepositoryTestable::GetSlicedTiles(
+        request.WithTileKeyRanges(ranges), 10, 14);
+    ASSERT_EQ(root_tiles.size(), ancestors.size());
+    for (const auto& root_tile : root_tiles) {
+      EXPECT_EQ(ancestors.count(root_tile.first), 1u);
+      EXPECT_EQ(root_tile.second, 4u);
+    }
+  }
+  {
+    SCOPED_TRACE("Corridor");
+    request.WithPolygon({}).WithTileKeyRanges({}).WithCorridor(polygon, 100.0);
+    const auto ranges = PrefetchRepositoryTestable::GetTileKeyRanges(request);
+    EXPECT_FALSE(ranges.empty());
+  }
+}
+
+TEST_F(PrefetchSubTilesTest, ResolvesQuadTreesInParallel) {
+  for (const std::uint32_t concurrency : {2u, 4u}) {
+    SCOPED_TRACE("Concurrency " + std::to_string(concurrency));
+
+    std::mutex mutex;
+    std::condition_variable limit_reached;
+    size_t started = 0u;
+    size_t in_flight = 0u;
+    size_t max_in_flight = 0u;
+
+    // Each request waits until as many requests as allowed were started.
+    const auto quad_tree = ReturnQuadTree();
+    EXPECT_CALL(*network_mock_,
+                Send(IsGetRequestPrefix(kUrlQuadPrefix), _, _, _, _))
+        .Times(4)
+        .WillRepeatedly([&](olp::http::NetworkRequest request,
+                            olp::http::Network::Payload payload,
+                            olp::http::Network::Callback callback,
+                            olp::http::Network::HeaderCallback header_callback,
+                            olp::http::Network::DataCallback data_callback) {
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            ++started;
+            max_in_flight = std::max(max_in_flight, ++in_flight);
+            limit_reached.notify_all();
+            limit_reached.wait_for(lock, kWaitTimeout,
+                                   [&]() { return started >= concurrency; });
+            --in_flight;
+          }
+          return quad_tree(request, payload, callback, header_callback,
+                           data_callback);
+        });
+
+    // Other root tiles on each run, as the resolved quadtrees are cached.
+    const auto root_tiles = MakeRootTiles(4u, concurrency);
+    const auto response = GetSubTiles(root_tiles, concurrency);
+
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult().size(), root_tiles.size());
+    EXPECT_EQ(max_in_flight, concurrency);
+  }
+}
+
+TEST_F(PrefetchSubTilesTest, StreamsSubQuadsOfResolvedQuadTrees) {
+  std::mutex mutex;
+  std::vector<std::string> events;
+
+  const auto quad_tree = ReturnQuadTree();
+  EXPECT_CALL(*network_mock_,
+              Send(IsGetRequestPrefix(kUrlQuadPrefix), _, _, _, _))
+      .Times(2)
+      .WillRepeatedly([&](olp::http::NetworkRequest request,
+                          olp::http::Network::Payload payload,
+                          olp::http::Network::Callback callback,
+                          olp::http::Network::HeaderCallback header_callback,
+                          olp::http::Network::DataCallback data_callback) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          events.push_back("request " + request.GetUrl());
+        }
+        return quad_tree(request, payload, callback, header_callback,
+                         data_callback);
+      });
+
+  const auto root_tiles = MakeRootTiles(2u);
+  const auto response = GetSubTiles(
+      root_tiles, 1u,
+      [&](const olp::geo::TileKey& root_tile, repository::SubQuadsResult) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back("sub quads " + root_tile.ToHereTile());
+      });
+
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_TRUE(response.GetResult().empty());
+
+  // The tiles of the first subtree are passed on before the second subtree is
+  // requested.
+  const auto first = root_tiles.begin()->first;
+  const auto second = root_tiles.rbegin()->first;
+  EXPECT_THAT(events, ::testing::ElementsAre(
+                          "request " + QuadTreeUrl(first),
+                          "sub quads " + first.ToHereTile(),
+                          "request " + QuadTreeUrl(second),
+                          "sub quads " + second.ToHereTile()));
+}
+
+TEST_F(PrefetchSubTilesTest, ErrorCancelsOtherQuadTreeRequests) {
+  constexpr olp::http::RequestId kPendingRequestId = 42;
+  const auto root_tiles = MakeRootTiles(2u);
+  const auto pending_tile = root_tiles.begin()->first;
+  const auto failing_tile = root_tiles.rbegin()->first;
+
+  // The request of the first root tile never gets a response, the request of
+  // the second one fails once the first one is pending.
+  std::promise<void> pending;
+  auto pending_future = pending.get_future();
+  EXPECT_CALL(*network_mock_,
+              Send(IsGetRequest(QuadTreeUrl(pending_tile)), _, _, _, _))
+      .WillOnce([&](olp::http::NetworkRequest, olp::http::Network::Payload,
+                    olp::http::Network::Callback,
+                    olp::http::Network::HeaderCallback,
+                    olp::http::Network::DataCallback) {
+        pending.set_value();
+        return olp::http::SendOutcome(kPendingRequestId);
+      });
+  EXPECT_CALL(*network_mock_,
+              Send(IsGetRequest(QuadTreeUrl(failing_tile)), _, _, _, _))
+      .WillOnce([&](olp::http::NetworkRequest request,
+                    olp::http::Network::Payload payload,
+                    olp::http::Network::Callback callback,
+                    olp::http::Network::HeaderCallback header_callback,
+                    olp::http::Network::DataCallback data_callback) {
+        pending_future.wait_for(kWaitTimeout);
+        return ReturnHttpResponse(
+            GetResponse(olp::http::HttpStatusCode::FORBIDDEN), "Forbidden")(
+            request, payload, callback, header_callback, data_callback);
+      });
+  EXPECT_CALL(*network_mock_, Cancel(_)).Times(::testing::AnyNumber());
+  EXPECT_CALL(*network_mock_, Cancel(kPendingRequestId)).Times(1);
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto response = GetSubTiles(root_tiles, 2u);
+
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(response.GetError().GetHttpStatusCode(),
+            olp::http::HttpStatusCode::FORBIDDEN);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, kWaitTimeout);
+}
 }  // namespace
@@ -63,4 +63,58 @@ TEST(PrefetchTilesRequestTest, TileKeys) {
   }
 }
 
+TEST(PrefetchTilesRequestTest, TileKeyRanges) {
+  PrefetchTilesRequest request;
+  EXPECT_TRUE(request.GetTileKeyRanges().empty());
+
+  TileKeyRange range;
+  range.first = TileKey::FromHereTile("5904591").ToQuadKey64();
+  range.last = range.first + 10;
+  request.WithTileKeyRanges({range});
+
+  ASSERT_EQ(1u, request.GetTileKeyRanges().size());
+  EXPECT_TRUE(request.GetTileKeyRanges().front() == range);
+  EXPECT_TRUE(request.GetTileKeys().empty());
+}
+
+TEST(PrefetchTilesRequestTest, PolygonAndCorridor) {
+  PrefetchTilesRequest request;
+  EXPECT_TRUE(request.GetPolygon().empty());
+  EXPECT_TRUE(request.GetCorridor().empty());
+
+  const std::vector<GeoCoordinates> points = {
+      GeoCoordinates::FromDegrees(52.52, 13.40),
+      GeoCoordinates::FromDegrees(51.34, 12.37),
+      GeoCoordinates::FromDegrees(48.14, 11.58)};
+  request.WithPolygon(points).WithCorridor(points, 500.0);
+
+  EXPECT_EQ(3u, request.GetPolygon().size());
+  EXPECT_EQ(3u, request.GetCorridor().size());
+  EXPECT_DOUBLE_EQ(500.0, request.GetCorridorBuffer());
+}
+
+TEST(PrefetchTilesRequestTest, QuadTreeConcurrency) {
+  PrefetchTilesRequest request;
+  EXPECT_EQ(4u, request.GetQuadTreeConcurrency());
+
+  request.WithQuadTreeConcurrency(16u);
+  EXPECT_EQ(16u, request.GetQuadTreeConcurrency());
+}
+
+TEST(PrefetchTilesRequestTest, MaxPendingTiles) {
+  PrefetchTilesRequest request;
+  EXPECT_EQ(1024u, request.GetMaxPendingTiles());
+
+  request.WithMaxPendingTiles(64u);
+  EXPECT_EQ(64u, request.GetMaxPendingTiles());
+}
+
+TEST(PrefetchTilesRequestTest, Resumable) {
+  PrefetchTilesRequest request;
+  EXPECT_FALSE(request.IsResumable());
+
+  request.WithResumable(true);
+  EXPECT_TRUE(request.IsResumable());
+}
+
 }  // namespace
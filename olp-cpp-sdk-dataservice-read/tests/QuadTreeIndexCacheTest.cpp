@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <mocks/CacheMock.h>
+#include "repositories/QuadTreeIndexCache.h"
+
+namespace {
+namespace read = olp::dataservice::read;
+namespace repository = olp::dataservice::read::repository;
+using olp::geo::TileKey;
+
+constexpr auto kQuadTreeKey =
+    "hrn:here:data::olp-here-test:catalog::layer::381::1::quadtree";
+constexpr auto kQuadTreeResponse =
+    R"jsonString({"subQuads": [{"subQuadKey": "4","version":282,"dataHandle":"7636348E50215979A39B5F3A429EDDB4.282","dataSize":277},{"subQuadKey":"1","version":48,"dataHandle":"BD53A6D60A34C20DC42ACAB2650FE361.48","dataSize":89}],"parentQuads":[{"partition":"95","version":253,"dataHandle":"B6F7614316BB8B81478ED7AE370B22A6.253","dataSize":6765}]})jsonString";
+
+constexpr auto kNoExpiry = std::numeric_limits<time_t>::max();
+
+read::QuadTreeIndex CreateQuadTree() {
+  auto stream = std::stringstream(kQuadTreeResponse);
+  return read::QuadTreeIndex(TileKey::FromHereTile("381"), 1, stream);
+}
+
+TEST(QuadTreeIndexCacheTest, PutGet) {
+  repository::QuadTreeIndexCache tree_cache;
+  auto cache = std::make_shared<CacheMock>();
+  const auto quad_tree = CreateQuadTree();
+  ASSERT_FALSE(quad_tree.IsNull());
+
+  read::QuadTreeIndex tree;
+  EXPECT_FALSE(tree_cache.Get(cache, kQuadTreeKey, tree));
+
+  tree_cache.Put(cache, kQuadTreeKey, quad_tree, kNoExpiry);
+
+  {
+    SCOPED_TRACE("Quad tree shares the data");
+
+    ASSERT_TRUE(tree_cache.Get(cache, kQuadTreeKey, tree));
+    EXPECT_EQ(tree.GetRawData(), quad_tree.GetRawData());
+
+    auto data = tree.Find(TileKey::FromHereTile("381"), false);
+    ASSERT_TRUE(data);
+    EXPECT_EQ(data->data_handle, "BD53A6D60A34C20DC42ACAB2650FE361.48");
+  }
+
+  {
+    SCOPED_TRACE("Other caches do not share the quad tree");
+
+    EXPECT_FALSE(
+        tree_cache.Get(std::make_shared<CacheMock>(), kQuadTreeKey, tree));
+  }
+}
+
+TEST(QuadTreeIndexCacheTest, Remove) {
+  repository::QuadTreeIndexCache tree_cache;
+  auto cache = std::make_shared<CacheMock>();
+  const auto quad_tree = CreateQuadTree();
+  read::QuadTreeIndex tree;
+
+  {
+    SCOPED_TRACE("Remove key");
+
+    tree_cache.Put(cache, kQuadTreeKey, quad_tree, kNoExpiry);
+    tree_cache.Remove(cache, kQuadTreeKey);
+    EXPECT_FALSE(tree_cache.Get(cache, kQuadTreeKey, tree));
+  }
+
+  {
+    SCOPED_TRACE("Remove prefix");
+
+    tree_cache.Put(cache, kQuadTreeKey, quad_tree, kNoExpiry);
+    tree_cache.RemoveWithPrefix(cache, "hrn:here:data::olp-here-test:other::");
+    EXPECT_TRUE(tree_cache.Get(cache, kQuadTreeKey, tree));
+
+    tree_cache.RemoveWithPrefix(cache,
+                                "hrn:here:data::olp-here-test:catalog::");
+    EXPECT_FALSE(tree_cache.Get(cache, kQuadTreeKey, tree));
+  }
+}
+
+TEST(QuadTreeIndexCacheTest, MaxSize) {
+  const auto quad_tree = CreateQuadTree();
+  repository::QuadTreeIndexCache tree_cache(quad_tree.GetRawData()->size());
+  auto cache = std::make_shared<CacheMock>();
+  read::QuadTreeIndex tree;
+
+  tree_cache.Put(cache, "first", quad_tree, kNoExpiry);
+  tree_cache.Put(cache, "second", quad_tree, kNoExpiry);
+
+  EXPECT_FALSE(tree_cache.Get(cache, "first", tree));
+  EXPECT_TRUE(tree_cache.Get(cache, "second", tree));
+}
+
+TEST(QuadTreeIndexCacheTest, SetMaxSize) {
+  const auto quad_tree = CreateQuadTree();
+  repository::QuadTreeIndexCache tree_cache;
+  auto cache = std::make_shared<CacheMock>();
+  read::QuadTreeIndex tree;
+
+  tree_cache.Put(cache, "first", quad_tree, kNoExpiry);
+  tree_cache.Put(cache, "second", quad_tree, kNoExpiry);
+
+  // The least recently used quadtree is evicted
+  EXPECT_TRUE(tree_cache.Get(cache, "first", tree));
+  tree_cache.SetMaxSize(quad_tree.GetRawData()->size());
+  EXPECT_TRUE(tree_cache.Get(cache, "first", tree));
+  EXPECT_FALSE(tree_cache.Get(cache, "second", tree));
+
+  tree_cache.SetMaxSize(0u);
+  EXPECT_FALSE(tree_cache.Get(cache, "first", tree));
+  tree_cache.Put(cache, "first", quad_tree, kNoExpiry);
+  EXPECT_FALSE(tree_cache.Get(cache, "first", tree));
+}
+
+TEST(QuadTreeIndexCacheTest, Expiry) {
+  repository::QuadTreeIndexCache tree_cache;
+  auto cache = std::make_shared<CacheMock>();
+  const auto quad_tree = CreateQuadTree();
+  read::QuadTreeIndex tree;
+
+  {
+    SCOPED_TRACE("Not expired");
+
+    tree_cache.Put(cache, kQuadTreeKey, quad_tree, 60);
+    EXPECT_TRUE(tree_cache.Get(cache, kQuadTreeKey, tree));
+  }
+
+  {
+    SCOPED_TRACE("Expired");
+
+    tree_cache.Put(cache, kQuadTreeKey, quad_tree, 1);
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    EXPECT_FALSE(tree_cache.Get(cache, kQuadTreeKey, tree));
+  }
+
+  {
+    SCOPED_TRACE("Already expired");
+
+    tree_cache.Put(cache, kQuadTreeKey, quad_tree, 60);
+    tree_cache.Put(cache, kQuadTreeKey, quad_tree, 0);
+    EXPECT_FALSE(tree_cache.Get(cache, kQuadTreeKey, tree));
+  }
+}
+
+}  // namespace
@@ -17,12 +17,15 @@
  * License-Filename: LICENSE
  */
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 #include <gmock/gmock.h>
 #include <matchers/NetworkUrlMatchers.h>
 #include <mocks/CacheMock.h>
 #include <mocks/NetworkMock.h>
+#include "../src/BlobDataWriter.h"
 #include "../src/repositories/QuadTreeIndex.h"
 
 namespace {
@@ -35,6 +38,79 @@ constexpr auto HTTP_RESPONSE_MAILFORMED =
 constexpr auto HTTP_RESPONSE_WRONG_FORMAT =
     R"jsonString({"parentQuads": 0,"subQuads": 0})jsonString";
 
+using IndexData = read::QuadTreeIndex::IndexData;
+
+// Writes the index in the first blob layout, as it was stored in the cache by
+// the previous SDK versions.
+std::shared_ptr<std::vector<unsigned char>> CreateV1Blob(
+    const olp::geo::TileKey& root, int depth, std::vector<IndexData> subs,
+    std::vector<IndexData> parents) {
+  auto by_quadkey = [](const IndexData& lhs, const IndexData& rhs) {
+    return lhs.tile_key.ToQuadKey64() < rhs.tile_key.ToQuadKey64();
+  };
+  std::sort(subs.begin(), subs.end(), by_quadkey);
+  std::sort(parents.begin(), parents.end(), by_quadkey);
+
+  const size_t header_size = 16u;
+  const size_t sub_entry_size = 8u;
+  const size_t parent_entry_size = 16u;
+  auto blob = std::make_shared<std::vector<unsigned char>>(
+      header_size + subs.size() * sub_entry_size +
+      parents.size() * parent_entry_size);
+
+  read::BlobDataWriter writer(*blob);
+  writer.Write(root.ToQuadKey64());
+  writer.Write(std::uint16_t(0));
+  writer.Write(static_cast<std::int8_t>(depth));
+  writer.Write(static_cast<std::uint8_t>(parents.size()));
+  writer.Write(static_cast<std::uint16_t>(subs.size()));
+
+  size_t tag_offset = blob->size();
+  auto write_tag_offset = [&](const IndexData& data) {
+    writer.Write(static_cast<std::uint32_t>(tag_offset));
+    tag_offset += 3 * sizeof(std::int64_t) + data.data_handle.size() +
+                  data.checksum.size() + data.additional_metadata.size() + 3;
+  };
+
+  writer.SetOffset(header_size);
+  for (const auto& data : subs) {
+    writer.Write(static_cast<std::uint16_t>(
+        data.tile_key.GetSubkey64(data.tile_key.Level() - root.Level())));
+    writer.Write(std::uint16_t(0));
+    write_tag_offset(data);
+  }
+  for (const auto& data : parents) {
+    writer.Write(data.tile_key.ToQuadKey64());
+    write_tag_offset(data);
+    writer.Write(std::uint32_t(0));
+  }
+
+  blob->resize(tag_offset);
+  for (const auto* quads : {&subs, &parents}) {
+    for (const auto& data : *quads) {
+      writer.Write(data.version);
+      writer.Write(data.data_size);
+      writer.Write(data.compressed_data_size);
+      writer.Write(data.data_handle);
+      writer.Write(data.checksum);
+      writer.Write(data.additional_metadata);
+    }
+  }
+  return blob;
+}
+
+IndexData CreateIndexData(const std::string& here_tile,
+                          const std::string& data_handle, uint64_t version) {
+  IndexData data;
+  data.tile_key = olp::geo::TileKey::FromHereTile(here_tile);
+  data.data_handle = data_handle;
+  data.checksum = "checksum-" + here_tile;
+  data.version = version;
+  data.data_size = 100;
+  data.compressed_data_size = 50;
+  return data;
+}
+
 TEST(QuadTreeIndexTest, ParseBlob) {
   using testing::Return;
 
@@ -112,6 +188,28 @@ TEST(QuadTreeIndexTest, ParseBlob) {
     }
   }
 
+  {
+    SCOPED_TRACE("Find with sub entry lookup");
+
+    auto shared_index = index.Share();
+    shared_index.CreateSubEntryLookup();
+
+    const auto tiles = {"381", "95", "1524", "1526", "1561298", "5842",
+                        "4818", "3"};
+    for (const auto tile : tiles) {
+      const auto tile_key = olp::geo::TileKey::FromHereTile(tile);
+      for (const auto aggregated : {false, true}) {
+        auto expected = index.Find(tile_key, aggregated);
+        auto data = shared_index.Find(tile_key, aggregated);
+        ASSERT_EQ(data == boost::none, expected == boost::none);
+        if (expected) {
+          EXPECT_EQ(data->tile_key, expected->tile_key);
+          EXPECT_EQ(data->data_handle, expected->data_handle);
+        }
+      }
+    }
+  }
+
   {
     SCOPED_TRACE("Malformed JSon response");
 
@@ -142,4 +240,119 @@ TEST(QuadTreeIndexTest, ParseBlob) {
   }
 }
 
+TEST(QuadTreeIndexTest, ReadBlob) {
+  const auto root = olp::geo::TileKey::FromHereTile("381");
+
+  {
+    SCOPED_TRACE("Read the blob in place");
+
+    auto stream = std::stringstream(HTTP_RESPONSE_QUADKEYS);
+    read::QuadTreeIndex index(root, 1, stream);
+    ASSERT_FALSE(index.IsNull());
+
+    read::QuadTreeIndex cached(index.GetRawData());
+    ASSERT_FALSE(cached.IsNull());
+    EXPECT_EQ(cached.GetRawData(), index.GetRawData());
+    EXPECT_EQ(cached.GetRootTile(), root);
+
+    const auto expected = index.GetIndexData();
+    const auto data = cached.GetIndexData();
+    ASSERT_EQ(data.size(), 8u);
+    ASSERT_EQ(data.size(), expected.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+      EXPECT_EQ(data[i].tile_key, expected[i].tile_key);
+      EXPECT_EQ(data[i].data_handle, expected[i].data_handle);
+      EXPECT_EQ(data[i].version, expected[i].version);
+      EXPECT_EQ(data[i].data_size, expected[i].data_size);
+    }
+  }
+
+  {
+    SCOPED_TRACE("Read the first blob layout");
+
+    const std::vector<IndexData> subs = {
+        CreateIndexData("381", "handle-381", 48),
+        CreateIndexData("1526", "handle-1526", 282),
+        CreateIndexData("1524", "handle-1524", 281)};
+    const std::vector<IndexData> parents = {
+        CreateIndexData("95", "handle-95", 253),
+        CreateIndexData("5", "handle-5", 282)};
+
+    read::QuadTreeIndex index(CreateV1Blob(root, 1, subs, parents));
+    ASSERT_FALSE(index.IsNull());
+    EXPECT_EQ(index.GetRootTile(), root);
+
+    for (const auto& expected : subs) {
+      auto data = index.Find(expected.tile_key, false);
+      ASSERT_FALSE(data == boost::none);
+      EXPECT_EQ(data->tile_key, expected.tile_key);
+      EXPECT_EQ(data->data_handle, expected.data_handle);
+      EXPECT_EQ(data->checksum, expected.checksum);
+      EXPECT_EQ(data->version, expected.version);
+      EXPECT_EQ(data->data_size, expected.data_size);
+      EXPECT_EQ(data->compressed_data_size, expected.compressed_data_size);
+    }
+
+    auto parent = index.Find(olp::geo::TileKey::FromHereTile("95"), false);
+    ASSERT_FALSE(parent == boost::none);
+    EXPECT_EQ(parent->data_handle, "handle-95");
+    EXPECT_EQ(parent->version, 253u);
+
+    auto aggregated =
+        index.Find(olp::geo::TileKey::FromHereTile("5842"), true);
+    ASSERT_FALSE(aggregated == boost::none);
+    EXPECT_EQ(aggregated->data_handle, "handle-5");
+
+    auto shared_index = index.Share();
+    shared_index.CreateSubEntryLookup();
+    auto data = shared_index.Find(olp::geo::TileKey::FromHereTile("1524"),
+                                  false);
+    ASSERT_FALSE(data == boost::none);
+    EXPECT_EQ(data->data_handle, "handle-1524");
+
+    EXPECT_EQ(index.GetIndexData().size(), 5u);
+  }
+
+  {
+    SCOPED_TRACE("Unknown blob version");
+
+    auto stream = std::stringstream(HTTP_RESPONSE_QUADKEYS);
+    read::QuadTreeIndex index(root, 1, stream);
+    auto blob = std::make_shared<std::vector<unsigned char>>(
+        *index.GetRawData());
+    const std::uint16_t version = 1u;
+    std::memcpy(blob->data() + sizeof(std::uint64_t), &version,
+                sizeof(version));
+
+    EXPECT_TRUE(read::QuadTreeIndex(blob).IsNull());
+  }
+
+  {
+    SCOPED_TRACE("Truncated blob");
+
+    auto stream = std::stringstream(HTTP_RESPONSE_QUADKEYS);
+    read::QuadTreeIndex index(root, 1, stream);
+    auto blob = std::make_shared<std::vector<unsigned char>>(
+        *index.GetRawData());
+    blob->resize(24u);
+
+    EXPECT_TRUE(read::QuadTreeIndex(blob).IsNull());
+  }
+
+  {
+    SCOPED_TRACE("Corrupted string heap");
+
+    auto stream = std::stringstream(HTTP_RESPONSE_QUADKEYS);
+    read::QuadTreeIndex index(root, 1, stream);
+    auto blob = std::make_shared<std::vector<unsigned char>>(
+        *index.GetRawData());
+    // Drop the last data handle bytes of the heap.
+    blob->resize(blob->size() - 4u);
+
+    read::QuadTreeIndex corrupted(blob);
+    ASSERT_FALSE(corrupted.IsNull());
+    EXPECT_LT(corrupted.GetIndexData().size(), 8u);
+  }
+}
+
 }  // namespace
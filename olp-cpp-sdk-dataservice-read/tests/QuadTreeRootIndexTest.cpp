@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include <mocks/CacheMock.h>
+#include "repositories/QuadTreeRootIndex.h"
+
+namespace {
+namespace repository = olp::dataservice::read::repository;
+using olp::geo::TileKey;
+
+constexpr auto kLayerKey = "hrn:here:data::olp-here-test:catalog::layer::1::";
+constexpr auto kOtherLayerKey =
+    "hrn:here:data::olp-here-test:catalog::other::1::";
+
+TEST(QuadTreeRootIndexTest, Find) {
+  repository::QuadTreeRootIndex index;
+  auto cache = std::make_shared<CacheMock>();
+  const auto root = TileKey::FromRowColumnLevel(1, 1, 4);
+
+  EXPECT_FALSE(index.Find(cache, kLayerKey, root, 4u));
+
+  index.Add(cache, kLayerKey, root);
+
+  {
+    SCOPED_TRACE("Root and its children are covered");
+
+    EXPECT_EQ(index.Find(cache, kLayerKey, root, 4u).get_value_or({}), root);
+    EXPECT_EQ(index.Find(cache, kLayerKey, root.ChangedLevelBy(4), 4u)
+                  .get_value_or({}),
+              root);
+  }
+
+  {
+    SCOPED_TRACE("Tiles out of the depth are not covered");
+
+    EXPECT_FALSE(index.Find(cache, kLayerKey, root.ChangedLevelBy(5), 4u));
+    EXPECT_FALSE(index.Find(cache, kLayerKey, root.ChangedLevelBy(-1), 4u));
+  }
+
+  {
+    SCOPED_TRACE("Other layers and caches are not covered");
+
+    EXPECT_FALSE(index.Find(cache, kOtherLayerKey, root, 4u));
+    EXPECT_FALSE(
+        index.Find(std::make_shared<CacheMock>(), kLayerKey, root, 4u));
+  }
+
+  {
+    SCOPED_TRACE("Farthest root is found first");
+
+    const auto child = root.ChangedLevelBy(1);
+    index.Add(cache, kLayerKey, child);
+    EXPECT_EQ(index.Find(cache, kLayerKey, child.ChangedLevelBy(1), 4u)
+                  .get_value_or({}),
+              root);
+  }
+}
+
+TEST(QuadTreeRootIndexTest, Remove) {
+  repository::QuadTreeRootIndex index;
+  auto cache = std::make_shared<CacheMock>();
+  const auto root = TileKey::FromRowColumnLevel(1, 1, 4);
+
+  {
+    SCOPED_TRACE("Remove root");
+
+    index.Add(cache, kLayerKey, root);
+    index.Remove(cache, kLayerKey, root);
+    EXPECT_FALSE(index.Find(cache, kLayerKey, root, 4u));
+  }
+
+  {
+    SCOPED_TRACE("Remove layer");
+
+    index.Add(cache, kLayerKey, root);
+    index.Add(cache, kOtherLayerKey, root);
+    index.RemoveWithPrefix(cache,
+                           "hrn:here:data::olp-here-test:catalog::layer::");
+    EXPECT_FALSE(index.Find(cache, kLayerKey, root, 4u));
+    EXPECT_TRUE(index.Find(cache, kOtherLayerKey, root, 4u));
+  }
+}
+
+TEST(QuadTreeRootIndexTest, MaxRoots) {
+  repository::QuadTreeRootIndex index(2u);
+  auto cache = std::make_shared<CacheMock>();
+  const auto first = TileKey::FromRowColumnLevel(0, 0, 4);
+  const auto second = TileKey::FromRowColumnLevel(0, 1, 4);
+  const auto third = TileKey::FromRowColumnLevel(0, 2, 4);
+
+  index.Add(cache, kLayerKey, first);
+  index.Add(cache, kLayerKey, second);
+  index.Add(cache, kLayerKey, third);
+
+  EXPECT_FALSE(index.Find(cache, kLayerKey, first, 4u));
+  EXPECT_FALSE(index.Find(cache, kLayerKey, second, 4u));
+  EXPECT_TRUE(index.Find(cache, kLayerKey, third, 4u));
+}
+
+}  // namespace
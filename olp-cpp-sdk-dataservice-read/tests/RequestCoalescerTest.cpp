@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "RequestCoalescer.h"
+
+namespace {
+namespace read = olp::dataservice::read;
+using olp::client::ApiError;
+using olp::client::CancellationToken;
+using olp::client::ErrorCode;
+
+using Coalescer = read::RequestCoalescer<std::string>;
+using StringResponse = Coalescer::ResponseType;
+
+// Keeps the scheduled callbacks, so that the test decides when they complete.
+struct ManualScheduler {
+  Coalescer::ScheduleFunction Schedule() {
+    return [this](Coalescer::CallbackType callback) {
+      scheduled++;
+      callbacks.push_back(std::move(callback));
+      return CancellationToken([this]() { cancelled++; });
+    };
+  }
+
+  std::vector<Coalescer::CallbackType> callbacks;
+  std::atomic<int> scheduled{0};
+  std::atomic<int> cancelled{0};
+};
+
+TEST(RequestCoalescerTest, IdenticalRequestsShareTask) {
+  Coalescer coalescer;
+  ManualScheduler scheduler;
+
+  std::vector<StringResponse> responses;
+  for (int index = 0; index < 10; ++index) {
+    coalescer.Execute(
+        "key",
+        [&](StringResponse response) {
+          responses.push_back(std::move(response));
+        },
+        scheduler.Schedule());
+  }
+
+  ASSERT_EQ(scheduler.scheduled, 1);
+  scheduler.callbacks.front()(std::string("data"));
+
+  ASSERT_EQ(responses.size(), 10u);
+  for (const auto& response : responses) {
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(response.GetResult(), "data");
+  }
+
+  // The task is completed, the next request schedules a new one.
+  coalescer.Execute("key", nullptr, scheduler.Schedule());
+  EXPECT_EQ(scheduler.scheduled, 2);
+}
+
+TEST(RequestCoalescerTest, DifferentKeysAreNotShared) {
+  Coalescer coalescer;
+  ManualScheduler scheduler;
+
+  coalescer.Execute("key1", nullptr, scheduler.Schedule());
+  coalescer.Execute("key2", nullptr, scheduler.Schedule());
+
+  EXPECT_EQ(scheduler.scheduled, 2);
+}
+
+TEST(RequestCoalescerTest, Cancel) {
+  Coalescer coalescer;
+  ManualScheduler scheduler;
+
+  std::vector<StringResponse> first_responses;
+  std::vector<StringResponse> second_responses;
+  auto first_token = coalescer.Execute(
+      "key",
+      [&](StringResponse response) {
+        first_responses.push_back(std::move(response));
+      },
+      scheduler.Schedule());
+  auto second_token = coalescer.Execute(
+      "key",
+      [&](StringResponse response) {
+        second_responses.push_back(std::move(response));
+      },
+      scheduler.Schedule());
+
+  {
+    SCOPED_TRACE("Cancel one of the requests");
+
+    first_token.Cancel();
+    ASSERT_EQ(first_responses.size(), 1u);
+    EXPECT_EQ(first_responses.front().GetError().GetErrorCode(),
+              ErrorCode::Cancelled);
+    EXPECT_EQ(scheduler.cancelled, 0);
+  }
+
+  {
+    SCOPED_TRACE("Cancel the last request");
+
+    second_token.Cancel();
+    EXPECT_EQ(scheduler.cancelled, 1);
+    EXPECT_TRUE(second_responses.empty());
+
+    // The cancelled task is not shared with new requests.
+    coalescer.Execute("key", nullptr, scheduler.Schedule());
+    EXPECT_EQ(scheduler.scheduled, 2);
+
+    scheduler.callbacks.front()(ApiError(ErrorCode::Cancelled, "Cancelled"));
+    ASSERT_EQ(second_responses.size(), 1u);
+    EXPECT_EQ(second_responses.front().GetError().GetErrorCode(),
+              ErrorCode::Cancelled);
+    EXPECT_EQ(first_responses.size(), 1u);
+  }
+}
+
+TEST(RequestCoalescerTest, ConcurrentRequests) {
+  Coalescer coalescer;
+  std::atomic<int> scheduled{0};
+  std::atomic<int> responses{0};
+
+  const int kThreads = 8;
+  const int kRequests = 1000;
+
+  auto schedule = [&](Coalescer::CallbackType callback) {
+    scheduled++;
+    std::thread([callback]() { callback(std::string("data")); }).detach();
+    return CancellationToken();
+  };
+
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < kThreads; ++thread) {
+    threads.emplace_back([&, thread]() {
+      for (int index = 0; index < kRequests; ++index) {
+        coalescer.Execute(
+            "key" + std::to_string(index % 4),
+            [&](StringResponse response) {
+              EXPECT_TRUE(response.IsSuccessful());
+              responses++;
+            },
+            schedule);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  while (responses.load() < kThreads * kRequests) {
+    std::this_thread::yield();
+  }
+
+  EXPECT_LE(scheduled.load(), kThreads * kRequests);
+  EXPECT_GE(scheduled.load(), 4);
+}
+
+}  // namespace
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+// clang-format off
+// this order is required
+#include "generated/parser/MessagesParser.h"
+#include "generated/parser/PartitionsParser.h"
+#include "generated/parser/SaxParser.h"
+#include <olp/core/generated/parser/JsonParser.h>
+// clang-format on
+
+namespace {
+namespace model = olp::dataservice::read::model;
+
+void ExpectEqual(const model::Partition& expected,
+                 const model::Partition& actual) {
+  EXPECT_EQ(expected.GetPartition(), actual.GetPartition());
+  EXPECT_EQ(expected.GetDataHandle(), actual.GetDataHandle());
+  EXPECT_EQ(expected.GetChecksum().get_value_or({}),
+            actual.GetChecksum().get_value_or({}));
+  EXPECT_EQ(expected.GetCrc().get_value_or({}),
+            actual.GetCrc().get_value_or({}));
+  EXPECT_EQ(expected.GetDataSize().get_value_or(-1),
+            actual.GetDataSize().get_value_or(-1));
+  EXPECT_EQ(expected.GetCompressedDataSize().get_value_or(-1),
+            actual.GetCompressedDataSize().get_value_or(-1));
+  EXPECT_EQ(expected.GetVersion().get_value_or(-1),
+            actual.GetVersion().get_value_or(-1));
+}
+
+std::string GeneratePartitionsJson(size_t count) {
+  std::string json = "{\"partitions\":[";
+  for (size_t index = 0u; index < count; ++index) {
+    if (index > 0u) {
+      json += ",";
+    }
+    json += "{\"checksum\":\"291f66029c232400e3403cd6e9cfd36e\","
+            "\"compressedDataSize\":1024,"
+            "\"dataHandle\":\"1b2ca68f-d4a0-4379-8120-cd025640510c\","
+            "\"dataSize\":" +
+            std::to_string(index) + ",\"partition\":\"" +
+            std::to_string(23618364 + index) + "\",\"version\":2}";
+  }
+  json += "],\"next\":\"url\"}";
+  return json;
+}
+
+TEST(SaxParserTest, Partitions) {
+  {
+    SCOPED_TRACE("Matches DOM parser");
+
+    const std::string json =
+        "{\"partitions\":["
+        "{\"checksum\":\"291f66\",\"compressedDataSize\":1024,"
+        "\"dataHandle\":\"handle-1\",\"dataSize\":2048,\"crc\":\"c3f276d7\","
+        "\"partition\":\"314010583\",\"version\":2},"
+        "{\"dataHandle\":\"handle-2\",\"partition\":\"314010584\","
+        "\"additionalMetadata\":{\"partition\":\"1\",\"list\":[{}, 1]}},"
+        "{}"
+        "],\"next\":\"url\",\"other\":[{\"partition\":\"0\"}]}";
+
+    auto expected = olp::parser::parse<model::Partitions>(json);
+    std::stringstream stream(json);
+    auto actual = olp::parser::parse_sax<model::Partitions>(stream);
+
+    ASSERT_EQ(expected.GetPartitions().size(), 3u);
+    ASSERT_EQ(actual.GetPartitions().size(), 3u);
+    for (size_t index = 0; index < 3u; ++index) {
+      ExpectEqual(expected.GetPartitions()[index],
+                  actual.GetPartitions()[index]);
+    }
+  }
+
+  {
+    SCOPED_TRACE("Members of unexpected type");
+
+    std::stringstream stream(
+        "{\"partitions\":[{\"dataHandle\":1,\"partition\":\"1\","
+        "\"dataSize\":null,\"version\":3.5,\"checksum\":[\"291f66\"]}]}");
+    auto partitions = olp::parser::parse_sax<model::Partitions>(stream);
+    ASSERT_EQ(partitions.GetPartitions().size(), 1u);
+
+    const auto& partition = partitions.GetPartitions().front();
+    EXPECT_EQ(partition.GetPartition(), "1");
+    EXPECT_TRUE(partition.GetDataHandle().empty());
+    EXPECT_FALSE(partition.GetDataSize());
+    EXPECT_FALSE(partition.GetVersion());
+    EXPECT_FALSE(partition.GetChecksum());
+  }
+
+  {
+    SCOPED_TRACE("Escaped strings");
+
+    std::stringstream stream(
+        "{\"partitions\":[{\"dataHandle\":\"a\\\"b\\nc\","
+        "\"partition\":\"1\"}]}");
+    auto partitions = olp::parser::parse_sax<model::Partitions>(stream);
+    ASSERT_EQ(partitions.GetPartitions().size(), 1u);
+    EXPECT_EQ(partitions.GetPartitions().front().GetDataHandle(), "a\"b\nc");
+    EXPECT_EQ(partitions.GetPartitions().front().GetPartition(), "1");
+  }
+
+  {
+    SCOPED_TRACE("Malformed JSON");
+
+    std::stringstream stream(
+        "{\"partitions\":[{\"dataHandle\":\"handle\",\"partition\":\"1\"}");
+    auto partitions = olp::parser::parse_sax<model::Partitions>(stream);
+    EXPECT_TRUE(partitions.GetPartitions().empty());
+  }
+
+  {
+    SCOPED_TRACE("No partitions");
+
+    std::stringstream stream("{\"partitions\":{\"partition\":\"1\"}}");
+    auto partitions = olp::parser::parse_sax<model::Partitions>(stream);
+    EXPECT_TRUE(partitions.GetPartitions().empty());
+  }
+}
+
+TEST(SaxParserTest, Messages) {
+  const std::string json =
+      "{\"messages\":["
+      "{\"metaData\":{\"partition\":\"314010583\",\"checksum\":\"ff74\","
+      "\"compressedDataSize\":152417,\"dataSize\":250110,\"data\":\"iVBO\","
+      "\"dataHandle\":\"bb76\",\"timestamp\":1517916706},"
+      "\"offset\":{\"partition\":7,\"offset\":38562}},"
+      "{\"offset\":{\"offset\":38563,\"partition\":\"7\"},"
+      "\"metaData\":{\"partition\":\"314010584\",\"data\":{\"a\":\"b\"}}},"
+      "{\"some_invalid_json\":\"yes\"}"
+      "]}";
+
+  std::stringstream stream(json);
+  const auto messages =
+      olp::parser::parse_sax<model::Messages>(stream).GetMessages();
+  ASSERT_EQ(messages.size(), 3u);
+
+  {
+    SCOPED_TRACE("Valid message");
+
+    const auto& metadata = messages[0].GetMetaData();
+    EXPECT_EQ(metadata.GetPartition(), "314010583");
+    ASSERT_TRUE(metadata.GetData() != nullptr);
+    EXPECT_EQ(std::string(metadata.GetData()->begin(),
+                          metadata.GetData()->end()),
+              "iVBO");
+    EXPECT_EQ(metadata.GetChecksum().get_value_or({}), "ff74");
+    EXPECT_EQ(metadata.GetCompressedDataSize().get_value_or(0), 152417);
+    EXPECT_EQ(metadata.GetDataSize().get_value_or(0), 250110);
+    EXPECT_EQ(metadata.GetDataHandle().get_value_or({}), "bb76");
+    EXPECT_EQ(metadata.GetTimestamp().get_value_or(0), 1517916706);
+    EXPECT_EQ(messages[0].GetOffset().GetPartition(), 7);
+    EXPECT_EQ(messages[0].GetOffset().GetOffset(), 38562);
+  }
+
+  {
+    SCOPED_TRACE("Members of unexpected type");
+
+    const auto& metadata = messages[1].GetMetaData();
+    EXPECT_EQ(metadata.GetPartition(), "314010584");
+    EXPECT_TRUE(metadata.GetData() == nullptr);
+    EXPECT_FALSE(metadata.GetDataHandle());
+    EXPECT_EQ(messages[1].GetOffset().GetPartition(), 0);
+    EXPECT_EQ(messages[1].GetOffset().GetOffset(), 38563);
+  }
+
+  {
+    SCOPED_TRACE("Invalid message");
+
+    const auto& metadata = messages[2].GetMetaData();
+    EXPECT_TRUE(metadata.GetPartition().empty());
+    EXPECT_TRUE(metadata.GetData() == nullptr);
+    EXPECT_FALSE(metadata.GetChecksum());
+    EXPECT_EQ(messages[2].GetOffset().GetOffset(), 0);
+  }
+}
+
+TEST(SaxParserTest, PartitionsPages) {
+  const auto json = GeneratePartitionsJson(5u);
+
+  {
+    SCOPED_TRACE("All pages");
+
+    std::stringstream stream(json);
+    std::vector<size_t> page_sizes;
+    std::vector<std::string> ids;
+    const bool result = olp::parser::parse_sax_pages(
+        stream, 2u, [&](model::Partitions page) {
+          page_sizes.push_back(page.GetPartitions().size());
+          for (const auto& partition : page.GetPartitions()) {
+            ids.push_back(partition.GetPartition());
+          }
+          return true;
+        });
+
+    EXPECT_TRUE(result);
+    EXPECT_EQ(page_sizes, (std::vector<size_t>{2u, 2u, 1u}));
+    ASSERT_EQ(ids.size(), 5u);
+    EXPECT_EQ(ids.front(), "23618364");
+    EXPECT_EQ(ids.back(), "23618368");
+  }
+
+  {
+    SCOPED_TRACE("Stopped by the callback");
+
+    std::stringstream stream(json);
+    size_t pages = 0u;
+    const bool result =
+        olp::parser::parse_sax_pages(stream, 2u, [&](model::Partitions) {
+          ++pages;
+          return false;
+        });
+
+    EXPECT_FALSE(result);
+    EXPECT_EQ(pages, 1u);
+  }
+
+  {
+    SCOPED_TRACE("Malformed response");
+
+    std::stringstream stream("{\"partitions\":[{\"partition\":\"1\"},");
+    const bool result = olp::parser::parse_sax_pages(
+        stream, 2u, [](model::Partitions) { return true; });
+
+    EXPECT_FALSE(result);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/http/HttpStatusCode.h>
+#include <olp/core/thread/ThreadPoolTaskScheduler.h>
+#include "StreamConsumer.h"
+
+namespace {
+namespace read = olp::dataservice::read;
+namespace model = olp::dataservice::read::model;
+using olp::client::CancellationContext;
+
+constexpr auto kWaitTimeout = std::chrono::seconds(10);
+
+// Every consume returns the next batch of messages from two partitions,
+// numbered by the offsets, and a new correlation id.
+class FakeStream {
+ public:
+  void SetMessagesPerBatch(size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages_per_batch_ = count;
+  }
+
+  read::StreamConsumer::ConsumeFunction Consume() {
+    return [=](CancellationContext,
+               std::string& correlation_id) -> read::PollResponse {
+      std::lock_guard<std::mutex> lock(mutex_);
+      consume_correlation_ids_.push_back(correlation_id);
+      correlation_id = "consume-" + std::to_string(consumed_batches_ + 1);
+      std::vector<model::Message> messages;
+      for (size_t index = 0; index < messages_per_batch_; ++index) {
+        model::StreamOffset offset;
+        offset.SetPartition(static_cast<int32_t>(next_offset_ % 2));
+        offset.SetOffset(next_offset_++);
+        model::Message message;
+        message.SetOffset(offset);
+        messages.push_back(message);
+      }
+      ++consumed_batches_;
+      model::Messages result;
+      result.SetMessages(std::move(messages));
+      return result;
+    };
+  }
+
+  read::StreamConsumer::CommitFunction Commit() {
+    return [=](const model::StreamOffsets& offsets,
+               CancellationContext,
+               std::string& correlation_id) -> read::Response<int> {
+      std::lock_guard<std::mutex> lock(mutex_);
+      commit_correlation_ids_.push_back(correlation_id);
+      if (fail_commits_ > 0u) {
+        --fail_commits_;
+        return olp::client::ApiError(
+            olp::client::ErrorCode::BadRequest, "Commit failed");
+      }
+      commits_.push_back(offsets);
+      return olp::http::HttpStatusCode::OK;
+    };
+  }
+
+  size_t ConsumedBatches() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return consumed_batches_;
+  }
+
+  std::vector<model::StreamOffsets> Commits() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return commits_;
+  }
+
+  std::vector<std::string> ConsumeCorrelationIds() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return consume_correlation_ids_;
+  }
+
+  std::vector<std::string> CommitCorrelationIds() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return commit_correlation_ids_;
+  }
+
+  void FailCommits(size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fail_commits_ = count;
+  }
+
+ private:
+  size_t messages_per_batch_{2u};
+  std::mutex mutex_;
+  int64_t next_offset_{0};
+  size_t consumed_batches_{0u};
+  size_t fail_commits_{0u};
+  std::vector<model::StreamOffsets> commits_;
+  std::vector<std::string> consume_correlation_ids_;
+  std::vector<std::string> commit_correlation_ids_;
+};
+
+class StreamConsumerTest : public ::testing::Test {
+ protected:
+  // Waits for the background tasks, like the client does on destruction.
+  void TearDown() override { pending_requests_->CancelAllAndWait(); }
+
+  std::shared_ptr<read::StreamConsumer> MakeConsumer(
+      const read::SubscribeRequest& request,
+      std::shared_ptr<olp::thread::TaskScheduler> task_scheduler = nullptr) {
+    return std::make_shared<read::StreamConsumer>(
+        request, "subscribe", stream_.Consume(), stream_.Commit(),
+        std::move(task_scheduler), pending_requests_);
+  }
+
+  FakeStream stream_;
+  std::shared_ptr<olp::thread::TaskScheduler> task_scheduler_ =
+      std::make_shared<olp::thread::ThreadPoolTaskScheduler>(1u);
+  std::shared_ptr<olp::client::PendingRequests> pending_requests_ =
+      std::make_shared<olp::client::PendingRequests>();
+};
+
+int64_t FirstOffset(const read::PollResponse& response) {
+  return response.GetResult().GetMessages().front().GetOffset().GetOffset();
+}
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate) {
+  const auto deadline = std::chrono::steady_clock::now() + kWaitTimeout;
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+TEST_F(StreamConsumerTest, CommitsBeforeReturningByDefault) {
+  stream_.SetMessagesPerBatch(3u);
+  auto consumer = MakeConsumer(read::SubscribeRequest());
+
+  auto response = consumer->Poll(CancellationContext());
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(response.GetResult().GetMessages().size(), 3u);
+
+  // The latest offset of every partition is committed.
+  auto commits = stream_.Commits();
+  ASSERT_EQ(commits.size(), 1u);
+  const auto& offsets = commits.front().GetOffsets();
+  ASSERT_EQ(offsets.size(), 2u);
+  EXPECT_EQ(offsets[0].GetPartition(), 0);
+  EXPECT_EQ(offsets[0].GetOffset(), 2);
+  EXPECT_EQ(offsets[1].GetPartition(), 1);
+  EXPECT_EQ(offsets[1].GetOffset(), 1);
+
+  // Nothing is left to commit.
+  EXPECT_TRUE(consumer->Flush(CancellationContext()).IsSuccessful());
+  EXPECT_EQ(stream_.Commits().size(), 1u);
+  EXPECT_EQ(stream_.ConsumedBatches(), 1u);
+}
+
+TEST_F(StreamConsumerTest, PrefetchesInBackground) {
+  auto consumer = MakeConsumer(
+      read::SubscribeRequest().WithPollPrefetch(2u), task_scheduler_);
+
+  auto response = consumer->Poll(CancellationContext());
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(FirstOffset(response), 0);
+
+  // The prefetch stops once the buffer is full.
+  ASSERT_TRUE(WaitFor([&] { return stream_.ConsumedBatches() == 3u; }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(stream_.ConsumedBatches(), 3u);
+
+  // The batches are returned in order.
+  for (int64_t offset = 2; offset < 10; offset += 2) {
+    response = consumer->Poll(CancellationContext());
+    ASSERT_TRUE(response.IsSuccessful());
+    EXPECT_EQ(FirstOffset(response), offset);
+  }
+  EXPECT_EQ(stream_.Commits().size(), 5u);
+}
+
+TEST_F(StreamConsumerTest, CommitsInBackground) {
+  auto consumer = MakeConsumer(
+      read::SubscribeRequest()
+          .WithCommitInterval(std::chrono::milliseconds(std::chrono::hours(1)))
+          .WithCommitBatchSize(4u),
+      task_scheduler_);
+
+  ASSERT_TRUE(consumer->Poll(CancellationContext()).IsSuccessful());
+  EXPECT_TRUE(stream_.Commits().empty());
+
+  // The batch size is reached.
+  ASSERT_TRUE(consumer->Poll(CancellationContext()).IsSuccessful());
+  ASSERT_TRUE(WaitFor([&] { return stream_.Commits().size() == 1u; }));
+  EXPECT_EQ(stream_.Commits().front().GetOffsets().back().GetOffset(), 3);
+
+  ASSERT_TRUE(consumer->Poll(CancellationContext()).IsSuccessful());
+  EXPECT_EQ(stream_.Commits().size(), 1u);
+
+  // The remaining offsets are committed on flush.
+  EXPECT_TRUE(consumer->Flush(CancellationContext()).IsSuccessful());
+  auto commits = stream_.Commits();
+  ASSERT_EQ(commits.size(), 2u);
+  EXPECT_EQ(commits.back().GetOffsets().back().GetOffset(), 5);
+}
+
+TEST_F(StreamConsumerTest, RestoresOffsetsOfFailedCommit) {
+  auto consumer = MakeConsumer(read::SubscribeRequest());
+
+  stream_.FailCommits(1u);
+  auto response = consumer->Poll(CancellationContext());
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(response.GetError().GetErrorCode(),
+            olp::client::ErrorCode::BadRequest);
+  EXPECT_TRUE(stream_.Commits().empty());
+
+  EXPECT_TRUE(consumer->Flush(CancellationContext()).IsSuccessful());
+  auto commits = stream_.Commits();
+  ASSERT_EQ(commits.size(), 1u);
+  EXPECT_EQ(commits.front().GetOffsets().size(), 2u);
+}
+
+TEST_F(StreamConsumerTest, ResetDropsPrefetchedBatches) {
+  auto consumer = MakeConsumer(
+      read::SubscribeRequest().WithPollPrefetch(1u), task_scheduler_);
+
+  ASSERT_TRUE(consumer->Poll(CancellationContext()).IsSuccessful());
+  ASSERT_TRUE(WaitFor([&] { return stream_.ConsumedBatches() == 2u; }));
+
+  consumer->Reset();
+
+  // The next batch is consumed after the reset.
+  auto response = consumer->Poll(CancellationContext());
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(FirstOffset(response), 4);
+}
+
+TEST_F(StreamConsumerTest, UsesLatestCorrelationId) {
+  auto consumer = MakeConsumer(read::SubscribeRequest());
+
+  ASSERT_TRUE(consumer->Poll(CancellationContext()).IsSuccessful());
+  ASSERT_TRUE(consumer->Poll(CancellationContext()).IsSuccessful());
+
+  // The first consume sends the id of the subscription, then every request
+  // sends the id returned by the last consume.
+  const std::vector<std::string> consume_ids = {"subscribe", "consume-1"};
+  const std::vector<std::string> commit_ids = {"consume-1", "consume-2"};
+  EXPECT_EQ(stream_.ConsumeCorrelationIds(), consume_ids);
+  EXPECT_EQ(stream_.CommitCorrelationIds(), commit_ids);
+  EXPECT_EQ(consumer->GetCorrelationId(), "consume-2");
+}
+}  // namespace
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/thread/ThreadPoolTaskScheduler.h>
+#include "StreamDataLoader.h"
+
+namespace {
+namespace read = olp::dataservice::read;
+namespace model = olp::dataservice::read::model;
+using olp::client::CancellationContext;
+
+model::Data ToData(const std::string& value) {
+  return std::make_shared<std::vector<unsigned char>>(value.begin(),
+                                                      value.end());
+}
+
+// Every even message has a data handle, and every odd one embedded data.
+model::Messages MakeMessages(size_t count) {
+  std::vector<model::Message> messages(count);
+  for (size_t index = 0; index < count; ++index) {
+    model::Metadata metadata;
+    if (index % 2 == 0) {
+      metadata.SetDataHandle("handle-" + std::to_string(index));
+    } else {
+      metadata.SetData(ToData("embedded-" + std::to_string(index)));
+    }
+    messages[index].SetMetaData(metadata);
+  }
+  model::Messages result;
+  result.SetMessages(std::move(messages));
+  return result;
+}
+
+std::string ToString(const read::DataResponse& response) {
+  const auto& data = response.GetResult();
+  return data ? std::string(data->begin(), data->end()) : std::string();
+}
+
+class StreamDataLoaderTest : public ::testing::Test {
+ protected:
+  // Waits for the background tasks, like the client does on destruction.
+  void TearDown() override { pending_requests_->CancelAllAndWait(); }
+
+  std::shared_ptr<olp::thread::TaskScheduler> task_scheduler_ =
+      std::make_shared<olp::thread::ThreadPoolTaskScheduler>(4u);
+  std::shared_ptr<olp::client::PendingRequests> pending_requests_ =
+      std::make_shared<olp::client::PendingRequests>();
+};
+
+TEST_F(StreamDataLoaderTest, KeepsOrderOfMessages) {
+  std::atomic<size_t> running{0u};
+  std::atomic<size_t> max_running{0u};
+  auto download = [&](const std::string& data_handle,
+                      CancellationContext) -> read::DataResponse {
+    const auto current = ++running;
+    auto max = max_running.load();
+    while (current > max && !max_running.compare_exchange_weak(max, current)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    --running;
+    return ToData(data_handle);
+  };
+
+  const auto messages = MakeMessages(20u);
+  auto response =
+      read::LoadMessagesData(messages, 3u, download, task_scheduler_,
+                             pending_requests_, CancellationContext());
+
+  ASSERT_TRUE(response.IsSuccessful());
+  const auto& result = response.GetResult();
+  ASSERT_EQ(result.size(), 20u);
+  for (size_t index = 0; index < result.size(); ++index) {
+    ASSERT_TRUE(result[index].IsSuccessful());
+    const auto prefix = index % 2 == 0 ? "handle-" : "embedded-";
+    EXPECT_EQ(ToString(result[index]), prefix + std::to_string(index));
+  }
+
+  EXPECT_GT(max_running.load(), 1u);
+  EXPECT_LE(max_running.load(), 3u);
+}
+
+TEST_F(StreamDataLoaderTest, DownloadsSequentiallyWithoutTaskScheduler) {
+  std::vector<std::string> handles;
+  auto download = [&](const std::string& data_handle,
+                      CancellationContext) -> read::DataResponse {
+    handles.push_back(data_handle);
+    if (data_handle == "handle-2") {
+      return olp::client::ApiError(olp::client::ErrorCode::NotFound,
+                                   "Not found");
+    }
+    return ToData(data_handle);
+  };
+
+  auto response =
+      read::LoadMessagesData(MakeMessages(5u), 8u, download, nullptr,
+                             pending_requests_, CancellationContext());
+
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(handles,
+            (std::vector<std::string>{"handle-0", "handle-2", "handle-4"}));
+
+  // A failed download does not fail the other messages.
+  const auto& result = response.GetResult();
+  ASSERT_EQ(result.size(), 5u);
+  EXPECT_TRUE(result[0].IsSuccessful());
+  ASSERT_FALSE(result[2].IsSuccessful());
+  EXPECT_EQ(result[2].GetError().GetErrorCode(),
+            olp::client::ErrorCode::NotFound);
+  EXPECT_EQ(ToString(result[4]), "handle-4");
+}
+
+TEST_F(StreamDataLoaderTest, Cancel) {
+  CancellationContext context;
+  std::atomic<size_t> downloads{0u};
+  auto download = [&](const std::string& data_handle,
+                      CancellationContext) -> read::DataResponse {
+    if (++downloads == 2u) {
+      context.CancelOperation();
+    }
+    return ToData(data_handle);
+  };
+
+  auto response = read::LoadMessagesData(MakeMessages(40u), 1u, download,
+                                         task_scheduler_, pending_requests_,
+                                         context);
+
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(response.GetError().GetErrorCode(),
+            olp::client::ErrorCode::Cancelled);
+  EXPECT_EQ(downloads.load(), 2u);
+}
+}  // namespace
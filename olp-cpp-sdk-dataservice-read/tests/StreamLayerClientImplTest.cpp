@@ -631,6 +631,53 @@ TEST_F(StreamLayerClientImplTest, GetData) {
   }
 }
 
+TEST_F(StreamLayerClientImplTest, GetDataOfMessages) {
+  // One lookup serves the whole batch, and the embedded data is not
+  // downloaded.
+  SetupNetworkExpectation(kUrlLookup, kHttpResponseLookup,
+                          http::HttpStatusCode::OK);
+
+  SetupNetworkExpectation(kUrlBlobGetBlob, kBlobData.c_str(),
+                          http::HttpStatusCode::OK);
+
+  read::StreamLayerClientImpl client(kHrn, kLayerId, settings_);
+
+  model::Metadata embedded_metadata;
+  embedded_metadata.SetData(std::make_shared<std::vector<unsigned char>>(
+      kBlobData.rbegin(), kBlobData.rend()));
+  model::Message embedded_message;
+  embedded_message.SetMetaData(embedded_metadata);
+
+  model::Metadata metadata;
+  metadata.SetDataHandle(kDataHandle);
+  model::Message message;
+  message.SetMetaData(metadata);
+
+  model::Messages messages;
+  messages.SetMessages({embedded_message, message});
+
+  auto future = client.GetData(messages, 4u).GetFuture();
+
+  ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+
+  const auto response = future.get();
+  ASSERT_TRUE(response.IsSuccessful());
+  const auto& result = response.GetResult();
+  ASSERT_EQ(result.size(), 2u);
+
+  ASSERT_TRUE(result[0].IsSuccessful());
+  ASSERT_TRUE(result[0].GetResult());
+  EXPECT_THAT(*result[0].GetResult(),
+              ElementsAreArray(kBlobData.rbegin(), kBlobData.rend()));
+
+  ASSERT_TRUE(result[1].IsSuccessful());
+  ASSERT_TRUE(result[1].GetResult());
+  EXPECT_THAT(*result[1].GetResult(),
+              ElementsAreArray(kBlobData.begin(), kBlobData.end()));
+
+  Mock::VerifyAndClearExpectations(network_mock_.get());
+}
+
 TEST_F(StreamLayerClientImplTest, GetDataCancellableFuture) {
   SetupNetworkExpectation(kUrlLookup, kHttpResponseLookup,
                           http::HttpStatusCode::OK);
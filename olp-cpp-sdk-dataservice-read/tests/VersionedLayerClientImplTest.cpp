@@ -66,6 +66,8 @@ constexpr auto kDataRequestOtherTile =
     R"(https://blob-ireland.data.api.platform.here.com/blobstore/v1/catalogs/hereos-internal-test-v2/layers/testlayer/data/95c5c703-e00e-4c38-841e-e419367474f1)";
 constexpr auto kDataRequestOtherTile2 =
     R"(https://blob-ireland.data.api.platform.here.com/blobstore/v1/catalogs/hereos-internal-test-v2/layers/testlayer/data/e83b397a-2be5-45a8-b7fb-ad4cb3ea13b1)";
+constexpr auto kUrlBlobData =
+    R"(https://blob-ireland.data.api.platform.here.com/blobstore/v1/catalogs/hereos-internal-test-v2/layers/testlayer/data/4eed6ed1-0d32-43b9-ae79-043cb4256432)";
 TEST(VersionedLayerClientTest, CanBeMoved) {
   read::VersionedLayerClient client_a(olp::client::HRN(), "", boost::none, {});
   read::VersionedLayerClient client_b(std::move(client_a));
@@ -101,6 +103,75 @@ TEST(VersionedLayerClientTest, GetData) {
   }
 }
 
+TEST(VersionedLayerClientTest, GetDataCoalescesIdenticalRequests) {
+  std::shared_ptr<NetworkMock> network_mock = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network_mock;
+  settings.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  settings.task_scheduler =
+      olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(1);
+  read::VersionedLayerClient client(kHrn, kLayerId, kCatalogVersion,
+                                    std::move(settings));
+
+  EXPECT_CALL(*network_mock, Send(IsGetRequest(kUrlLookup), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kHttpResponseLookup));
+
+  auto wait_for_release = std::make_shared<std::promise<void>>();
+  auto network_called = std::make_shared<std::promise<void>>();
+  olp::http::RequestId request_id;
+  NetworkCallback send_mock;
+  CancelCallback cancel_mock;
+  std::tie(request_id, send_mock, cancel_mock) = GenerateNetworkMockActions(
+      network_called, wait_for_release,
+      {olp::http::HttpStatusCode::OK, "someData"});
+
+  // Only the first request reaches the network.
+  EXPECT_CALL(*network_mock, Send(IsGetRequest(kUrlBlobData), _, _, _, _))
+      .Times(1)
+      .WillOnce(testing::Invoke(std::move(send_mock)));
+  EXPECT_CALL(*network_mock, Cancel(_)).Times(0);
+
+  constexpr auto kRequests = 3u;
+  std::vector<std::promise<read::DataResponse>> promises(kRequests);
+  std::vector<olp::client::CancellationToken> tokens;
+  for (auto& promise : promises) {
+    tokens.push_back(client.GetData(
+        read::DataRequest().WithDataHandle(kBlobDataHandle),
+        [&promise](read::DataResponse response) {
+          promise.set_value(std::move(response));
+        }));
+  }
+
+  network_called->get_future().wait();
+
+  // Cancelling one request does not cancel the others.
+  tokens.front().Cancel();
+  auto cancelled_future = promises.front().get_future();
+  ASSERT_EQ(cancelled_future.wait_for(kTimeout), std::future_status::ready);
+  auto cancelled_response = cancelled_future.get();
+  ASSERT_FALSE(cancelled_response.IsSuccessful());
+  EXPECT_EQ(cancelled_response.GetError().GetErrorCode(),
+            olp::client::ErrorCode::Cancelled);
+
+  wait_for_release->set_value();
+
+  for (auto index = 1u; index < kRequests; ++index) {
+    auto future = promises[index].get_future();
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+
+    auto response = future.get();
+    ASSERT_TRUE(response.IsSuccessful());
+    ASSERT_TRUE(response.GetResult());
+    EXPECT_EQ("someData", std::string(response.GetResult()->begin(),
+                                      response.GetResult()->end()));
+  }
+
+  testing::Mock::VerifyAndClearExpectations(network_mock.get());
+}
+
 TEST(VersionedLayerClientTest, RemoveFromCachePartition) {
   olp::client::OlpClientSettings settings;
   std::shared_ptr<CacheMock> cache_mock = std::make_shared<CacheMock>();
@@ -167,6 +238,8 @@ TEST(VersionedLayerClientTest, RemoveFromCacheTileKey) {
   olp::client::OlpClientSettings settings;
   std::shared_ptr<CacheMock> cache_mock = std::make_shared<CacheMock>();
   settings.cache = cache_mock;
+  // Every operation reads the quad tree from the mocked cache.
+  settings.quad_tree_memory_cache_size = 0u;
 
   auto depth = 4;
   auto tile_key = olp::geo::TileKey::FromHereTile(kHereTile);
@@ -24,6 +24,7 @@
 #include <mocks/NetworkMock.h>
 #include <olp/core/cache/CacheSettings.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/utils/Compression.h>
 #include <olp/dataservice/read/CatalogClient.h>
 #include <olp/dataservice/read/PrefetchTileResult.h>
 #include "VolatileLayerClientImpl.h"
@@ -53,6 +54,18 @@ constexpr auto kHttpResponseLookup =
     R"jsonString([{"api":"query","version":"v1","baseURL":"https://query.data.api.platform.here.com/query/v1/catalogs/hereos-internal-test-v2","parameters":{}},
     {"api":"volatile-blob","version":"v1","baseURL":"https://volatile-blob-ireland.data.api.platform.here.com/blobstore/v1/catalogs/hereos-internal-test-v2","parameters":{}}])jsonString";
 
+constexpr auto kUrlLookupConfig =
+    R"(https://api-lookup.data.api.platform.here.com/lookup/v1/platform/apis)";
+
+constexpr auto kUrlConfig =
+    R"(https://config.data.api.platform.here.com/config/v1/catalogs/hrn:here:data::olp-here-test:hereos-internal-test-v2)";
+
+constexpr auto kHttpResponseLookupConfig =
+    R"jsonString([{"api":"config","version":"v1","baseURL":"https://config.data.api.platform.here.com/config/v1","parameters":{}}])jsonString";
+
+constexpr auto kHttpResponseConfigGzip =
+    R"jsonString({"id":"hereos-internal-test-v2","hrn":"hrn:here:data::olp-here-test:hereos-internal-test-v2","layers":[{"id":"testlayer","contentType":"text/plain","contentEncoding":"gzip"}],"version":3})jsonString";
+
 constexpr auto kHttpResponsePartition269 =
     R"jsonString({ "partitions": [{"version":4,"partition":"269","layer":"testlayer","dataHandle":"4eed6ed1-0d32-43b9-ae79-043cb4256432"}]})jsonString";
 
@@ -348,6 +361,146 @@ TEST(VolatileLayerClientImplTest, GetDataCancellableFutureCancel) {
             olp::client::ErrorCode::Cancelled);
 }
 
+TEST(VolatileLayerClientImplTest, GetDataCoalescesIdenticalRequests) {
+  std::shared_ptr<NetworkMock> network_mock = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network_mock;
+  settings.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  settings.task_scheduler =
+      olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(1);
+  read::VolatileLayerClientImpl client(kHrn, kLayerId, std::move(settings));
+
+  SetupNetworkExpectation(*network_mock, kUrlLookup, kHttpResponseLookup,
+                          olp::http::HttpStatusCode::OK);
+
+  auto wait_for_release = std::make_shared<std::promise<void>>();
+  auto network_called = std::make_shared<std::promise<void>>();
+  olp::http::RequestId request_id;
+  NetworkCallback send_mock;
+  CancelCallback cancel_mock;
+  std::tie(request_id, send_mock, cancel_mock) = GenerateNetworkMockActions(
+      network_called, wait_for_release,
+      {olp::http::HttpStatusCode::OK, kData1});
+
+  // Only the first request reaches the network.
+  EXPECT_CALL(*network_mock,
+              Send(IsGetRequest(kUrlVolatileBlobData), _, _, _, _))
+      .Times(1)
+      .WillOnce(testing::Invoke(std::move(send_mock)));
+  EXPECT_CALL(*network_mock, Cancel(_)).Times(0);
+
+  constexpr auto kRequests = 3u;
+  std::vector<std::promise<read::DataResponse>> promises(kRequests);
+  std::vector<olp::client::CancellationToken> tokens;
+  for (auto& promise : promises) {
+    tokens.push_back(client.GetData(
+        read::DataRequest().WithDataHandle(kBlobDataHandle),
+        [&promise](read::DataResponse response) {
+          promise.set_value(std::move(response));
+        }));
+  }
+
+  network_called->get_future().wait();
+
+  // Cancelling one request does not cancel the others.
+  tokens.back().Cancel();
+  auto cancelled_future = promises.back().get_future();
+  ASSERT_EQ(cancelled_future.wait_for(kTimeout), std::future_status::ready);
+  auto cancelled_response = cancelled_future.get();
+  ASSERT_FALSE(cancelled_response.IsSuccessful());
+  EXPECT_EQ(cancelled_response.GetError().GetErrorCode(),
+            olp::client::ErrorCode::Cancelled);
+
+  wait_for_release->set_value();
+
+  for (auto index = 0u; index + 1 < kRequests; ++index) {
+    auto future = promises[index].get_future();
+    ASSERT_EQ(future.wait_for(kTimeout), std::future_status::ready);
+
+    auto response = future.get();
+    ASSERT_TRUE(response.IsSuccessful());
+    ASSERT_TRUE(response.GetResult());
+    EXPECT_EQ(kData1, std::string(response.GetResult()->begin(),
+                                  response.GetResult()->end()));
+  }
+
+  Mock::VerifyAndClearExpectations(network_mock.get());
+}
+
+TEST(VolatileLayerClientImplTest, GetDataDoesNotCoalesceDecompression) {
+  using olp::utils::Compression;
+  using olp::utils::ContentEncoding;
+  if (!Compression::IsSupported(ContentEncoding::kGzip)) {
+    GTEST_SKIP() << "Built without zlib";
+  }
+
+  const std::string data = kData1;
+  const auto compressed = Compression::Compress(
+      ContentEncoding::kGzip,
+      olp::http::BodySource::FromData(
+          std::make_shared<std::vector<std::uint8_t>>(data.begin(),
+                                                      data.end())));
+  ASSERT_TRUE(compressed);
+
+  std::shared_ptr<NetworkMock> network_mock = std::make_shared<NetworkMock>();
+  olp::client::OlpClientSettings settings;
+  settings.network_request_handler = network_mock;
+  settings.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  settings.task_scheduler =
+      olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(1);
+  auto task_scheduler = settings.task_scheduler;
+  read::VolatileLayerClientImpl client(kHrn, kLayerId, std::move(settings));
+
+  SetupNetworkExpectation(*network_mock, kUrlLookup, kHttpResponseLookup,
+                          olp::http::HttpStatusCode::OK);
+  SetupNetworkExpectation(*network_mock, kUrlLookupConfig,
+                          kHttpResponseLookupConfig,
+                          olp::http::HttpStatusCode::OK);
+  SetupNetworkExpectation(*network_mock, kUrlConfig, kHttpResponseConfigGzip,
+                          olp::http::HttpStatusCode::OK);
+  EXPECT_CALL(*network_mock,
+              Send(IsGetRequest(kUrlVolatileBlobData), _, _, _, _))
+      .WillRepeatedly(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          std::string(compressed->begin(), compressed->end())));
+
+  // Holds the requests until both are made, so identical requests would be
+  // coalesced.
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  task_scheduler->ScheduleTask([released]() { released.wait(); });
+
+  auto compressed_future =
+      client.GetData(read::DataRequest().WithDataHandle(kBlobDataHandle))
+          .GetFuture();
+  auto decompressed_future =
+      client
+          .GetData(read::DataRequest()
+                       .WithDataHandle(kBlobDataHandle)
+                       .WithDecompression(true))
+          .GetFuture();
+  release.set_value();
+
+  ASSERT_EQ(compressed_future.wait_for(kTimeout), std::future_status::ready);
+  auto response = compressed_future.get();
+  ASSERT_TRUE(response.IsSuccessful());
+  ASSERT_TRUE(response.GetResult());
+  EXPECT_EQ(*compressed, *response.GetResult());
+
+  ASSERT_EQ(decompressed_future.wait_for(kTimeout),
+            std::future_status::ready);
+  response = decompressed_future.get();
+  ASSERT_TRUE(response.IsSuccessful());
+  ASSERT_TRUE(response.GetResult());
+  EXPECT_EQ(data, std::string(response.GetResult()->begin(),
+                              response.GetResult()->end()));
+
+  Mock::VerifyAndClearExpectations(network_mock.get());
+}
+
 TEST(VolatileLayerClientImplTest, RemoveFromCachePartition) {
   olp::client::OlpClientSettings settings;
   std::shared_ptr<CacheMock> cache_mock = std::make_shared<CacheMock>();
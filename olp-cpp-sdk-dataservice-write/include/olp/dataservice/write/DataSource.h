@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <olp/core/http/BodySource.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/**
+ * @brief The content to upload that is read on demand.
+ *
+ * Large payloads are uploaded in parts that the network reads from
+ * the source while they are sent, so the payload is not kept in memory.
+ */
+using DataSource = http::BodySource;
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
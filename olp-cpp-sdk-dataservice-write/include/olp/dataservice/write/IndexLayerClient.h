@@ -27,6 +27,7 @@
 #include <olp/core/client/OlpClientSettings.h>
 #include <olp/core/porting/deprecated.h>
 #include <olp/dataservice/write/DataServiceWriteApi.h>
+#include <olp/dataservice/write/IndexLayerClientSettings.h>
 #include <olp/dataservice/write/generated/model/ResponseOkSingle.h>
 #include <olp/dataservice/write/model/DeleteIndexDataRequest.h>
 #include <olp/dataservice/write/model/PublishIndexRequest.h>
@@ -72,6 +73,17 @@ class DATASERVICE_WRITE_API IndexLayerClient {
    */
   IndexLayerClient(client::HRN catalog, client::OlpClientSettings settings);
 
+  /**
+   * @brief Creates the `IndexLayerClient` instance.
+   * @param catalog The HRN that specifies the catalog to which this client
+   * writes.
+   * @param settings Client settings used to control the behavior of the client
+   * instance.
+   * @param index_settings The settings used to batch the queued indexes.
+   */
+  IndexLayerClient(client::HRN catalog, client::OlpClientSettings settings,
+                   IndexLayerClientSettings index_settings);
+
   /**
    * @brief Cancels all the ongoing operations that this client started.
    *
@@ -150,6 +162,56 @@ class DATASERVICE_WRITE_API IndexLayerClient {
   olp::client::CancellationToken UpdateIndex(model::UpdateIndexRequest request,
                                              UpdateIndexCallback callback);
 
+  /**
+   * @brief Queues an index for publishing to an index layer.
+   *
+   * The data of the queued indexes is uploaded in parallel, and their index
+   * entries are submitted together in one update request per layer and
+   * billing tag. The entries are submitted when the maximum number of entries
+   * per update is collected, when the oldest entry waited for the maximum
+   * update delay, or when `FlushQueuedIndexes` is called. The order of the
+   * queued indexes is not preserved.
+   *
+   * Blocks while the maximum number of queued indexes are not completed.
+   *
+   * @note Content-Type for this request is set implicitly based on the
+   * layer metadata for the target layer on the HERE platform.
+   * @param request PublishIndexRequest object that represents the
+   * parameters for the queued index.
+   * @param callback PublishIndexCallback that is called with the
+   * PublishIndexResponse when the index entry is submitted or fails.
+   * @return CancellationToken that cancels the index unless its entry is
+   * already submitted.
+   */
+  olp::client::CancellationToken QueueIndex(model::PublishIndexRequest request,
+                                            PublishIndexCallback callback);
+
+  /**
+   * @brief Queues index additions and removals for an index layer.
+   *
+   * The additions and removals are submitted together with the entries of
+   * the queued indexes of the same layer and billing tag.
+   *
+   * Blocks while the maximum number of queued indexes are not completed.
+   *
+   * @param request UpdateIndexRequest object that represents the
+   * parameters for the queued update.
+   * @param callback UpdateIndexCallback that is called with the
+   * UpdateIndexResponse when the update is submitted or fails.
+   * @return CancellationToken that cancels the update unless it is already
+   * submitted.
+   */
+  olp::client::CancellationToken QueueUpdateIndex(
+      model::UpdateIndexRequest request, UpdateIndexCallback callback);
+
+  /**
+   * @brief Submits the collected entries of the queued indexes without
+   * waiting for the maximum update delay.
+   *
+   * The indexes whose data is still uploaded are submitted as usual.
+   */
+  void FlushQueuedIndexes();
+
  private:
   std::shared_ptr<IndexLayerClientImpl> impl_;
 };
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include <olp/dataservice/write/DataServiceWriteApi.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/**
+ * @brief Configures how `IndexLayerClient` batches the queued indexes.
+ *
+ * The data of the queued indexes is uploaded in parallel, and the index
+ * entries are submitted together in one update request per layer.
+ */
+struct DATASERVICE_WRITE_API IndexLayerClientSettings {
+  /**
+   * @brief The maximum number of index entries submitted in one update
+   * request. Must be positive.
+   */
+  size_t maximum_indexes_per_update = 100u;
+
+  /**
+   * @brief The maximum time that an uploaded index entry waits for the other
+   * entries of its update request.
+   */
+  std::chrono::milliseconds maximum_update_delay{500};
+
+  /**
+   * @brief The maximum number of the queued indexes whose data is uploaded in
+   * parallel.
+   *
+   * Requires the task scheduler in the client settings.
+   */
+  size_t maximum_parallel_uploads = 4u;
+
+  /**
+   * @brief The maximum number of the queued indexes that are not completed.
+   *
+   * When the limit is reached, queuing blocks until the earlier indexes are
+   * completed. Must be positive.
+   */
+  size_t maximum_queued_indexes = 1000u;
+};
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -45,6 +45,7 @@ class HRN;
 
 namespace dataservice {
 namespace write {
+class AutoFlushController;
 class StreamLayerClientImpl;
 
 /**
@@ -187,6 +188,7 @@ class DATASERVICE_WRITE_API StreamLayerClient {
 
  private:
   std::shared_ptr<StreamLayerClientImpl> impl_;
+  std::shared_ptr<AutoFlushController> auto_flush_controller_;
 };
 
 }  // namespace write
@@ -19,8 +19,9 @@
 
 #pragma once
 
-#include <string>
+#include <chrono>
 #include <limits>
+#include <string>
 
 #include <olp/dataservice/write/DataServiceWriteApi.h>
 
@@ -37,6 +38,48 @@ struct DATASERVICE_WRITE_API StreamLayerClientSettings {
    * @brief The maximum number of requests that can be stored. Must be positive.
    */
   size_t maximum_requests = std::numeric_limits<size_t>::max();
+
+  /**
+   * @brief The maximum number of the queued requests that `Flush` publishes
+   * in parallel.
+   *
+   * Requires the task scheduler in the client settings. Values greater than 1
+   * do not preserve the order of the queued messages in the layer.
+   */
+  size_t maximum_parallel_requests = 1u;
+
+  /**
+   * @brief The number of queued requests that triggers a flush of the queue.
+   *
+   * Setting 0 disables this trigger. The auto flush is enabled when any of
+   * its triggers is set. It flushes in the background and reports nothing to
+   * the user, the failed requests are dropped from the queue.
+   */
+  size_t auto_flush_num_events = 0u;
+
+  /**
+   * @brief The size of the queued data (in bytes) that triggers a flush of
+   * the queue.
+   *
+   * Setting 0 disables this trigger.
+   */
+  size_t auto_flush_num_bytes = 0u;
+
+  /**
+   * @brief The longest time a queued request waits before the queue is
+   * flushed.
+   *
+   * Setting 0 disables this trigger.
+   */
+  std::chrono::milliseconds auto_flush_max_age{0};
+
+  /**
+   * @brief The time a single auto flush should take.
+   *
+   * The number of requests flushed at once is tuned to it from the duration
+   * of the previous auto flushes. Setting 0 flushes the whole queue at once.
+   */
+  std::chrono::milliseconds target_flush_latency{0};
 };
 
 }  // namespace write
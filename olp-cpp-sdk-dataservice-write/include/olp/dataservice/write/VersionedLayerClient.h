@@ -34,6 +34,7 @@
 #include <olp/dataservice/write/generated/model/ResponseOkSingle.h>
 #include <olp/dataservice/write/model/CheckDataExistsRequest.h>
 #include <olp/dataservice/write/model/PublishPartitionDataRequest.h>
+#include <olp/dataservice/write/model/PublishPartitionsRequest.h>
 #include <olp/dataservice/write/model/StartBatchRequest.h>
 #include <olp/dataservice/write/model/VersionResponse.h>
 
@@ -71,6 +72,12 @@ using PublishPartitionDataResponse =
 using PublishPartitionDataCallback =
     std::function<void(PublishPartitionDataResponse response)>;
 
+using PublishPartitionsResult = model::PublishPartitionsProgress;
+using PublishPartitionsResponse =
+    client::ApiResponse<PublishPartitionsResult, client::ApiError>;
+using PublishPartitionsCallback =
+    std::function<void(PublishPartitionsResponse response)>;
+
 using CheckDataExistsStatusCode = int;
 using CheckDataExistsResponse =
     client::ApiResponse<CheckDataExistsStatusCode, client::ApiError>;
@@ -212,6 +219,42 @@ class DATASERVICE_WRITE_API VersionedLayerClient {
       const model::Publication& pub, model::PublishPartitionDataRequest request,
       PublishPartitionDataCallback callback);
 
+  /**
+   * @brief Call to publish many partitions into a versioned layer.
+   *
+   * The data of the partitions is uploaded in parallel and the metadata is
+   * uploaded in bulk. If an upload fails, no new partition is started and
+   * the error is returned; the partitions that are already committed stay in
+   * the batch. Publishing the same partition again overwrites it, so
+   * the request can be retried with the partitions that are not committed.
+   * @note Content-type for this request will be set implicitly based on the
+   * layer metadata for the target layer on the HERE platform.
+   * @param pub The publication to add the partitions to.
+   * @param request PublishPartitionsRequest object representing the
+   * partitions and the parameters for this call.
+   *
+   * @return A CancellableFuture containing the PublishPartitionsResponse.
+   */
+  olp::client::CancellableFuture<PublishPartitionsResponse> PublishToBatch(
+      const model::Publication& pub, model::PublishPartitionsRequest request);
+
+  /**
+   * @brief Call to publish many partitions into a versioned layer.
+   *
+   * See the overload that returns a CancellableFuture for details.
+   * @param pub The publication to add the partitions to.
+   * @param request PublishPartitionsRequest object representing the
+   * partitions and the parameters for this call.
+   * @param callback PublishPartitionsCallback which will be called with the
+   * PublishPartitionsResponse when the operation completes.
+   *
+   * @return A CancellationToken which can be used to cancel the ongoing
+   * request.
+   */
+  olp::client::CancellationToken PublishToBatch(
+      const model::Publication& pub, model::PublishPartitionsRequest request,
+      PublishPartitionsCallback callback);
+
   /**
    * @brief Check if a datahandle exits.
    * @param request details of the check data exists operation to start
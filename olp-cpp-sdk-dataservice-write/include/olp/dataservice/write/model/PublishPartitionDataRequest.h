@@ -27,6 +27,7 @@
 #include <boost/optional.hpp>
 
 #include <olp/dataservice/write/DataServiceWriteApi.h>
+#include <olp/dataservice/write/DataSource.h>
 
 namespace olp {
 namespace dataservice {
@@ -67,6 +68,24 @@ class DATASERVICE_WRITE_API PublishPartitionDataRequest {
     return *this;
   }
 
+  /**
+   * @return data source previously set.
+   */
+  inline const boost::optional<DataSource>& GetDataSource() const {
+    return data_source_;
+  }
+
+  /**
+   * @param data_source Source of the content to be uploaded to the HERE
+   * platform. Use it instead of the data to upload large content that does
+   * not fit into memory.
+   * @note Optional. Ignored if the data is set.
+   */
+  inline PublishPartitionDataRequest& WithDataSource(DataSource data_source) {
+    data_source_ = std::move(data_source);
+    return *this;
+  }
+
   /**
    * @return Layer ID previously set.
    */
@@ -190,9 +209,29 @@ class DATASERVICE_WRITE_API PublishPartitionDataRequest {
     return *this;
   }
 
+  /**
+   * @return whether the data is compressed before it is published.
+   */
+  inline bool GetCompression() const { return compression_; }
+
+  /**
+   * @param compression Whether the data is compressed with the content
+   * encoding of the layer, for example gzip, before it is published. The data
+   * is published as is if the layer has no content encoding or the data is
+   * already compressed.
+   * @note Can not be combined with a checksum, since the checksum of the
+   * compressed data is not known in advance.
+   */
+  inline PublishPartitionDataRequest& WithCompression(bool compression) {
+    compression_ = compression;
+    return *this;
+  }
+
  private:
   std::shared_ptr<std::vector<unsigned char>> data_;
 
+  boost::optional<DataSource> data_source_;
+
   std::string layer_id_;
 
   boost::optional<std::string> partition_id_;
@@ -200,6 +239,8 @@ class DATASERVICE_WRITE_API PublishPartitionDataRequest {
   boost::optional<std::string> billing_tag_;
 
   boost::optional<std::string> checksum_;
+
+  bool compression_ = false;
 };
 
 }  // namespace model
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <olp/dataservice/write/DataServiceWriteApi.h>
+#include <olp/dataservice/write/model/PublishPartitionDataRequest.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+namespace model {
+
+/**
+ * @brief The progress of a \c PublishPartitionsRequest.
+ */
+struct DATASERVICE_WRITE_API PublishPartitionsProgress {
+  /// The number of partitions which data is uploaded.
+  std::uint64_t partitions_uploaded = 0u;
+  /// The number of partitions which metadata is uploaded to the batch.
+  std::uint64_t partitions_committed = 0u;
+  /// The number of uploaded data bytes.
+  std::uint64_t bytes_uploaded = 0u;
+  /// The number of partitions which data already existed and was not
+  /// uploaded again. They are also counted as uploaded.
+  std::uint64_t partitions_reused = 0u;
+};
+
+/**
+ * @brief PublishPartitionsRequest used to publish many partitions into
+ * a HERE platform versioned layer batch.
+ *
+ * The data of the partitions is uploaded in parallel and the metadata is
+ * uploaded in bulk, so that one metadata request covers many partitions.
+ */
+class DATASERVICE_WRITE_API PublishPartitionsRequest {
+ public:
+  /**
+   * @brief Provides the next partition to publish.
+   *
+   * Is never called concurrently.
+   *
+   * @return The partition or \c boost::none if no partition is left.
+   */
+  using PartitionSource =
+      std::function<boost::optional<PublishPartitionDataRequest>()>;
+
+  /**
+   * @brief Receives the progress of the request.
+   *
+   * Is called after a partition is uploaded or a metadata upload is
+   * finished, possibly from several threads. It must not block.
+   */
+  using ProgressCallback = std::function<void(PublishPartitionsProgress)>;
+
+  PublishPartitionsRequest() = default;
+
+  /**
+   * @return partition source previously set.
+   */
+  inline const PartitionSource& GetPartitions() const { return partitions_; }
+
+  /**
+   * @param partitions Source of the partitions to publish, the partitions are
+   * requested one by one while the previous ones are uploaded.
+   * @note Required.
+   */
+  inline PublishPartitionsRequest& WithPartitions(PartitionSource partitions) {
+    partitions_ = std::move(partitions);
+    return *this;
+  }
+
+  /**
+   * @param partitions The partitions to publish.
+   * @note Required.
+   */
+  inline PublishPartitionsRequest& WithPartitions(
+      std::vector<PublishPartitionDataRequest> partitions) {
+    using Partition = boost::optional<PublishPartitionDataRequest>;
+    auto list = std::make_shared<std::vector<PublishPartitionDataRequest>>(
+        std::move(partitions));
+    auto next = std::make_shared<size_t>(0u);
+    partitions_ = [list, next]() -> Partition {
+      if (*next >= list->size()) {
+        return boost::none;
+      }
+      return (*list)[(*next)++];
+    };
+    return *this;
+  }
+
+  /**
+   * @return maximum number of data uploads running at the same time.
+   */
+  inline size_t GetMaxParallelUploads() const { return max_parallel_uploads_; }
+
+  /**
+   * @param max_parallel_uploads Maximum number of data uploads running at the
+   * same time. The uploads run on the task scheduler of the client settings,
+   * without it the data is uploaded one by one.
+   */
+  inline PublishPartitionsRequest& WithMaxParallelUploads(
+      size_t max_parallel_uploads) {
+    max_parallel_uploads_ = max_parallel_uploads;
+    return *this;
+  }
+
+  /**
+   * @return maximum number of partitions in a single metadata upload.
+   */
+  inline size_t GetMaxPartitionsPerUpload() const {
+    return max_partitions_per_upload_;
+  }
+
+  /**
+   * @param max_partitions Maximum number of partitions in a single metadata
+   * upload.
+   */
+  inline PublishPartitionsRequest& WithMaxPartitionsPerUpload(
+      size_t max_partitions) {
+    max_partitions_per_upload_ = max_partitions;
+    return *this;
+  }
+
+  /**
+   * @return approximate maximum size of a single metadata upload in bytes.
+   */
+  inline size_t GetMaxBytesPerUpload() const { return max_bytes_per_upload_; }
+
+  /**
+   * @param max_bytes Approximate maximum size of a single metadata upload in
+   * bytes.
+   */
+  inline PublishPartitionsRequest& WithMaxBytesPerUpload(size_t max_bytes) {
+    max_bytes_per_upload_ = max_bytes;
+    return *this;
+  }
+
+  /**
+   * @return whether existing data is reused.
+   */
+  inline bool GetDeduplication() const { return deduplication_; }
+
+  /**
+   * @param deduplication Whether existing data is reused. The data handle of
+   * a partition is derived from the SHA-256 hash of its data, and the data is
+   * uploaded only if the layer does not have it already. Republishing mostly
+   * unchanged data then uploads only what changed, at the cost of hashing the
+   * data and one existence check per partition.
+   * @note The data of a layer must not be deleted while it is deduplicated,
+   * since deleted data handles cannot be reused.
+   */
+  inline PublishPartitionsRequest& WithDeduplication(bool deduplication) {
+    deduplication_ = deduplication;
+    return *this;
+  }
+
+  /**
+   * @return progress callback previously set.
+   */
+  inline const ProgressCallback& GetProgressCallback() const {
+    return progress_callback_;
+  }
+
+  /**
+   * @param progress_callback Receives the progress of the request.
+   */
+  inline PublishPartitionsRequest& WithProgressCallback(
+      ProgressCallback progress_callback) {
+    progress_callback_ = std::move(progress_callback);
+    return *this;
+  }
+
+ private:
+  PartitionSource partitions_;
+
+  size_t max_parallel_uploads_ = 8u;
+
+  size_t max_partitions_per_upload_ = 1000u;
+
+  size_t max_bytes_per_upload_ = 4u * 1024u * 1024u;
+
+  bool deduplication_ = false;
+
+  ProgressCallback progress_callback_;
+};
+
+}  // namespace model
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "AdaptiveFlushPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+namespace {
+int MinBatchSize(const AutoFlushSettings& settings) {
+  return std::max(settings.min_events_per_single_flush, 1);
+}
+
+int MaxBatchSize(const AutoFlushSettings& settings) {
+  return std::max(settings.max_events_per_single_flush,
+                  MinBatchSize(settings));
+}
+
+int InitialBatchSize(const AutoFlushSettings& settings) {
+  if (settings.target_flush_latency.count() <= 0) {
+    return settings.events_per_single_flush;
+  }
+
+  const int initial = settings.events_per_single_flush > 0
+                          ? settings.events_per_single_flush
+                          : settings.auto_flush_num_events;
+  return std::min(std::max(initial, MinBatchSize(settings)),
+                  MaxBatchSize(settings));
+}
+}  // namespace
+
+AdaptiveFlushPolicy::AdaptiveFlushPolicy(const AutoFlushSettings& settings)
+    : settings_(settings),
+      queued_(),
+      queued_bytes_(0u),
+      batch_size_(InitialBatchSize(settings)) {}
+
+void AdaptiveFlushPolicy::OnQueued(size_t data_size, Clock::time_point now) {
+  queued_.push_back({now, data_size});
+  queued_bytes_ += data_size;
+}
+
+void AdaptiveFlushPolicy::OnFlushed(size_t num_requests,
+                                    std::chrono::milliseconds duration,
+                                    size_t queue_size) {
+  // The flushed and the dropped requests leave the queue from the front.
+  while (queued_.size() > queue_size) {
+    queued_bytes_ -= queued_.front().data_size;
+    queued_.pop_front();
+  }
+
+  if (settings_.target_flush_latency.count() <= 0 || num_requests == 0u) {
+    return;
+  }
+
+  // The number of requests that fits the target at the speed of the last
+  // flush. The size moves halfway to it, so a single slow or fast flush is
+  // smoothed out, and it at most doubles per flush.
+  const auto elapsed = std::max<std::chrono::milliseconds::rep>(
+      duration.count(), 1);
+  const double fitting = static_cast<double>(num_requests) *
+                         settings_.target_flush_latency.count() / elapsed;
+  const double next =
+      std::min((batch_size_ + fitting) / 2.0, 2.0 * batch_size_);
+
+  batch_size_ = static_cast<int>(
+      std::min<double>(std::max<double>(std::round(next),
+                                        MinBatchSize(settings_)),
+                       MaxBatchSize(settings_)));
+}
+
+bool AdaptiveFlushPolicy::IsFlushRequired(Clock::time_point now) const {
+  if (settings_.auto_flush_num_bytes > 0u &&
+      queued_bytes_ >= settings_.auto_flush_num_bytes) {
+    return true;
+  }
+
+  const auto deadline = GetDeadline();
+  return deadline && now >= *deadline;
+}
+
+boost::optional<AdaptiveFlushPolicy::Clock::time_point>
+AdaptiveFlushPolicy::GetDeadline() const {
+  if (settings_.auto_flush_max_age.count() <= 0 || queued_.empty()) {
+    return boost::none;
+  }
+  return queued_.front().time + settings_.auto_flush_max_age;
+}
+
+int AdaptiveFlushPolicy::GetBatchSize() const { return batch_size_; }
+
+size_t AdaptiveFlushPolicy::GetQueuedBytes() const { return queued_bytes_; }
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+
+#include <boost/optional.hpp>
+
+#include "AutoFlushSettings.h"
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/**
+ * @brief Decides when the queued requests are flushed and how many of them.
+ *
+ * Tracks the size and the age of the queued requests, so a flush is triggered
+ * by the queued bytes or by the oldest request. The number of requests flushed
+ * at once is tuned so that a flush takes about the target latency. The class
+ * is not thread-safe.
+ */
+class AdaptiveFlushPolicy {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit AdaptiveFlushPolicy(const AutoFlushSettings& settings);
+
+  /// Records a queued request with the size of its data.
+  void OnQueued(size_t data_size, Clock::time_point now = Clock::now());
+
+  /**
+   * @brief Tunes the number of requests flushed at once after a flush.
+   *
+   * @param num_requests The number of the flushed requests.
+   * @param duration The time the flush took.
+   * @param queue_size The number of the requests that are still queued, the
+   * oldest requests above it are no longer tracked.
+   */
+  void OnFlushed(size_t num_requests, std::chrono::milliseconds duration,
+                 size_t queue_size);
+
+  /// Checks whether the queued bytes or the age of the oldest request
+  /// require a flush.
+  bool IsFlushRequired(Clock::time_point now = Clock::now()) const;
+
+  /// Returns the time when the oldest request must be flushed, or
+  /// `boost::none` if no request is queued or the age is not limited.
+  boost::optional<Clock::time_point> GetDeadline() const;
+
+  /// Returns the number of requests to flush, 0 flushes all of them.
+  int GetBatchSize() const;
+
+  /// Returns the size of the queued data in bytes.
+  size_t GetQueuedBytes() const;
+
+ private:
+  struct QueuedRequest {
+    Clock::time_point time;
+    size_t data_size;
+  };
+
+  const AutoFlushSettings settings_;
+  std::deque<QueuedRequest> queued_;
+  size_t queued_bytes_;
+  int batch_size_;
+};
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -19,7 +19,14 @@
 
 #include "AutoFlushController.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
 #include <olp/dataservice/write/StreamLayerClient.h>
+#include "AdaptiveFlushPolicy.h"
 #include "BackgroundTaskCollection.h"
 #include "StreamLayerClientImpl.h"
 #include "TimeUtils.h"
@@ -28,6 +35,11 @@ namespace olp {
 namespace dataservice {
 namespace write {
 
+namespace {
+// How long the deadline timer waits when no request is queued.
+constexpr auto kIdleTimerPeriod = std::chrono::seconds(1);
+}  // namespace
+
 /**
  class DisabledAutoFlushControllerImpl
  To be used when auto-flush is disbled, prevents any automated flush events
@@ -44,7 +56,7 @@ class DisabledAutoFlushControllerImpl
 
   void NotifyQueueEventStart() override {}
 
-  void NotifyQueueEventComplete() override {}
+  void NotifyQueueEventComplete(size_t /*data_size*/) override {}
 
   void NotifyFlushEvent() override {}
 };
@@ -65,6 +77,10 @@ class EnabledAutoFlushControllerImpl
       : client_impl_(client_impl),
         flush_settings_(std::move(flush_settings)),
         listener_(listener),
+        policy_(flush_settings_),
+        policy_mutex_(),
+        policy_condition_(),
+        flush_in_progress_(false),
         background_task_col_(),
         cancel_mutex_(),
         cancel_token_map_(),
@@ -78,7 +94,8 @@ class EnabledAutoFlushControllerImpl
 
   void Enable() override {
     InitialiseAutoFlushPeriodic();
-    AutoFlushNumEvents();
+    InitialiseAutoFlushMaxAge();
+    AutoFlushIfRequired();
   }
 
   std::future<void> Disable() override {
@@ -88,7 +105,9 @@ class EnabledAutoFlushControllerImpl
 
   void NotifyQueueEventStart() override { HandleNotifyQueueEventStart(); }
 
-  void NotifyQueueEventComplete() override { HandleNotifyQueueEventComplete(); }
+  void NotifyQueueEventComplete(size_t data_size) override {
+    HandleNotifyQueueEventComplete(data_size);
+  }
 
   void NotifyFlushEvent() override { HandleNotifyFlushEvent(); }
 
@@ -110,16 +129,36 @@ class EnabledAutoFlushControllerImpl
   }
 
  private:
-  void AutoFlushNumEvents() {
-    if (IsAutoFlushNumEventsRequired()) {
-      AddBackgroundFlushTask();
+  // Flushes when the number or the size of the queued requests, or the age
+  // of the oldest one, reaches its limit. Only one such flush runs at a time,
+  // the next one is triggered when it completes, so bursts of requests are
+  // flushed together instead of in many small flushes.
+  void AutoFlushIfRequired() {
+    const bool num_events_required = IsAutoFlushNumEventsRequired();
+    {
+      std::lock_guard<std::mutex> lock(policy_mutex_);
+      if (flush_in_progress_ ||
+          !(num_events_required || policy_.IsFlushRequired())) {
+        return;
+      }
+      flush_in_progress_ = true;
+    }
+
+    if (!AddBackgroundFlushTask(true)) {
+      std::lock_guard<std::mutex> lock(policy_mutex_);
+      flush_in_progress_ = false;
     }
   }
 
   bool IsAutoFlushNumEventsRequired() {
+    if (flush_settings_.auto_flush_num_events <= 0) {
+      return false;
+    }
+
     auto impl_pointer = client_impl_.lock();
     if (impl_pointer) {
-      return impl_pointer->QueueSize() >= flush_settings_.auto_flush_num_events;
+      return impl_pointer->QueueSize() >=
+             static_cast<size_t>(flush_settings_.auto_flush_num_events);
     }
     return false;
   }
@@ -132,6 +171,46 @@ class EnabledAutoFlushControllerImpl
 
   void InitialiseAutoFlushPeriodic() { InitialiseAutoFlushInterval(); }
 
+  void InitialiseAutoFlushMaxAge() {
+    if (flush_settings_.auto_flush_max_age.count() > 0) {
+      std::thread(&EnabledAutoFlushControllerImpl::RunDeadlineTimer,
+                  std::weak_ptr<EnabledAutoFlushControllerImpl>(
+                      this->shared_from_this()))
+          .detach();
+    }
+  }
+
+  // The controller is referenced only while the timer waits, so it is
+  // released when its owner is gone, possibly on this thread.
+  static void RunDeadlineTimer(
+      std::weak_ptr<EnabledAutoFlushControllerImpl> controller) {
+    while (true) {
+      auto self = controller.lock();
+      if (!self || self->IsCancelled() || self->client_impl_.expired()) {
+        return;
+      }
+
+      bool expired = false;
+      {
+        std::unique_lock<std::mutex> lock(self->policy_mutex_);
+        const auto deadline = self->policy_.GetDeadline();
+        const auto idle_deadline =
+            AdaptiveFlushPolicy::Clock::now() + kIdleTimerPeriod;
+        if (deadline && !self->flush_in_progress_ &&
+            *deadline <= idle_deadline) {
+          expired = self->policy_condition_.wait_until(lock, *deadline) ==
+                    std::cv_status::timeout;
+        } else {
+          self->policy_condition_.wait_until(lock, idle_deadline);
+        }
+      }
+
+      if (expired) {
+        self->AutoFlushIfRequired();
+      }
+    }
+  }
+
   void HandleNotifyFlushEvent() {
     // No-op
   }
@@ -140,7 +219,38 @@ class EnabledAutoFlushControllerImpl
     // No-op
   }
 
-  void HandleNotifyQueueEventComplete() { AutoFlushNumEvents(); }
+  void HandleNotifyQueueEventComplete(size_t data_size) {
+    {
+      std::lock_guard<std::mutex> lock(policy_mutex_);
+      policy_.OnQueued(data_size);
+    }
+    policy_condition_.notify_all();
+    AutoFlushIfRequired();
+  }
+
+  void HandleFlushEventResults(FlushResponse results,
+                               AdaptiveFlushPolicy::Clock::time_point start,
+                               bool triggered) {
+    const auto duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            AdaptiveFlushPolicy::Clock::now() - start);
+    auto impl_pointer = client_impl_.lock();
+    const auto queue_size = impl_pointer ? impl_pointer->QueueSize() : 0u;
+    {
+      std::lock_guard<std::mutex> lock(policy_mutex_);
+      policy_.OnFlushed(results.size(), duration, queue_size);
+      if (triggered) {
+        flush_in_progress_ = false;
+      }
+    }
+    policy_condition_.notify_all();
+    NotifyFlushEventResults(results);
+
+    // Catches up when more requests were queued during the flush.
+    if (triggered && !IsCancelled()) {
+      AutoFlushIfRequired();
+    }
+  }
 
   void NotifyFlushEventStart() const {
     if (listener_) listener_->NotifyFlushEventStarted();
@@ -151,34 +261,52 @@ class EnabledAutoFlushControllerImpl
   }
 
   void Cancel() {
-    std::lock_guard<std::mutex> lock(cancel_mutex_);
-    for (auto& pair : cancel_token_map_) {
-      pair.second.Cancel();
+    {
+      std::lock_guard<std::mutex> lock(cancel_mutex_);
+      for (auto& pair : cancel_token_map_) {
+        pair.second.Cancel();
+      }
+      is_cancelled_ = true;
     }
-    is_cancelled_ = true;
+
+    // Wakes up the deadline timer, the mutex makes sure it is waiting.
+    std::lock_guard<std::mutex> lock(policy_mutex_);
+    policy_condition_.notify_all();
   }
 
-  bool AddBackgroundFlushTask() {
+  // The triggered flushes are the ones that `AutoFlushIfRequired` started.
+  bool AddBackgroundFlushTask(bool triggered = false) {
     auto impl_pointer = client_impl_.lock();
     if (!impl_pointer) {
       return false;
     }
 
+    // The task is added before the thread starts, so `Disable` waits for it.
     auto self = this->shared_from_this();
+    auto id = background_task_col_.AddTask();
     NotifyFlushEventStart();
-    auto flush_thread = std::thread([self, impl_pointer]() {
-      auto id = self->background_task_col_.AddTask();
+    auto flush_thread = std::thread([self, impl_pointer, id, triggered]() {
+      if (self->IsCancelled()) {
+        self->background_task_col_.ReleaseTask(id);
+        return;
+      }
+
+      const auto start = AdaptiveFlushPolicy::Clock::now();
 
-      const auto num_requests_to_flush =
-          self->flush_settings_.events_per_single_flush;
+      int num_requests_to_flush = 0;
+      {
+        std::lock_guard<std::mutex> lock(self->policy_mutex_);
+        num_requests_to_flush = self->policy_.GetBatchSize();
+      }
       model::FlushRequest request =
           model::FlushRequest().WithNumberOfRequestsToFlush(
               num_requests_to_flush);
       auto cancel_token = impl_pointer->Flush(
-          std::move(request), [self, id](FlushResponse results) {
+          std::move(request),
+          [self, id, start, triggered](FlushResponse results) {
             self->background_task_col_.ReleaseTask(id);
             self->RemoveCancelToken(id);
-            self->NotifyFlushEventResults(results);
+            self->HandleFlushEventResults(results, start, triggered);
           });
       self->AddCancelToken(id, cancel_token);
     });
@@ -225,6 +353,10 @@ class EnabledAutoFlushControllerImpl
   std::weak_ptr<ClientImpl> client_impl_;
   AutoFlushSettings flush_settings_;
   std::shared_ptr<FlushEventListener<FlushResponse>> listener_;
+  AdaptiveFlushPolicy policy_;
+  std::mutex policy_mutex_;
+  std::condition_variable policy_condition_;
+  bool flush_in_progress_;
   BackgroundTaskCollection<size_t> background_task_col_;
   std::mutex cancel_mutex_;
   std::map<size_t, olp::client::CancellationToken> cancel_token_map_;
@@ -236,6 +368,8 @@ AutoFlushController::AutoFlushController(
     : flush_settings_(flush_settings),
       impl_(std::make_shared<DisabledAutoFlushControllerImpl>()) {}
 
+AutoFlushController::~AutoFlushController() { Disable().wait(); }
+
 template <typename ClientImpl, typename FlushResponse>
 void AutoFlushController::Enable(
     std::shared_ptr<ClientImpl> client_impl,
@@ -270,8 +404,8 @@ std::future<void> AutoFlushController::Disable() {
 void AutoFlushController::NotifyQueueEventStart() {
   impl_->NotifyQueueEventStart();
 }
-void AutoFlushController::NotifyQueueEventComplete() {
-  impl_->NotifyQueueEventComplete();
+void AutoFlushController::NotifyQueueEventComplete(size_t data_size) {
+  impl_->NotifyQueueEventComplete(data_size);
 }
 void AutoFlushController::NotifyFlushEvent() { impl_->NotifyFlushEvent(); }
 
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <future>
 #include <memory>
 
@@ -32,6 +33,8 @@ namespace write {
 class AutoFlushController {
  public:
   AutoFlushController(const AutoFlushSettings& flush_settings);
+  /// Disables the auto flush and waits for the running flushes.
+  ~AutoFlushController();
 
   template <typename ClientImpl, typename FlushResponse>
   void Enable(std::shared_ptr<ClientImpl> client_impl,
@@ -40,7 +43,8 @@ class AutoFlushController {
   std::future<void> Disable();
 
   void NotifyQueueEventStart();
-  void NotifyQueueEventComplete();
+  /// Notifies that a request with the data of the given size is queued.
+  void NotifyQueueEventComplete(size_t data_size);
   void NotifyFlushEvent();
 
   // Implmentation base class
@@ -52,7 +56,7 @@ class AutoFlushController {
     virtual std::future<void> Disable() = 0;
 
     virtual void NotifyQueueEventStart() = 0;
-    virtual void NotifyQueueEventComplete() = 0;
+    virtual void NotifyQueueEventComplete(size_t data_size) = 0;
     virtual void NotifyFlushEvent() = 0;
   };
 
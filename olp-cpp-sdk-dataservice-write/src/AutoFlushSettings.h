@@ -19,6 +19,9 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+
 namespace olp {
 namespace dataservice {
 namespace write {
@@ -26,6 +29,7 @@ namespace write {
 struct AutoFlushSettings {
   /**
    * How many requests can be cached before an auto flush event is triggered.
+   * Setting 0 indicates this feature is disabled.
    */
   int auto_flush_num_events = 20;
 
@@ -40,6 +44,32 @@ struct AutoFlushSettings {
    *  0 to flush all partitions. Non-positive number will flush nothing.
    */
   int events_per_single_flush = 0;
+
+  /**
+   * @brief How many bytes of data can be queued before an auto flush event is
+   * triggered. Setting 0 indicates this feature is disabled.
+   */
+  size_t auto_flush_num_bytes = 0;
+
+  /**
+   * @brief The longest time a queued request waits before an auto flush event
+   * is triggered. Setting 0 indicates this feature is disabled.
+   */
+  std::chrono::milliseconds auto_flush_max_age{0};
+
+  /**
+   * @brief The time a single flush should take. The number of partitions
+   * flushed each time is tuned to it from the latency of the previous flush
+   * events. Setting 0 indicates this feature is disabled, then
+   * `events_per_single_flush` is used.
+   */
+  std::chrono::milliseconds target_flush_latency{0};
+
+  /**
+   * @brief The bounds of the tuned number of partitions flushed each time.
+   */
+  int min_events_per_single_flush = 1;
+  int max_events_per_single_flush = 1000;
 };
 
 }  // namespace write
@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "CatalogCache.h"
+
+#include <future>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include <olp/core/logging/Log.h>
+
+#include "ApiClientLookup.h"
+
+// clang-format off
+#include "generated/parser/CatalogParser.h"
+#include <olp/core/generated/parser/JsonParser.h>
+#include "generated/serializer/CatalogSerializer.h"
+#include "generated/serializer/JsonSerializer.h"
+// clang-format on
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+namespace {
+constexpr auto kLogTag = "CatalogCache";
+
+std::string CreateKey(const client::HRN& catalog) {
+  return catalog.ToCatalogHRNString() + "::write::catalog";
+}
+
+// The fetch of a configuration that the other clients wait for.
+struct Fetch {
+  client::CancellationContext context;
+  std::map<size_t, CatalogCache::Callback> callbacks;
+  size_t next_callback_id{0u};
+  bool done{false};
+};
+
+// The weak pointer keeps the key of a cache unique until the fetches for it
+// finish, even when another cache is created at the same address.
+using FetchKey = std::pair<std::weak_ptr<cache::KeyValueCache>, std::string>;
+
+struct FetchKeyLess {
+  bool operator()(const FetchKey& lhs, const FetchKey& rhs) const {
+    std::owner_less<std::weak_ptr<cache::KeyValueCache>> less;
+    if (less(lhs.first, rhs.first)) {
+      return true;
+    }
+    if (less(rhs.first, lhs.first)) {
+      return false;
+    }
+    return lhs.second < rhs.second;
+  }
+};
+
+struct Fetches {
+  std::mutex mutex;
+  std::map<FetchKey, std::shared_ptr<Fetch>, FetchKeyLess> fetches;
+};
+
+Fetches& GetFetches() {
+  static Fetches fetches;
+  return fetches;
+}
+
+struct Waiter {
+  std::shared_ptr<Fetch> fetch;
+  client::CancellationToken token;
+  bool starts_fetch{false};
+};
+
+void Detach(const FetchKey& key, const std::shared_ptr<Fetch>& fetch,
+            size_t callback_id) {
+  auto& fetches = GetFetches();
+  CatalogCache::Callback callback;
+  bool cancel_fetch = false;
+  {
+    std::lock_guard<std::mutex> lock(fetches.mutex);
+    auto it = fetch->callbacks.find(callback_id);
+    if (it == fetch->callbacks.end()) {
+      return;
+    }
+
+    callback = std::move(it->second);
+    fetch->callbacks.erase(it);
+    if (fetch->callbacks.empty() && !fetch->done) {
+      // Nobody waits for the configuration anymore, the next client starts
+      // a new fetch.
+      cancel_fetch = true;
+      auto pending_fetch = fetches.fetches.find(key);
+      if (pending_fetch != fetches.fetches.end() &&
+          pending_fetch->second == fetch) {
+        fetches.fetches.erase(pending_fetch);
+      }
+    }
+  }
+
+  if (cancel_fetch) {
+    fetch->context.CancelOperation();
+  }
+  callback(client::ApiError(client::ErrorCode::Cancelled,
+                            "Operation cancelled.", true));
+}
+
+Waiter Wait(const FetchKey& key, CatalogCache::Callback callback) {
+  auto& fetches = GetFetches();
+  Waiter waiter;
+  size_t callback_id = 0u;
+  {
+    std::lock_guard<std::mutex> lock(fetches.mutex);
+    auto& pending_fetch = fetches.fetches[key];
+    if (!pending_fetch) {
+      pending_fetch = std::make_shared<Fetch>();
+      waiter.starts_fetch = true;
+    }
+    waiter.fetch = pending_fetch;
+    callback_id = pending_fetch->next_callback_id++;
+    pending_fetch->callbacks.emplace(callback_id, std::move(callback));
+  }
+
+  auto fetch = waiter.fetch;
+  waiter.token = client::CancellationToken(
+      [=]() { Detach(key, fetch, callback_id); });
+  return waiter;
+}
+
+void Complete(const FetchKey& key, const std::shared_ptr<Fetch>& fetch,
+              const CatalogResponse& response) {
+  auto& fetches = GetFetches();
+  std::map<size_t, CatalogCache::Callback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(fetches.mutex);
+    fetch->done = true;
+    callbacks.swap(fetch->callbacks);
+    auto pending_fetch = fetches.fetches.find(key);
+    if (pending_fetch != fetches.fetches.end() &&
+        pending_fetch->second == fetch) {
+      fetches.fetches.erase(pending_fetch);
+    }
+  }
+
+  for (auto& callback : callbacks) {
+    callback.second(response);
+  }
+}
+
+void StartFetch(const client::HRN& catalog, const FetchKey& key,
+                const std::shared_ptr<Fetch>& pending_fetch,
+                const CatalogCache::FetchFunction& fetch) {
+  // Another fetch may have finished since the cache was checked.
+  auto configuration = CatalogCache::Find(catalog, key.first.lock());
+  if (configuration) {
+    Complete(key, pending_fetch, std::move(*configuration));
+    return;
+  }
+
+  fetch(pending_fetch->context, [=](CatalogResponse response) {
+    if (response.IsSuccessful()) {
+      CatalogCache::Put(catalog, key.first.lock(), response.GetResult());
+    }
+    Complete(key, pending_fetch, response);
+  });
+}
+}  // namespace
+
+constexpr time_t CatalogCache::kExpiryTimeInSecs;
+
+CatalogResponse CatalogCache::Get(
+    const client::HRN& catalog, const client::OlpClientSettings& settings,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context) {
+  auto fetch = [=](client::CancellationContext context, Callback callback) {
+    auto config_response = ApiClientLookup::LookupApiClient(
+        catalog, context, "config", "v1", settings);
+    if (!config_response.IsSuccessful()) {
+      callback(config_response.GetError());
+      return;
+    }
+
+    callback(ConfigApi::GetCatalog(config_response.GetResult(),
+                                   catalog.ToString(), billing_tag, context));
+  };
+
+  return Get(catalog, settings.cache, fetch, std::move(context));
+}
+
+CatalogResponse CatalogCache::Get(
+    const client::HRN& catalog,
+    const std::shared_ptr<cache::KeyValueCache>& cache,
+    const FetchFunction& fetch, client::CancellationContext context) {
+  auto promise = std::make_shared<std::promise<CatalogResponse>>();
+  auto future = promise->get_future();
+  auto callback = [promise](CatalogResponse response) {
+    promise->set_value(std::move(response));
+  };
+
+  if (!cache) {
+    fetch(std::move(context), std::move(callback));
+    return future.get();
+  }
+
+  auto configuration = Find(catalog, cache);
+  if (configuration) {
+    return std::move(*configuration);
+  }
+
+  // The context is not held while the configuration is fetched, a cancelled
+  // context detaches this client from the fetch.
+  const FetchKey key(cache, CreateKey(catalog));
+  auto waiter = Wait(key, std::move(callback));
+  if (!context.ExecuteOrCancelled([&]() { return waiter.token; })) {
+    waiter.token.Cancel();
+  }
+  if (waiter.starts_fetch) {
+    StartFetch(catalog, key, waiter.fetch, fetch);
+  }
+
+  return future.get();
+}
+
+client::CancellationToken CatalogCache::Get(
+    const client::HRN& catalog,
+    const std::shared_ptr<cache::KeyValueCache>& cache, FetchFunction fetch,
+    Callback callback) {
+  if (!cache) {
+    client::CancellationContext context;
+    fetch(context, std::move(callback));
+    return client::CancellationToken(
+        [=]() mutable { context.CancelOperation(); });
+  }
+
+  auto configuration = Find(catalog, cache);
+  if (configuration) {
+    callback(std::move(*configuration));
+    return client::CancellationToken();
+  }
+
+  const FetchKey key(cache, CreateKey(catalog));
+  auto waiter = Wait(key, std::move(callback));
+  if (waiter.starts_fetch) {
+    StartFetch(catalog, key, waiter.fetch, fetch);
+  }
+  return waiter.token;
+}
+
+boost::optional<model::Catalog> CatalogCache::Find(
+    const client::HRN& catalog,
+    const std::shared_ptr<cache::KeyValueCache>& cache) {
+  if (!cache) {
+    return boost::none;
+  }
+
+  auto cached_catalog =
+      cache->Get(CreateKey(catalog), [](const std::string& value) {
+        return parser::parse<model::Catalog>(value);
+      });
+  if (cached_catalog.empty()) {
+    return boost::none;
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Find(%s) -> from cache",
+                      catalog.ToCatalogHRNString().c_str());
+  return boost::any_cast<model::Catalog>(cached_catalog);
+}
+
+void CatalogCache::Put(const client::HRN& catalog,
+                       const std::shared_ptr<cache::KeyValueCache>& cache,
+                       const model::Catalog& configuration) {
+  if (!cache) {
+    return;
+  }
+
+  const auto key = CreateKey(catalog);
+  if (!cache->Put(key, configuration,
+                  [&]() { return serializer::serialize(configuration); },
+                  kExpiryTimeInSecs)) {
+    OLP_SDK_LOG_WARNING_F(kLogTag, "Failed to put '%s' to cache", key.c_str());
+  }
+}
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include <olp/core/cache/KeyValueCache.h>
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/CancellationToken.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClientSettings.h>
+#include "generated/ConfigApi.h"
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/**
+ * @brief Keeps the catalog configurations in the cache of the settings.
+ *
+ * The configuration is needed to find the content type and the encoding of
+ * the layers, so the write clients that use the same cache share it until it
+ * expires. Only one client fetches the configuration of a catalog at a time,
+ * the callbacks of the other clients are called when that fetch finishes.
+ * Without a cache, the configuration is fetched every time, so the layer
+ * clients keep their own copy until it expires instead.
+ *
+ * The concurrent clients share the fetch of the first one, so the request is
+ * sent with the billing tag of that client only.
+ */
+class CatalogCache {
+ public:
+  using Callback = std::function<void(CatalogResponse)>;
+
+  /// Fetches the configuration, and calls the callback exactly once.
+  using FetchFunction =
+      std::function<void(client::CancellationContext, Callback)>;
+
+  /// The configurations are reused for this long, in seconds.
+  static constexpr time_t kExpiryTimeInSecs = 5 * 60;
+
+  /**
+   * @brief Gets the configuration of the catalog.
+   *
+   * @param catalog The HRN of the catalog.
+   * @param settings The settings with the cache and used to look up the
+   * config service.
+   * @param billing_tag The billing tag of the fetch request, if any. When
+   * another client already fetches the configuration, its billing tag is used.
+   * @param context The `CancellationContext` instance.
+   */
+  static CatalogResponse Get(const client::HRN& catalog,
+                             const client::OlpClientSettings& settings,
+                             const boost::optional<std::string>& billing_tag,
+                             client::CancellationContext context);
+
+  /**
+   * @brief Gets the configuration from the cache, fetching it with
+   * the function.
+   *
+   * Waits for the fetch without holding the context, so the context can be
+   * cancelled at any time.
+   */
+  static CatalogResponse Get(
+      const client::HRN& catalog,
+      const std::shared_ptr<cache::KeyValueCache>& cache,
+      const FetchFunction& fetch, client::CancellationContext context);
+
+  /**
+   * @brief Gets the configuration from the cache, fetching it with
+   * the function.
+   *
+   * The callback may be called before this method returns. Cancelling
+   * the returned token calls the callback with the `Cancelled` error, and
+   * the fetch is cancelled when no other client waits for it.
+   */
+  static client::CancellationToken Get(
+      const client::HRN& catalog,
+      const std::shared_ptr<cache::KeyValueCache>& cache, FetchFunction fetch,
+      Callback callback);
+
+  /// Finds the configuration of the catalog in the cache.
+  static boost::optional<model::Catalog> Find(
+      const client::HRN& catalog,
+      const std::shared_ptr<cache::KeyValueCache>& cache);
+
+  /// Stores the configuration of the catalog that is fetched by the client.
+  static void Put(const client::HRN& catalog,
+                  const std::shared_ptr<cache::KeyValueCache>& cache,
+                  const model::Catalog& configuration);
+};
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
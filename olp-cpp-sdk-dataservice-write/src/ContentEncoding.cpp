@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "ContentEncoding.h"
+
+#include <algorithm>
+
+#include <olp/core/logging/Log.h>
+#include <olp/core/utils/Compression.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+namespace {
+constexpr auto kLogTag = "ContentEncoding";
+
+std::string FindContentEncodingForLayerId(const model::Catalog& catalog,
+                                          const std::string& layer_id) {
+  for (const auto& layer : catalog.GetLayers()) {
+    if (layer.GetId() == layer_id) {
+      return layer.GetContentEncoding();
+    }
+  }
+  return {};
+}
+}  // namespace
+
+CompressDataResponse CompressData(
+    const model::Catalog& catalog, const std::string& layer_id,
+    const DataSource& source, const boost::optional<std::string>& checksum) {
+  const auto name = FindContentEncodingForLayerId(catalog, layer_id);
+  if (name.empty()) {
+    return std::shared_ptr<std::vector<unsigned char>>();
+  }
+
+  const auto encoding = utils::Compression::ParseContentEncoding(name);
+  if (!encoding || !utils::Compression::IsSupported(*encoding)) {
+    return client::ApiError(
+        client::ErrorCode::InvalidArgument,
+        "Content encoding `" + name + "` of the layer is not supported");
+  }
+
+  // Data that is compressed already is published as is.
+  std::vector<unsigned char> header(
+      static_cast<size_t>(std::min<std::uint64_t>(source.GetSize(), 2u)));
+  if (!source.Read(0u, header.size(), header.data())) {
+    return client::ApiError(client::ErrorCode::InvalidArgument,
+                            "Unable to read the data source");
+  }
+  if (utils::Compression::IsCompressed(*encoding, header)) {
+    return std::shared_ptr<std::vector<unsigned char>>();
+  }
+
+  if (checksum) {
+    return client::ApiError(client::ErrorCode::InvalidArgument,
+                            "The checksum of compressed data is not known");
+  }
+
+  utils::CompressionStatistics statistics;
+  auto data = utils::Compression::Compress(*encoding, source, &statistics);
+  if (!data) {
+    return client::ApiError(client::ErrorCode::InvalidArgument,
+                            "Unable to compress the data");
+  }
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag,
+                      "Compressed data, layer=%s, size=%llu B, ratio=%.2f, "
+                      "time=%lld us",
+                      layer_id.c_str(),
+                      static_cast<unsigned long long>(
+                          statistics.uncompressed_size),
+                      statistics.GetRatio(),
+                      static_cast<long long>(statistics.duration.count()));
+  return data;
+}
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <olp/core/client/ApiError.h>
+#include <olp/core/client/ApiResponse.h>
+#include <olp/dataservice/write/DataSource.h>
+#include "generated/model/Catalog.h"
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+using CompressDataResponse =
+    client::ApiResponse<std::shared_ptr<std::vector<unsigned char>>,
+                        client::ApiError>;
+
+/**
+ * @brief Compresses the data with the content encoding of the layer.
+ *
+ * @param catalog The catalog configuration.
+ * @param layer_id The layer to publish to.
+ * @param source The data to publish.
+ * @param checksum The checksum of the request, compressed data can not have
+ * one.
+ *
+ * @return The compressed data, or `nullptr` if the data is published as is,
+ * because the layer has no content encoding or the data is already
+ * compressed.
+ */
+CompressDataResponse CompressData(const model::Catalog& catalog,
+                                  const std::string& layer_id,
+                                  const DataSource& source,
+                                  const boost::optional<std::string>& checksum);
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "ContentHash.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <olp/core/utils/Sha256.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+namespace {
+constexpr size_t kReadChunkSize = 1024u * 1024u;
+}  // namespace
+
+boost::optional<std::string> ComputeContentHash(const DataSource& source) {
+  utils::Sha256 hash;
+  std::vector<std::uint8_t> buffer(
+      static_cast<size_t>(std::min<std::uint64_t>(source.GetSize(),
+                                                  kReadChunkSize)));
+  for (std::uint64_t offset = 0u; offset < source.GetSize();) {
+    const auto size = static_cast<size_t>(std::min<std::uint64_t>(
+        source.GetSize() - offset, buffer.size()));
+    if (!source.Read(offset, size, buffer.data())) {
+      return boost::none;
+    }
+    hash.Update(buffer.data(), size);
+    offset += size;
+  }
+  return utils::Sha256::ToHexString(hash.Final());
+}
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include <olp/dataservice/write/DataSource.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/**
+ * @brief Computes the hash of the content.
+ *
+ * The content is read in chunks, so it is not loaded into memory at once.
+ *
+ * @return The hexadecimal SHA-256 of the content or `boost::none` if the
+ * content cannot be read.
+ */
+boost::optional<std::string> ComputeContentHash(const DataSource& source);
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
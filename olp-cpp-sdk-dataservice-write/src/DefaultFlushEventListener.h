@@ -20,6 +20,7 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -44,6 +45,7 @@ class DefaultFlushEventListener : public FlushEventListener<FlushResponse> {
     {
       std::lock_guard<std::mutex> locker(mutex_);
       ++metrics_.num_attempted_flush_events;
+      flush_start_ = std::chrono::steady_clock::now();
       metrics = metrics_;
     }
     NotifyFlushMetricsHasChanged(std::move(metrics));
@@ -57,8 +59,12 @@ class DefaultFlushEventListener : public FlushEventListener<FlushResponse> {
   template <typename T>
   bool CollateFlushEventResults(const std::vector<T>& results) {
     metrics_.num_total_flushed_requests += results.size();
+    metrics_.last_flush_num_requests = results.size();
+    metrics_.last_flush_duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - flush_start_);
 
-    thread_local size_t flush_requests_failed =
+    const size_t flush_requests_failed =
         std::count_if(std::begin(results), std::end(results),
                       [](T result) -> bool { return !result.IsSuccessful(); });
     metrics_.num_failed_flushed_requests += flush_requests_failed;
@@ -67,6 +73,7 @@ class DefaultFlushEventListener : public FlushEventListener<FlushResponse> {
 
   mutable std::mutex mutex_;
   FlushMetrics metrics_;
+  std::chrono::steady_clock::time_point flush_start_;
 };
 
 }  // namespace write
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 
 namespace olp {
@@ -33,28 +34,38 @@ struct FlushMetrics {
   /**
   * @brief Number of attempted flush events.
   */
-  size_t num_attempted_flush_events;
+  size_t num_attempted_flush_events = 0;
 
   /**
    * @brief Number of failed flush events
    */
-  size_t num_failed_flush_events;
+  size_t num_failed_flush_events = 0;
 
   /**
    * @brief Total number of flush events.
    */
-  size_t num_total_flush_events;
+  size_t num_total_flush_events = 0;
 
   /**
    * @brief Total number of requests queued to \c StreamLayerClient.
    */
-  size_t num_total_flushed_requests;
+  size_t num_total_flushed_requests = 0;
 
   /**
    * @brief Number of failed requests, which were queued to \c
    * StreamLayerClient.
    */
-  size_t num_failed_flushed_requests;
+  size_t num_failed_flushed_requests = 0;
+
+  /**
+   * @brief Number of requests flushed by the last flush event.
+   */
+  size_t last_flush_num_requests = 0;
+
+  /**
+   * @brief Time spent by the last flush event.
+   */
+  std::chrono::milliseconds last_flush_duration{0};
 };
 
 }  // namespace write
@@ -0,0 +1,392 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include "IndexBatchWriter.h"
+
+#include <algorithm>
+
+#include "Common.h"
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+namespace {
+// The timer checks at least this often whether the writer is still used.
+constexpr auto kIdleTimerPeriod = std::chrono::seconds(1);
+
+client::ApiError CancelledError() {
+  return client::ApiError(client::ErrorCode::Cancelled, "Operation cancelled.",
+                          true);
+}
+}  // namespace
+
+struct IndexBatchWriter::Record {
+  std::string layer_id;
+  boost::optional<std::string> billing_tag;
+  // The data and the index entry, set until the data is uploaded.
+  boost::optional<model::PublishIndexRequest> publish_request;
+  std::vector<model::Index> additions;
+  std::vector<std::string> removals;
+  PublishIndexCallback publish_callback;
+  UpdateIndexCallback update_callback;
+  client::CancellationContext context;
+};
+
+IndexBatchWriter::IndexBatchWriter(
+    IndexLayerClientSettings settings,
+    std::shared_ptr<thread::TaskScheduler> task_scheduler,
+    std::shared_ptr<client::PendingRequests> pending_requests,
+    UploadFunction upload, UpdateFunction update)
+    : settings_(std::move(settings)),
+      task_scheduler_(std::move(task_scheduler)),
+      pending_requests_(std::move(pending_requests)),
+      upload_(std::move(upload)),
+      update_(std::move(update)) {}
+
+IndexBatchWriter::~IndexBatchWriter() { Stop(); }
+
+client::CancellationToken IndexBatchWriter::Queue(
+    model::PublishIndexRequest request, PublishIndexCallback callback) {
+  auto record = std::make_shared<Record>();
+  record->layer_id = request.GetLayerId();
+  record->billing_tag = request.GetBillingTag();
+  record->publish_request = std::move(request);
+  record->publish_callback = std::move(callback);
+  return Enqueue(std::move(record));
+}
+
+client::CancellationToken IndexBatchWriter::Queue(
+    model::UpdateIndexRequest request, UpdateIndexCallback callback) {
+  auto record = std::make_shared<Record>();
+  record->layer_id = request.GetLayerId();
+  record->billing_tag = request.GetBillingTag();
+  record->additions = request.GetIndexAdditions();
+  record->removals = request.GetIndexRemovals();
+  record->update_callback = std::move(callback);
+  return Enqueue(std::move(record));
+}
+
+void IndexBatchWriter::Flush() {
+  std::map<BatchKey, PendingBatch> batches;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batches.swap(pending_);
+  }
+  for (auto& batch : batches) {
+    Submit(batch.first, std::move(batch.second.records));
+  }
+}
+
+void IndexBatchWriter::CancelPending() {
+  std::vector<RecordPtr> records;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    records = TakePendingRecords();
+  }
+  Complete(records, CancelledError());
+}
+
+void IndexBatchWriter::Stop() {
+  std::vector<RecordPtr> records;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+    records = TakePendingRecords();
+  }
+  timer_condition_.notify_all();
+  space_condition_.notify_all();
+
+  if (timer_.joinable()) {
+    // The timer releases the last reference when the owner is gone.
+    if (timer_.get_id() == std::this_thread::get_id()) {
+      timer_.detach();
+    } else {
+      timer_.join();
+    }
+  }
+
+  Complete(records, CancelledError());
+}
+
+client::CancellationToken IndexBatchWriter::Enqueue(RecordPtr record) {
+  auto context = record->context;
+  client::CancellationToken token(
+      [context]() mutable { context.CancelOperation(); });
+
+  const size_t max_uploads =
+      task_scheduler_ ? std::max<size_t>(settings_.maximum_parallel_uploads, 1u)
+                      : 1u;
+  bool stopped = false;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    space_condition_.wait(lock, [&] {
+      return stopped_ || incomplete_ < settings_.maximum_queued_indexes;
+    });
+
+    ++incomplete_;
+    stopped = stopped_;
+    if (!stopped && !timer_.joinable()) {
+      timer_ = std::thread(&IndexBatchWriter::RunTimer,
+                           std::weak_ptr<IndexBatchWriter>(shared_from_this()));
+    }
+
+    if (!stopped && record->publish_request) {
+      if (uploading_.size() >= max_uploads) {
+        queue_.push_back(std::move(record));
+        return token;
+      }
+      uploading_.push_back(record);
+    }
+  }
+
+  if (stopped) {
+    Complete({record}, CancelledError());
+  } else if (record->publish_request) {
+    Upload(std::move(record));
+  } else {
+    AddToBatch(std::move(record));
+  }
+  return token;
+}
+
+void IndexBatchWriter::Upload(RecordPtr record) {
+  auto self = shared_from_this();
+
+  // Without the task scheduler the uploads run one after another on the
+  // calling thread, so the next record is uploaded by this loop.
+  while (record) {
+    auto next = std::make_shared<RecordPtr>();
+    AddTask(
+        task_scheduler_, pending_requests_,
+        [=](client::CancellationContext context) -> UploadIndexDataResponse {
+          auto record_context = record->context;
+          if (record_context.IsCancelled() ||
+              !context.ExecuteOrCancelled([&]() {
+                return client::CancellationToken([record_context]() mutable {
+                  record_context.CancelOperation();
+                });
+              })) {
+            return CancelledError();
+          }
+          return self->upload_(*record->publish_request, record_context);
+        },
+        [=](UploadIndexDataResponse response) {
+          *next = self->OnUploaded(record, std::move(response));
+          if (self->task_scheduler_ && *next) {
+            self->Upload(std::move(*next));
+          }
+        });
+    record = task_scheduler_ ? nullptr : std::move(*next);
+  }
+}
+
+IndexBatchWriter::RecordPtr IndexBatchWriter::OnUploaded(
+    RecordPtr record, UploadIndexDataResponse response) {
+  RecordPtr next;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uploading_.erase(std::remove(uploading_.begin(), uploading_.end(), record),
+                     uploading_.end());
+    if (!stopped_ && !queue_.empty()) {
+      next = std::move(queue_.front());
+      queue_.pop_front();
+      uploading_.push_back(next);
+    }
+  }
+
+  if (!response.IsSuccessful()) {
+    Complete({record}, response.GetError());
+  } else {
+    record->publish_request = boost::none;
+    record->additions.push_back(response.MoveResult());
+    AddToBatch(std::move(record));
+  }
+  return next;
+}
+
+void IndexBatchWriter::AddToBatch(RecordPtr record) {
+  BatchKey key(record->layer_id, record->billing_tag);
+  std::vector<RecordPtr> records;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!stopped_) {
+      auto& batch = pending_[key];
+      if (batch.records.empty()) {
+        batch.deadline =
+            std::chrono::steady_clock::now() + settings_.maximum_update_delay;
+        timer_condition_.notify_one();
+      }
+      batch.entries += record->additions.size() + record->removals.size();
+      batch.records.push_back(std::move(record));
+
+      if (batch.entries >=
+          std::max<size_t>(settings_.maximum_indexes_per_update, 1u)) {
+        records.swap(batch.records);
+        pending_.erase(key);
+      }
+    }
+  }
+
+  // The record is not collected when the writer is stopped.
+  if (record) {
+    Complete({record}, CancelledError());
+  } else if (!records.empty()) {
+    Submit(key, std::move(records));
+  }
+}
+
+void IndexBatchWriter::Submit(const BatchKey& key,
+                              std::vector<RecordPtr> records) {
+  // The cancelled records are left out of the update request.
+  auto cancelled = std::stable_partition(
+      records.begin(), records.end(),
+      [](const RecordPtr& record) { return !record->context.IsCancelled(); });
+  Complete(std::vector<RecordPtr>(cancelled, records.end()), CancelledError());
+  records.erase(cancelled, records.end());
+  if (records.empty()) {
+    return;
+  }
+
+  std::vector<model::Index> additions;
+  std::vector<std::string> removals;
+  for (const auto& record : records) {
+    additions.insert(additions.end(), record->additions.begin(),
+                     record->additions.end());
+    removals.insert(removals.end(), record->removals.begin(),
+                    record->removals.end());
+  }
+
+  model::UpdateIndexRequest request;
+  request.WithLayerId(key.first)
+      .WithIndexAdditions(std::move(additions))
+      .WithIndexRemovals(std::move(removals));
+  if (key.second) {
+    request.WithBillingTag(*key.second);
+  }
+
+  auto self = shared_from_this();
+  AddTask(
+      task_scheduler_, pending_requests_,
+      [=](client::CancellationContext context) -> UpdateIndexResponse {
+        return self->update_(request, std::move(context));
+      },
+      [=](UpdateIndexResponse response) {
+        boost::optional<client::ApiError> error;
+        if (!response.IsSuccessful()) {
+          error = response.GetError();
+        }
+        self->Complete(records, error);
+      });
+}
+
+void IndexBatchWriter::Complete(
+    const std::vector<RecordPtr>& records,
+    const boost::optional<client::ApiError>& error) {
+  if (records.empty()) {
+    return;
+  }
+
+  for (const auto& record : records) {
+    if (record->publish_callback) {
+      if (error) {
+        record->publish_callback(PublishIndexResponse(*error));
+      } else {
+        model::ResponseOkSingle result;
+        result.SetTraceID(record->additions.front().GetId());
+        record->publish_callback(PublishIndexResponse(std::move(result)));
+      }
+    } else if (record->update_callback) {
+      record->update_callback(
+          error ? UpdateIndexResponse(*error)
+                : UpdateIndexResponse(client::ApiNoResult()));
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    incomplete_ -= records.size();
+  }
+  space_condition_.notify_all();
+}
+
+std::vector<IndexBatchWriter::RecordPtr>
+IndexBatchWriter::TakePendingRecords() {
+  std::vector<RecordPtr> records(queue_.begin(), queue_.end());
+  queue_.clear();
+  for (auto& batch : pending_) {
+    records.insert(records.end(), batch.second.records.begin(),
+                   batch.second.records.end());
+  }
+  pending_.clear();
+
+  // The uploads complete the records with the cancellation error.
+  for (auto& record : uploading_) {
+    record->context.CancelOperation();
+  }
+  return records;
+}
+
+bool IndexBatchWriter::SubmitExpired() {
+  std::vector<std::pair<BatchKey, std::vector<RecordPtr>>> expired;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopped_) {
+      return false;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    auto next_deadline = now + kIdleTimerPeriod;
+    for (auto it = pending_.begin(); it != pending_.end();) {
+      if (it->second.deadline <= now) {
+        expired.emplace_back(it->first, std::move(it->second.records));
+        it = pending_.erase(it);
+      } else {
+        next_deadline = std::min(next_deadline, it->second.deadline);
+        ++it;
+      }
+    }
+
+    if (expired.empty()) {
+      timer_condition_.wait_until(lock, next_deadline);
+      return !stopped_;
+    }
+  }
+
+  for (auto& batch : expired) {
+    Submit(batch.first, std::move(batch.second));
+  }
+  return true;
+}
+
+void IndexBatchWriter::RunTimer(std::weak_ptr<IndexBatchWriter> writer) {
+  // The writer is referenced only while it is used, so it is released when
+  // its owner is gone, possibly on this thread.
+  while (true) {
+    auto self = writer.lock();
+    if (!self || !self->SubmitExpired()) {
+      return;
+    }
+  }
+}
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <olp/core/client/ApiError.h>
+#include <olp/core/client/ApiResponse.h>
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/CancellationToken.h>
+#include <olp/core/client/PendingRequests.h>
+#include <olp/core/thread/TaskScheduler.h>
+#include <olp/dataservice/write/IndexLayerClient.h>
+#include <olp/dataservice/write/IndexLayerClientSettings.h>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/// The index entry of the uploaded data, with the data handle as its ID.
+using UploadIndexDataResponse =
+    client::ApiResponse<model::Index, client::ApiError>;
+
+/**
+ * @brief Batches the queued indexes of an index layer.
+ *
+ * The data of the queued indexes is uploaded by tasks on the task scheduler,
+ * up to `maximum_parallel_uploads` at once. The uploaded index entries are
+ * collected per layer and billing tag, and submitted with one update request
+ * when `maximum_indexes_per_update` entries are collected, or when the oldest
+ * entry waited for `maximum_update_delay`. A background thread submits the
+ * entries whose delay expired.
+ *
+ * The tasks are tracked by the pending requests, so cancelling them fails the
+ * indexes that are uploaded or submitted.
+ */
+class IndexBatchWriter : public std::enable_shared_from_this<IndexBatchWriter> {
+ public:
+  using UploadFunction = std::function<UploadIndexDataResponse(
+      const model::PublishIndexRequest&, client::CancellationContext)>;
+  using UpdateFunction = std::function<UpdateIndexResponse(
+      const model::UpdateIndexRequest&, client::CancellationContext)>;
+
+  IndexBatchWriter(IndexLayerClientSettings settings,
+                   std::shared_ptr<thread::TaskScheduler> task_scheduler,
+                   std::shared_ptr<client::PendingRequests> pending_requests,
+                   UploadFunction upload, UpdateFunction update);
+
+  ~IndexBatchWriter();
+
+  /**
+   * @brief Queues the data and the index entry for publishing.
+   *
+   * Blocks while `maximum_queued_indexes` indexes are not completed.
+   *
+   * @return The token that cancels the index unless it is already submitted.
+   */
+  client::CancellationToken Queue(model::PublishIndexRequest request,
+                                  PublishIndexCallback callback);
+
+  /**
+   * @brief Queues the index additions and removals for submitting.
+   *
+   * Blocks while `maximum_queued_indexes` indexes are not completed.
+   *
+   * @return The token that cancels the update unless it is already submitted.
+   */
+  client::CancellationToken Queue(model::UpdateIndexRequest request,
+                                  UpdateIndexCallback callback);
+
+  /// Submits the collected index entries without waiting for the delay.
+  void Flush();
+
+  /// Cancels the queued and collected indexes, new indexes are accepted.
+  void CancelPending();
+
+  /// Cancels the queued and collected indexes and stops the writer.
+  void Stop();
+
+ private:
+  struct Record;
+  using RecordPtr = std::shared_ptr<Record>;
+  using BatchKey = std::pair<std::string, boost::optional<std::string>>;
+
+  // The index entries of one layer and billing tag that wait for submitting.
+  struct PendingBatch {
+    std::vector<RecordPtr> records;
+    size_t entries{0u};
+    std::chrono::steady_clock::time_point deadline;
+  };
+
+  client::CancellationToken Enqueue(RecordPtr record);
+  void Upload(RecordPtr record);
+  RecordPtr OnUploaded(RecordPtr record, UploadIndexDataResponse response);
+  void AddToBatch(RecordPtr record);
+  void Submit(const BatchKey& key, std::vector<RecordPtr> records);
+  void Complete(const std::vector<RecordPtr>& records,
+                const boost::optional<client::ApiError>& error);
+
+  // Takes the queued and collected records and cancels the uploads. Must be
+  // called with the mutex locked.
+  std::vector<RecordPtr> TakePendingRecords();
+
+  // Waits for the next deadline and submits the expired batches. Returns
+  // false when the writer is stopped.
+  bool SubmitExpired();
+
+  static void RunTimer(std::weak_ptr<IndexBatchWriter> writer);
+
+  const IndexLayerClientSettings settings_;
+  const std::shared_ptr<thread::TaskScheduler> task_scheduler_;
+  const std::shared_ptr<client::PendingRequests> pending_requests_;
+  const UploadFunction upload_;
+  const UpdateFunction update_;
+
+  std::mutex mutex_;
+  std::condition_variable space_condition_;
+  std::condition_variable timer_condition_;
+  std::deque<RecordPtr> queue_;
+  std::map<BatchKey, PendingBatch> pending_;
+  std::vector<RecordPtr> uploading_;
+  size_t incomplete_{0u};
+  bool stopped_{false};
+  std::thread timer_;
+};
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -28,6 +28,13 @@ IndexLayerClient::IndexLayerClient(client::HRN catalog,
                                    client::OlpClientSettings settings)
     : impl_(std::make_shared<IndexLayerClientImpl>(catalog, settings)) {}
 
+IndexLayerClient::IndexLayerClient(client::HRN catalog,
+                                   client::OlpClientSettings settings,
+                                   IndexLayerClientSettings index_settings)
+    : impl_(std::make_shared<IndexLayerClientImpl>(
+          std::move(catalog), std::move(settings), std::move(index_settings))) {
+}
+
 void IndexLayerClient::CancelPendingRequests() {
   impl_->CancelPendingRequests();
 }
@@ -61,6 +68,18 @@ olp::client::CancellationToken IndexLayerClient::UpdateIndex(
     model::UpdateIndexRequest request, UpdateIndexCallback callback) {
   return impl_->UpdateIndex(request, callback);
 }
+
+olp::client::CancellationToken IndexLayerClient::QueueIndex(
+    model::PublishIndexRequest request, PublishIndexCallback callback) {
+  return impl_->QueueIndex(std::move(request), callback);
+}
+
+olp::client::CancellationToken IndexLayerClient::QueueUpdateIndex(
+    model::UpdateIndexRequest request, UpdateIndexCallback callback) {
+  return impl_->QueueUpdateIndex(std::move(request), callback);
+}
+
+void IndexLayerClient::FlushQueuedIndexes() { impl_->FlushQueuedIndexes(); }
 }  // namespace write
 }  // namespace dataservice
 }  // namespace olp
@@ -27,6 +27,8 @@
 #include <olp/core/client/CancellationContext.h>
 
 #include "ApiClientLookup.h"
+#include "CatalogCache.h"
+#include "IndexBatchWriter.h"
 #include "generated/BlobApi.h"
 #include "generated/ConfigApi.h"
 #include "generated/IndexApi.h"
@@ -44,8 +46,9 @@ namespace olp {
 namespace dataservice {
 namespace write {
 
-IndexLayerClientImpl::IndexLayerClientImpl(client::HRN catalog,
-                                           client::OlpClientSettings settings)
+IndexLayerClientImpl::IndexLayerClientImpl(
+    client::HRN catalog, client::OlpClientSettings settings,
+    IndexLayerClientSettings index_settings)
     : catalog_(std::move(catalog)),
       catalog_model_(),
       settings_(std::move(settings)),
@@ -53,10 +56,20 @@ IndexLayerClientImpl::IndexLayerClientImpl(client::HRN catalog,
       apiclient_blob_(nullptr),
       apiclient_index_(nullptr),
       pending_requests_(std::make_shared<client::PendingRequests>()),
-      init_in_progress_(false) {}
+      init_in_progress_(false),
+      index_settings_(std::move(index_settings)),
+      publishing_initialized_(false) {}
 
 IndexLayerClientImpl::~IndexLayerClientImpl() {
   tokenList_.CancelAll();
+  std::shared_ptr<IndexBatchWriter> batch_writer;
+  {
+    std::lock_guard<std::mutex> lock(batch_writer_mutex_);
+    batch_writer = batch_writer_;
+  }
+  if (batch_writer) {
+    batch_writer->Stop();
+  }
   pending_requests_->CancelAllAndWait();
 }
 
@@ -143,6 +156,14 @@ olp::client::CancellationToken IndexLayerClientImpl::InitApiClients(
 }
 
 void IndexLayerClientImpl::CancelPendingRequests() {
+  std::shared_ptr<IndexBatchWriter> batch_writer;
+  {
+    std::lock_guard<std::mutex> lock(batch_writer_mutex_);
+    batch_writer = batch_writer_;
+  }
+  if (batch_writer) {
+    batch_writer->CancelPending();
+  }
   pending_requests_->CancelAll();
   tokenList_.CancelAll();
 }
@@ -150,30 +171,60 @@ void IndexLayerClientImpl::CancelPendingRequests() {
 client::CancellationToken IndexLayerClientImpl::InitCatalogModel(
     const model::PublishIndexRequest& /*request*/,
     const InitCatalogModelCallback& callback) {
-  if (!catalog_model_.GetId().empty()) {
-    callback(boost::none);
-    return client::CancellationToken();
-  }
-
   auto self = shared_from_this();
-  return ConfigApi::GetCatalog(
-      apiclient_config_, catalog_.ToString(), boost::none,
-      [=](CatalogResponse catalog_response) mutable {
-        if (!catalog_response.IsSuccessful()) {
-          callback(std::move(catalog_response.GetError()));
-          return;
-        }
+  auto catalog_callback = [=](CatalogResponse catalog_response) {
+    if (!catalog_response.IsSuccessful()) {
+      callback(catalog_response.GetError());
+      return;
+    }
 
-        self->catalog_model_ = catalog_response.MoveResult();
+    {
+      std::lock_guard<std::mutex> lock(self->catalog_model_mutex_);
+      self->catalog_model_ = catalog_response.MoveResult();
+      self->catalog_model_expiry_ =
+          std::time(nullptr) + CatalogCache::kExpiryTimeInSecs;
+    }
+    callback(boost::none);
+  };
 
+  // Without a cache, the client keeps the configuration until it expires.
+  if (!settings_.cache) {
+    {
+      std::lock_guard<std::mutex> lock(catalog_model_mutex_);
+      if (std::time(nullptr) < catalog_model_expiry_) {
         callback(boost::none);
-      });
+        return client::CancellationToken();
+      }
+    }
+    return ConfigApi::GetCatalog(apiclient_config_, catalog_.ToString(),
+                                 boost::none, catalog_callback);
+  }
+
+  // The configuration is shared with the other clients through the cache,
+  // so it is fetched again only when the cached one expires.
+  auto fetch = [=](client::CancellationContext context,
+                   CatalogCache::Callback fetch_callback) {
+    context.ExecuteOrCancelled(
+        [&]() {
+          return ConfigApi::GetCatalog(self->apiclient_config_,
+                                       self->catalog_.ToString(), boost::none,
+                                       fetch_callback);
+        },
+        [&]() {
+          fetch_callback(client::ApiError(client::ErrorCode::Cancelled,
+                                          "Operation cancelled.", true));
+        });
+  };
+
+  return CatalogCache::Get(catalog_, settings_.cache, fetch,
+                           catalog_callback);
 }
 
 std::string IndexLayerClientImpl::FindContentTypeForLayerId(
     const std::string& layer_id) {
+  std::lock_guard<std::mutex> lock(catalog_model_mutex_);
   std::string content_type;
-  for (auto layer : catalog_model_.GetLayers()) {
+  for (const auto& layer : catalog_model_.GetLayers()) {
     if (layer.GetId() == layer_id) {
       // TODO optimization opportunity - cache
       // content-type for layer when found for O(1)
@@ -441,6 +492,175 @@ client::CancellationToken IndexLayerClientImpl::UpdateIndex(
   return token;
 }
 
+client::CancellationToken IndexLayerClientImpl::QueueIndex(
+    model::PublishIndexRequest request, const PublishIndexCallback& callback) {
+  if (!request.GetData()) {
+    callback(PublishIndexResponse(client::ApiError(
+        client::ErrorCode::InvalidArgument, "Request data empty.")));
+    return client::CancellationToken();
+  }
+
+  if (request.GetLayerId().empty()) {
+    callback(PublishIndexResponse(client::ApiError(
+        client::ErrorCode::InvalidArgument, "Request layer Id empty.")));
+    return client::CancellationToken();
+  }
+
+  return GetBatchWriter()->Queue(std::move(request), callback);
+}
+
+client::CancellationToken IndexLayerClientImpl::QueueUpdateIndex(
+    model::UpdateIndexRequest request, const UpdateIndexCallback& callback) {
+  if (request.GetLayerId().empty()) {
+    callback(UpdateIndexResponse(client::ApiError(
+        client::ErrorCode::InvalidArgument, "Request layer Id empty.")));
+    return client::CancellationToken();
+  }
+
+  return GetBatchWriter()->Queue(std::move(request), callback);
+}
+
+void IndexLayerClientImpl::FlushQueuedIndexes() { GetBatchWriter()->Flush(); }
+
+std::shared_ptr<IndexBatchWriter> IndexLayerClientImpl::GetBatchWriter() {
+  std::lock_guard<std::mutex> lock(batch_writer_mutex_);
+  if (batch_writer_) {
+    return batch_writer_;
+  }
+
+  // The writer does not keep the client alive.
+  std::weak_ptr<IndexLayerClientImpl> weak_self = shared_from_this();
+  auto upload = [weak_self](const model::PublishIndexRequest& request,
+                            client::CancellationContext context)
+      -> UploadIndexDataResponse {
+    auto self = weak_self.lock();
+    if (!self) {
+      return client::ApiError(client::ErrorCode::Cancelled,
+                              "Operation cancelled.", true);
+    }
+    return self->UploadIndexData(request, std::move(context));
+  };
+
+  auto update = [weak_self](const model::UpdateIndexRequest& request,
+                            client::CancellationContext context)
+      -> UpdateIndexResponse {
+    auto self = weak_self.lock();
+    if (!self) {
+      return client::ApiError(client::ErrorCode::Cancelled,
+                              "Operation cancelled.", true);
+    }
+    auto init_response = self->InitPublishing(context);
+    if (!init_response.IsSuccessful()) {
+      return init_response.GetError();
+    }
+    return IndexApi::performUpdate(*self->apiclient_index_, request,
+                                   request.GetBillingTag(), std::move(context));
+  };
+
+  batch_writer_ = std::make_shared<IndexBatchWriter>(
+      index_settings_, settings_.task_scheduler, pending_requests_,
+      std::move(upload), std::move(update));
+  return batch_writer_;
+}
+
+client::ApiResponse<client::ApiNoResult, client::ApiError>
+IndexLayerClientImpl::InitPublishing(client::CancellationContext context) {
+  if (publishing_initialized_.load()) {
+    return client::ApiNoResult();
+  }
+
+  // The uploads wait for the first one instead of initializing in parallel.
+  std::lock_guard<std::mutex> lock(init_publishing_mutex_);
+  if (publishing_initialized_.load()) {
+    return client::ApiNoResult();
+  }
+
+  using InitResponse =
+      client::ApiResponse<client::ApiNoResult, client::ApiError>;
+  auto promise = std::make_shared<std::promise<InitResponse>>();
+  auto future = promise->get_future();
+
+  auto init_callback = [promise](boost::optional<client::ApiError> error) {
+    if (error) {
+      promise->set_value(std::move(*error));
+    } else {
+      promise->set_value(client::ApiNoResult());
+    }
+  };
+
+  auto cancel_function = [=]() {
+    init_callback(client::ApiError(client::ErrorCode::Cancelled,
+                                   "Operation cancelled.", true));
+  };
+
+  auto self = shared_from_this();
+  auto cancel_context = std::make_shared<client::CancellationContext>();
+
+  auto init_catalog_model_function = [=]() -> client::CancellationToken {
+    return self->InitCatalogModel(model::PublishIndexRequest(), init_callback);
+  };
+
+  auto init_api_client_callback =
+      [=](boost::optional<client::ApiError> init_api_error) {
+        if (init_api_error) {
+          init_callback(std::move(init_api_error));
+          return;
+        }
+
+        cancel_context->ExecuteOrCancelled(init_catalog_model_function,
+                                           cancel_function);
+      };
+
+  context.ExecuteOrCancelled(
+      [&]() -> client::CancellationToken {
+        InitApiClients(cancel_context, init_api_client_callback);
+        return client::CancellationToken(
+            [cancel_context]() { cancel_context->CancelOperation(); });
+      },
+      cancel_function);
+
+  auto response = future.get();
+  if (response.IsSuccessful()) {
+    publishing_initialized_.store(true);
+  }
+  return response;
+}
+
+UploadIndexDataResponse IndexLayerClientImpl::UploadIndexData(
+    const model::PublishIndexRequest& request,
+    client::CancellationContext context) {
+  auto init_response = InitPublishing(context);
+  if (!init_response.IsSuccessful()) {
+    return init_response.GetError();
+  }
+
+  auto content_type = FindContentTypeForLayerId(request.GetLayerId());
+  if (content_type.empty()) {
+    auto errmsg = boost::format(
+                      "Unable to find the Layer ID (%1%) "
+                      "provided in the PublishIndexRequest in the "
+                      "Catalog specified when creating "
+                      "this IndexLayerClient instance.") %
+                  request.GetLayerId();
+    return client::ApiError(client::ErrorCode::InvalidArgument, errmsg.str());
+  }
+
+  // A conflict on the new data handle means that a retried upload already
+  // stored the data.
+  const auto data_handle = GenerateUuid();
+  auto response = BlobApi::PutBlob(*apiclient_blob_, request.GetLayerId(),
+                                   content_type, data_handle, request.GetData(),
+                                   request.GetBillingTag(), std::move(context));
+  if (!response.IsSuccessful() && response.GetError().GetHttpStatusCode() !=
+                                      http::HttpStatusCode::CONFLICT) {
+    return response.GetError();
+  }
+
+  auto index = request.GetIndex();
+  index.SetId(data_handle);
+  return index;
+}
+
 }  // namespace write
 }  // namespace dataservice
 }  // namespace olp
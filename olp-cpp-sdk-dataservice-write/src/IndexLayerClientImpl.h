@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <ctime>
 #include <mutex>
 
 #include <olp/core/client/HRN.h>
@@ -28,9 +29,12 @@
 #include "ApiClientLookup.h"
 #include "CancellationTokenList.h"
 
+#include <atomic>
 #include <memory>
 
 #include <olp/dataservice/write/IndexLayerClient.h>
+#include <olp/dataservice/write/IndexLayerClientSettings.h>
+#include "IndexBatchWriter.h"
 #include "generated/model/Catalog.h"
 
 namespace olp {
@@ -49,7 +53,9 @@ using InitCatalogModelCallback =
 class IndexLayerClientImpl
     : public std::enable_shared_from_this<IndexLayerClientImpl> {
  public:
-  IndexLayerClientImpl(client::HRN catalog, client::OlpClientSettings settings);
+  IndexLayerClientImpl(client::HRN catalog, client::OlpClientSettings settings,
+                       IndexLayerClientSettings index_settings =
+                           IndexLayerClientSettings());
 
   virtual ~IndexLayerClientImpl();
 
@@ -77,6 +83,14 @@ class IndexLayerClientImpl
       const model::UpdateIndexRequest& request,
       const UpdateIndexCallback& callback);
 
+  olp::client::CancellationToken QueueIndex(
+      model::PublishIndexRequest request, const PublishIndexCallback& callback);
+
+  olp::client::CancellationToken QueueUpdateIndex(
+      model::UpdateIndexRequest request, const UpdateIndexCallback& callback);
+
+  void FlushQueuedIndexes();
+
  private:
   client::CancellationToken InitApiClients(
       std::shared_ptr<client::CancellationContext> cancel_context,
@@ -88,9 +102,24 @@ class IndexLayerClientImpl
 
   std::string FindContentTypeForLayerId(const std::string& layer_id);
 
+  std::shared_ptr<IndexBatchWriter> GetBatchWriter();
+
+  /// Initializes the API clients and the catalog model once for the queued
+  /// indexes.
+  client::ApiResponse<client::ApiNoResult, client::ApiError> InitPublishing(
+      client::CancellationContext context);
+
+  UploadIndexDataResponse UploadIndexData(
+      const model::PublishIndexRequest& request,
+      client::CancellationContext context);
+
  private:
   client::HRN catalog_;
+  /// Every operation refreshes the catalog model from the catalog cache, or
+  /// when there is no cache, once the model expires.
+  std::mutex catalog_model_mutex_;
   model::Catalog catalog_model_;
+  time_t catalog_model_expiry_{0};
 
   client::OlpClientSettings settings_;
 
@@ -106,6 +135,12 @@ class IndexLayerClientImpl
   std::condition_variable cond_var_;
 
   bool init_in_progress_;
+
+  IndexLayerClientSettings index_settings_;
+  std::mutex batch_writer_mutex_;
+  std::shared_ptr<IndexBatchWriter> batch_writer_;
+  std::mutex init_publishing_mutex_;
+  std::atomic<bool> publishing_initialized_;
 };
 }  // namespace write
 }  // namespace dataservice
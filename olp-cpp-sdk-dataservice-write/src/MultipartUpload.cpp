@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "MultipartUpload.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <olp/core/client/CancellationToken.h>
+#include <olp/core/logging/Log.h>
+#include "Common.h"
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+namespace {
+constexpr auto kLogTag = "MultipartUpload";
+
+struct UploadState {
+  std::mutex mutex;
+  std::condition_variable condition;
+  size_t part_count{0u};
+  size_t next_part{0u};
+  size_t running{0u};
+  bool cancelled{false};
+  boost::optional<client::ApiError> error;
+  UploadedParts parts;
+};
+
+struct UploadTarget {
+  client::OlpClient client;
+  std::string upload_part_url;
+  const DataSource* source;
+  std::uint64_t part_size;
+};
+
+bool IsAbsoluteUrl(const std::string& url) {
+  return url.compare(0, 7, "http://") == 0 ||
+         url.compare(0, 8, "https://") == 0;
+}
+
+// Uploads the parts one by one until none is left or any part fails.
+void UploadParts(const std::shared_ptr<UploadState>& state,
+                 const std::shared_ptr<UploadTarget>& target,
+                 client::CancellationContext context) {
+  while (true) {
+    size_t part = 0u;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->cancelled || state->error ||
+          state->next_part >= state->part_count) {
+        return;
+      }
+      part = state->next_part++;
+      ++state->running;
+    }
+
+    // The network reads the part from the source while it is sent.
+    auto data = std::make_shared<const DataSource>(target->source->Slice(
+        part * target->part_size, target->part_size));
+
+    auto response = BlobApi::UploadPart(
+        target->client, target->upload_part_url, part + 1u, data, context);
+
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (response.IsSuccessful()) {
+        state->parts[part] = {part + 1u, response.MoveResult()};
+      } else if (!state->error) {
+        state->error = response.GetError();
+      }
+      --state->running;
+    }
+    state->condition.notify_all();
+  }
+}
+}  // namespace
+
+PutBlobResponse UploadBlobInParts(
+    const client::OlpClient& blob_client,
+    const client::OlpClientSettings& settings, const std::string& layer_id,
+    const std::string& content_type, const std::string& data_handle,
+    const DataSource& source, const boost::optional<std::string>& billing_tag,
+    const std::shared_ptr<client::PendingRequests>& pending_requests,
+    client::CancellationContext context,
+    const MultipartUploadSettings& upload_settings) {
+  auto init_response = BlobApi::InitMultipartUpload(
+      blob_client, layer_id, content_type, data_handle, billing_tag, context);
+  if (!init_response.IsSuccessful()) {
+    return init_response.GetError();
+  }
+  const auto upload = init_response.MoveResult();
+
+  // The service returns absolute URLs, which are not relative to the base URL
+  // of the blob client.
+  client::OlpClient link_client;
+  link_client.SetSettings(settings);
+  auto client_for = [&](const std::string& url) -> const client::OlpClient& {
+    return IsAbsoluteUrl(url) ? link_client : blob_client;
+  };
+
+  const auto part_size = std::max<std::uint64_t>(upload_settings.part_size, 1u);
+  auto state = std::make_shared<UploadState>();
+  state->part_count =
+      static_cast<size_t>((source.GetSize() + part_size - 1u) / part_size);
+  state->parts.resize(state->part_count);
+
+  auto target = std::make_shared<UploadTarget>();
+  target->client = client_for(upload.upload_part_url);
+  target->upload_part_url = upload.upload_part_url;
+  target->source = &source;
+  target->part_size = part_size;
+
+  OLP_SDK_LOG_DEBUG_F(kLogTag, "Uploading %zu parts, data_handle=%s",
+                      state->part_count, data_handle.c_str());
+
+  // The calling thread is one of the workers.
+  using WorkerResponse = client::ApiResponse<bool, client::ApiError>;
+  std::vector<client::CancellationToken> tokens;
+  if (settings.task_scheduler) {
+    const auto workers =
+        std::min(upload_settings.max_parallel_parts, state->part_count);
+    for (size_t worker = 1u; worker < workers; ++worker) {
+      tokens.push_back(AddTask(
+          settings.task_scheduler, pending_requests,
+          [=](client::CancellationContext worker_context) -> WorkerResponse {
+            UploadParts(state, target, worker_context);
+            return true;
+          },
+          [](WorkerResponse) {}));
+    }
+  }
+
+  client::CancellationContext inner_context;
+  auto cancel = [=]() mutable {
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->cancelled = true;
+    }
+    inner_context.CancelOperation();
+    for (auto& token : tokens) {
+      token.Cancel();
+    }
+  };
+
+  if (context.ExecuteOrCancelled(
+          [&]() { return client::CancellationToken(cancel); })) {
+    UploadParts(state, target, inner_context);
+  } else {
+    cancel();
+  }
+
+  // Wait for the parts that other workers started, no part starts
+  // afterwards. The workers that did not start yet access only the state and
+  // the target, which they own, so the source may go away.
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&] { return state->running == 0u; });
+    target->source = nullptr;
+  }
+
+  boost::optional<client::ApiError> error = state->error;
+  if (context.IsCancelled()) {
+    error = client::ApiError(client::ErrorCode::Cancelled, "Cancelled");
+  }
+
+  if (error) {
+    if (!upload.delete_url.empty()) {
+      // The upload is aborted even if the request is cancelled.
+      auto abort_response = BlobApi::AbortMultipartUpload(
+          client_for(upload.delete_url), upload.delete_url,
+          client::CancellationContext());
+      if (!abort_response.IsSuccessful()) {
+        OLP_SDK_LOG_WARNING_F(kLogTag,
+                              "Unable to abort the upload, data_handle=%s, "
+                              "error=%s",
+                              data_handle.c_str(),
+                              abort_response.GetError().GetMessage().c_str());
+      }
+    }
+    return *error;
+  }
+
+  return BlobApi::CompleteMultipartUpload(client_for(upload.complete_url),
+                                          upload.complete_url, state->parts,
+                                          context);
+}
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
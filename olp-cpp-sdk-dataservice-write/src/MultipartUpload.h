@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <olp/core/client/CancellationContext.h>
+#include <olp/core/client/OlpClient.h>
+#include <olp/core/client/OlpClientSettings.h>
+#include <olp/core/client/PendingRequests.h>
+#include <olp/dataservice/write/DataSource.h>
+#include "generated/BlobApi.h"
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/// The blobs larger than this are uploaded in parts.
+constexpr std::uint64_t kMultipartUploadThreshold = 20971520;  // 20 MiB
+
+struct MultipartUploadSettings {
+  /// The size of every part except the last one, at least 5 MB.
+  std::uint64_t part_size = 8388608;  // 8 MiB
+  /// The maximum number of the parts that are uploaded at the same time.
+  size_t max_parallel_parts = 4u;
+};
+
+/**
+ * @brief Uploads the content of the source as a data blob in parts.
+ *
+ * The parts are streamed from the source and uploaded by up to
+ * `max_parallel_parts` workers, the calling thread is one of them and the
+ * others run on the task scheduler of the settings. Every part is retried
+ * according to the retry settings of the client. If any part fails or the
+ * upload is cancelled, the upload is aborted.
+ *
+ * @param blob_client The client of the blob service.
+ * @param settings The settings used for the URLs returned by the service.
+ * @param layer_id The ID of the layer that the data blob belongs to.
+ * @param content_type The content type configured for the layer.
+ * @param data_handle The data handle of the data blob.
+ * @param source The content of the data blob.
+ * @param billing_tag The optional billing tag.
+ * @param pending_requests Tracks the workers.
+ * @param context The `CancellationContext` instance.
+ * @param upload_settings The part size and the number of parallel parts.
+ *
+ * @return An empty response or an error.
+ */
+PutBlobResponse UploadBlobInParts(
+    const client::OlpClient& blob_client,
+    const client::OlpClientSettings& settings, const std::string& layer_id,
+    const std::string& content_type, const std::string& data_handle,
+    const DataSource& source, const boost::optional<std::string>& billing_tag,
+    const std::shared_ptr<client::PendingRequests>& pending_requests,
+    client::CancellationContext context,
+    const MultipartUploadSettings& upload_settings = MultipartUploadSettings());
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
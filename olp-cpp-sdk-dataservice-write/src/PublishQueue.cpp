@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include "PublishQueue.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <utility>
+
+#include <olp/core/logging/Log.h>
+
+// clang-format off
+#include <generated/serializer/PublishDataRequestSerializer.h>
+#include <generated/serializer/JsonSerializer.h>
+// clang-format on
+
+// clang-format off
+#include <generated/parser/PublishDataRequestParser.h>
+#include <olp/core/generated/parser/JsonParser.h>
+// clang-format on
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+namespace {
+constexpr auto kLogTag = "PublishQueue";
+// Zero padded, so the keys of the requests sort in the queue order.
+constexpr size_t kPositionWidth = 20u;
+
+std::string ToString(const std::string& value) { return value; }
+
+// The weak pointer keeps the key of a cache unique while the queue is used,
+// even when another cache is created at the same address.
+using QueueKey = std::pair<std::weak_ptr<cache::KeyValueCache>, std::string>;
+
+struct QueueKeyLess {
+  bool operator()(const QueueKey& lhs, const QueueKey& rhs) const {
+    std::owner_less<std::weak_ptr<cache::KeyValueCache>> less;
+    if (less(lhs.first, rhs.first)) {
+      return true;
+    }
+    if (less(rhs.first, lhs.first)) {
+      return false;
+    }
+    return lhs.second < rhs.second;
+  }
+};
+
+struct Queues {
+  std::mutex mutex;
+  std::map<QueueKey, std::weak_ptr<PublishQueue>, QueueKeyLess> queues;
+};
+
+Queues& GetQueues() {
+  static Queues queues;
+  return queues;
+}
+}  // namespace
+
+PublishQueue::PublishQueue(std::shared_ptr<cache::KeyValueCache> cache,
+                           std::string key_prefix, std::string legacy_list_key)
+    : cache_(std::move(cache)),
+      key_prefix_(std::move(key_prefix)),
+      legacy_list_key_(std::move(legacy_list_key)),
+      head_key_(key_prefix_ + "-head"),
+      tail_key_(key_prefix_ + "-tail"),
+      loaded_(false),
+      head_(0u),
+      tail_(0u) {}
+
+std::shared_ptr<PublishQueue> PublishQueue::Create(
+    std::shared_ptr<cache::KeyValueCache> cache, std::string key_prefix,
+    std::string legacy_list_key) {
+  auto& queues = GetQueues();
+  std::lock_guard<std::mutex> lock(queues.mutex);
+  for (auto it = queues.queues.begin(); it != queues.queues.end();) {
+    if (it->second.expired()) {
+      it = queues.queues.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto& existing_queue = queues.queues[QueueKey(cache, key_prefix)];
+  auto queue = existing_queue.lock();
+  if (!queue) {
+    queue = std::make_shared<PublishQueue>(
+        std::move(cache), std::move(key_prefix), std::move(legacy_list_key));
+    existing_queue = queue;
+  }
+  return queue;
+}
+
+size_t PublishQueue::Size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Load();
+  return static_cast<size_t>(tail_ - head_);
+}
+
+bool PublishQueue::Push(const model::PublishDataRequest& request) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Load();
+
+  // An interrupted push leaves only an invisible request, which the next
+  // push overwrites.
+  if (!PutRequest(tail_, request) || !PutCursor(tail_key_, tail_ + 1u)) {
+    OLP_SDK_LOG_ERROR(kLogTag, "Unable to store the request in the cache");
+    return false;
+  }
+
+  ++tail_;
+  return true;
+}
+
+std::vector<model::PublishDataRequest> PublishQueue::Peek(size_t count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Load();
+
+  std::vector<model::PublishDataRequest> requests;
+  auto position = head_;
+  while (requests.size() < count && position < tail_) {
+    auto request = GetRequest(RequestKey(position));
+    if (request) {
+      requests.push_back(std::move(*request));
+      ++position;
+      continue;
+    }
+
+    if (!requests.empty()) {
+      // Dropped once it is at the front.
+      break;
+    }
+
+    OLP_SDK_LOG_ERROR(kLogTag,
+                      "Unable to restore the request from the cache, "
+                      "dropping it");
+    PopLocked(1u);
+    position = head_;
+  }
+
+  return requests;
+}
+
+void PublishQueue::Pop(size_t count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Load();
+  PopLocked(count);
+}
+
+boost::optional<model::PublishDataRequest> PublishQueue::PopFront() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Load();
+
+  while (head_ < tail_) {
+    auto request = GetRequest(RequestKey(head_));
+    PopLocked(1u);
+    if (request) {
+      return request;
+    }
+
+    OLP_SDK_LOG_ERROR(kLogTag,
+                      "Unable to restore the request from the cache, "
+                      "dropping it");
+  }
+
+  return boost::none;
+}
+
+void PublishQueue::Load() {
+  if (loaded_) {
+    return;
+  }
+  loaded_ = true;
+
+  head_ = GetCursor(head_key_);
+  tail_ = GetCursor(tail_key_);
+  if (tail_ < head_) {
+    OLP_SDK_LOG_WARNING(kLogTag, "Inconsistent queue cursors, queue is reset");
+    tail_ = head_;
+    PutCursor(tail_key_, tail_);
+  }
+
+  // Removes the requests left by interrupted pops.
+  if (head_ == tail_) {
+    cache_->RemoveKeysWithPrefix(key_prefix_ + "-item-");
+  }
+
+  MigrateLegacyList();
+}
+
+void PublishQueue::MigrateLegacyList() {
+  const auto list_any = cache_->Get(legacy_list_key_, ToString);
+  if (list_any.empty()) {
+    return;
+  }
+
+  const auto list = boost::any_cast<std::string>(list_any);
+  std::vector<std::string> keys;
+  size_t begin = 0u;
+  for (auto end = list.find(','); end != std::string::npos;
+       begin = end + 1u, end = list.find(',', begin)) {
+    keys.push_back(list.substr(begin, end - begin));
+  }
+
+  auto tail = tail_;
+  for (const auto& key : keys) {
+    auto request = GetRequest(key);
+    if (request && PutRequest(tail, *request)) {
+      ++tail;
+    }
+  }
+
+  if (tail != tail_ && !PutCursor(tail_key_, tail)) {
+    OLP_SDK_LOG_ERROR(kLogTag, "Unable to migrate the queued requests");
+    return;
+  }
+  tail_ = tail;
+
+  cache_->Remove(legacy_list_key_);
+  for (const auto& key : keys) {
+    cache_->Remove(key);
+  }
+
+  OLP_SDK_LOG_INFO_F(kLogTag, "Migrated %zu queued requests", keys.size());
+}
+
+bool PublishQueue::PutRequest(std::uint64_t position,
+                              const model::PublishDataRequest& request) {
+  return cache_->Put(RequestKey(position), request, [&]() {
+    return olp::serializer::serialize<model::PublishDataRequest>(request);
+  });
+}
+
+void PublishQueue::PopLocked(size_t count) {
+  const auto end = head_ + std::min<std::uint64_t>(count, tail_ - head_);
+  if (end == head_) {
+    return;
+  }
+
+  // An interrupted pop leaves only unreachable requests, which are removed
+  // when the queue is loaded empty.
+  if (!PutCursor(head_key_, end)) {
+    OLP_SDK_LOG_ERROR(kLogTag, "Unable to store the queue head in the cache");
+  }
+
+  for (auto position = head_; position < end; ++position) {
+    cache_->Remove(RequestKey(position));
+  }
+  head_ = end;
+}
+
+std::string PublishQueue::RequestKey(std::uint64_t position) const {
+  auto number = std::to_string(position);
+  if (number.size() < kPositionWidth) {
+    number.insert(0u, kPositionWidth - number.size(), '0');
+  }
+  return key_prefix_ + "-item-" + number;
+}
+
+boost::optional<model::PublishDataRequest> PublishQueue::GetRequest(
+    const std::string& key) {
+  const auto request_any = cache_->Get(key, [](const std::string& value) {
+    return olp::parser::parse<model::PublishDataRequest>(value);
+  });
+
+  if (request_any.empty()) {
+    return boost::none;
+  }
+  return boost::any_cast<model::PublishDataRequest>(request_any);
+}
+
+std::uint64_t PublishQueue::GetCursor(const std::string& key) {
+  const auto value_any = cache_->Get(key, ToString);
+  if (value_any.empty()) {
+    return 0u;
+  }
+  return std::strtoull(boost::any_cast<std::string>(value_any).c_str(),
+                       nullptr, 10);
+}
+
+bool PublishQueue::PutCursor(const std::string& key, std::uint64_t value) {
+  const auto value_string = std::to_string(value);
+  return cache_->Put(key, value_string, [&]() { return value_string; });
+}
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
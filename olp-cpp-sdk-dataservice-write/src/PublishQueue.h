@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <olp/core/cache/KeyValueCache.h>
+#include <olp/dataservice/write/model/PublishDataRequest.h>
+#include <boost/optional.hpp>
+
+namespace olp {
+namespace dataservice {
+namespace write {
+
+/**
+ * @brief A persistent FIFO queue of publish requests.
+ *
+ * Every request is stored under its own sequence-numbered key, and the
+ * positions of the first and the next request are stored as head and tail
+ * cursors, so pushing and popping a request takes a constant number of cache
+ * operations. A request is written before the tail cursor that makes it
+ * visible, and the head cursor is moved before the popped requests are
+ * removed, so an interrupted operation never loses or duplicates a queued
+ * request. `Pop` moves the head once for any number of requests, so a flush
+ * can persist its progress once per batch.
+ *
+ * The queue is loaded from the cache on first use, including the queue
+ * stored by previous SDK versions as a comma-separated list of keys. The
+ * cursors are kept in memory afterwards, so the clients that use the same
+ * cache and catalog share one queue created with `Create`.
+ */
+class PublishQueue {
+ public:
+  /**
+   * @param cache The cache that stores the queue.
+   * @param key_prefix The prefix of all the keys of the queue.
+   * @param legacy_list_key The key of the queue stored by previous SDK
+   * versions.
+   */
+  PublishQueue(std::shared_ptr<cache::KeyValueCache> cache,
+               std::string key_prefix, std::string legacy_list_key);
+
+  /// Returns the queue that is already used for the cache and the prefix, or
+  /// creates a new one.
+  static std::shared_ptr<PublishQueue> Create(
+      std::shared_ptr<cache::KeyValueCache> cache, std::string key_prefix,
+      std::string legacy_list_key);
+
+  /// Returns the number of the queued requests.
+  size_t Size();
+
+  /// Appends the request to the end of the queue.
+  bool Push(const model::PublishDataRequest& request);
+
+  /// Returns up to `count` requests from the front of the queue without
+  /// removing them. The requests that cannot be read are dropped.
+  std::vector<model::PublishDataRequest> Peek(size_t count);
+
+  /// Removes up to `count` requests from the front of the queue.
+  void Pop(size_t count);
+
+  /// Removes and returns the first request that can be read.
+  boost::optional<model::PublishDataRequest> PopFront();
+
+ protected:
+  /// Loads the cursors, must be called with the mutex locked.
+  void Load();
+
+  /// Moves the requests of the legacy list to the queue, must be called with
+  /// the mutex locked.
+  void MigrateLegacyList();
+
+  /// Stores the request at the given position, must be called with the
+  /// mutex locked.
+  bool PutRequest(std::uint64_t position,
+                  const model::PublishDataRequest& request);
+
+  /// Must be called with the mutex locked.
+  void PopLocked(size_t count);
+
+  std::string RequestKey(std::uint64_t position) const;
+
+  boost::optional<model::PublishDataRequest> GetRequest(
+      const std::string& key);
+
+  std::uint64_t GetCursor(const std::string& key);
+
+  bool PutCursor(const std::string& key, std::uint64_t value);
+
+ private:
+  std::shared_ptr<cache::KeyValueCache> cache_;
+  const std::string key_prefix_;
+  const std::string legacy_list_key_;
+  const std::string head_key_;
+  const std::string tail_key_;
+
+  std::mutex mutex_;
+  bool loaded_;
+  std::uint64_t head_;
+  std::uint64_t tail_;
+};
+
+}  // namespace write
+}  // namespace dataservice
+}  // namespace olp
@@ -19,14 +19,39 @@
 
 #include "olp/dataservice/write/StreamLayerClient.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <olp/core/cache/DefaultCache.h>
 #include <olp/core/client/OlpClientSettingsFactory.h>
+#include "AutoFlushController.h"
+#include "FlushEventListener.h"
 #include "StreamLayerClientImpl.h"
 
 namespace olp {
 namespace dataservice {
 namespace write {
 
+namespace {
+bool IsAutoFlushEnabled(const StreamLayerClientSettings& settings) {
+  return settings.auto_flush_num_events > 0u ||
+         settings.auto_flush_num_bytes > 0u ||
+         settings.auto_flush_max_age.count() > 0;
+}
+
+AutoFlushSettings GetAutoFlushSettings(
+    const StreamLayerClientSettings& settings) {
+  AutoFlushSettings flush_settings;
+  flush_settings.auto_flush_num_events = static_cast<int>(
+      std::min<size_t>(settings.auto_flush_num_events,
+                       std::numeric_limits<int>::max()));
+  flush_settings.auto_flush_num_bytes = settings.auto_flush_num_bytes;
+  flush_settings.auto_flush_max_age = settings.auto_flush_max_age;
+  flush_settings.target_flush_latency = settings.target_flush_latency;
+  return flush_settings;
+}
+}  // namespace
+
 std::shared_ptr<cache::KeyValueCache> CreateDefaultCache(
     cache::CacheSettings settings) {
   return client::OlpClientSettingsFactory::CreateDefaultCache(
@@ -40,8 +65,18 @@ StreamLayerClient::StreamLayerClient(client::HRN catalog,
     settings.cache = client::OlpClientSettingsFactory::CreateDefaultCache({});
   }
 
+  const bool auto_flush = IsAutoFlushEnabled(client_settings);
+  const auto flush_settings = GetAutoFlushSettings(client_settings);
+
   impl_ = std::make_shared<StreamLayerClientImpl>(
       std::move(catalog), std::move(client_settings), std::move(settings));
+
+  if (auto_flush) {
+    auto_flush_controller_ =
+        std::make_shared<AutoFlushController>(flush_settings);
+    auto_flush_controller_->Enable(
+        impl_, std::shared_ptr<FlushEventListener<const FlushResponse&>>());
+  }
 }
 
 void StreamLayerClient::CancelPendingRequests() {
@@ -60,7 +95,12 @@ olp::client::CancellationToken StreamLayerClient::PublishData(
 
 boost::optional<std::string> StreamLayerClient::Queue(
     model::PublishDataRequest request) {
-  return impl_->Queue(request);
+  auto error = impl_->Queue(request);
+  if (!error && auto_flush_controller_) {
+    auto_flush_controller_->NotifyQueueEventComplete(
+        request.GetData()->size());
+  }
+  return error;
 }
 
 olp::client::CancellableFuture<StreamLayerClient::FlushResponse>
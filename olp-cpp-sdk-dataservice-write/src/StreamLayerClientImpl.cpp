@@ -19,6 +19,9 @@
 
 #include "StreamLayerClientImpl.h"
 
+#include <algorithm>
+#include <condition_variable>
+
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -32,21 +35,15 @@
 #include <olp/dataservice/write/model/PublishDataRequest.h>
 #include <olp/dataservice/write/model/PublishSdiiRequest.h>
 #include "ApiClientLookup.h"
+#include "CatalogCache.h"
+#include "Common.h"
+#include "ContentEncoding.h"
+#include "MultipartUpload.h"
+#include "PublishQueue.h"
 #include "generated/BlobApi.h"
-#include "generated/ConfigApi.h"
 #include "generated/IngestApi.h"
 #include "generated/PublishApi.h"
 
-// clang-format off
-#include <generated/serializer/PublishDataRequestSerializer.h>
-#include <generated/serializer/JsonSerializer.h>
-// clang-format on
-
-// clang-format off
-#include <generated/parser/PublishDataRequestParser.h>
-#include <olp/core/generated/parser/JsonParser.h>
-// clang-format on
-
 using namespace olp::client;
 using namespace olp::dataservice::write::model;
 
@@ -56,7 +53,9 @@ namespace write {
 
 namespace {
 constexpr auto kLogTag = "StreamLayerClientImpl";
-constexpr int64_t kTwentyMib = 20971520;  // 20 MiB
+constexpr std::uint64_t kTwentyMib = 20971520;  // 20 MiB
+// Number of the queued requests removed from the cache at once by `Flush`.
+constexpr size_t kFlushBatchSize = 32u;
 
 void ExecuteOrSchedule(const std::shared_ptr<thread::TaskScheduler>& scheduler,
                        thread::TaskScheduler::CallFuncType&& func) {
@@ -69,6 +68,79 @@ void ExecuteOrSchedule(const std::shared_ptr<thread::TaskScheduler>& scheduler,
   // Schedule for async execution
   scheduler->ScheduleTask(std::move(func));
 }
+
+using PublishFunction = std::function<PublishDataResponse(
+    const model::PublishDataRequest&, client::CancellationContext)>;
+
+struct PublishBatchState {
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<model::PublishDataRequest> requests;
+  std::vector<boost::optional<PublishDataResponse>> responses;
+  size_t next_request{0u};
+  size_t running{0u};
+  bool cancelled{false};
+};
+
+// Publishes the requests one by one until none is left.
+void PublishRequests(const std::shared_ptr<PublishBatchState>& state,
+                     const PublishFunction& publish,
+                     client::CancellationContext context) {
+  while (true) {
+    size_t index = 0u;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->cancelled || state->next_request >= state->requests.size()) {
+        return;
+      }
+      index = state->next_request++;
+      ++state->running;
+    }
+
+    auto response = publish(state->requests[index], context);
+
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->responses[index] = std::move(response);
+      --state->running;
+    }
+    state->condition.notify_all();
+  }
+}
+
+std::uint64_t GetDataSize(const model::PublishDataRequest& request) {
+  if (request.GetData()) {
+    return request.GetData()->size();
+  }
+  return request.GetDataSource() ? request.GetDataSource()->GetSize() : 0u;
+}
+
+// Replaces the data of the request with the data compressed with the
+// content encoding of the layer, if the request asks for it.
+boost::optional<ApiError> CompressRequestData(
+    const model::Catalog& catalog, model::PublishDataRequest& request) {
+  if (!request.GetCompression()) {
+    return boost::none;
+  }
+
+  const auto source = request.GetData() || !request.GetDataSource()
+                          ? DataSource::FromData(request.GetData())
+                          : *request.GetDataSource();
+  auto response = CompressData(catalog, request.GetLayerId(), source,
+                               request.GetChecksum());
+  if (!response.IsSuccessful()) {
+    return response.GetError();
+  }
+  if (response.GetResult()) {
+    request.WithData(response.MoveResult());
+  }
+  return boost::none;
+}
+
+bool IsCancelledResponse(const PublishDataResponse& response) {
+  return !response.IsSuccessful() &&
+         response.GetError().GetErrorCode() == ErrorCode::Cancelled;
+}
 }  // namespace
 
 StreamLayerClientImpl::StreamLayerClientImpl(
@@ -77,10 +149,15 @@ StreamLayerClientImpl::StreamLayerClientImpl(
     : catalog_(std::move(catalog)),
       settings_(std::move(settings)),
       cache_(settings_.cache),
-      cache_mutex_(),
       stream_client_settings_(std::move(client_settings)),
       pending_requests_(std::make_shared<client::PendingRequests>()),
-      task_scheduler_(std::move(settings_.task_scheduler)) {}
+      task_scheduler_(std::move(settings_.task_scheduler)) {
+  if (cache_) {
+    const auto queue_prefix = catalog_.ToCatalogHRNString() + "-stream-queue";
+    queue_ = PublishQueue::Create(cache_, queue_prefix,
+                                  queue_prefix + "-cache");
+  }
+}
 
 StreamLayerClientImpl::~StreamLayerClientImpl() {
   pending_requests_->CancelAllAndWait();
@@ -104,25 +181,38 @@ std::string StreamLayerClientImpl::FindContentTypeForLayerId(
   return {};
 }
 
-std::string StreamLayerClientImpl::GetUuidListKey() const {
-  static const std::string kStreamCachePostfix = "-stream-queue-cache";
-  const std::string uuid_list_key =
-      catalog_.ToCatalogHRNString() + kStreamCachePostfix;
-  return uuid_list_key;
-}
+StreamLayerClientImpl::ContentTypeResponse
+StreamLayerClientImpl::PrepareRequestData(const model::Catalog& catalog,
+                                          model::PublishDataRequest& request) {
+  auto content_type = FindContentTypeForLayerId(catalog, request.GetLayerId());
+  if (content_type.empty()) {
+    return ApiError(ErrorCode::InvalidArgument,
+                    "Unable to find the Layer ID=`" + request.GetLayerId() +
+                        "` provided in the PublishDataRequest in the "
+                        "Catalog=" +
+                        catalog_.ToString());
+  }
 
-size_t StreamLayerClientImpl::QueueSize() const {
-  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto compress_error = CompressRequestData(catalog, request);
+  if (compress_error) {
+    return *compress_error;
+  }
+  return content_type;
+}
 
-  const auto uuid_list_any =
-      cache_->Get(GetUuidListKey(), [](const std::string& s) { return s; });
-  std::string uuid_list = "";
-  if (!uuid_list_any.empty()) {
-    uuid_list = boost::any_cast<std::string>(uuid_list_any);
-    return std::count(uuid_list.cbegin(), uuid_list.cend(), ',');
+StreamLayerClientImpl::ContentTypeResponse
+StreamLayerClientImpl::PrepareRequestData(
+    model::PublishDataRequest& request, client::CancellationContext context) {
+  auto catalog_response = CatalogCache::Get(
+      catalog_, settings_, request.GetBillingTag(), context);
+  if (!catalog_response.IsSuccessful()) {
+    return catalog_response.GetError();
   }
+  return PrepareRequestData(catalog_response.GetResult(), request);
+}
 
-  return 0;
+size_t StreamLayerClientImpl::QueueSize() const {
+  return queue_ ? queue_->Size() : 0u;
 }
 
 boost::optional<std::string> StreamLayerClientImpl::Queue(
@@ -148,67 +238,14 @@ boost::optional<std::string> StreamLayerClientImpl::Queue(
         "Maximum number of requests has reached");
   }
 
-  {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
-    const auto publish_data_key = GenerateUuid();
-    cache_->Put(publish_data_key, request, [=]() {
-      return olp::serializer::serialize<PublishDataRequest>(request);
-    });
-
-    const auto uuid_list_any =
-        cache_->Get(GetUuidListKey(), [](const std::string& s) { return s; });
-    std::string uuid_list = "";
-    if (!uuid_list_any.empty()) {
-      uuid_list = boost::any_cast<std::string>(uuid_list_any);
-    }
-    uuid_list += publish_data_key + ",";
-
-    cache_->Put(GetUuidListKey(), uuid_list,
-                [&uuid_list]() { return uuid_list; });
+  if (!queue_->Push(request)) {
+    return boost::make_optional<std::string>(
+        "Unable to store the request in the cache");
   }
 
   return boost::none;
 }
 
-boost::optional<model::PublishDataRequest>
-StreamLayerClientImpl::PopFromQueue() {
-  std::lock_guard<std::mutex> lock(cache_mutex_);
-
-  const auto uuid_list_any =
-      cache_->Get(GetUuidListKey(), [](const std::string& s) { return s; });
-
-  if (uuid_list_any.empty()) {
-    OLP_SDK_LOG_ERROR(kLogTag, "Unable to Restore UUID list from Cache");
-    return boost::none;
-  }
-
-  auto uuid_list = boost::any_cast<std::string>(uuid_list_any);
-
-  auto pos = uuid_list.find(",");
-  if (pos == std::string::npos) {
-    return boost::none;
-  }
-
-  const auto publish_data_key = uuid_list.substr(0, pos);
-  auto publish_data_any =
-      cache_->Get(publish_data_key, [](const std::string& s) {
-        return olp::parser::parse<PublishDataRequest>(s);
-      });
-
-  cache_->Remove(publish_data_key);
-  uuid_list.erase(0, pos + 1);
-  cache_->Put(GetUuidListKey(), uuid_list,
-              [&uuid_list]() { return uuid_list; });
-
-  if (publish_data_any.empty()) {
-    OLP_SDK_LOG_ERROR(kLogTag,
-                      "Unable to Restore PublishData Request from Cache");
-    return boost::none;
-  }
-
-  return boost::any_cast<PublishDataRequest>(publish_data_any);
-}
-
 olp::client::CancellableFuture<StreamLayerClient::FlushResponse>
 StreamLayerClientImpl::Flush(model::FlushRequest request) {
   auto promise =
@@ -240,32 +277,82 @@ olp::client::CancellationToken StreamLayerClientImpl::Flush(
 
         StreamLayerClient::FlushResponse responses;
         const auto maximum_events_number = request.GetNumberOfRequestsToFlush();
-        if (maximum_events_number < 0) {
+        if (maximum_events_number < 0 || !queue_) {
           callback(std::move(responses));
           return EmptyFlushApiResponse{};
         }
 
-        int counter = 0;
-        while ((!maximum_events_number || counter < maximum_events_number) &&
-               (this->QueueSize() > 0) && !context.IsCancelled()) {
-          auto publish_request = this->PopFromQueue();
-          if (publish_request == boost::none) {
-            continue;
+        std::lock_guard<std::mutex> lock(flush_mutex_);
+
+        // The catalog configuration is resolved once per billing tag and
+        // flush, and the requests are removed from the queue once per batch.
+        const auto max_batch_size = std::max(
+            kFlushBatchSize, stream_client_settings_.maximum_parallel_requests);
+        PublishTargets targets;
+        size_t counter = 0u;
+        while (!context.IsCancelled()) {
+          auto batch_size = max_batch_size;
+          if (maximum_events_number) {
+            batch_size = std::min(
+                batch_size,
+                static_cast<size_t>(maximum_events_number) - counter);
           }
 
-          auto publish_response = PublishDataTask(*publish_request, context);
-          responses.emplace_back(std::move(publish_response));
-
-          // If cancelled queue back task
-          if (context.IsCancelled()) {
-            this->Queue(*publish_request);
+          auto batch = queue_->Peek(batch_size);
+          if (batch.empty()) {
             break;
           }
 
-          counter++;
+          // A request without a target and the requests after it stay in the
+          // queue, so a failed lookup does not drop them.
+          boost::optional<PublishDataResponse> target_error;
+          for (auto it = batch.begin(); it != batch.end(); ++it) {
+            const auto& billing_tag = it->GetBillingTag();
+            if (targets.count(billing_tag)) {
+              continue;
+            }
+
+            auto target = ResolvePublishTarget(*it, context);
+            if (!target.IsSuccessful()) {
+              target_error = PublishDataResponse(target.GetError());
+              batch.erase(it, batch.end());
+              break;
+            }
+            targets.emplace(billing_tag, target.MoveResult());
+          }
+
+          std::vector<boost::optional<PublishDataResponse>> batch_responses;
+          if (!batch.empty()) {
+            batch_responses = PublishBatch(targets, batch, context);
+          }
+
+          // The cancelled requests and the requests after them stay in the
+          // queue.
+          size_t published = 0u;
+          while (published < batch_responses.size() &&
+                 batch_responses[published] &&
+                 !IsCancelledResponse(*batch_responses[published])) {
+            published++;
+          }
+
+          for (auto& response : batch_responses) {
+            if (response) {
+              responses.emplace_back(std::move(*response));
+            }
+          }
+
+          if (target_error) {
+            responses.emplace_back(std::move(*target_error));
+          }
+
+          queue_->Pop(published);
+          counter += published;
+          if (published < batch.size() || target_error) {
+            break;
+          }
         }
 
-        OLP_SDK_LOG_INFO_F(kLogTag, "Flushed %d publish requests", counter);
+        OLP_SDK_LOG_INFO_F(kLogTag, "Flushed %zu publish requests", counter);
         callback(responses);
         return EmptyFlushApiResponse{};
       },
@@ -300,7 +387,7 @@ StreamLayerClientImpl::PublishData(const model::PublishDataRequest request) {
 
 CancellationToken StreamLayerClientImpl::PublishData(
     model::PublishDataRequest request, PublishDataCallback callback) {
-  if (!request.GetData()) {
+  if (!request.GetData() && !request.GetDataSource()) {
     callback(PublishDataResponse(
         ApiError(ErrorCode::InvalidArgument, "Request's data is null.")));
     return CancellationToken();
@@ -322,10 +409,119 @@ CancellationToken StreamLayerClientImpl::PublishData(
   return task_context.CancelToken();
 }
 
+std::vector<boost::optional<PublishDataResponse>>
+StreamLayerClientImpl::PublishBatch(
+    const PublishTargets& targets,
+    const std::vector<model::PublishDataRequest>& requests,
+    client::CancellationContext context) {
+  auto state = std::make_shared<PublishBatchState>();
+  state->requests = requests;
+  state->responses.resize(requests.size());
+
+  PublishFunction publish = [=](const model::PublishDataRequest& request,
+                                client::CancellationContext context) {
+    return PublishQueuedData(targets.at(request.GetBillingTag()), request,
+                             std::move(context));
+  };
+
+  // The calling thread is one of the workers.
+  using WorkerResponse = client::ApiResponse<bool, client::ApiError>;
+  std::vector<client::CancellationToken> tokens;
+  if (task_scheduler_) {
+    const auto workers = std::min(
+        stream_client_settings_.maximum_parallel_requests, requests.size());
+    for (size_t worker = 1u; worker < workers; ++worker) {
+      tokens.push_back(AddTask(
+          task_scheduler_, pending_requests_,
+          [=](client::CancellationContext worker_context) -> WorkerResponse {
+            PublishRequests(state, publish, worker_context);
+            return true;
+          },
+          [](WorkerResponse) {}));
+    }
+  }
+
+  client::CancellationContext inner_context;
+  auto cancel = [=]() mutable {
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->cancelled = true;
+    }
+    inner_context.CancelOperation();
+    for (auto& token : tokens) {
+      token.Cancel();
+    }
+  };
+
+  if (!context.ExecuteOrCancelled(
+          [&]() { return client::CancellationToken(cancel); })) {
+    cancel();
+    return std::move(state->responses);
+  }
+
+  PublishRequests(state, publish, inner_context);
+
+  // Wait for the requests that other workers started, no request starts
+  // afterwards.
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->condition.wait(lock, [&] { return state->running == 0u; });
+  return std::move(state->responses);
+}
+
+StreamLayerClientImpl::PublishTargetResponse
+StreamLayerClientImpl::ResolvePublishTarget(
+    const model::PublishDataRequest& request,
+    client::CancellationContext context) {
+  auto catalog_response = CatalogCache::Get(
+      catalog_, settings_, request.GetBillingTag(), context);
+  if (!catalog_response.IsSuccessful()) {
+    return catalog_response.GetError();
+  }
+
+  auto ingest_response = ApiClientLookup::LookupApiClient(
+      catalog_, context, "ingest", "v1", settings_);
+  if (!ingest_response.IsSuccessful()) {
+    return ingest_response.GetError();
+  }
+
+  PublishTarget target;
+  target.ingest_client = ingest_response.MoveResult();
+  target.catalog = catalog_response.MoveResult();
+  return target;
+}
+
+PublishDataResponse StreamLayerClientImpl::PublishQueuedData(
+    const PublishTarget& target, model::PublishDataRequest request,
+    client::CancellationContext context) {
+  if (GetDataSize(request) > kTwentyMib) {
+    return PublishDataGreaterThanTwentyMib(std::move(request),
+                                           std::move(context));
+  }
+
+  auto content_type = PrepareRequestData(target.catalog, request);
+  if (!content_type.IsSuccessful()) {
+    return PublishDataResponse(content_type.GetError());
+  }
+
+  return IngestApi::IngestData(
+      target.ingest_client, request.GetLayerId(), content_type.GetResult(),
+      request.GetData(), request.GetTraceId(), request.GetBillingTag(),
+      request.GetChecksum(), context);
+}
+
 PublishDataResponse StreamLayerClientImpl::PublishDataTask(
     model::PublishDataRequest request, client::CancellationContext context) {
-  const int64_t data_size = request.GetData()->size() * sizeof(unsigned char);
+  const auto data_size = GetDataSize(request);
   if (data_size <= kTwentyMib) {
+    if (!request.GetData() && request.GetDataSource()) {
+      // Small content is ingested directly, so it is read into memory.
+      auto data = std::make_shared<std::vector<unsigned char>>(data_size);
+      if (!request.GetDataSource()->Read(0u, data_size, data->data())) {
+        return PublishDataResponse(ApiError(ErrorCode::InvalidArgument,
+                                            "Unable to read the data source"));
+      }
+      request.WithData(std::move(data));
+    }
     return PublishDataLessThanTwentyMib(std::move(request), std::move(context));
   } else {
     return PublishDataGreaterThanTwentyMib(std::move(request),
@@ -339,29 +535,11 @@ PublishDataResponse StreamLayerClientImpl::PublishDataLessThanTwentyMib(
                       "Started publishing data less than 20 MB, size=%zu B",
                       request.GetData()->size());
 
-  auto response = ApiClientLookup::LookupApiClient(catalog_, context, "config",
-                                                   "v1", settings_);
-  if (!response.IsSuccessful()) {
-    return PublishDataResponse(response.GetError());
-  }
-
-  client::OlpClient client = response.GetResult();
-  auto catalog_response = ConfigApi::GetCatalog(
-      client, catalog_.ToString(), request.GetBillingTag(), context);
-  if (!catalog_response.IsSuccessful()) {
-    return PublishDataResponse(catalog_response.GetError());
-  }
-
-  auto catalog = catalog_response.GetResult();
-  auto content_type = FindContentTypeForLayerId(catalog, request.GetLayerId());
-  if (content_type.empty()) {
-    return PublishDataResponse(
-        ApiError(ErrorCode::InvalidArgument,
-                 "Unable to find the Layer ID=`" + request.GetLayerId() +
-                     "` provided in the PublishDataRequest in the "
-                     "Catalog=" +
-                     catalog_.ToString()));
+  auto content_type_response = PrepareRequestData(request, context);
+  if (!content_type_response.IsSuccessful()) {
+    return PublishDataResponse(content_type_response.GetError());
   }
+  const auto& content_type = content_type_response.GetResult();
 
   auto ingest_api = ApiClientLookup::LookupApiClient(catalog_, context,
                                                      "ingest", "v1", settings_);
@@ -389,33 +567,16 @@ PublishDataResponse StreamLayerClientImpl::PublishDataLessThanTwentyMib(
 
 PublishDataResponse StreamLayerClientImpl::PublishDataGreaterThanTwentyMib(
     model::PublishDataRequest request, client::CancellationContext context) {
+  const auto data_size = GetDataSize(request);
   OLP_SDK_LOG_TRACE_F(kLogTag,
-                      "Started publishing data greater than 20MB, size=%zu B",
-                      request.GetData()->size());
-
-  auto config_response = ApiClientLookup::LookupApiClient(
-      catalog_, context, "config", "v1", settings_);
-  if (!config_response.IsSuccessful()) {
-    return PublishDataResponse(config_response.GetError());
-  }
+                      "Started publishing data greater than 20MB, size=%llu B",
+                      static_cast<unsigned long long>(data_size));
 
-  client::OlpClient config_client = config_response.MoveResult();
-  auto catalog_response = ConfigApi::GetCatalog(
-      config_client, catalog_.ToString(), request.GetBillingTag(), context);
-  if (!catalog_response.IsSuccessful()) {
-    return PublishDataResponse(catalog_response.GetError());
-  }
-
-  auto catalog = catalog_response.MoveResult();
-  auto content_type = FindContentTypeForLayerId(catalog, request.GetLayerId());
-  if (content_type.empty()) {
-    return PublishDataResponse(
-        ApiError(ErrorCode::InvalidArgument,
-                 "Unable to find the Layer ID=`" + request.GetLayerId() +
-                     "` provided in the PublishDataRequest in the "
-                     "Catalog=" +
-                     catalog_.ToString()));
+  auto content_type_response = PrepareRequestData(request, context);
+  if (!content_type_response.IsSuccessful()) {
+    return PublishDataResponse(content_type_response.GetError());
   }
+  const auto& content_type = content_type_response.GetResult();
 
   // Init api clients for publications:
   auto publish_client_response = ApiClientLookup::LookupApiClient(
@@ -450,11 +611,23 @@ PublishDataResponse StreamLayerClientImpl::PublishDataGreaterThanTwentyMib(
   const std::string publication_id =
       init_publicaion_response.GetResult().GetId().get();
 
-  // 2. Put blob API:
+  // 2. Put blob API, large blobs are uploaded in parts:
   const auto data_handle = GenerateUuid();
-  auto put_blob_response = BlobApi::PutBlob(
-      blob_client, request.GetLayerId(), content_type, data_handle,
-      request.GetData(), request.GetBillingTag(), context);
+  PutBlobResponse put_blob_response;
+  if (request.GetData() &&
+      request.GetData()->size() <= kMultipartUploadThreshold) {
+    put_blob_response = BlobApi::PutBlob(
+        blob_client, request.GetLayerId(), content_type, data_handle,
+        request.GetData(), request.GetBillingTag(), context);
+  } else {
+    const auto source = request.GetData()
+                            ? DataSource::FromData(request.GetData())
+                            : *request.GetDataSource();
+    put_blob_response = UploadBlobInParts(
+        blob_client, settings_, request.GetLayerId(), content_type,
+        data_handle, source, request.GetBillingTag(), pending_requests_,
+        context);
+  }
   if (!put_blob_response.IsSuccessful()) {
     return PublishDataResponse(put_blob_response.GetError());
   }
@@ -487,8 +660,9 @@ PublishDataResponse StreamLayerClientImpl::PublishDataGreaterThanTwentyMib(
 
   OLP_SDK_LOG_TRACE_F(
       kLogTag,
-      "Successfully published data greater than 20 MB, size=%zu B, trace_id=%s",
-      request.GetData()->size(), partition_id.c_str());
+      "Successfully published data greater than 20 MB, size=%llu B, "
+      "trace_id=%s",
+      static_cast<unsigned long long>(data_size), partition_id.c_str());
   return PublishDataResponse(response_ok_single);
 }
 
@@ -19,9 +19,14 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClient.h>
 #include <olp/core/client/OlpClientSettings.h>
 
 #include <olp/dataservice/write/StreamLayerClient.h>
@@ -36,6 +41,8 @@ class PendingRequests;
 namespace dataservice {
 namespace write {
 
+class PublishQueue;
+
 class StreamLayerClientImpl {
  public:
   StreamLayerClientImpl(client::HRN catalog,
@@ -57,7 +64,6 @@ class StreamLayerClientImpl {
   olp::client::CancellationToken Flush(
       model::FlushRequest request, StreamLayerClient::FlushCallback callback);
   size_t QueueSize() const;
-  boost::optional<model::PublishDataRequest> PopFromQueue();
 
   client::CancellableFuture<PublishSdiiResponse> PublishSdii(
       model::PublishSdiiRequest request);
@@ -83,11 +89,50 @@ class StreamLayerClientImpl {
 
   virtual std::string GenerateUuid() const;
 
+  /// The ingest client and the catalog configuration that `Flush` resolves
+  /// once for all the flushed requests with the same billing tag.
+  struct PublishTarget {
+    client::OlpClient ingest_client;
+    model::Catalog catalog;
+  };
+  using PublishTargetResponse =
+      client::ApiResponse<PublishTarget, client::ApiError>;
+  /// The publish targets by the billing tag.
+  using PublishTargets =
+      std::map<boost::optional<std::string>, PublishTarget>;
+
+  /// Resolves the publish target with the billing tag of the request.
+  virtual PublishTargetResponse ResolvePublishTarget(
+      const model::PublishDataRequest& request,
+      client::CancellationContext context);
+
+  virtual PublishDataResponse PublishQueuedData(
+      const PublishTarget& target, model::PublishDataRequest request,
+      client::CancellationContext context);
+
  private:
+  /// Publishes the requests in parallel, the responses of the requests that
+  /// did not start are empty.
+  std::vector<boost::optional<PublishDataResponse>> PublishBatch(
+      const PublishTargets& targets,
+      const std::vector<model::PublishDataRequest>& requests,
+      client::CancellationContext context);
+
   std::string FindContentTypeForLayerId(const model::Catalog& catalog,
                                         const std::string& layer_id);
 
-  std::string GetUuidListKey() const;
+  using ContentTypeResponse =
+      client::ApiResponse<std::string, client::ApiError>;
+
+  /// Finds the content type of the request layer and compresses the request
+  /// data if the request asks for it.
+  ContentTypeResponse PrepareRequestData(const model::Catalog& catalog,
+                                         model::PublishDataRequest& request);
+
+  /// Gets the catalog configuration with the billing tag of the request and
+  /// prepares the request data with it.
+  ContentTypeResponse PrepareRequestData(model::PublishDataRequest& request,
+                                         client::CancellationContext context);
 
  private:
   client::HRN catalog_;
@@ -95,7 +140,9 @@ class StreamLayerClientImpl {
   client::OlpClientSettings settings_;
 
   std::shared_ptr<cache::KeyValueCache> cache_;
-  mutable std::mutex cache_mutex_;
+  std::shared_ptr<PublishQueue> queue_;
+  /// Serializes the flushes, so the queued requests are published once.
+  std::mutex flush_mutex_;
   StreamLayerClientSettings stream_client_settings_;
 
   std::shared_ptr<client::PendingRequests> pending_requests_;
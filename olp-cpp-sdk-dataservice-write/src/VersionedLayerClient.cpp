@@ -96,6 +96,18 @@ olp::client::CancellationToken VersionedLayerClient::PublishToBatch(
   return impl_->PublishToBatch(pub, request, std::move(callback));
 }
 
+olp::client::CancellableFuture<PublishPartitionsResponse>
+VersionedLayerClient::PublishToBatch(const model::Publication& pub,
+                                     model::PublishPartitionsRequest request) {
+  return impl_->PublishToBatch(pub, std::move(request));
+}
+
+olp::client::CancellationToken VersionedLayerClient::PublishToBatch(
+    const model::Publication& pub, model::PublishPartitionsRequest request,
+    PublishPartitionsCallback callback) {
+  return impl_->PublishToBatch(pub, std::move(request), std::move(callback));
+}
+
 olp::client::CancellableFuture<CheckDataExistsResponse>
 VersionedLayerClient::CheckDataExists(model::CheckDataExistsRequest request) {
   return impl_->CheckDataExists(request);
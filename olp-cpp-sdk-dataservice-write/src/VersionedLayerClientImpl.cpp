@@ -22,13 +22,21 @@
 #include <olp/core/client/OlpClientFactory.h>
 
 #include "ApiClientLookup.h"
+#include "CatalogCache.h"
 #include "Common.h"
+#include "ContentEncoding.h"
+#include "ContentHash.h"
+#include "MultipartUpload.h"
 #include "generated/BlobApi.h"
 #include "generated/ConfigApi.h"
 #include "generated/MetadataApi.h"
 #include "generated/PublishApi.h"
 #include "generated/QueryApi.h"
 
+#include <algorithm>
+#include <map>
+#include <vector>
+
 #include <boost/format.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
@@ -45,6 +53,145 @@ namespace olp {
 namespace dataservice {
 namespace write {
 
+namespace {
+using UploadDataFunction = std::function<UploadPartitionDataResponse(
+    const model::PublishPartitionDataRequest&, client::CancellationContext)>;
+using CommitFunction = std::function<UploadPartitionResponse(
+    const std::string&, std::vector<model::PublishPartition>,
+    client::CancellationContext)>;
+
+// The metadata of the uploaded partitions that waits for a bulk upload.
+struct PendingPartitions {
+  std::vector<model::PublishPartition> partitions;
+  size_t bytes{0u};
+};
+
+struct PublishPartitionsState {
+  std::mutex mutex;
+  std::condition_variable condition;
+  model::PublishPartitionsRequest::PartitionSource partitions;
+  model::PublishPartitionsRequest::ProgressCallback progress_callback;
+  size_t max_partitions_per_upload{1u};
+  size_t max_bytes_per_upload{0u};
+  std::map<std::string, PendingPartitions> pending;
+  model::PublishPartitionsProgress progress;
+  boost::optional<client::ApiError> error;
+  size_t running{0u};
+  bool exhausted{false};
+  bool cancelled{false};
+};
+
+// The approximate size of the partition in the metadata upload request.
+size_t GetMetadataSize(const model::PublishPartition& partition) {
+  // The names of the fields, the quotes and the numbers.
+  constexpr size_t kFieldsSize = 96u;
+  return kFieldsSize + partition.GetPartition().value_or("").size() +
+         partition.GetDataHandle().value_or("").size() +
+         partition.GetChecksum().value_or("").size();
+}
+
+void ReportProgress(const PublishPartitionsState& state,
+                    const model::PublishPartitionsProgress& progress) {
+  if (state.progress_callback) {
+    state.progress_callback(progress);
+  }
+}
+
+bool CommitPartitions(const std::shared_ptr<PublishPartitionsState>& state,
+                      const CommitFunction& commit, const std::string& layer_id,
+                      std::vector<model::PublishPartition> partitions,
+                      client::CancellationContext context) {
+  const auto count = partitions.size();
+  auto response = commit(layer_id, std::move(partitions), std::move(context));
+
+  model::PublishPartitionsProgress progress;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!response.IsSuccessful()) {
+      if (!state->error) {
+        state->error = response.GetError();
+      }
+      return false;
+    }
+    state->progress.partitions_committed += count;
+    progress = state->progress;
+  }
+  ReportProgress(*state, progress);
+  return true;
+}
+
+// Uploads the data of the partitions one by one until none is left or any
+// upload fails. The metadata is uploaded when enough partitions of a layer
+// are collected.
+void PublishPartitionsWorker(
+    const std::shared_ptr<PublishPartitionsState>& state,
+    const UploadDataFunction& upload, const CommitFunction& commit,
+    client::CancellationContext context) {
+  while (true) {
+    boost::optional<model::PublishPartitionDataRequest> request;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->cancelled || state->error || state->exhausted) {
+        return;
+      }
+      request = state->partitions();
+      if (!request) {
+        state->exhausted = true;
+        return;
+      }
+      ++state->running;
+    }
+
+    auto response = upload(*request, context);
+
+    std::vector<model::PublishPartition> batch;
+    model::PublishPartitionsProgress progress;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (!response.IsSuccessful()) {
+        if (!state->error) {
+          state->error = response.GetError();
+        }
+      } else {
+        auto result = response.MoveResult();
+        auto& partition = result.partition;
+        ++state->progress.partitions_uploaded;
+        if (result.reused) {
+          ++state->progress.partitions_reused;
+        } else {
+          state->progress.bytes_uploaded +=
+              static_cast<std::uint64_t>(partition.GetDataSize().value_or(0));
+        }
+
+        auto& pending = state->pending[request->GetLayerId()];
+        pending.bytes += GetMetadataSize(partition);
+        pending.partitions.push_back(std::move(partition));
+        if (pending.partitions.size() >= state->max_partitions_per_upload ||
+            pending.bytes >= state->max_bytes_per_upload) {
+          batch.swap(pending.partitions);
+          pending.bytes = 0u;
+        }
+        progress = state->progress;
+      }
+    }
+
+    if (response.IsSuccessful()) {
+      ReportProgress(*state, progress);
+      if (!batch.empty()) {
+        CommitPartitions(state, commit, request->GetLayerId(),
+                         std::move(batch), context);
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      --state->running;
+    }
+    state->condition.notify_all();
+  }
+}
+}  // namespace
+
 VersionedLayerClientImpl::VersionedLayerClientImpl(
     client::HRN catalog, client::OlpClientSettings settings)
     : catalog_(std::move(catalog)),
@@ -478,6 +625,14 @@ olp::client::CancellationToken VersionedLayerClientImpl::PublishToBatch(
     return {};
   }
 
+  // Large content is uploaded in parts, and read from the source on demand.
+  boost::optional<DataSource> source;
+  if (!request.GetData()) {
+    source = request.GetDataSource();
+  } else if (request.GetData()->size() > kMultipartUploadThreshold) {
+    source = DataSource::FromData(request.GetData());
+  }
+
   const auto data_handle = GenerateUuid();
   std::shared_ptr<model::PublishPartition> partition =
       std::make_shared<model::PublishPartition>();
@@ -516,12 +671,30 @@ olp::client::CancellationToken VersionedLayerClientImpl::PublishToBatch(
   };
 
   auto catalogModel_callback = [=](boost::optional<client::ApiError> error) {
+    auto upload_source = source;
+    if (!error && request.GetCompression()) {
+      auto compress_response = CompressData(
+          self->GetCatalogModel(), layer_id,
+          source ? *source : DataSource::FromData(request.GetData()),
+          request.GetChecksum());
+      if (!compress_response.IsSuccessful()) {
+        error = compress_response.GetError();
+      } else if (compress_response.GetResult()) {
+        const auto& data = compress_response.GetResult();
+        partition->SetData(data);
+        upload_source = boost::none;
+        if (data->size() > kMultipartUploadThreshold) {
+          upload_source = DataSource::FromData(data);
+        }
+      }
+    }
+
     if (error) {
       self->tokenList_.RemoveTask(id);
       callback(std::move(*error));
     } else {
-      self->UploadBlob(publication_id, partition, data_handle, layer_id,
-                       cancel_context, uploadBlob_callback);
+      self->UploadBlob(publication_id, partition, upload_source, data_handle,
+                       layer_id, cancel_context, uploadBlob_callback);
     }
   };
 
@@ -533,6 +706,272 @@ olp::client::CancellationToken VersionedLayerClientImpl::PublishToBatch(
   return token;
 }
 
+olp::client::CancellableFuture<PublishPartitionsResponse>
+VersionedLayerClientImpl::PublishToBatch(
+    const model::Publication& pub, model::PublishPartitionsRequest request) {
+  auto promise = std::make_shared<std::promise<PublishPartitionsResponse>>();
+  return olp::client::CancellableFuture<PublishPartitionsResponse>(
+      PublishToBatch(pub, std::move(request),
+                     [promise](PublishPartitionsResponse response) {
+                       promise->set_value(std::move(response));
+                     }),
+      promise);
+}
+
+olp::client::CancellationToken VersionedLayerClientImpl::PublishToBatch(
+    const model::Publication& pub, model::PublishPartitionsRequest request,
+    PublishPartitionsCallback callback) {
+  std::string publication_id = pub.GetId().value_or("");
+  if (publication_id.empty()) {
+    callback(client::ApiError(client::ErrorCode::InvalidArgument,
+                              "Invalid publication", true));
+    return {};
+  }
+
+  if (!request.GetPartitions()) {
+    callback(client::ApiError(client::ErrorCode::InvalidArgument,
+                              "Invalid request", true));
+    return {};
+  }
+
+  auto self = shared_from_this();
+  return AddTask(
+      settings_.task_scheduler, pending_requests_,
+      [=](client::CancellationContext context) -> PublishPartitionsResponse {
+        return self->PublishPartitions(publication_id, request, context);
+      },
+      std::move(callback));
+}
+
+PublishPartitionsResponse VersionedLayerClientImpl::PublishPartitions(
+    const std::string& publication_id,
+    const model::PublishPartitionsRequest& request,
+    client::CancellationContext context) {
+  auto init_response = InitCatalogModel(context);
+  if (!init_response.IsSuccessful()) {
+    return init_response.GetError();
+  }
+
+  auto state = std::make_shared<PublishPartitionsState>();
+  state->partitions = request.GetPartitions();
+  state->progress_callback = request.GetProgressCallback();
+  state->max_partitions_per_upload =
+      std::max<size_t>(request.GetMaxPartitionsPerUpload(), 1u);
+  state->max_bytes_per_upload = request.GetMaxBytesPerUpload();
+
+  const auto deduplication = request.GetDeduplication();
+  auto self = shared_from_this();
+  UploadDataFunction upload =
+      [=](const model::PublishPartitionDataRequest& partition,
+          client::CancellationContext context) {
+        return self->UploadPartitionData(partition, deduplication,
+                                         std::move(context));
+      };
+
+  CommitFunction commit = [=](const std::string& layer_id,
+                              std::vector<model::PublishPartition> partitions,
+                              client::CancellationContext context) {
+    return self->UploadPartitions(publication_id, layer_id,
+                                  std::move(partitions), std::move(context));
+  };
+
+  // The calling thread is one of the workers.
+  using WorkerResponse = client::ApiResponse<bool, client::ApiError>;
+  std::vector<client::CancellationToken> tokens;
+  if (settings_.task_scheduler) {
+    for (size_t worker = 1u; worker < request.GetMaxParallelUploads();
+         ++worker) {
+      tokens.push_back(AddTask(
+          settings_.task_scheduler, pending_requests_,
+          [=](client::CancellationContext worker_context) -> WorkerResponse {
+            PublishPartitionsWorker(state, upload, commit, worker_context);
+            return true;
+          },
+          [](WorkerResponse) {}));
+    }
+  }
+
+  client::CancellationContext inner_context;
+  auto cancel = [=]() mutable {
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->cancelled = true;
+    }
+    inner_context.CancelOperation();
+    for (auto& token : tokens) {
+      token.Cancel();
+    }
+  };
+
+  if (context.ExecuteOrCancelled(
+          [&]() { return client::CancellationToken(cancel); })) {
+    PublishPartitionsWorker(state, upload, commit, inner_context);
+  } else {
+    cancel();
+  }
+
+  // Wait for the partitions that other workers started, no partition starts
+  // afterwards.
+  std::map<std::string, PendingPartitions> pending;
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&] { return state->running == 0u; });
+    if (!state->cancelled && !state->error) {
+      pending.swap(state->pending);
+    }
+  }
+
+  // Upload the metadata that did not fill a whole upload.
+  for (auto& layer : pending) {
+    if (!layer.second.partitions.empty() &&
+        !CommitPartitions(state, commit, layer.first,
+                          std::move(layer.second.partitions), inner_context)) {
+      break;
+    }
+  }
+
+  if (context.IsCancelled()) {
+    return client::ApiError(client::ErrorCode::Cancelled,
+                            "Operation cancelled.", true);
+  }
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  if (state->error) {
+    return *state->error;
+  }
+  return state->progress;
+}
+
+UploadPartitionDataResponse VersionedLayerClientImpl::UploadPartitionData(
+    const model::PublishPartitionDataRequest& request, bool deduplication,
+    client::CancellationContext context) {
+  const auto& layer_id = request.GetLayerId();
+  const auto content_type = FindContentTypeForLayerId(layer_id);
+  if (content_type.empty()) {
+    auto errmsg = boost::format(
+                      "Unable to find the Layer ID (%1%) "
+                      "provided in the request in the "
+                      "Catalog specified when creating "
+                      "this VersionedLayerClient instance.") %
+                  layer_id;
+    return client::ApiError(client::ErrorCode::InvalidArgument, errmsg.str());
+  }
+
+  if (!request.GetData() && !request.GetDataSource()) {
+    return client::ApiError(client::ErrorCode::InvalidArgument,
+                            "Invalid request, the data is missing");
+  }
+
+  auto data = request.GetData();
+  auto source = data ? DataSource::FromData(data) : *request.GetDataSource();
+  if (request.GetCompression()) {
+    auto compress_response = CompressData(GetCatalogModel(), layer_id, source,
+                                          request.GetChecksum());
+    if (!compress_response.IsSuccessful()) {
+      return compress_response.GetError();
+    }
+    if (compress_response.GetResult()) {
+      data = compress_response.MoveResult();
+      source = DataSource::FromData(data);
+    }
+  }
+
+  UploadedPartition result;
+  auto& partition = result.partition;
+  partition.SetPartition(request.GetPartitionId().value_or(""));
+  partition.SetDataSize(static_cast<int64_t>(source.GetSize()));
+  if (request.GetChecksum()) {
+    partition.SetChecksum(*request.GetChecksum());
+  }
+
+  // Every partition gets a new data handle, or one derived from the data.
+  // In both cases a conflict means that the data is already uploaded.
+  std::string data_handle;
+  if (deduplication) {
+    auto hash = ComputeContentHash(source);
+    if (!hash) {
+      return client::ApiError(client::ErrorCode::InvalidArgument,
+                              "Invalid request, the data cannot be read");
+    }
+    data_handle = std::move(*hash);
+
+    auto exists_response =
+        BlobApi::CheckBlobExists(*apiclient_blob_, layer_id, data_handle,
+                                 request.GetBillingTag(), context);
+    if (!exists_response.IsSuccessful()) {
+      return exists_response.GetError();
+    }
+    if (exists_response.GetResult() == http::HttpStatusCode::OK) {
+      partition.SetDataHandle(data_handle);
+      result.reused = true;
+      return result;
+    }
+  } else {
+    data_handle = GenerateUuid();
+  }
+
+  PutBlobResponse response = client::ApiNoResult();
+  if (data && data->size() <= kMultipartUploadThreshold) {
+    response = BlobApi::PutBlob(*apiclient_blob_, layer_id, content_type,
+                                data_handle, data, request.GetBillingTag(),
+                                std::move(context));
+  } else {
+    response = UploadBlobInParts(*apiclient_blob_, settings_, layer_id,
+                                 content_type, data_handle, source,
+                                 request.GetBillingTag(), pending_requests_,
+                                 std::move(context));
+  }
+
+  if (!response.IsSuccessful() && response.GetError().GetHttpStatusCode() !=
+                                      http::HttpStatusCode::CONFLICT) {
+    return response.GetError();
+  }
+
+  partition.SetDataHandle(data_handle);
+  return result;
+}
+
+UploadPartitionResponse VersionedLayerClientImpl::UploadPartitions(
+    const std::string& publication_id, const std::string& layer_id,
+    std::vector<model::PublishPartition> partitions,
+    client::CancellationContext context) {
+  // The metadata of a partition is idempotent within a publication, so
+  // a retried upload is safe.
+  model::PublishPartitions metadata;
+  metadata.SetPartitions(std::move(partitions));
+  return PublishApi::UploadPartitions(*apiclient_publish_, metadata,
+                                      publication_id, layer_id, boost::none,
+                                      std::move(context));
+}
+
+InitCatalogModelResponse VersionedLayerClientImpl::InitCatalogModel(
+    client::CancellationContext context) {
+  auto promise = std::make_shared<std::promise<InitCatalogModelResponse>>();
+  auto future = promise->get_future();
+
+  auto cancel_context = std::make_shared<client::CancellationContext>();
+  context.ExecuteOrCancelled(
+      [&]() {
+        InitCatalogModel(
+            cancel_context,
+            [promise](boost::optional<client::ApiError> error) {
+              if (error) {
+                promise->set_value(std::move(*error));
+              } else {
+                promise->set_value(client::ApiNoResult());
+              }
+            });
+        return client::CancellationToken(
+            [cancel_context]() { cancel_context->CancelOperation(); });
+      },
+      [&]() {
+        promise->set_value(client::ApiError(client::ErrorCode::Cancelled,
+                                            "Operation cancelled.", true));
+      });
+
+  return future.get();
+}
+
 void VersionedLayerClientImpl::InitCatalogModel(
     std::shared_ptr<client::CancellationContext> cancel_context,
     const InitCatalogModelCallback& callback) {
@@ -542,18 +981,53 @@ void VersionedLayerClientImpl::InitCatalogModel(
                               "Operation cancelled.", true));
   };
 
-  auto initCatalog_callback = [=](CatalogResponse response) mutable {
+  auto initCatalog_callback = [=](CatalogResponse response) {
     if (!response.IsSuccessful()) {
       callback(std::move(response.GetError()));
     } else {
-      catalog_model_ = response.MoveResult();
+      {
+        std::lock_guard<std::mutex> lock(self->catalog_model_mutex_);
+        self->catalog_model_ = response.MoveResult();
+        self->catalog_model_expiry_ =
+            std::time(nullptr) + CatalogCache::kExpiryTimeInSecs;
+      }
       callback(boost::none);
     }
   };
 
+  // The configuration is shared with the other clients through the cache,
+  // so it is fetched again only when the cached one expires.
+  auto fetch = [=](client::CancellationContext context,
+                   CatalogCache::Callback fetch_callback) {
+    context.ExecuteOrCancelled(
+        [&]() {
+          return ConfigApi::GetCatalog(self->apiclient_config_,
+                                       self->catalog_.ToString(), boost::none,
+                                       fetch_callback);
+        },
+        [&]() {
+          fetch_callback(client::ApiError(client::ErrorCode::Cancelled,
+                                          "Operation cancelled.", true));
+        });
+  };
+
   auto initCatalog_function = [=]() -> client::CancellationToken {
-    return ConfigApi::GetCatalog(self->apiclient_config_, catalog_.ToString(),
-                                 boost::none, initCatalog_callback);
+    // Without a cache, the client keeps the configuration until it expires.
+    if (!self->settings_.cache) {
+      {
+        std::lock_guard<std::mutex> lock(self->catalog_model_mutex_);
+        if (std::time(nullptr) < self->catalog_model_expiry_) {
+          callback(boost::none);
+          return client::CancellationToken();
+        }
+      }
+      return ConfigApi::GetCatalog(self->apiclient_config_,
+                                   self->catalog_.ToString(), boost::none,
+                                   initCatalog_callback);
+    }
+
+    return CatalogCache::Get(self->catalog_, self->settings_.cache, fetch,
+                             initCatalog_callback);
   };
 
   cancel_context->ExecuteOrCancelled(
@@ -564,12 +1038,8 @@ void VersionedLayerClientImpl::InitCatalogModel(
                 callback(err.get());
                 return;
               }
-              if (!self->catalog_model_.GetId().empty()) {
-                callback(boost::none);
-              } else {
-                cancel_context->ExecuteOrCancelled(initCatalog_function,
-                                                   cancel_function);
-              }
+              cancel_context->ExecuteOrCancelled(initCatalog_function,
+                                                 cancel_function);
             });
       },
       cancel_function);
@@ -622,10 +1092,16 @@ void VersionedLayerClientImpl::UploadPartition(
       cancel_function);
 }
 
+model::Catalog VersionedLayerClientImpl::GetCatalogModel() {
+  std::lock_guard<std::mutex> lock(catalog_model_mutex_);
+  return catalog_model_;
+}
+
 std::string VersionedLayerClientImpl::FindContentTypeForLayerId(
     const std::string& layer_id) {
+  std::lock_guard<std::mutex> lock(catalog_model_mutex_);
   std::string content_type;
-  for (auto layer : catalog_model_.GetLayers()) {
+  for (const auto& layer : catalog_model_.GetLayers()) {
     if (layer.GetId() == layer_id) {
       // TODO optimization opportunity - cache
       // content-type for layer when found for O(1)
@@ -639,7 +1115,8 @@ std::string VersionedLayerClientImpl::FindContentTypeForLayerId(
 
 void VersionedLayerClientImpl::UploadBlob(
     std::string /*publication_id*/,
-    std::shared_ptr<model::PublishPartition> partition, std::string data_handle,
+    std::shared_ptr<model::PublishPartition> partition,
+    boost::optional<DataSource> source, std::string data_handle,
     std::string layer_id,
     std::shared_ptr<client::CancellationContext> cancel_context,
     const UploadBlobCallback& callback) {
@@ -671,6 +1148,18 @@ void VersionedLayerClientImpl::UploadBlob(
   }
 
   auto uploadBlob_function = [=]() -> client::CancellationToken {
+    if (source) {
+      return AddTask(
+          self->settings_.task_scheduler, self->pending_requests_,
+          [=](client::CancellationContext context) -> UploadBlobResponse {
+            return UploadBlobInParts(*self->apiclient_blob_, self->settings_,
+                                     layer_id, content_type, data_handle,
+                                     *source, boost::none,
+                                     self->pending_requests_, context);
+          },
+          uploadBlob_callback);
+    }
+
     return BlobApi::PutBlob(*self->apiclient_blob_, layer_id, content_type,
                             data_handle, partition->GetData(), boost::none,
                             uploadBlob_callback);
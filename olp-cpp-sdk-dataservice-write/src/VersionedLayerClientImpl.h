@@ -30,8 +30,11 @@
 #include "generated/model/Catalog.h"
 
 #include <condition_variable>
+#include <ctime>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace olp {
 namespace dataservice {
@@ -41,6 +44,8 @@ using InitApiClientsCallback =
     std::function<void(boost::optional<client::ApiError>)>;
 using InitCatalogModelCallback =
     std::function<void(boost::optional<client::ApiError>)>;
+using InitCatalogModelResponse =
+    client::ApiResponse<client::ApiNoResult, client::ApiError>;
 
 using UploadPartitionResult = client::ApiNoResult;
 using UploadPartitionResponse =
@@ -53,6 +58,15 @@ using UploadBlobResponse =
     client::ApiResponse<UploadBlobResult, client::ApiError>;
 using UploadBlobCallback = std::function<void(UploadBlobResponse response)>;
 
+/// The metadata of a partition which data is uploaded.
+struct UploadedPartition {
+  model::PublishPartition partition;
+  /// True if the data already existed and was not uploaded.
+  bool reused{false};
+};
+using UploadPartitionDataResponse =
+    client::ApiResponse<UploadedPartition, client::ApiError>;
+
 class VersionedLayerClientImpl
     : public std::enable_shared_from_this<VersionedLayerClientImpl> {
  public:
@@ -100,6 +114,13 @@ class VersionedLayerClientImpl
       const model::PublishPartitionDataRequest& request,
       PublishPartitionDataCallback callback);
 
+  client::CancellableFuture<PublishPartitionsResponse> PublishToBatch(
+      const model::Publication& pub, model::PublishPartitionsRequest request);
+
+  client::CancellationToken PublishToBatch(
+      const model::Publication& pub, model::PublishPartitionsRequest request,
+      PublishPartitionsCallback callback);
+
   client::CancellableFuture<CheckDataExistsResponse> CheckDataExists(
       const model::CheckDataExistsRequest& request);
 
@@ -107,7 +128,27 @@ class VersionedLayerClientImpl
       const model::CheckDataExistsRequest& request,
       CheckDataExistsCallback callback);
 
+ protected:
+  /// Waits until the API clients and the catalog model are initialized.
+  virtual InitCatalogModelResponse InitCatalogModel(
+      client::CancellationContext context);
+
+  /// Uploads the data of the partition and returns its metadata. With
+  /// deduplication the data handle is derived from the data, and the data is
+  /// not uploaded if the layer already has it.
+  virtual UploadPartitionDataResponse UploadPartitionData(
+      const model::PublishPartitionDataRequest& request, bool deduplication,
+      client::CancellationContext context);
+
+  /// Uploads the metadata of the partitions to the publication.
+  virtual UploadPartitionResponse UploadPartitions(
+      const std::string& publication_id, const std::string& layer_id,
+      std::vector<model::PublishPartition> partitions,
+      client::CancellationContext context);
+
  private:
+  model::Catalog GetCatalogModel();
+
   std::string FindContentTypeForLayerId(const std::string& layer_id);
 
   client::CancellationToken InitApiClients(
@@ -118,9 +159,15 @@ class VersionedLayerClientImpl
       std::shared_ptr<client::CancellationContext> cancel_context,
       const InitCatalogModelCallback& callback);
 
+  PublishPartitionsResponse PublishPartitions(
+      const std::string& publication_id,
+      const model::PublishPartitionsRequest& request,
+      client::CancellationContext context);
+
   void UploadBlob(std::string publication_id,
                   std::shared_ptr<model::PublishPartition> partition,
-                  std::string data_handle, std::string layer_id,
+                  boost::optional<DataSource> source, std::string data_handle,
+                  std::string layer_id,
                   std::shared_ptr<client::CancellationContext> cancel_context,
                   const UploadBlobCallback& callback);
 
@@ -133,7 +180,11 @@ class VersionedLayerClientImpl
   client::HRN catalog_;
   client::OlpClientSettings settings_;
 
+  /// Every operation refreshes the catalog model from the catalog cache, or
+  /// when there is no cache, once the model expires.
+  std::mutex catalog_model_mutex_;
   model::Catalog catalog_model_;
+  time_t catalog_model_expiry_{0};
 
   std::shared_ptr<client::OlpClient> apiclient_blob_;
   std::shared_ptr<client::OlpClient> apiclient_config_;
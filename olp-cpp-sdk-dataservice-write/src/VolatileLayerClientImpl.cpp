@@ -27,6 +27,7 @@
 #include <olp/core/client/CancellationContext.h>
 
 #include "ApiClientLookup.h"
+#include "CatalogCache.h"
 #include "generated/BlobApi.h"
 #include "generated/ConfigApi.h"
 #include "generated/MetadataApi.h"
@@ -183,30 +184,60 @@ void VolatileLayerClientImpl::CancelPendingRequests() {
 client::CancellationToken VolatileLayerClientImpl::InitCatalogModel(
     const model::PublishPartitionDataRequest& /*request*/,
     const InitCatalogModelCallback& callback) {
-  if (!catalog_model_.GetId().empty()) {
-    callback(boost::none);
-    return client::CancellationToken();
-  }
-
   auto self = shared_from_this();
-  return ConfigApi::GetCatalog(
-      apiclient_config_, catalog_.ToString(), boost::none,
-      [=](CatalogResponse catalog_response) mutable {
-        if (!catalog_response.IsSuccessful()) {
-          callback(std::move(catalog_response.GetError()));
-          return;
-        }
+  auto catalog_callback = [=](CatalogResponse catalog_response) {
+    if (!catalog_response.IsSuccessful()) {
+      callback(catalog_response.GetError());
+      return;
+    }
 
-        self->catalog_model_ = catalog_response.MoveResult();
+    {
+      std::lock_guard<std::mutex> lock(self->catalog_model_mutex_);
+      self->catalog_model_ = catalog_response.MoveResult();
+      self->catalog_model_expiry_ =
+          std::time(nullptr) + CatalogCache::kExpiryTimeInSecs;
+    }
+    callback(boost::none);
+  };
 
+  // Without a cache, the client keeps the configuration until it expires.
+  if (!settings_.cache) {
+    {
+      std::lock_guard<std::mutex> lock(catalog_model_mutex_);
+      if (std::time(nullptr) < catalog_model_expiry_) {
         callback(boost::none);
-      });
+        return client::CancellationToken();
+      }
+    }
+    return ConfigApi::GetCatalog(apiclient_config_, catalog_.ToString(),
+                                 boost::none, catalog_callback);
+  }
+
+  // The configuration is shared with the other clients through the cache,
+  // so it is fetched again only when the cached one expires.
+  auto fetch = [=](client::CancellationContext context,
+                   CatalogCache::Callback fetch_callback) {
+    context.ExecuteOrCancelled(
+        [&]() {
+          return ConfigApi::GetCatalog(self->apiclient_config_,
+                                       self->catalog_.ToString(), boost::none,
+                                       fetch_callback);
+        },
+        [&]() {
+          fetch_callback(client::ApiError(client::ErrorCode::Cancelled,
+                                          "Operation cancelled.", true));
+        });
+  };
+
+  return CatalogCache::Get(catalog_, settings_.cache, fetch,
+                           catalog_callback);
 }
 
 std::string VolatileLayerClientImpl::FindContentTypeForLayerId(
     const std::string& layer_id) {
+  std::lock_guard<std::mutex> lock(catalog_model_mutex_);
   std::string content_type;
-  for (auto layer : catalog_model_.GetLayers()) {
+  for (const auto& layer : catalog_model_.GetLayers()) {
     if (layer.GetId() == layer_id) {
       // TODO optimization opportunity - cache
       // content-type for layer when found for O(1)
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <ctime>
 #include <map>
 #include <mutex>
 
@@ -121,7 +122,11 @@ class VolatileLayerClientImpl
 
  private:
   client::HRN catalog_;
+  /// Every operation refreshes the catalog model from the catalog cache, or
+  /// when there is no cache, once the model expires.
+  std::mutex catalog_model_mutex_;
   model::Catalog catalog_model_;
+  time_t catalog_model_expiry_{0};
 
   client::OlpClientSettings settings_;
 
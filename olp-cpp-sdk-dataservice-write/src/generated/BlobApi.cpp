@@ -19,16 +19,55 @@
 
 #include "BlobApi.h"
 
+#include <algorithm>
+#include <cctype>
 #include <memory>
 #include <sstream>
 
 #include <olp/core/client/HttpResponse.h>
 #include <olp/core/http/HttpStatusCode.h>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 namespace client = olp::client;
 
 namespace {
 const std::string kQueryParamBillingTag = "billingTag";
+const std::string kQueryParamPartNumber = "partNumber";
+const std::string kApplicationJson = "application/json";
+
+std::string GetLink(const rapidjson::Value& links, const char* name) {
+  if (!links.HasMember(name) || !links[name].IsObject() ||
+      !links[name].HasMember("href") || !links[name]["href"].IsString()) {
+    return {};
+  }
+  return links[name]["href"].GetString();
+}
+
+std::string FindHeader(const olp::http::Headers& headers,
+                       const std::string& name) {
+  for (const auto& header : headers) {
+    if (header.first.size() == name.size() &&
+        std::equal(name.begin(), name.end(), header.first.begin(),
+                   [](char lhs, char rhs) {
+                     return std::tolower(lhs) == std::tolower(rhs);
+                   })) {
+      return header.second;
+    }
+  }
+  return {};
+}
+
+std::shared_ptr<std::vector<unsigned char>> ToBody(
+    const rapidjson::Document& document) {
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  const auto* begin = buffer.GetString();
+  return std::make_shared<std::vector<unsigned char>>(
+      begin, begin + buffer.GetSize());
+}
 }  // namespace
 
 namespace olp {
@@ -133,6 +172,148 @@ client::CancellationToken BlobApi::deleteBlob(
   return cancel_token;
 }
 
+InitMultipartUploadResponse BlobApi::InitMultipartUpload(
+    const client::OlpClient& client, const std::string& layer_id,
+    const std::string& content_type, const std::string& data_handle,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", kApplicationJson));
+
+  if (billing_tag) {
+    query_params.insert(
+        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
+  }
+
+  rapidjson::Document body;
+  body.SetObject();
+  body.AddMember("contentType", rapidjson::StringRef(content_type.c_str()),
+                 body.GetAllocator());
+
+  std::string init_uri =
+      "/layers/" + layer_id + "/data/" + data_handle + "/multiparts";
+
+  auto http_response = client.CallApi(
+      std::move(init_uri), "POST", std::move(query_params),
+      std::move(header_params), std::move(form_params), ToBody(body),
+      kApplicationJson, std::move(context));
+
+  if (http_response.status != http::HttpStatusCode::OK &&
+      http_response.status != http::HttpStatusCode::CREATED) {
+    return client::ApiError(http_response.status, http_response.response.str());
+  }
+
+  rapidjson::Document document;
+  document.Parse(http_response.response.str().c_str());
+  if (!document.IsObject() || !document.HasMember("links") ||
+      !document["links"].IsObject()) {
+    return client::ApiError(client::ErrorCode::InternalFailure,
+                            "Unexpected multipart upload response");
+  }
+
+  const auto& links = document["links"];
+  MultipartUpload upload;
+  upload.upload_part_url = GetLink(links, "uploadPart");
+  upload.complete_url = GetLink(links, "complete");
+  upload.delete_url = GetLink(links, "delete");
+  if (upload.upload_part_url.empty() || upload.complete_url.empty()) {
+    return client::ApiError(client::ErrorCode::InternalFailure,
+                            "Multipart upload response misses links");
+  }
+
+  return upload;
+}
+
+UploadPartResponse BlobApi::UploadPart(
+    const client::OlpClient& client, const std::string& url,
+    size_t part_number, std::shared_ptr<const http::BodySource> data,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+
+  header_params.insert(std::make_pair("Accept", kApplicationJson));
+  query_params.insert(
+      std::make_pair(kQueryParamPartNumber, std::to_string(part_number)));
+
+  auto http_response = client.CallApi(
+      url, "POST", std::move(query_params), std::move(header_params),
+      std::move(data), "application/octet-stream", std::move(context));
+
+  if (http_response.status != http::HttpStatusCode::OK &&
+      http_response.status != http::HttpStatusCode::NO_CONTENT) {
+    return client::ApiError(http_response.status, http_response.response.str());
+  }
+
+  auto etag = FindHeader(http_response.headers, "ETag");
+  if (etag.empty()) {
+    return client::ApiError(client::ErrorCode::InternalFailure,
+                            "Upload part response misses the ETag");
+  }
+
+  return etag;
+}
+
+CompleteMultipartUploadResponse BlobApi::CompleteMultipartUpload(
+    const client::OlpClient& client, const std::string& url,
+    const UploadedParts& parts, client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", kApplicationJson));
+
+  rapidjson::Document body;
+  body.SetObject();
+  auto& allocator = body.GetAllocator();
+  rapidjson::Value parts_value(rapidjson::kArrayType);
+  for (const auto& part : parts) {
+    rapidjson::Value part_value(rapidjson::kObjectType);
+    part_value.AddMember("etag", rapidjson::StringRef(part.second.c_str()),
+                         allocator);
+    part_value.AddMember("number", static_cast<uint64_t>(part.first),
+                         allocator);
+    parts_value.PushBack(part_value, allocator);
+  }
+  body.AddMember("parts", parts_value, allocator);
+
+  auto http_response = client.CallApi(
+      url, "PUT", std::move(query_params), std::move(header_params),
+      std::move(form_params), ToBody(body), kApplicationJson,
+      std::move(context));
+
+  if (http_response.status != http::HttpStatusCode::OK &&
+      http_response.status != http::HttpStatusCode::NO_CONTENT) {
+    return client::ApiError(http_response.status, http_response.response.str());
+  }
+
+  return client::ApiNoResult();
+}
+
+CompleteMultipartUploadResponse BlobApi::AbortMultipartUpload(
+    const client::OlpClient& client, const std::string& url,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", kApplicationJson));
+
+  auto http_response = client.CallApi(
+      url, "DELETE", std::move(query_params), std::move(header_params),
+      std::move(form_params), nullptr, "", std::move(context));
+
+  if (http_response.status != http::HttpStatusCode::OK &&
+      http_response.status != http::HttpStatusCode::ACCEPTED &&
+      http_response.status != http::HttpStatusCode::NO_CONTENT) {
+    return client::ApiError(http_response.status, http_response.response.str());
+  }
+
+  return client::ApiNoResult();
+}
+
 client::CancellationToken BlobApi::checkBlobExists(
     const client::OlpClient& client, const std::string& layer_id,
     const std::string& data_handle,
@@ -165,6 +346,36 @@ client::CancellationToken BlobApi::checkBlobExists(
   return cancel_token;
 }
 
+CheckBlobRespone BlobApi::CheckBlobExists(
+    const client::OlpClient& client, const std::string& layer_id,
+    const std::string& data_handle,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", "application/json"));
+
+  if (billing_tag) {
+    query_params.insert(
+        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
+  }
+
+  std::string check_blob_uri = "/layers/" + layer_id + "/data/" + data_handle;
+  auto http_response = client.CallApi(
+      std::move(check_blob_uri), "HEAD", std::move(query_params),
+      std::move(header_params), std::move(form_params), nullptr, "",
+      std::move(context));
+
+  if (http_response.status != http::HttpStatusCode::OK &&
+      http_response.status != http::HttpStatusCode::NOT_FOUND) {
+    return client::ApiError(http_response.status, http_response.response.str());
+  }
+
+  return http_response.status;
+}
+
 }  // namespace write
 }  // namespace dataservice
 }  // namespace olp
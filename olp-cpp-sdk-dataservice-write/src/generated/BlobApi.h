@@ -21,12 +21,15 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiNoResult.h>
 #include <olp/core/client/ApiResponse.h>
 #include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/OlpClient.h>
+#include <olp/core/http/BodySource.h>
 
 namespace olp {
 namespace dataservice {
@@ -41,6 +44,21 @@ using DeleteBlobCallback = std::function<void(DeleteBlobRespone)>;
 using CheckBlobRespone = client::ApiResponse<int, client::ApiError>;
 using CheckBlobCallback = std::function<void(CheckBlobRespone)>;
 
+/// The URLs of the operations on a multipart upload.
+struct MultipartUpload {
+  std::string upload_part_url;
+  std::string complete_url;
+  std::string delete_url;
+};
+using InitMultipartUploadResponse =
+    client::ApiResponse<MultipartUpload, client::ApiError>;
+/// The ETag of the uploaded part.
+using UploadPartResponse = client::ApiResponse<std::string, client::ApiError>;
+/// The part numbers with the ETags of the uploaded parts.
+using UploadedParts = std::vector<std::pair<size_t, std::string>>;
+using CompleteMultipartUploadResponse =
+    client::ApiResponse<client::ApiNoResult, client::ApiError>;
+
 /**
  * @brief The blob service supports the upload and retrieval of large volumes of
  * data from the storage of a catalog. Each discrete chunk of data is stored as
@@ -133,11 +151,91 @@ class BlobApi {
    * CheckBlobResponse when the operation completes.
    * @return
    */
+  /**
+   * @brief Starts a multipart upload of a data blob
+   * Use this upload mechanism for large blobs. The parts are uploaded with
+   * \c UploadPart and the upload is finished with \c CompleteMultipartUpload.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id The ID of the layer that the data blob belongs to.
+   * @param content_type The content type configured for the target layer.
+   * @param data_handle The data handle (ID) represents an identifier for the
+   * data blob.
+   * @param billing_tag Optional. An optional free-form tag which is used for
+   * grouping billing records together. If supplied, it must be between 4 - 16
+   * characters, contain only alpha/numeric ASCII characters [A-Za-z0-9].
+   * @param context The CancellationContext instance.
+   * @return The URLs of the operations on the upload.
+   */
+  static InitMultipartUploadResponse InitMultipartUpload(
+      const client::OlpClient& client, const std::string& layer_id,
+      const std::string& content_type, const std::string& data_handle,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context);
+
+  /**
+   * @brief Uploads a part of a multipart upload
+   * All the parts except the last one must be at least 5 MB.
+   * @param client Instance of OlpClient used to make REST request, the URL is
+   * appended to the base URL of the client.
+   * @param url The upload part URL of the upload.
+   * @param part_number The number of the part starting from 1.
+   * @param data The content of the part, it is read while it is sent.
+   * @param context The CancellationContext instance.
+   * @return The ETag of the uploaded part.
+   */
+  static UploadPartResponse UploadPart(
+      const client::OlpClient& client, const std::string& url,
+      size_t part_number, std::shared_ptr<const http::BodySource> data,
+      client::CancellationContext context);
+
+  /**
+   * @brief Finishes a multipart upload
+   * @param client Instance of OlpClient used to make REST request, the URL is
+   * appended to the base URL of the client.
+   * @param url The complete URL of the upload.
+   * @param parts The numbers and the ETags of all the uploaded parts.
+   * @param context The CancellationContext instance.
+   */
+  static CompleteMultipartUploadResponse CompleteMultipartUpload(
+      const client::OlpClient& client, const std::string& url,
+      const UploadedParts& parts, client::CancellationContext context);
+
+  /**
+   * @brief Cancels a multipart upload and removes the uploaded parts
+   * @param client Instance of OlpClient used to make REST request, the URL is
+   * appended to the base URL of the client.
+   * @param url The delete URL of the upload.
+   * @param context The CancellationContext instance.
+   */
+  static CompleteMultipartUploadResponse AbortMultipartUpload(
+      const client::OlpClient& client, const std::string& url,
+      client::CancellationContext context);
+
   static client::CancellationToken checkBlobExists(
       const client::OlpClient& client, const std::string& layer_id,
       const std::string& data_handle,
       const boost::optional<std::string>& billing_tag,
       const CheckBlobCallback& callback);
+
+  /**
+   * @brief Checks if a data handle exists
+   * Blocking version of \c checkBlobExists.
+   * @param client Instance of OlpClient used to make REST request.
+   * @param layer_id The ID of the layer that the data blob belongs to.
+   * @param data_handle The data handle (ID) represents an identifier for the
+   * data blob.
+   * @param billing_tag Optional. An optional free-form tag which is used for
+   * grouping billing records together.
+   * @param context A CancellationContext, which can be used to cancel the
+   * pending request.
+   * @return The HTTP status, which is OK if the blob exists and NOT_FOUND if
+   * it does not.
+   */
+  static CheckBlobRespone CheckBlobExists(
+      const client::OlpClient& client, const std::string& layer_id,
+      const std::string& data_handle,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context);
 };
 
 }  // namespace write
@@ -133,6 +133,40 @@ client::CancellationToken IndexApi::performUpdate(
       });
   return cancel_token;
 }
+
+UpdateIndexesResponse IndexApi::performUpdate(
+    const client::OlpClient& client, const model::UpdateIndexRequest& request,
+    const boost::optional<std::string>& billing_tag,
+    client::CancellationContext context) {
+  std::multimap<std::string, std::string> header_params;
+  std::multimap<std::string, std::string> query_params;
+  std::multimap<std::string, std::string> form_params;
+
+  header_params.insert(std::make_pair("Accept", "application/json"));
+
+  if (billing_tag) {
+    query_params.insert(
+        std::make_pair(kQueryParamBillingTag, billing_tag.get()));
+  }
+
+  std::string update_indexes_uri = "/layers/" + request.GetLayerId();
+
+  auto serialized_update_request = serializer::serialize(request);
+  auto data = std::make_shared<std::vector<unsigned char>>(
+      serialized_update_request.begin(), serialized_update_request.end());
+
+  auto http_response = client.CallApi(
+      std::move(update_indexes_uri), "PUT", std::move(query_params),
+      std::move(header_params), std::move(form_params), std::move(data),
+      "application/json", std::move(context));
+  if (http_response.status != http::HttpStatusCode::OK &&
+      http_response.status != http::HttpStatusCode::CREATED) {
+    return UpdateIndexesResponse(
+        client::ApiError(http_response.status, http_response.response.str()));
+  }
+
+  return UpdateIndexesResponse(client::ApiNoResult());
+}
 }  // namespace write
 }  // namespace dataservice
 }  // namespace olp
@@ -25,6 +25,7 @@
 #include <olp/core/client/ApiError.h>
 #include <olp/core/client/ApiNoResult.h>
 #include <olp/core/client/ApiResponse.h>
+#include <olp/core/client/CancellationContext.h>
 #include <olp/core/client/OlpClient.h>
 
 #include <olp/dataservice/write/generated/model/Index.h>
@@ -132,6 +133,12 @@ class IndexApi {
       const client::OlpClient& client, const model::UpdateIndexRequest& request,
       const boost::optional<std::string>& billing_tag,
       UpdateIndexesCallback callback);
+
+  /** @brief Sync version of \c performUpdate method. */
+  static UpdateIndexesResponse performUpdate(
+      const client::OlpClient& client, const model::UpdateIndexRequest& request,
+      const boost::optional<std::string>& billing_tag,
+      client::CancellationContext context);
 };
 
 }  // namespace write
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+#include "AdaptiveFlushPolicy.h"
+
+namespace {
+
+namespace write = olp::dataservice::write;
+using std::chrono::milliseconds;
+using Clock = write::AdaptiveFlushPolicy::Clock;
+
+write::AutoFlushSettings TunedSettings() {
+  write::AutoFlushSettings settings;
+  settings.auto_flush_num_events = 20;
+  settings.target_flush_latency = milliseconds(100);
+  return settings;
+}
+
+TEST(AdaptiveFlushPolicyTest, FlushesOnQueuedBytes) {
+  write::AutoFlushSettings settings;
+  settings.auto_flush_num_bytes = 1000u;
+  write::AdaptiveFlushPolicy policy(settings);
+
+  const auto now = Clock::now();
+  policy.OnQueued(600u, now);
+  EXPECT_FALSE(policy.IsFlushRequired(now));
+
+  policy.OnQueued(400u, now);
+  EXPECT_EQ(1000u, policy.GetQueuedBytes());
+  EXPECT_TRUE(policy.IsFlushRequired(now));
+
+  // Both requests are flushed, so the bytes are no longer queued.
+  policy.OnFlushed(2u, milliseconds(10), 0u);
+  EXPECT_EQ(0u, policy.GetQueuedBytes());
+  EXPECT_FALSE(policy.IsFlushRequired(now));
+}
+
+TEST(AdaptiveFlushPolicyTest, FlushesOnMaxAge) {
+  write::AutoFlushSettings settings;
+  settings.auto_flush_max_age = milliseconds(500);
+  write::AdaptiveFlushPolicy policy(settings);
+
+  const auto start = Clock::now();
+  EXPECT_FALSE(policy.GetDeadline());
+  EXPECT_FALSE(policy.IsFlushRequired(start));
+
+  policy.OnQueued(10u, start);
+  policy.OnQueued(10u, start + milliseconds(300));
+
+  auto deadline = policy.GetDeadline();
+  ASSERT_TRUE(deadline);
+  EXPECT_EQ(start + milliseconds(500), *deadline);
+  EXPECT_FALSE(policy.IsFlushRequired(start + milliseconds(499)));
+  EXPECT_TRUE(policy.IsFlushRequired(start + milliseconds(500)));
+
+  // The oldest request is flushed, the deadline moves to the next one.
+  policy.OnFlushed(1u, milliseconds(10), 1u);
+  deadline = policy.GetDeadline();
+  ASSERT_TRUE(deadline);
+  EXPECT_EQ(start + milliseconds(800), *deadline);
+  EXPECT_FALSE(policy.IsFlushRequired(start + milliseconds(500)));
+}
+
+TEST(AdaptiveFlushPolicyTest, NoTriggersByDefault) {
+  write::AdaptiveFlushPolicy policy{write::AutoFlushSettings()};
+
+  const auto start = Clock::now();
+  policy.OnQueued(1024u * 1024u, start);
+  EXPECT_FALSE(policy.GetDeadline());
+  EXPECT_FALSE(policy.IsFlushRequired(start + std::chrono::hours(1)));
+}
+
+TEST(AdaptiveFlushPolicyTest, KeepsBatchSizeWithoutTarget) {
+  write::AutoFlushSettings settings;
+  settings.events_per_single_flush = 5;
+  write::AdaptiveFlushPolicy policy(settings);
+  EXPECT_EQ(5, policy.GetBatchSize());
+
+  policy.OnFlushed(5u, milliseconds(10000), 0u);
+  EXPECT_EQ(5, policy.GetBatchSize());
+}
+
+TEST(AdaptiveFlushPolicyTest, ShrinksBatchOnSlowFlush) {
+  write::AdaptiveFlushPolicy policy(TunedSettings());
+  EXPECT_EQ(20, policy.GetBatchSize());
+
+  // 5 requests fit the target, the size moves halfway to it.
+  policy.OnFlushed(20u, milliseconds(400), 0u);
+  EXPECT_EQ(13, policy.GetBatchSize());
+}
+
+TEST(AdaptiveFlushPolicyTest, GrowsBatchOnFastFlush) {
+  write::AdaptiveFlushPolicy policy(TunedSettings());
+
+  // 200 requests fit the target, but the size at most doubles.
+  policy.OnFlushed(20u, milliseconds(10), 0u);
+  EXPECT_EQ(40, policy.GetBatchSize());
+
+  // A flush that matches the target keeps the size.
+  policy.OnFlushed(40u, milliseconds(100), 0u);
+  EXPECT_EQ(40, policy.GetBatchSize());
+
+  // An empty flush says nothing about the latency.
+  policy.OnFlushed(0u, milliseconds(0), 0u);
+  EXPECT_EQ(40, policy.GetBatchSize());
+}
+
+TEST(AdaptiveFlushPolicyTest, KeepsBatchSizeWithinBounds) {
+  auto settings = TunedSettings();
+  settings.min_events_per_single_flush = 15;
+  settings.max_events_per_single_flush = 30;
+
+  write::AdaptiveFlushPolicy policy(settings);
+  policy.OnFlushed(20u, milliseconds(0), 0u);
+  EXPECT_EQ(30, policy.GetBatchSize());
+
+  for (int i = 0; i < 10; ++i) {
+    policy.OnFlushed(30u, milliseconds(10000), 0u);
+  }
+  EXPECT_EQ(15, policy.GetBatchSize());
+}
+
+}  // namespace
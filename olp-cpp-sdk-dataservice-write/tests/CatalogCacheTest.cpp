@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <atomic>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <mocks/CacheMock.h>
+#include "CatalogCache.h"
+
+namespace {
+
+using testing::_;
+namespace client = olp::client;
+namespace write = olp::dataservice::write;
+namespace model = olp::dataservice::write::model;
+
+const auto kCatalog =
+    client::HRN::FromString("hrn:here:data:::some_test_catalog");
+const std::string kCacheKey =
+    "hrn:here:data:::some_test_catalog::write::catalog";
+const std::string kLayer = "layer";
+const std::string kContentType = "application/json";
+
+model::Catalog MakeCatalog() {
+  model::Layer layer;
+  layer.SetId(kLayer);
+  layer.SetContentType(kContentType);
+  layer.SetContentEncoding("gzip");
+
+  model::Catalog catalog;
+  catalog.SetId("some_test_catalog");
+  catalog.SetHrn(kCatalog.ToCatalogHRNString());
+  catalog.SetLayers({layer});
+  return catalog;
+}
+
+class CatalogCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // The cache keeps only the encoded values, so every lookup decodes them.
+    cache_ = std::make_shared<testing::NiceMock<CacheMock>>();
+    ON_CALL(*cache_, Put(_, _, _, _))
+        .WillByDefault([this](const std::string& key, const boost::any&,
+                              const olp::cache::Encoder& encoder, time_t) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          values_[key] = encoder();
+          return true;
+        });
+    ON_CALL(*cache_, Get(_, _))
+        .WillByDefault([this](const std::string& key,
+                              const olp::cache::Decoder& decoder) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          auto it = values_.find(key);
+          return it != values_.end() ? decoder(it->second) : boost::any();
+        });
+  }
+
+  write::CatalogCache::FetchFunction CountingFetch() {
+    return [this](client::CancellationContext,
+                  write::CatalogCache::Callback callback) {
+      ++fetches_;
+      callback(MakeCatalog());
+    };
+  }
+
+  std::shared_ptr<CacheMock> cache_;
+  std::mutex mutex_;
+  std::map<std::string, std::string> values_;
+  std::atomic<int> fetches_{0};
+};
+
+TEST_F(CatalogCacheTest, ReusesCachedConfiguration) {
+  EXPECT_CALL(*cache_,
+              Put(kCacheKey, _, _, write::CatalogCache::kExpiryTimeInSecs))
+      .Times(1);
+
+  for (int i = 0; i < 3; ++i) {
+    auto response = write::CatalogCache::Get(kCatalog, cache_, CountingFetch(),
+                                             client::CancellationContext());
+    ASSERT_TRUE(response.IsSuccessful());
+
+    const auto& layers = response.GetResult().GetLayers();
+    ASSERT_EQ(1u, layers.size());
+    EXPECT_EQ(kLayer, layers.front().GetId());
+    EXPECT_EQ(kContentType, layers.front().GetContentType());
+    EXPECT_EQ("gzip", layers.front().GetContentEncoding());
+  }
+
+  EXPECT_EQ(1, fetches_.load());
+}
+
+TEST_F(CatalogCacheTest, FetchesEveryTimeWithoutCache) {
+  for (int i = 0; i < 2; ++i) {
+    auto response = write::CatalogCache::Get(kCatalog, nullptr, CountingFetch(),
+                                             client::CancellationContext());
+    EXPECT_TRUE(response.IsSuccessful());
+  }
+
+  EXPECT_EQ(2, fetches_.load());
+  EXPECT_FALSE(write::CatalogCache::Find(kCatalog, nullptr));
+}
+
+TEST_F(CatalogCacheTest, DoesNotCacheErrors) {
+  auto failing_fetch = [this](client::CancellationContext,
+                              write::CatalogCache::Callback callback) {
+    ++fetches_;
+    callback(client::ApiError(client::ErrorCode::ServiceUnavailable,
+                              "Service unavailable"));
+  };
+
+  auto response = write::CatalogCache::Get(kCatalog, cache_, failing_fetch,
+                                           client::CancellationContext());
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(client::ErrorCode::ServiceUnavailable,
+            response.GetError().GetErrorCode());
+  EXPECT_FALSE(write::CatalogCache::Find(kCatalog, cache_));
+
+  response = write::CatalogCache::Get(kCatalog, cache_, CountingFetch(),
+                                      client::CancellationContext());
+  EXPECT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(2, fetches_.load());
+}
+
+TEST_F(CatalogCacheTest, SharesConfigurationStoredByClient) {
+  write::CatalogCache::Put(kCatalog, cache_, MakeCatalog());
+
+  auto catalog = write::CatalogCache::Find(kCatalog, cache_);
+  ASSERT_TRUE(catalog);
+  EXPECT_EQ("some_test_catalog", catalog->GetId());
+
+  auto response = write::CatalogCache::Get(kCatalog, cache_, CountingFetch(),
+                                           client::CancellationContext());
+  EXPECT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(0, fetches_.load());
+}
+
+TEST_F(CatalogCacheTest, FetchesOnceForConcurrentClients) {
+  constexpr int kClients = 4;
+
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::promise<void> started;
+  auto blocking_fetch = [&](client::CancellationContext,
+                            write::CatalogCache::Callback callback) {
+    if (++fetches_ == 1) {
+      started.set_value();
+    }
+    released.wait();
+    callback(MakeCatalog());
+  };
+
+  std::vector<std::future<write::CatalogResponse>> responses;
+  responses.push_back(std::async(std::launch::async, [&] {
+    return write::CatalogCache::Get(kCatalog, cache_, blocking_fetch,
+                                    client::CancellationContext());
+  }));
+  started.get_future().wait();
+
+  for (int i = 1; i < kClients; ++i) {
+    responses.push_back(std::async(std::launch::async, [&] {
+      return write::CatalogCache::Get(kCatalog, cache_, blocking_fetch,
+                                      client::CancellationContext());
+    }));
+  }
+
+  // Gives the other clients the time to wait for the fetch.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  release.set_value();
+
+  for (auto& response : responses) {
+    EXPECT_TRUE(response.get().IsSuccessful());
+  }
+  EXPECT_EQ(1, fetches_.load());
+}
+
+TEST_F(CatalogCacheTest, CancelsWaitingClient) {
+  // The fetch finishes when it is released, or when it is cancelled.
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::promise<client::CancellationContext> started;
+  std::thread fetch_thread;
+  auto pending_fetch = [&](client::CancellationContext context,
+                           write::CatalogCache::Callback callback) {
+    ++fetches_;
+    started.set_value(context);
+    fetch_thread = std::thread([=] {
+      released.wait();
+      if (context.IsCancelled()) {
+        callback(client::ApiError(client::ErrorCode::Cancelled,
+                                  "Operation cancelled.", true));
+      } else {
+        callback(MakeCatalog());
+      }
+    });
+  };
+
+  std::promise<write::CatalogResponse> first_response;
+  auto first_token = write::CatalogCache::Get(
+      kCatalog, cache_, pending_fetch,
+      [&](write::CatalogResponse response) {
+        first_response.set_value(std::move(response));
+      });
+  auto fetch_context = started.get_future().get();
+
+  client::CancellationContext waiting_context;
+  auto waiting_response = std::async(std::launch::async, [&] {
+    return write::CatalogCache::Get(kCatalog, cache_, pending_fetch,
+                                    waiting_context);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  // The waiting client returns while the fetch continues for the first one.
+  waiting_context.CancelOperation();
+  auto response = waiting_response.get();
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(client::ErrorCode::Cancelled, response.GetError().GetErrorCode());
+  EXPECT_FALSE(fetch_context.IsCancelled());
+
+  // The fetch is cancelled when nobody waits for it.
+  first_token.Cancel();
+  response = first_response.get_future().get();
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(client::ErrorCode::Cancelled, response.GetError().GetErrorCode());
+  EXPECT_TRUE(fetch_context.IsCancelled());
+
+  release.set_value();
+  fetch_thread.join();
+  EXPECT_FALSE(write::CatalogCache::Find(kCatalog, cache_));
+
+  // The next client starts a new fetch.
+  response = write::CatalogCache::Get(kCatalog, cache_, CountingFetch(),
+                                      client::CancellationContext());
+  EXPECT_TRUE(response.IsSuccessful());
+  EXPECT_EQ(2, fetches_.load());
+}
+
+TEST_F(CatalogCacheTest, FetchesSeparatelyForEveryCache) {
+  auto other_cache = std::make_shared<testing::NiceMock<CacheMock>>();
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::promise<void> started;
+  auto blocking_fetch = [&](client::CancellationContext,
+                            write::CatalogCache::Callback callback) {
+    if (++fetches_ == 1) {
+      started.set_value();
+    }
+    released.wait();
+    callback(MakeCatalog());
+  };
+
+  auto response = std::async(std::launch::async, [&] {
+    return write::CatalogCache::Get(kCatalog, cache_, blocking_fetch,
+                                    client::CancellationContext());
+  });
+  started.get_future().wait();
+
+  // The fetch for the other cache does not wait for the first one.
+  auto other_response = write::CatalogCache::Get(
+      kCatalog, other_cache, CountingFetch(), client::CancellationContext());
+  EXPECT_TRUE(other_response.IsSuccessful());
+  EXPECT_EQ(2, fetches_.load());
+
+  release.set_value();
+  EXPECT_TRUE(response.get().IsSuccessful());
+}
+
+}  // namespace
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2019 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/utils/Compression.h>
+#include "ContentEncoding.h"
+
+namespace {
+
+namespace client = olp::client;
+namespace model = olp::dataservice::write::model;
+namespace write = olp::dataservice::write;
+using olp::utils::Compression;
+using olp::utils::ContentEncoding;
+
+model::Catalog CreateCatalog(const std::string& content_encoding) {
+  model::Layer layer;
+  layer.SetId("layer");
+  layer.SetContentEncoding(content_encoding);
+  model::Catalog catalog;
+  catalog.SetLayers({layer});
+  return catalog;
+}
+
+write::DataSource CreateSource(const std::string& content) {
+  return write::DataSource::FromData(
+      std::make_shared<std::vector<unsigned char>>(content.begin(),
+                                                   content.end()));
+}
+
+TEST(ContentEncodingTest, LayerWithoutEncoding) {
+  auto response = write::CompressData(CreateCatalog(""), "layer",
+                                      CreateSource("data"), boost::none);
+  ASSERT_TRUE(response.IsSuccessful());
+  EXPECT_FALSE(response.GetResult());
+}
+
+TEST(ContentEncodingTest, UnsupportedEncoding) {
+  auto response = write::CompressData(CreateCatalog("br"), "layer",
+                                      CreateSource("data"), boost::none);
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(client::ErrorCode::InvalidArgument,
+            response.GetError().GetErrorCode());
+}
+
+TEST(ContentEncodingTest, Gzip) {
+  if (!Compression::IsSupported(ContentEncoding::kGzip)) {
+    GTEST_SKIP() << "Built without zlib";
+  }
+
+  const auto catalog = CreateCatalog("gzip");
+  const std::string content(1000u, 'a');
+
+  auto response =
+      write::CompressData(catalog, "layer", CreateSource(content), boost::none);
+  ASSERT_TRUE(response.IsSuccessful());
+  const auto compressed = response.GetResult();
+  ASSERT_TRUE(compressed);
+  EXPECT_LT(compressed->size(), content.size());
+
+  auto decompressed =
+      Compression::Decompress(ContentEncoding::kGzip, *compressed);
+  ASSERT_TRUE(decompressed);
+  EXPECT_EQ(content, std::string(decompressed->begin(), decompressed->end()));
+
+  {
+    SCOPED_TRACE("Compressed data is published as is");
+    auto again = write::CompressData(
+        catalog, "layer", write::DataSource::FromData(compressed), boost::none);
+    ASSERT_TRUE(again.IsSuccessful());
+    EXPECT_FALSE(again.GetResult());
+  }
+  {
+    SCOPED_TRACE("Checksum of the uncompressed data");
+    auto with_checksum = write::CompressData(
+        catalog, "layer", CreateSource(content), std::string("checksum"));
+    ASSERT_FALSE(with_checksum.IsSuccessful());
+    EXPECT_EQ(client::ErrorCode::InvalidArgument,
+              with_checksum.GetError().GetErrorCode());
+  }
+}
+
+}  // namespace
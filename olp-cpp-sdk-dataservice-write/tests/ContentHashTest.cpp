@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2019 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/utils/Sha256.h>
+#include "ContentHash.h"
+
+namespace {
+
+namespace write = olp::dataservice::write;
+
+std::string Hash(const std::string& data) {
+  olp::utils::Sha256 hash;
+  hash.Update(reinterpret_cast<const std::uint8_t*>(data.data()),
+              data.size());
+  return olp::utils::Sha256::ToHexString(hash.Final());
+}
+
+TEST(ContentHashTest, ComputeContentHash) {
+  const std::string content(3000000u, 'x');
+  auto data = std::make_shared<std::vector<unsigned char>>(content.begin(),
+                                                           content.end());
+
+  // The content is read in several chunks.
+  auto hash = write::ComputeContentHash(write::DataSource::FromData(data));
+  ASSERT_TRUE(hash);
+  EXPECT_EQ(Hash(content), *hash);
+
+  auto failing_source = write::DataSource(
+      10u, [](std::uint64_t, size_t, std::uint8_t*) { return false; });
+  EXPECT_FALSE(write::ComputeContentHash(failing_source));
+}
+
+}  // namespace
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <set>
+
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include "IndexBatchWriter.h"
+
+namespace {
+
+namespace client = olp::client;
+using namespace olp::dataservice::write;
+
+constexpr auto kLayer = "layer";
+constexpr auto kWaitTimeout = std::chrono::seconds(10);
+
+model::PublishIndexRequest MakeRequest(const std::string& name) {
+  model::Index index;
+  index.SetId(name);
+  return model::PublishIndexRequest()
+      .WithLayerId(kLayer)
+      .WithData(std::make_shared<std::vector<unsigned char>>(name.begin(),
+                                                             name.end()))
+      .WithIndex(std::move(index));
+}
+
+// Collects the responses of the queued indexes.
+class Responses {
+ public:
+  PublishIndexCallback Callback() {
+    return [this](PublishIndexResponse response) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      responses_.push_back(std::move(response));
+      condition_.notify_all();
+    };
+  }
+
+  std::vector<PublishIndexResponse> Wait(size_t count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    EXPECT_TRUE(condition_.wait_for(lock, kWaitTimeout, [&] {
+      return responses_.size() >= count;
+    }));
+    return responses_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<PublishIndexResponse> responses_;
+};
+
+class IndexBatchWriterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pending_requests_ = std::make_shared<client::PendingRequests>();
+    settings_.maximum_indexes_per_update = 4u;
+    settings_.maximum_update_delay = std::chrono::minutes(10);
+  }
+
+  void TearDown() override {
+    if (writer_) {
+      writer_->Stop();
+    }
+    pending_requests_->CancelAllAndWait();
+  }
+
+  void CreateWriter() {
+    // The data handle is the name of the index data.
+    auto upload = [](const model::PublishIndexRequest& request,
+                     client::CancellationContext) -> UploadIndexDataResponse {
+      const auto& data = *request.GetData();
+      if (std::string(data.begin(), data.end()) == "invalid") {
+        return client::ApiError(client::ErrorCode::BadRequest, "Invalid");
+      }
+      auto index = request.GetIndex();
+      index.SetId("handle-" + index.GetId());
+      return index;
+    };
+
+    auto update = [this](const model::UpdateIndexRequest& request,
+                         client::CancellationContext) -> UpdateIndexResponse {
+      std::lock_guard<std::mutex> lock(mutex_);
+      updates_.push_back(request);
+      return client::ApiNoResult();
+    };
+
+    writer_ = std::make_shared<IndexBatchWriter>(
+        settings_, task_scheduler_, pending_requests_, upload, update);
+  }
+
+  std::vector<model::UpdateIndexRequest> Updates() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return updates_;
+  }
+
+  IndexLayerClientSettings settings_;
+  std::shared_ptr<olp::thread::TaskScheduler> task_scheduler_;
+  std::shared_ptr<client::PendingRequests> pending_requests_;
+  std::shared_ptr<IndexBatchWriter> writer_;
+  std::mutex mutex_;
+  std::vector<model::UpdateIndexRequest> updates_;
+};
+
+TEST_F(IndexBatchWriterTest, SubmitsFullUpdates) {
+  task_scheduler_ =
+      client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(3u);
+  settings_.maximum_parallel_uploads = 3u;
+  CreateWriter();
+
+  Responses responses;
+  for (size_t i = 0; i < 8u; ++i) {
+    writer_->Queue(MakeRequest(std::to_string(i)), responses.Callback());
+  }
+
+  std::set<std::string> trace_ids;
+  for (const auto& response : responses.Wait(8u)) {
+    ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+    trace_ids.insert(response.GetResult().GetTraceID());
+  }
+  EXPECT_EQ(8u, trace_ids.size());
+  EXPECT_EQ(1u, trace_ids.count("handle-7"));
+
+  const auto updates = Updates();
+  ASSERT_EQ(2u, updates.size());
+  for (const auto& update : updates) {
+    EXPECT_EQ(kLayer, update.GetLayerId());
+    EXPECT_EQ(4u, update.GetIndexAdditions().size());
+  }
+}
+
+TEST_F(IndexBatchWriterTest, SubmitsAfterDelay) {
+  settings_.maximum_update_delay = std::chrono::milliseconds(20);
+  CreateWriter();
+
+  Responses responses;
+  for (const auto name : {"1", "2", "3"}) {
+    writer_->Queue(MakeRequest(name), responses.Callback());
+  }
+  EXPECT_TRUE(Updates().empty());
+
+  for (const auto& response : responses.Wait(3u)) {
+    EXPECT_TRUE(response.IsSuccessful());
+  }
+
+  const auto updates = Updates();
+  ASSERT_EQ(1u, updates.size());
+  EXPECT_EQ(3u, updates.front().GetIndexAdditions().size());
+}
+
+TEST_F(IndexBatchWriterTest, FailsOnlyFailedIndexes) {
+  CreateWriter();
+
+  Responses responses;
+  writer_->Queue(MakeRequest("1"), responses.Callback());
+  writer_->Queue(MakeRequest("invalid"), responses.Callback());
+  writer_->Queue(MakeRequest("2"), responses.Callback());
+
+  // The upload fails before the others are submitted.
+  auto failed = responses.Wait(1u);
+  ASSERT_FALSE(failed.front().IsSuccessful());
+  EXPECT_EQ(client::ErrorCode::BadRequest,
+            failed.front().GetError().GetErrorCode());
+
+  writer_->Flush();
+  auto all = responses.Wait(3u);
+  EXPECT_TRUE(all[1].IsSuccessful());
+  EXPECT_TRUE(all[2].IsSuccessful());
+
+  const auto updates = Updates();
+  ASSERT_EQ(1u, updates.size());
+  EXPECT_EQ(2u, updates.front().GetIndexAdditions().size());
+}
+
+TEST_F(IndexBatchWriterTest, MergesQueuedUpdates) {
+  CreateWriter();
+
+  Responses responses;
+  writer_->Queue(MakeRequest("1"), responses.Callback());
+
+  std::promise<UpdateIndexResponse> update_promise;
+  writer_->Queue(model::UpdateIndexRequest()
+                     .WithLayerId(kLayer)
+                     .WithIndexRemovals({"handle-0"}),
+                 [&](UpdateIndexResponse response) {
+                   update_promise.set_value(std::move(response));
+                 });
+
+  // Other layers are submitted separately.
+  writer_->Queue(MakeRequest("2").WithLayerId("other"), responses.Callback());
+  writer_->Flush();
+
+  responses.Wait(2u);
+  EXPECT_TRUE(update_promise.get_future().get().IsSuccessful());
+
+  auto updates = Updates();
+  ASSERT_EQ(2u, updates.size());
+  const auto& update =
+      updates[0].GetLayerId() == kLayer ? updates[0] : updates[1];
+  ASSERT_EQ(1u, update.GetIndexAdditions().size());
+  EXPECT_EQ("handle-1", update.GetIndexAdditions().front().GetId());
+  EXPECT_EQ(std::vector<std::string>{"handle-0"}, update.GetIndexRemovals());
+}
+
+TEST_F(IndexBatchWriterTest, BlocksWhenFull) {
+  settings_.maximum_queued_indexes = 2u;
+  CreateWriter();
+
+  Responses responses;
+  writer_->Queue(MakeRequest("1"), responses.Callback());
+  writer_->Queue(MakeRequest("2"), responses.Callback());
+
+  auto queued = std::async(std::launch::async, [&] {
+    writer_->Queue(MakeRequest("3"), responses.Callback());
+  });
+  EXPECT_EQ(std::future_status::timeout,
+            queued.wait_for(std::chrono::milliseconds(50)));
+
+  writer_->Flush();
+  EXPECT_EQ(std::future_status::ready, queued.wait_for(kWaitTimeout));
+
+  writer_->Flush();
+  for (const auto& response : responses.Wait(3u)) {
+    EXPECT_TRUE(response.IsSuccessful());
+  }
+}
+
+TEST_F(IndexBatchWriterTest, CancelsIndexes) {
+  CreateWriter();
+
+  Responses responses;
+  auto token = writer_->Queue(MakeRequest("1"), responses.Callback());
+  writer_->Queue(MakeRequest("2"), responses.Callback());
+
+  token.Cancel();
+  writer_->Flush();
+
+  auto all = responses.Wait(2u);
+  ASSERT_FALSE(all[0].IsSuccessful());
+  EXPECT_EQ(client::ErrorCode::Cancelled, all[0].GetError().GetErrorCode());
+  EXPECT_TRUE(all[1].IsSuccessful());
+
+  writer_->Queue(MakeRequest("3"), responses.Callback());
+  writer_->Stop();
+
+  all = responses.Wait(3u);
+  ASSERT_FALSE(all[2].IsSuccessful());
+  EXPECT_EQ(client::ErrorCode::Cancelled, all[2].GetError().GetErrorCode());
+  EXPECT_EQ(1u, Updates().size());
+}
+
+}  // namespace
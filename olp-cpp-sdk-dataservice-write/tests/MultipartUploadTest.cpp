@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gmock/gmock.h>
+#include <matchers/NetworkUrlMatchers.h>
+#include <mocks/NetworkMock.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include "MultipartUpload.h"
+
+namespace {
+
+using testing::_;
+using testing::InSequence;
+namespace client = olp::client;
+namespace http = olp::http;
+namespace write = olp::dataservice::write;
+
+const std::string kBlobBaseUrl =
+    "https://blob.data.api.platform.here.com/blobstore/v1/catalogs/"
+    "hrn:here:data:::some_test_catalog";
+const std::string kLayer = "layer";
+const std::string kDataHandle = "handle";
+const std::string kContentType = "application/octet-stream";
+
+const std::string kInitUrl =
+    kBlobBaseUrl + "/layers/" + kLayer + "/data/" + kDataHandle + "/multiparts";
+const std::string kUploadPartUrl = "https://upload.here.com/part";
+const std::string kCompleteUrl = "https://upload.here.com/complete";
+const std::string kDeleteUrl = "https://upload.here.com/delete";
+
+const std::string kInitResponse =
+    R"jsonString({"links":{"uploadPart":{"href":")jsonString" +
+    kUploadPartUrl + R"jsonString("},"complete":{"href":")jsonString" +
+    kCompleteUrl + R"jsonString("},"delete":{"href":")jsonString" +
+    kDeleteUrl + R"jsonString("}}})jsonString";
+
+const std::string kCompleteBody =
+    R"jsonString({"parts":[{"etag":"etag-1","number":1},)jsonString"
+    R"jsonString({"etag":"etag-2","number":2},)jsonString"
+    R"jsonString({"etag":"etag-3","number":3}]})jsonString";
+
+std::string PartUrl(size_t part_number) {
+  return kUploadPartUrl + "?partNumber=" + std::to_string(part_number);
+}
+
+// The part is not copied into the body, it is read from the source.
+MATCHER_P(BodySourceEq, expected_body, "") {
+  const auto source = arg.GetBodySource();
+  if (arg.GetBody() || !source) {
+    return false;
+  }
+  const auto body = source->ReadAll();
+  return body && std::string(body->begin(), body->end()) == expected_body;
+}
+
+class MultipartUploadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    network_ = std::make_shared<testing::StrictMock<NetworkMock>>();
+    settings_.network_request_handler = network_;
+    settings_.retry_settings.timeout = 1;
+
+    blob_client_.SetBaseUrl(kBlobBaseUrl);
+    blob_client_.SetSettings(settings_);
+
+    // 10 bytes in parts of 4 bytes.
+    const std::string data = "0123456789";
+    data_ = std::make_shared<std::vector<unsigned char>>(data.begin(),
+                                                         data.end());
+    upload_settings_.part_size = 4u;
+
+    pending_requests_ = std::make_shared<client::PendingRequests>();
+  }
+
+  void TearDown() override {
+    network_.reset();
+    settings_.network_request_handler.reset();
+  }
+
+  write::PutBlobResponse Upload() {
+    return write::UploadBlobInParts(
+        blob_client_, settings_, kLayer, kContentType, kDataHandle,
+        write::DataSource::FromData(data_), boost::none, pending_requests_,
+        client::CancellationContext(), upload_settings_);
+  }
+
+  std::shared_ptr<NetworkMock> network_;
+  client::OlpClientSettings settings_;
+  client::OlpClient blob_client_;
+  std::shared_ptr<std::vector<unsigned char>> data_;
+  write::MultipartUploadSettings upload_settings_;
+  std::shared_ptr<client::PendingRequests> pending_requests_;
+};
+
+TEST_F(MultipartUploadTest, UploadsAllParts) {
+  {
+    InSequence sequence;
+
+    EXPECT_CALL(*network_, Send(IsPostRequest(kInitUrl), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            GetResponse(http::HttpStatusCode::CREATED), kInitResponse));
+
+    const std::vector<std::string> parts = {"0123", "4567", "89"};
+    for (size_t part = 1u; part <= parts.size(); ++part) {
+      EXPECT_CALL(*network_,
+                  Send(testing::AllOf(IsPostRequest(PartUrl(part)),
+                                      BodySourceEq(parts[part - 1u])),
+                       _, _, _, _))
+          .WillOnce(ReturnHttpResponse(
+              GetResponse(http::HttpStatusCode::NO_CONTENT), "",
+              {{"etag", "etag-" + std::to_string(part)}}));
+    }
+
+    EXPECT_CALL(*network_, Send(testing::AllOf(IsPutRequest(kCompleteUrl),
+                                               BodyEq(kCompleteBody)),
+                                _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            GetResponse(http::HttpStatusCode::NO_CONTENT), ""));
+  }
+
+  auto response = Upload();
+
+  EXPECT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+}
+
+TEST_F(MultipartUploadTest, UploadsPartsInParallel) {
+  settings_.task_scheduler =
+      client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(3u);
+  blob_client_.SetSettings(settings_);
+  upload_settings_.max_parallel_parts = 3u;
+
+  EXPECT_CALL(*network_, Send(IsPostRequest(kInitUrl), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(GetResponse(http::HttpStatusCode::OK),
+                                   kInitResponse));
+
+  for (size_t part = 1u; part <= 3u; ++part) {
+    EXPECT_CALL(*network_, Send(IsPostRequest(PartUrl(part)), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            GetResponse(http::HttpStatusCode::OK), "",
+            {{"ETag", "etag-" + std::to_string(part)}}));
+  }
+
+  // The parts are listed in order no matter which one finished first.
+  EXPECT_CALL(*network_, Send(testing::AllOf(IsPutRequest(kCompleteUrl),
+                                             BodyEq(kCompleteBody)),
+                              _, _, _, _))
+      .WillOnce(
+          ReturnHttpResponse(GetResponse(http::HttpStatusCode::OK), ""));
+
+  auto response = Upload();
+
+  EXPECT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+  EXPECT_TRUE(pending_requests_->CancelAllAndWait());
+}
+
+TEST_F(MultipartUploadTest, AbortsOnFailedPart) {
+  {
+    InSequence sequence;
+
+    EXPECT_CALL(*network_, Send(IsPostRequest(kInitUrl), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(GetResponse(http::HttpStatusCode::OK),
+                                     kInitResponse));
+
+    EXPECT_CALL(*network_, Send(IsPostRequest(PartUrl(1u)), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(GetResponse(http::HttpStatusCode::OK),
+                                     "", {{"ETag", "etag-1"}}));
+
+    EXPECT_CALL(*network_, Send(IsPostRequest(PartUrl(2u)), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            GetResponse(http::HttpStatusCode::BAD_REQUEST), "Bad part"));
+
+    EXPECT_CALL(*network_, Send(IsDeleteRequest(kDeleteUrl), _, _, _, _))
+        .WillOnce(ReturnHttpResponse(
+            GetResponse(http::HttpStatusCode::NO_CONTENT), ""));
+  }
+
+  auto response = Upload();
+
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(http::HttpStatusCode::BAD_REQUEST,
+            response.GetError().GetHttpStatusCode());
+}
+
+}  // namespace
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <gtest/gtest.h>
+
+#include <olp/core/cache/CacheSettings.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include "PublishQueue.h"
+
+// clang-format off
+#include <generated/serializer/PublishDataRequestSerializer.h>
+#include <generated/serializer/JsonSerializer.h>
+// clang-format on
+
+namespace {
+
+using namespace olp::dataservice::write;
+
+constexpr auto kPrefix = "hrn:here:data::olp-here-test:catalog-stream-queue";
+constexpr auto kLegacyListKey =
+    "hrn:here:data::olp-here-test:catalog-stream-queue-cache";
+
+model::PublishDataRequest MakeRequest(const std::string& trace_id) {
+  return model::PublishDataRequest()
+      .WithTraceId(trace_id)
+      .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+      .WithLayerId("layer");
+}
+
+std::vector<std::string> TraceIds(
+    const std::vector<model::PublishDataRequest>& requests) {
+  std::vector<std::string> trace_ids;
+  for (const auto& request : requests) {
+    trace_ids.push_back(request.GetTraceId().get_value_or(""));
+  }
+  return trace_ids;
+}
+
+class PublishQueueTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    cache_ = olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  }
+
+  std::shared_ptr<olp::cache::KeyValueCache> cache_;
+};
+
+TEST_F(PublishQueueTest, KeepsOrder) {
+  PublishQueue queue(cache_, kPrefix, kLegacyListKey);
+  EXPECT_EQ(0u, queue.Size());
+  EXPECT_FALSE(queue.PopFront());
+
+  for (const auto trace_id : {"1", "2", "3"}) {
+    EXPECT_TRUE(queue.Push(MakeRequest(trace_id)));
+  }
+  EXPECT_EQ(3u, queue.Size());
+
+  EXPECT_EQ(std::vector<std::string>({"1", "2"}), TraceIds(queue.Peek(2u)));
+  EXPECT_EQ(3u, queue.Size());
+
+  queue.Pop(2u);
+  EXPECT_EQ(1u, queue.Size());
+
+  auto request = queue.PopFront();
+  ASSERT_TRUE(request);
+  EXPECT_EQ("3", request->GetTraceId().get());
+  EXPECT_EQ(0u, queue.Size());
+  EXPECT_TRUE(queue.Peek(2u).empty());
+
+  // Popping more requests than queued empties the queue
+  EXPECT_TRUE(queue.Push(MakeRequest("4")));
+  queue.Pop(10u);
+  EXPECT_EQ(0u, queue.Size());
+}
+
+TEST_F(PublishQueueTest, RestoredFromCache) {
+  {
+    PublishQueue queue(cache_, kPrefix, kLegacyListKey);
+    for (const auto trace_id : {"1", "2", "3"}) {
+      EXPECT_TRUE(queue.Push(MakeRequest(trace_id)));
+    }
+    queue.Pop(1u);
+  }
+
+  PublishQueue queue(cache_, kPrefix, kLegacyListKey);
+  EXPECT_EQ(2u, queue.Size());
+  EXPECT_EQ(std::vector<std::string>({"2", "3"}), TraceIds(queue.Peek(5u)));
+
+  EXPECT_TRUE(queue.Push(MakeRequest("4")));
+  EXPECT_EQ(std::vector<std::string>({"2", "3", "4"}),
+            TraceIds(queue.Peek(5u)));
+}
+
+TEST_F(PublishQueueTest, SharedByCacheAndPrefix) {
+  auto queue = PublishQueue::Create(cache_, kPrefix, kLegacyListKey);
+  auto same_queue = PublishQueue::Create(cache_, kPrefix, kLegacyListKey);
+  EXPECT_EQ(queue, same_queue);
+
+  EXPECT_TRUE(queue->Push(MakeRequest("1")));
+  EXPECT_TRUE(same_queue->Push(MakeRequest("2")));
+  EXPECT_EQ(std::vector<std::string>({"1", "2"}), TraceIds(queue->Peek(5u)));
+
+  std::shared_ptr<olp::cache::KeyValueCache> other_cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  auto other_queue = PublishQueue::Create(other_cache, kPrefix, kLegacyListKey);
+  EXPECT_NE(queue, other_queue);
+  EXPECT_EQ(0u, other_queue->Size());
+}
+
+TEST_F(PublishQueueTest, RemovesLeftoverRequests) {
+  const auto to_string = [](const std::string& value) { return value; };
+  const auto leftover_key = std::string(kPrefix) + "-item-leftover";
+  cache_->Put(leftover_key, std::string("request"),
+              []() { return std::string("request"); });
+
+  PublishQueue queue(cache_, kPrefix, kLegacyListKey);
+  EXPECT_EQ(0u, queue.Size());
+  EXPECT_TRUE(cache_->Get(leftover_key, to_string).empty());
+}
+
+TEST_F(PublishQueueTest, MigratesLegacyList) {
+  std::string list;
+  for (const auto key : {"uuid-1", "uuid-2"}) {
+    const auto request = MakeRequest(key);
+    cache_->Put(key, request, [&]() {
+      return olp::serializer::serialize<model::PublishDataRequest>(request);
+    });
+    list += std::string(key) + ",";
+  }
+  cache_->Put(kLegacyListKey, list, [&]() { return list; });
+
+  PublishQueue queue(cache_, kPrefix, kLegacyListKey);
+  EXPECT_EQ(2u, queue.Size());
+  EXPECT_EQ(std::vector<std::string>({"uuid-1", "uuid-2"}),
+            TraceIds(queue.Peek(5u)));
+
+  const auto to_string = [](const std::string& value) { return value; };
+  EXPECT_TRUE(cache_->Get(kLegacyListKey, to_string).empty());
+  EXPECT_TRUE(cache_->Get("uuid-1", to_string).empty());
+  EXPECT_TRUE(cache_->Get("uuid-2", to_string).empty());
+}
+
+}  // namespace
@@ -110,6 +110,8 @@ class MockStreamLayerClientImpl : public write::StreamLayerClientImpl {
   using StreamLayerClientImpl::StreamLayerClientImpl;
   using write::StreamLayerClientImpl::PublishDataGreaterThanTwentyMib;
   using write::StreamLayerClientImpl::PublishDataLessThanTwentyMib;
+  using write::StreamLayerClientImpl::PublishTarget;
+  using write::StreamLayerClientImpl::PublishTargetResponse;
 
   MOCK_METHOD(write::PublishSdiiResponse, IngestSdii,
               (model::PublishSdiiRequest request,
@@ -121,6 +123,16 @@ class MockStreamLayerClientImpl : public write::StreamLayerClientImpl {
                client::CancellationContext context),
               (override));
 
+  MOCK_METHOD(PublishTargetResponse, ResolvePublishTarget,
+              (const model::PublishDataRequest& request,
+               client::CancellationContext context),
+              (override));
+
+  MOCK_METHOD(write::PublishDataResponse, PublishQueuedData,
+              (const PublishTarget& target, model::PublishDataRequest request,
+               client::CancellationContext context),
+              (override));
+
   MOCK_METHOD(std::string, GenerateUuid, (), (const, override));
 };
 
@@ -732,23 +744,23 @@ TEST_F(StreamLayerClientImplTest, QueueAndFlush) {
   auto client = std::make_shared<MockStreamLayerClientImpl>(
       kHrn, write::StreamLayerClientSettings{}, settings_);
 
-  size_t uuid_call_count = 1;
   // Forward trace ID from request to response
-  ON_CALL(*client, PublishDataTask(_, _))
-      .WillByDefault([](model::PublishDataRequest request,
+  ON_CALL(*client, PublishQueuedData(_, _, _))
+      .WillByDefault([](const MockStreamLayerClientImpl::PublishTarget &,
+                        model::PublishDataRequest request,
                         client::CancellationContext /*context*/)
                          -> write::PublishDataResponse {
         write::PublishDataResult result;
         result.SetTraceID(request.GetTraceId().get());
         return write::PublishDataResponse{result};
       });
-  ON_CALL(*client, GenerateUuid)
-      .WillByDefault([&uuid_call_count]() -> std::string {
-        return std::to_string(uuid_call_count++);
-      });
+  ON_CALL(*client, ResolvePublishTarget(_, _))
+      .WillByDefault(Return(MockStreamLayerClientImpl::PublishTarget{}));
 
-  EXPECT_CALL(*client, PublishDataTask(_, _)).Times(kBatchSize);
-  EXPECT_CALL(*client, GenerateUuid()).Times(kBatchSize);
+  // The catalog is resolved once for all the requests
+  EXPECT_CALL(*client, ResolvePublishTarget(_, _)).Times(1);
+  EXPECT_CALL(*client, PublishQueuedData(_, _, _)).Times(kBatchSize);
+  EXPECT_CALL(*client, PublishDataTask(_, _)).Times(0);
 
   // queues all  requests:
   for (size_t i = 0; i < kBatchSize; ++i) {
@@ -776,4 +788,129 @@ TEST_F(StreamLayerClientImplTest, QueueAndFlush) {
   EXPECT_EQ(kBatchSize, trace_ids.size());
 }
 
+TEST_F(StreamLayerClientImplTest, FlushKeepsQueueOnTargetError) {
+  const size_t kBatchSize = 10;
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+
+  auto client = std::make_shared<MockStreamLayerClientImpl>(
+      kHrn, write::StreamLayerClientSettings{}, settings_);
+
+  ON_CALL(*client, PublishQueuedData(_, _, _))
+      .WillByDefault(Return(write::PublishDataResponse{
+          write::PublishDataResult{}}));
+
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    auto error = client->Queue(
+        model::PublishDataRequest()
+            .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+            .WithLayerId("layer")
+            .WithBillingTag(i % 2 ? "odd" : "even"));
+    EXPECT_EQ(boost::none, error) << *error;
+  }
+
+  {
+    SCOPED_TRACE("Lookup fails");
+
+    EXPECT_CALL(*client, ResolvePublishTarget(_, _))
+        .WillOnce(Return(client::ApiError(
+            client::ErrorCode::ServiceUnavailable, "Service unavailable")));
+    EXPECT_CALL(*client, PublishQueuedData(_, _, _)).Times(0);
+
+    auto response = client->Flush(model::FlushRequest()).GetFuture().get();
+    ASSERT_EQ(response.size(), 1u);
+    EXPECT_EQ(client::ErrorCode::ServiceUnavailable,
+              response.front().GetError().GetErrorCode());
+    EXPECT_EQ(client->QueueSize(), kBatchSize);
+
+    Mock::VerifyAndClearExpectations(client.get());
+  }
+
+  {
+    SCOPED_TRACE("Lookup of the second billing tag fails");
+
+    EXPECT_CALL(*client, ResolvePublishTarget(_, _))
+        .WillOnce(Return(MockStreamLayerClientImpl::PublishTarget{}))
+        .WillOnce(Return(client::ApiError(
+            client::ErrorCode::ServiceUnavailable, "Service unavailable")));
+    EXPECT_CALL(*client, PublishQueuedData(_, _, _)).Times(1);
+
+    auto response = client->Flush(model::FlushRequest()).GetFuture().get();
+    ASSERT_EQ(response.size(), 2u);
+    EXPECT_TRUE(response.front().IsSuccessful());
+    EXPECT_FALSE(response.back().IsSuccessful());
+    EXPECT_EQ(client->QueueSize(), kBatchSize - 1);
+
+    Mock::VerifyAndClearExpectations(client.get());
+  }
+
+  {
+    SCOPED_TRACE("Targets are resolved once per billing tag");
+
+    EXPECT_CALL(*client, ResolvePublishTarget(_, _))
+        .Times(2)
+        .WillRepeatedly(Return(MockStreamLayerClientImpl::PublishTarget{}));
+    EXPECT_CALL(*client, PublishQueuedData(_, _, _)).Times(kBatchSize - 1);
+
+    auto response = client->Flush(model::FlushRequest()).GetFuture().get();
+    EXPECT_EQ(response.size(), kBatchSize - 1);
+    EXPECT_EQ(client->QueueSize(), 0u);
+
+    Mock::VerifyAndClearExpectations(client.get());
+  }
+}
+
+TEST_F(StreamLayerClientImplTest, FlushInParallel) {
+  const size_t kBatchSize = 10;
+  settings_.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache({});
+  settings_.task_scheduler =
+      olp::client::OlpClientSettingsFactory::CreateDefaultTaskScheduler(4);
+
+  write::StreamLayerClientSettings client_settings;
+  client_settings.maximum_parallel_requests = 4;
+  write::StreamLayerClientImpl client{kHrn, client_settings, settings_};
+
+  // The lookups and the catalog are requested once for all the requests
+  EXPECT_CALL(*network_, Send(IsGetRequest(kConfigRequestUrl), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kConfigHttpResponse));
+
+  EXPECT_CALL(*network_, Send(IsGetRequest(kGetCatalogRequest), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kGetCatalogResponse));
+
+  EXPECT_CALL(*network_, Send(IsGetRequest(kIngestRequestUrl), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(olp::http::NetworkResponse().WithStatus(
+                                       olp::http::HttpStatusCode::OK),
+                                   kIngestHttpResponse));
+
+  EXPECT_CALL(*network_,
+              Send(IsPostRequest(kPostIngestDataRequest), _, _, _, _))
+      .Times(kBatchSize)
+      .WillRepeatedly(ReturnHttpResponse(
+          olp::http::NetworkResponse().WithStatus(
+              olp::http::HttpStatusCode::OK),
+          kPostIngestDataHttpResponse));
+
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    auto error = client.Queue(
+        model::PublishDataRequest()
+            .WithData(std::make_shared<std::vector<unsigned char>>(1, 'z'))
+            .WithLayerId(kLayerName));
+    EXPECT_EQ(boost::none, error) << *error;
+  }
+
+  auto response = client.Flush(model::FlushRequest()).GetFuture().get();
+  EXPECT_EQ(response.size(), kBatchSize);
+  for (const auto &r : response) {
+    EXPECT_TRUE(r.IsSuccessful());
+    EXPECT_EQ(kPostIngestDataTraceID, r.GetResult().GetTraceID());
+  }
+
+  EXPECT_EQ(client.QueueSize(), 0u);
+}
+
 }  // namespace
@@ -59,6 +59,49 @@ const std::string kUserSigninResponse = R"JSON(
     {"accessToken":"password_grant_token","tokenType":"bearer","expiresIn":3599,"refreshToken":"5j687leur4njgb4osomifn55p0","userId":"HERE-5fa10eda-39ff-4cbc-9b0c-5acba4685649"}
     )JSON";
 
+class VersionedLayerClientImplMock : public write::VersionedLayerClientImpl {
+ public:
+  using write::VersionedLayerClientImpl::VersionedLayerClientImpl;
+
+  MOCK_METHOD(write::InitCatalogModelResponse, InitCatalogModel,
+              (client::CancellationContext), (override));
+
+  MOCK_METHOD(write::UploadPartitionDataResponse, UploadPartitionData,
+              (const model::PublishPartitionDataRequest&, bool,
+               client::CancellationContext),
+              (override));
+
+  MOCK_METHOD(write::UploadPartitionResponse, UploadPartitions,
+              (const std::string&, const std::string&,
+               std::vector<model::PublishPartition>,
+               client::CancellationContext),
+              (override));
+};
+
+write::UploadedPartition UploadResult(
+    const model::PublishPartitionDataRequest& request, bool reused = false) {
+  write::UploadedPartition result;
+  auto& partition = result.partition;
+  partition.SetPartition(request.GetPartitionId().value_or(""));
+  partition.SetDataHandle("handle-" + partition.GetPartition().value_or(""));
+  partition.SetDataSize(static_cast<int64_t>(request.GetData()->size()));
+  result.reused = reused;
+  return result;
+}
+
+std::vector<model::PublishPartitionDataRequest> GeneratePartitions(
+    size_t count) {
+  auto data = std::make_shared<std::vector<unsigned char>>(4u, 'a');
+  std::vector<model::PublishPartitionDataRequest> partitions;
+  for (size_t i = 0; i < count; ++i) {
+    partitions.push_back(model::PublishPartitionDataRequest()
+                             .WithLayerId(kLayer)
+                             .WithPartitionId(std::to_string(i))
+                             .WithData(data));
+  }
+  return partitions;
+}
+
 class VersionedLayerClientImplTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -677,4 +720,150 @@ TEST_F(VersionedLayerClientImplTest, CompleteBatchCancel) {
   }
 }
 
+TEST_F(VersionedLayerClientImplTest, PublishPartitions) {
+  auto client =
+      std::make_shared<testing::NiceMock<VersionedLayerClientImplMock>>(
+          kHrn, settings_);
+
+  model::Publication publication;
+  publication.SetId("publication");
+
+  const size_t kPartitions = 10u;
+  std::mutex mutex;
+  std::vector<std::string> committed;
+
+  EXPECT_CALL(*client, InitCatalogModel(_))
+      .WillOnce(Return(client::ApiNoResult()));
+  EXPECT_CALL(*client, UploadPartitionData(_, false, _))
+      .Times(kPartitions)
+      .WillRepeatedly([](const model::PublishPartitionDataRequest& request,
+                         bool, client::CancellationContext) {
+        return UploadResult(request);
+      });
+  // 10 partitions are committed in batches of 4, 4, and 2.
+  EXPECT_CALL(*client, UploadPartitions("publication", kLayer, _, _))
+      .Times(3)
+      .WillRepeatedly([&](const std::string&, const std::string&,
+                          std::vector<model::PublishPartition> partitions,
+                          client::CancellationContext) {
+        EXPECT_LE(partitions.size(), 4u);
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& partition : partitions) {
+          EXPECT_EQ("handle-" + partition.GetPartition().value_or(""),
+                    partition.GetDataHandle().value_or(""));
+          committed.push_back(partition.GetPartition().value_or(""));
+        }
+        return client::ApiNoResult();
+      });
+
+  std::atomic<uint64_t> last_committed{0u};
+  auto request = model::PublishPartitionsRequest()
+                     .WithPartitions(GeneratePartitions(kPartitions))
+                     .WithMaxParallelUploads(3u)
+                     .WithMaxPartitionsPerUpload(4u)
+                     .WithProgressCallback(
+                         [&](model::PublishPartitionsProgress progress) {
+                           EXPECT_LE(progress.partitions_committed,
+                                     progress.partitions_uploaded);
+                           last_committed = progress.partitions_committed;
+                         });
+
+  auto response =
+      client->PublishToBatch(publication, request).GetFuture().get();
+
+  ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+  EXPECT_EQ(kPartitions, response.GetResult().partitions_uploaded);
+  EXPECT_EQ(kPartitions, response.GetResult().partitions_committed);
+  EXPECT_EQ(kPartitions * 4u, response.GetResult().bytes_uploaded);
+  EXPECT_EQ(0u, response.GetResult().partitions_reused);
+  EXPECT_EQ(kPartitions, last_committed.load());
+  EXPECT_EQ(kPartitions, committed.size());
+}
+
+TEST_F(VersionedLayerClientImplTest, PublishPartitionsDeduplicated) {
+  auto client =
+      std::make_shared<testing::NiceMock<VersionedLayerClientImplMock>>(
+          kHrn, settings_);
+
+  model::Publication publication;
+  publication.SetId("publication");
+
+  EXPECT_CALL(*client, InitCatalogModel(_))
+      .WillOnce(Return(client::ApiNoResult()));
+  // The data of the odd partitions already exists.
+  EXPECT_CALL(*client, UploadPartitionData(_, true, _))
+      .Times(4)
+      .WillRepeatedly([](const model::PublishPartitionDataRequest& request,
+                         bool, client::CancellationContext) {
+        const auto index = std::stoul(request.GetPartitionId().value_or(""));
+        return UploadResult(request, index % 2u == 1u);
+      });
+  EXPECT_CALL(*client, UploadPartitions("publication", kLayer, _, _))
+      .WillOnce([](const std::string&, const std::string&,
+                   std::vector<model::PublishPartition> partitions,
+                   client::CancellationContext) {
+        // The reused data is published like the uploaded one.
+        EXPECT_EQ(4u, partitions.size());
+        return client::ApiNoResult();
+      });
+
+  auto request = model::PublishPartitionsRequest()
+                     .WithPartitions(GeneratePartitions(4u))
+                     .WithDeduplication(true);
+  auto response =
+      client->PublishToBatch(publication, request).GetFuture().get();
+
+  ASSERT_TRUE(response.IsSuccessful()) << response.GetError().GetMessage();
+  EXPECT_EQ(4u, response.GetResult().partitions_uploaded);
+  EXPECT_EQ(4u, response.GetResult().partitions_committed);
+  EXPECT_EQ(2u, response.GetResult().partitions_reused);
+  EXPECT_EQ(2u * 4u, response.GetResult().bytes_uploaded);
+}
+
+TEST_F(VersionedLayerClientImplTest, PublishPartitionsFailed) {
+  auto client =
+      std::make_shared<testing::NiceMock<VersionedLayerClientImplMock>>(
+          kHrn, settings_);
+
+  model::Publication publication;
+  publication.SetId("publication");
+
+  {
+    SCOPED_TRACE("Invalid publication");
+
+    auto request =
+        model::PublishPartitionsRequest().WithPartitions(GeneratePartitions(1u));
+    auto response =
+        client->PublishToBatch(model::Publication(), request).GetFuture().get();
+
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(client::ErrorCode::InvalidArgument,
+              response.GetError().GetErrorCode());
+  }
+  {
+    SCOPED_TRACE("Failed upload");
+
+    EXPECT_CALL(*client, InitCatalogModel(_))
+        .WillOnce(Return(client::ApiNoResult()));
+    EXPECT_CALL(*client, UploadPartitionData(_, _, _))
+        .WillOnce(Return(client::ApiError(client::ErrorCode::BadRequest,
+                                          "Bad request")));
+    EXPECT_CALL(*client, UploadPartitions(_, _, _, _)).Times(0);
+
+    auto response =
+        client
+            ->PublishToBatch(publication,
+                             model::PublishPartitionsRequest()
+                                 .WithPartitions(GeneratePartitions(3u))
+                                 .WithMaxParallelUploads(1u))
+            .GetFuture()
+            .get();
+
+    ASSERT_FALSE(response.IsSuccessful());
+    EXPECT_EQ(client::ErrorCode::BadRequest,
+              response.GetError().GetErrorCode());
+    Mock::VerifyAndClearExpectations(client.get());
+  }
+}
+
 }  // namespace
@@ -515,4 +515,34 @@ TEST_F(IndexLayerClientTest, PublishDataCancelPutBlob) {
   ASSERT_NO_FATAL_FAILURE(PublishCancelledAssertions(response));
 }
 
+TEST_F(IndexLayerClientTest, QueueUpdateIndexOffline) {
+  const auto offline_status =
+      static_cast<int>(olp::http::ErrorCode::OFFLINE_ERROR);
+  EXPECT_CALL(*network_, Send(IsPutRequest(URL_INSERT_INDEX), _, _, _, _))
+      .WillOnce(ReturnHttpResponse(GetResponse(offline_status), "Offline"));
+
+  model::Index index = GetTestIndex();
+  index.SetId("2f269191-5ef7-42a4-a445-fdfe53f95d92");
+
+  std::promise<write::UpdateIndexResponse> promise;
+  auto future = promise.get_future();
+  client_->QueueUpdateIndex(
+      model::UpdateIndexRequest()
+          .WithIndexAdditions({index})
+          .WithLayerId(GetTestLayer()),
+      [&](write::UpdateIndexResponse response) {
+        promise.set_value(std::move(response));
+      });
+  client_->FlushQueuedIndexes();
+
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(10)),
+            std::future_status::ready);
+  auto response = future.get();
+
+  // A request that did not reach the server is not a successful update.
+  testing::Mock::VerifyAndClearExpectations(network_.get());
+  ASSERT_FALSE(response.IsSuccessful());
+  EXPECT_EQ(response.GetError().GetHttpStatusCode(), offline_status);
+}
+
 }  // namespace
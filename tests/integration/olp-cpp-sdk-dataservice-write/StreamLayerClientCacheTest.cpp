@@ -336,7 +336,7 @@ TEST_F(StreamLayerClientCacheTest, FlushDataMultiple) {
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_CONFIG), _, _, _, _))
       .Times(1);
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_GET_CATALOG), _, _, _, _))
-      .Times(5);
+      .Times(1);
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_INGEST), _, _, _, _))
       .Times(1);
   EXPECT_CALL(*network_, Send(IsPostRequest(URL_INGEST_DATA), _, _, _, _))
@@ -452,7 +452,7 @@ TEST_F(StreamLayerClientCacheTest, FlushDataMaxEventsDefaultSetting) {
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_CONFIG), _, _, _, _))
       .Times(1);
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_GET_CATALOG), _, _, _, _))
-      .Times(5);
+      .Times(1);
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_INGEST), _, _, _, _))
       .Times(1);
 
@@ -470,7 +470,7 @@ TEST_F(StreamLayerClientCacheTest, FlushDataMaxEventsValidCustomSetting) {
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_CONFIG), _, _, _, _))
       .Times(1);
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_GET_CATALOG), _, _, _, _))
-      .Times(3);
+      .Times(1);
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_INGEST), _, _, _, _))
       .Times(1);
   EXPECT_CALL(*network_, Send(IsPostRequest(URL_INGEST_DATA), _, _, _, _))
@@ -510,7 +510,7 @@ TEST_F(StreamLayerClientCacheTest, FlushSettingsMaximumRequests) {
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_CONFIG), _, _, _, _))
       .Times(1);
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_GET_CATALOG), _, _, _, _))
-      .Times(15);
+      .Times(1);
   EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_INGEST), _, _, _, _))
       .Times(1);
 
@@ -536,4 +536,75 @@ TEST_F(StreamLayerClientCacheTest, FlushSettingsMaximumRequests) {
   ASSERT_NO_FATAL_FAILURE(MaximumRequestsSuccessAssertions(0, 10));
 }
 
+TEST_F(StreamLayerClientCacheTest, AutoFlushOnQueuedBytes) {
+  disk_cache_->Close();
+  stream_client_settings_.auto_flush_num_bytes = 3 * data_->size();
+  client_ = CreateStreamLayerClient();
+
+  const int kNumRequests = 3;
+  auto limit_reached = std::make_shared<std::atomic_bool>(false);
+  auto published = std::make_shared<std::atomic_int>(0);
+  auto flushed = std::make_shared<std::promise<void>>();
+
+  EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_CONFIG), _, _, _, _))
+      .Times(1);
+  EXPECT_CALL(*network_, Send(IsGetRequest(URL_GET_CATALOG), _, _, _, _))
+      .Times(1);
+  EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_INGEST), _, _, _, _))
+      .Times(1);
+  EXPECT_CALL(*network_, Send(IsPostRequest(URL_INGEST_DATA), _, _, _, _))
+      .Times(kNumRequests)
+      .WillRepeatedly(testing::DoAll(
+          testing::InvokeWithoutArgs([=]() {
+            // Nothing is flushed before the queued data reaches the limit
+            EXPECT_TRUE(limit_reached->load());
+            if (++*published == kNumRequests) {
+              flushed->set_value();
+            }
+          }),
+          ReturnHttpResponse(
+              olp::http::NetworkResponse().WithStatus(http::HttpStatusCode::OK),
+              HTTP_RESPONSE_INGEST_DATA)));
+
+  for (int i = 0; i < kNumRequests; i++) {
+    limit_reached->store(i + 1 == kNumRequests);
+    auto error = client_->Queue(
+        model::PublishDataRequest().WithData(data_).WithLayerId(
+            GetTestLayer()));
+    ASSERT_FALSE(error) << error.get();
+  }
+
+  // The queue is flushed in the background, without calling Flush
+  EXPECT_EQ(std::future_status::ready,
+            flushed->get_future().wait_for(std::chrono::seconds(10)));
+}
+
+TEST_F(StreamLayerClientCacheTest, AutoFlushOnMaxAge) {
+  disk_cache_->Close();
+  stream_client_settings_.auto_flush_max_age = std::chrono::milliseconds(100);
+  client_ = CreateStreamLayerClient();
+
+  auto flushed = std::make_shared<std::promise<void>>();
+
+  EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_CONFIG), _, _, _, _))
+      .Times(1);
+  EXPECT_CALL(*network_, Send(IsGetRequest(URL_GET_CATALOG), _, _, _, _))
+      .Times(1);
+  EXPECT_CALL(*network_, Send(IsGetRequest(URL_LOOKUP_INGEST), _, _, _, _))
+      .Times(1);
+  EXPECT_CALL(*network_, Send(IsPostRequest(URL_INGEST_DATA), _, _, _, _))
+      .WillOnce(testing::DoAll(
+          testing::InvokeWithoutArgs([=]() { flushed->set_value(); }),
+          ReturnHttpResponse(
+              olp::http::NetworkResponse().WithStatus(http::HttpStatusCode::OK),
+              HTTP_RESPONSE_INGEST_DATA)));
+
+  auto error = client_->Queue(
+      model::PublishDataRequest().WithData(data_).WithLayerId(GetTestLayer()));
+  ASSERT_FALSE(error) << error.get();
+
+  EXPECT_EQ(std::future_status::ready,
+            flushed->get_future().wait_for(std::chrono::seconds(10)));
+}
+
 }  // namespace
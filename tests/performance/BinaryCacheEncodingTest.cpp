@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/generated/parser/JsonParser.h>
+#include <olp/core/generated/serializer/SerializerWrapper.h>
+#include <olp/core/logging/Log.h>
+#include "generated/parser/PartitionsParser.h"
+#include "generated/serializer/JsonSerializer.h"
+#include "generated/serializer/PartitionsSerializer.h"
+#include "repositories/BinaryCacheEncoding.h"
+
+namespace {
+namespace model = olp::dataservice::read::model;
+namespace binary = olp::dataservice::read::repository::binary;
+
+constexpr auto kLogTag = "BinaryCacheEncodingTest";
+constexpr int kPartitionsCount = 100000;
+
+model::Partition CreatePartition(int index) {
+  model::Partition partition;
+  partition.SetPartition(std::to_string(23618364 + index));
+  partition.SetDataHandle("7636348E50215979A39B5F3A429EDDB4." +
+                          std::to_string(index));
+  partition.SetChecksum(std::string("291f66029c232400e3403cd6e9cfd36e"));
+  partition.SetDataSize(100500 + index);
+  partition.SetVersion(-1 - index);
+  return partition;
+}
+
+// Compares the decoding of the cached partitions with the JSON parsing.
+TEST(BinaryCacheEncodingTest, DecodeThroughput) {
+  std::vector<std::string> binary_values;
+  std::vector<std::string> json_values;
+  binary_values.reserve(kPartitionsCount);
+  json_values.reserve(kPartitionsCount);
+  size_t binary_size = 0u;
+  size_t json_size = 0u;
+  for (int index = 0; index < kPartitionsCount; ++index) {
+    const auto partition = CreatePartition(index);
+    binary_values.push_back(binary::Encode(partition));
+    json_values.push_back(olp::serializer::serialize(partition));
+    binary_size += binary_values.back().size();
+    json_size += json_values.back().size();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (const auto& value : binary_values) {
+    model::Partition partition;
+    ASSERT_TRUE(binary::Decode(value, partition));
+  }
+  const auto binary_time = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (const auto& value : json_values) {
+    auto partition = olp::parser::parse<model::Partition>(value);
+    ASSERT_FALSE(partition.GetDataHandle().empty());
+  }
+  const auto json_time = std::chrono::steady_clock::now() - start;
+
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "Decoded %d partitions: binary %zu bytes in %lld us, JSON %zu bytes in "
+      "%lld us",
+      kPartitionsCount, binary_size,
+      static_cast<long long>(duration_cast<microseconds>(binary_time).count()),
+      json_size,
+      static_cast<long long>(duration_cast<microseconds>(json_time).count()));
+
+  EXPECT_LT(binary_size, json_size);
+}
+
+}  // namespace
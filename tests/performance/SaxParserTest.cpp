@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <olp/core/logging/Log.h>
+// clang-format off
+// this order is required
+#include "generated/parser/MessagesParser.h"
+#include "generated/parser/PartitionsParser.h"
+#include "generated/parser/SaxParser.h"
+#include <olp/core/generated/parser/JsonParser.h>
+// clang-format on
+
+namespace {
+namespace model = olp::dataservice::read::model;
+
+constexpr auto kLogTag = "SaxParserTest";
+constexpr size_t kPartitionsCount = 100000u;
+
+std::string GeneratePartitionsJson(size_t count) {
+  std::string json = "{\"partitions\":[";
+  for (size_t index = 0u; index < count; ++index) {
+    if (index > 0u) {
+      json += ",";
+    }
+    json += "{\"checksum\":\"291f66029c232400e3403cd6e9cfd36e\","
+            "\"compressedDataSize\":1024,"
+            "\"dataHandle\":\"1b2ca68f-d4a0-4379-8120-cd025640510c\","
+            "\"dataSize\":" +
+            std::to_string(index) + ",\"partition\":\"" +
+            std::to_string(23618364 + index) + "\",\"version\":2}";
+  }
+  json += "],\"next\":\"url\"}";
+  return json;
+}
+
+// Compares the SAX parser with the DOM one on a large metadata page.
+TEST(SaxParserTest, PartitionsThroughput) {
+  const auto json = GeneratePartitionsJson(kPartitionsCount);
+
+  size_t dom_size = 0u;
+  {
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    dom_size = document.GetAllocator().Size();
+  }
+
+  std::stringstream dom_stream(json);
+  auto start = std::chrono::steady_clock::now();
+  auto expected = olp::parser::parse<model::Partitions>(dom_stream);
+  const auto dom_time = std::chrono::steady_clock::now() - start;
+
+  std::stringstream sax_stream(json);
+  start = std::chrono::steady_clock::now();
+  auto actual = olp::parser::parse_sax<model::Partitions>(sax_stream);
+  const auto sax_time = std::chrono::steady_clock::now() - start;
+
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag, "JSON size: %zu bytes, DOM: %zu bytes in %lld us, SAX: %lld us",
+      json.size(), dom_size,
+      static_cast<long long>(duration_cast<microseconds>(dom_time).count()),
+      static_cast<long long>(duration_cast<microseconds>(sax_time).count()));
+
+  ASSERT_EQ(expected.GetPartitions().size(), kPartitionsCount);
+  ASSERT_EQ(actual.GetPartitions().size(), kPartitionsCount);
+  EXPECT_EQ(expected.GetPartitions().back().GetPartition(),
+            actual.GetPartitions().back().GetPartition());
+  EXPECT_EQ(expected.GetPartitions().back().GetDataSize().get_value_or(-1),
+            actual.GetPartitions().back().GetDataSize().get_value_or(-1));
+}
+
+}  // namespace
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/logging/Log.h>
+#include <olp/dataservice/read/StreamLayerClient.h>
+
+#include "MemoryTestBase.h"
+
+namespace {
+struct TestConfiguration : public TestBaseConfiguration {
+  std::string configuration_name;
+
+  std::uint16_t poll_count = 100;
+  // The time spent on processing one batch of messages.
+  std::chrono::milliseconds processing_time{10};
+  size_t poll_prefetch = 0;
+  boost::optional<std::chrono::milliseconds> commit_interval;
+};
+
+std::ostream& operator<<(std::ostream& os, const TestConfiguration& config) {
+  return os << "TestConfiguration("
+            << ".configuration_name=" << config.configuration_name
+            << ", .poll_count=" << config.poll_count
+            << ", .poll_prefetch=" << config.poll_prefetch
+            << ", .task_scheduler_capacity=" << config.task_scheduler_capacity
+            << ")";
+}
+
+constexpr auto kLogTag = "StreamLayerClientTest";
+const olp::client::HRN kCatalog("hrn:here:data::olp-here-test:testhrn");
+const std::string kStreamLayerId("stream_test_layer");
+
+using StreamLayerClientTest = MemoryTestBase<TestConfiguration>;
+
+TEST_P(StreamLayerClientTest, PollMessages) {
+  // Enable only errors to have a short output.
+  olp::logging::Log::setLevel(olp::logging::Level::Warning);
+
+  const auto& parameter = GetParam();
+
+  olp::dataservice::read::StreamLayerClient client(
+      kCatalog, kStreamLayerId, CreateCatalogClientSettings());
+
+  auto subscribe_response =
+      client
+          .Subscribe(olp::dataservice::read::SubscribeRequest()
+                         .WithPollPrefetch(parameter.poll_prefetch)
+                         .WithCommitInterval(parameter.commit_interval))
+          .GetFuture()
+          .get();
+  ASSERT_TRUE(subscribe_response.IsSuccessful())
+      << subscribe_response.GetError().GetMessage();
+
+  size_t messages = 0;
+  size_t failed_polls = 0;
+  const auto start = std::chrono::steady_clock::now();
+
+  for (auto poll = 0; poll < parameter.poll_count; ++poll) {
+    auto response = client.Poll().GetFuture().get();
+    if (!response.IsSuccessful()) {
+      ++failed_polls;
+      continue;
+    }
+
+    messages += response.GetResult().GetMessages().size();
+    std::this_thread::sleep_for(parameter.processing_time);
+  }
+
+  EXPECT_TRUE(client.Unsubscribe().GetFuture().get().IsSuccessful());
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  const auto messages_per_second =
+      elapsed.count() > 0 ? messages * 1000 / elapsed.count() : messages;
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag,
+      "Test %s finished, messages %zu, failed polls %zu, elapsed %lld ms, "
+      "messages/sec %lld",
+      parameter.configuration_name.c_str(), messages, failed_polls,
+      static_cast<long long>(elapsed.count()),
+      static_cast<long long>(messages_per_second));
+
+  EXPECT_EQ(failed_polls, 0u);
+}
+
+/*
+ * Consumes and commits every batch before returning it.
+ */
+TestConfiguration SynchronousPoll() {
+  TestConfiguration configuration;
+  SetNullCacheConfiguration(configuration);
+  configuration.configuration_name = "synchronous_poll";
+  return configuration;
+}
+
+/*
+ * Consumes the next batches and commits the offsets in the background.
+ */
+TestConfiguration PipelinedPoll() {
+  TestConfiguration configuration;
+  SetNullCacheConfiguration(configuration);
+  configuration.poll_prefetch = 2;
+  configuration.commit_interval = std::chrono::milliseconds(100);
+  configuration.configuration_name = "pipelined_poll";
+  return configuration;
+}
+
+std::vector<TestConfiguration> Configurations() {
+  std::vector<TestConfiguration> configurations;
+  configurations.emplace_back(SynchronousPoll());
+  configurations.emplace_back(PipelinedPoll());
+  return configurations;
+}
+
+std::string TestName(const testing::TestParamInfo<TestConfiguration>& info) {
+  return info.param.configuration_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(Throughput, StreamLayerClientTest,
+                         ::testing::ValuesIn(Configurations()), TestName);
+}  // namespace
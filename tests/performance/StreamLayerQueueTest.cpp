@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/cache/CacheSettings.h>
+#include <olp/core/client/HRN.h>
+#include <olp/core/client/OlpClientSettings.h>
+#include <olp/core/client/OlpClientSettingsFactory.h>
+#include <olp/core/logging/Log.h>
+#include <olp/core/utils/Dir.h>
+#include <olp/dataservice/write/StreamLayerClient.h>
+
+namespace {
+namespace write = olp::dataservice::write;
+
+constexpr auto kLogTag = "StreamLayerQueueTest";
+constexpr size_t kRequestCount = 100000u;
+const olp::client::HRN kCatalog("hrn:here:data::olp-here-test:testhrn");
+
+olp::client::OlpClientSettings CreateSettings(const std::string& cache_path) {
+  olp::cache::CacheSettings cache_settings;
+  cache_settings.disk_path_mutable = cache_path;
+
+  olp::client::OlpClientSettings settings;
+  settings.cache =
+      olp::client::OlpClientSettingsFactory::CreateDefaultCache(cache_settings);
+  return settings;
+}
+
+write::StreamLayerClientSettings CreateClientSettings() {
+  write::StreamLayerClientSettings client_settings;
+  client_settings.maximum_requests = kRequestCount + 1u;
+  return client_settings;
+}
+
+// Queues the requests in the cache on disk and reports the throughput.
+TEST(StreamLayerQueueTest, Queue) {
+  olp::logging::Log::setLevel(olp::logging::Level::Warning);
+
+  const auto cache_path =
+      olp::utils::Dir::TempDirectory() + "/stream_layer_queue_test";
+  olp::utils::Dir::Remove(cache_path);
+
+  const auto data = std::make_shared<std::vector<unsigned char>>(1024u, 'z');
+
+  {
+    write::StreamLayerClient client(kCatalog, CreateClientSettings(),
+                                    CreateSettings(cache_path));
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kRequestCount; ++i) {
+      const auto error = client.Queue(write::model::PublishDataRequest()
+                                          .WithData(data)
+                                          .WithLayerId("stream_test_layer"));
+      ASSERT_FALSE(error) << *error;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    OLP_SDK_LOG_CRITICAL_INFO_F(
+        kLogTag, "Queued %zu requests in %lld ms, requests/sec %lld",
+        kRequestCount, static_cast<long long>(elapsed.count()),
+        static_cast<long long>(kRequestCount * 1000 /
+                               std::max<long long>(elapsed.count(), 1)));
+  }
+
+  // The queue is restored without reading the queued requests, so the last
+  // request fits and the next one is rejected.
+  write::StreamLayerClient client(kCatalog, CreateClientSettings(),
+                                  CreateSettings(cache_path));
+  const auto request =
+      write::model::PublishDataRequest().WithData(data).WithLayerId(
+          "stream_test_layer");
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(client.Queue(request));
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  EXPECT_TRUE(client.Queue(request));
+
+  OLP_SDK_LOG_CRITICAL_INFO_F(kLogTag, "Restored the queue in %lld us",
+                              static_cast<long long>(elapsed.count()));
+
+  olp::utils::Dir::Remove(cache_path);
+}
+
+}  // namespace
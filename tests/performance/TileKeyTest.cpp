@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <olp/core/geo/tiling/TileKey.h>
+#include <olp/core/logging/Log.h>
+
+namespace {
+using olp::geo::TileKey;
+
+constexpr auto kLogTag = "TileKeyTest";
+constexpr size_t kTileCount = 1u << 20;
+constexpr int kRounds = 10;
+
+std::vector<TileKey> GenerateTileKeys() {
+  std::mt19937 random(42);
+  std::vector<TileKey> tile_keys;
+  tile_keys.reserve(kTileCount);
+  for (size_t i = 0; i < kTileCount; ++i) {
+    const std::uint32_t level = 1u + random() % TileKey::MaxLevel;
+    const std::uint32_t mask = (std::uint32_t(1) << level) - 1;
+    tile_keys.push_back(
+        TileKey::FromRowColumnLevel(random() & mask, random() & mask, level));
+  }
+  return tile_keys;
+}
+
+// Runs the function `kRounds` times and reports the time per tile key.
+template <typename Function>
+void Measure(const char* name, Function function) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    function();
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+  OLP_SDK_LOG_CRITICAL_INFO_F(
+      kLogTag, "%s: %.2f ns per tile key", name,
+      static_cast<double>(elapsed.count()) / (kRounds * kTileCount));
+}
+
+TEST(TileKeyTest, QuadKey64) {
+  const auto tile_keys = GenerateTileKeys();
+  std::vector<std::uint64_t> quad_keys(kTileCount);
+  std::vector<TileKey> result(kTileCount);
+
+  Measure("ToQuadKey64", [&] {
+    for (size_t i = 0; i < kTileCount; ++i) {
+      quad_keys[i] = tile_keys[i].ToQuadKey64();
+    }
+  });
+
+  Measure("ToQuadKey64 batch", [&] {
+    olp::geo::ToQuadKey64(tile_keys.data(), kTileCount, quad_keys.data());
+  });
+
+  Measure("FromQuadKey64", [&] {
+    for (size_t i = 0; i < kTileCount; ++i) {
+      result[i] = TileKey::FromQuadKey64(quad_keys[i]);
+    }
+  });
+
+  Measure("FromQuadKey64 batch", [&] {
+    olp::geo::FromQuadKey64(quad_keys.data(), kTileCount, result.data());
+  });
+
+  EXPECT_EQ(result, tile_keys);
+}
+
+TEST(TileKeyTest, StringKeys) {
+  const auto tile_keys = GenerateTileKeys();
+  size_t total_length = 0;
+
+  Measure("ToQuadKey", [&] {
+    for (const auto& tile_key : tile_keys) {
+      total_length += tile_key.ToQuadKey().size();
+    }
+  });
+
+  Measure("ToHereTile", [&] {
+    for (const auto& tile_key : tile_keys) {
+      total_length += tile_key.ToHereTile().size();
+    }
+  });
+
+  char buffer[TileKey::HereTileMaxLength + 1];
+  Measure("ToHereTile buffer", [&] {
+    for (const auto& tile_key : tile_keys) {
+      total_length += tile_key.ToHereTile(buffer, sizeof(buffer));
+    }
+  });
+
+  std::vector<std::string> here_tiles;
+  here_tiles.reserve(kTileCount);
+  for (const auto& tile_key : tile_keys) {
+    here_tiles.push_back(tile_key.ToHereTile());
+  }
+
+  std::vector<TileKey> result(kTileCount);
+  Measure("FromHereTile", [&] {
+    for (size_t i = 0; i < kTileCount; ++i) {
+      result[i] = TileKey::FromHereTile(here_tiles[i]);
+    }
+  });
+
+  EXPECT_GT(total_length, 0u);
+  EXPECT_EQ(result, tile_keys);
+}
+
+}  // namespace
@@ -28,6 +28,7 @@ const config_service_handler = require('./config_service.js')
 const metadata_service_handler = require('./metadata_service.js')
 const query_service_handler = require('./query_service.js')
 const blob_service_handler = require('./blob_service.js')
+const stream_service_handler = require('./stream_service.js')
 const errors_generator = require('./errors_generator.js')
 
 const port = 3000
@@ -70,6 +71,10 @@ handlers[services.metadata] = metadata_service_handler.handler
 handlers[services.query] = query_service_handler.handler
 handlers[services.blob] = blob_service_handler.handler
 
+// Handlers that also support the write operations, called with the method
+const method_handlers = {};
+method_handlers[services.stream] = stream_service_handler.handler
+
 const requestHandler = async (request, response) => {
 
   request.on('error', (err) => {
@@ -81,9 +86,11 @@ const requestHandler = async (request, response) => {
   });
 
   const { headers, method, url } = request;
+  const { host, query, pathname } = URL.parse(url, true)
 
-  // Currently we support only read operations
-  if (method != 'GET') {
+  // Currently we support only read operations, except for the stream service
+  const method_handler = method_handlers[host]
+  if (method != 'GET' && !method_handler) {
     response.writeHead(404, {})
     response.end('Not Found')
     return
@@ -104,9 +111,9 @@ const requestHandler = async (request, response) => {
     processor = timeoutDecorator(processor)
   }
 
-  const { host, query, pathname } = URL.parse(url, true)
-
-  const handler = handlers[host]
+  const handler = method_handler ?
+    (pathname, query) => method_handler(method, pathname, query) :
+    handlers[host]
   if (handler) {
     processor(response, pathname, query, handler)
     return
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2020 HERE Europe B.V.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * License-Filename: LICENSE
+ */
+
+const services = require('./urls.js')
+
+// Messages returned by one consume request
+const messagesPerBatch = 100
+// Size of the embedded data of one message
+const messageDataSize = 1024
+
+var nextOffset = 0
+var nextSubscriptionId = 0
+
+function generateSubscribeApiResponse(request) {
+    const catalog = request[1]
+    nextSubscriptionId += 1
+    return {
+        "nodeBaseURL" : "http://" + services.stream + catalog,
+        "subscriptionId" : process.pid + "-" + nextSubscriptionId
+    }
+}
+
+function generateData() {
+    var data = ""
+    var characters = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789';
+    for ( var i = 0; i < messageDataSize; i++ ) {
+        data += characters.charAt(Math.floor(Math.random() * characters.length));
+    }
+    return data
+}
+
+function generateConsumeDataApiResponse(request) {
+    const data = generateData()
+    var messages = []
+    for ( var i = 0; i < messagesPerBatch; i++ ) {
+        const offset = nextOffset++
+        messages.push({
+            "metaData" : {
+                "partition" : String(offset),
+                "data" : data,
+                "timestamp" : Date.now()
+            },
+            "offset" : {
+                "partition" : offset % 4,
+                "offset" : offset
+            }
+        })
+    }
+    return { "messages" : messages }
+}
+
+const methods = [
+{
+    method: 'POST',
+    regex: /(.+)\/layers\/(.+)\/subscribe$/,
+    status: 201,
+    handler: generateSubscribeApiResponse
+},
+{
+    method: 'DELETE',
+    regex: /layers\/(.+)\/subscribe$/,
+    status: 200,
+    handler: null
+},
+{
+    method: 'GET',
+    regex: /layers\/(.+)\/partitions$/,
+    status: 200,
+    handler: generateConsumeDataApiResponse
+},
+{
+    method: 'PUT',
+    regex: /layers\/(.+)\/(offsets|seek)$/,
+    status: 200,
+    handler: null
+}
+]
+
+function stream_handler(method, pathname, query) {
+    for (entry of methods) {
+        const match = pathname.match(entry.regex)
+        if (entry.method == method && match) {
+            const text = entry.handler ? JSON.stringify(entry.handler(match)) : ""
+            return { status: entry.status, text: text, headers: {"Content-Type": "application/json"} }
+        }
+    }
+    console.log("Not handled", method, pathname)
+    return { status: 404, text: "Not Found" }
+}
+
+exports.handler = stream_handler
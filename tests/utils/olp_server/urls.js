@@ -22,3 +22,4 @@ exports.config = "config_service.com"
 exports.metadata = "metadata_service.com"
 exports.query = "query_service.com"
 exports.blob = "blob_service.com"
+exports.stream = "stream_service.com"